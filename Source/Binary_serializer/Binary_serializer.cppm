@@ -1,6 +1,8 @@
 module;
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <memory_resource>
 #include <optional>
@@ -12,37 +14,206 @@ export module h.binary_serializer;
 import h.binary_serializer.generated;
 import h.binary_serializer.generics;
 import h.common;
+import h.common.filesystem;
 import h.core;
 
 namespace h::binary_serializer
 {
+    // A module file starts with a header and a section table, followed by the sections.
+    // Each section can be decoded on its own, so that readers that only need declarations
+    // never touch the function bodies.
+    constexpr std::uint32_t module_file_magic = 0x00424C48; // "HLB\0"
+    constexpr std::uint32_t module_file_version = 1;
+
+    export enum class Module_section : std::uint32_t
+    {
+        Module_info = 0,
+        Export_declarations,
+        Internal_declarations,
+        Definitions,
+        Count
+    };
+
+    export struct Module_section_range
+    {
+        std::uint64_t offset = 0;
+        std::uint64_t size = 0;
+    };
+
+    export using Module_section_table = std::array<Module_section_range, static_cast<std::size_t>(Module_section::Count)>;
+
+    export struct Module_file
+    {
+        h::common::Mapped_file mapped_file;
+        Module_section_table sections;
+    };
+
+    static constexpr std::size_t get_module_file_header_size()
+    {
+        return 4 * sizeof(std::uint32_t) + std::tuple_size_v<Module_section_table> * 2 * sizeof(std::uint64_t);
+    }
+
+    static void serialize_module_info(
+        Serializer& serializer,
+        h::Module const& core_module
+    )
+    {
+        serialize(serializer, core_module.language_version);
+        serialize(serializer, core_module.name);
+        serialize(serializer, core_module.content_hash);
+        serialize(serializer, core_module.dependencies);
+        serialize(serializer, core_module.comment);
+        serialize(serializer, core_module.source_file_path);
+    }
+
+    static void deserialize_module_info(
+        Deserializer& deserializer,
+        h::Module& core_module
+    )
+    {
+        deserialize(deserializer, core_module.language_version);
+        deserialize(deserializer, core_module.name);
+        deserialize(deserializer, core_module.content_hash);
+        deserialize(deserializer, core_module.dependencies);
+        deserialize(deserializer, core_module.comment);
+        deserialize(deserializer, core_module.source_file_path);
+    }
+
     export std::optional<std::pmr::vector<std::byte>> serialize_module(
         h::Module const& core_module,
         std::pmr::polymorphic_allocator<> const& output_allocator,
         std::pmr::polymorphic_allocator<> const& temporaries_allocator
     )
     {
+        std::array<Serializer, static_cast<std::size_t>(Module_section::Count)> section_serializers
+        {
+            Serializer{ .data{temporaries_allocator} },
+            Serializer{ .data{temporaries_allocator} },
+            Serializer{ .data{temporaries_allocator} },
+            Serializer{ .data{temporaries_allocator} },
+        };
+        serialize_module_info(section_serializers[static_cast<std::size_t>(Module_section::Module_info)], core_module);
+        serialize(section_serializers[static_cast<std::size_t>(Module_section::Export_declarations)], core_module.export_declarations);
+        serialize(section_serializers[static_cast<std::size_t>(Module_section::Internal_declarations)], core_module.internal_declarations);
+        serialize(section_serializers[static_cast<std::size_t>(Module_section::Definitions)], core_module.definitions);
+
         Serializer serializer
         {
-            .data{temporaries_allocator}
+            .data{output_allocator}
         };
-        serialize(serializer, core_module);
 
-        return std::pmr::vector<std::byte>{std::move(serializer.data), output_allocator};
+        std::size_t total_size = get_module_file_header_size();
+        for (Serializer const& section_serializer : section_serializers)
+            total_size += section_serializer.data.size();
+        serializer.data.reserve(total_size);
+
+        std::uint32_t const header[] = { module_file_magic, module_file_version, static_cast<std::uint32_t>(section_serializers.size()), 0 };
+        write_data(serializer, header, sizeof(header));
+
+        std::uint64_t offset = get_module_file_header_size();
+        for (Serializer const& section_serializer : section_serializers)
+        {
+            write_uint64(serializer, offset);
+            write_uint64(serializer, section_serializer.data.size());
+            offset += section_serializer.data.size();
+        }
+
+        for (Serializer const& section_serializer : section_serializers)
+            write_data(serializer, section_serializer.data.data(), section_serializer.data.size());
+
+        return std::move(serializer.data);
     }
 
-    export std::optional<h::Module> deserialize_module(
+    export std::optional<Module_section_table> read_module_section_table(
         std::span<std::byte const> const data
     )
     {
+        if (data.size() < get_module_file_header_size())
+            return std::nullopt;
+
         Deserializer deserializer
         {
             .data = data,
             .offset = 0,
         };
 
+        std::uint32_t header[4] = {};
+        read_data(deserializer, header, sizeof(header));
+
+        if (header[0] != module_file_magic || header[1] != module_file_version || header[2] != static_cast<std::uint32_t>(Module_section::Count))
+            return std::nullopt;
+
+        Module_section_table sections = {};
+        for (Module_section_range& section : sections)
+        {
+            section.offset = read_uint64(deserializer);
+            section.size = read_uint64(deserializer);
+
+            if (section.offset > data.size() || section.size > data.size() - section.offset)
+                return std::nullopt;
+        }
+
+        return sections;
+    }
+
+    static Deserializer create_section_deserializer(
+        std::span<std::byte const> const data,
+        Module_section_table const& sections,
+        Module_section const section
+    )
+    {
+        Module_section_range const& range = sections[static_cast<std::size_t>(section)];
+
+        return Deserializer
+        {
+            .data = data.subspan(range.offset, range.size),
+            .offset = 0,
+        };
+    }
+
+    static h::Module deserialize_module_declarations(
+        std::span<std::byte const> const data,
+        Module_section_table const& sections
+    )
+    {
         h::Module core_module = {};
-        deserialize(deserializer, core_module);
+
+        {
+            Deserializer deserializer = create_section_deserializer(data, sections, Module_section::Module_info);
+            deserialize_module_info(deserializer, core_module);
+        }
+        {
+            Deserializer deserializer = create_section_deserializer(data, sections, Module_section::Export_declarations);
+            deserialize(deserializer, core_module.export_declarations);
+        }
+        {
+            Deserializer deserializer = create_section_deserializer(data, sections, Module_section::Internal_declarations);
+            deserialize(deserializer, core_module.internal_declarations);
+        }
+
+        return core_module;
+    }
+
+    static void deserialize_module_definitions(
+        std::span<std::byte const> const data,
+        Module_section_table const& sections,
+        h::Module& core_module
+    )
+    {
+        Deserializer deserializer = create_section_deserializer(data, sections, Module_section::Definitions);
+        deserialize(deserializer, core_module.definitions);
+    }
+
+    export std::optional<h::Module> deserialize_module(
+        std::span<std::byte const> const data
+    )
+    {
+        std::optional<Module_section_table> const sections = read_module_section_table(data);
+        if (!sections.has_value())
+            return std::nullopt;
+
+        h::Module core_module = deserialize_module_declarations(data, sections.value());
+        deserialize_module_definitions(data, sections.value(), core_module);
 
         return core_module;
     }
@@ -65,17 +236,63 @@ namespace h::binary_serializer
         return true;
     }
 
+    // Returns std::nullopt if the file does not exist or was written with a different format version.
+    export std::optional<Module_file> open_module_file(
+        std::filesystem::path const& file_path
+    )
+    {
+        std::optional<h::common::Mapped_file> mapped_file = h::common::map_file(file_path);
+        if (!mapped_file.has_value())
+            return std::nullopt;
+
+        std::optional<Module_section_table> const sections = read_module_section_table(mapped_file->data);
+        if (!sections.has_value())
+            return std::nullopt;
+
+        return Module_file
+        {
+            .mapped_file = std::move(mapped_file.value()),
+            .sections = sections.value(),
+        };
+    }
+
+    // Decodes everything except the function definitions.
+    export h::Module read_module_declarations(
+        Module_file const& module_file
+    )
+    {
+        return deserialize_module_declarations(module_file.mapped_file.data, module_file.sections);
+    }
+
+    export void read_module_definitions(
+        Module_file const& module_file,
+        h::Module& core_module
+    )
+    {
+        deserialize_module_definitions(module_file.mapped_file.data, module_file.sections, core_module);
+    }
+
+    export std::optional<h::Module> read_module_declarations_from_file(
+        std::filesystem::path const& file_path
+    )
+    {
+        std::optional<Module_file> const module_file = open_module_file(file_path);
+        if (!module_file.has_value())
+            return std::nullopt;
+
+        return read_module_declarations(module_file.value());
+    }
+
     export std::optional<h::Module> read_module_from_file(
         std::filesystem::path const& file_path
     )
     {
-        std::optional<std::pmr::vector<std::byte>> const data = h::common::read_binary_file(file_path);
-        if (!data.has_value())
+        std::optional<Module_file> const module_file = open_module_file(file_path);
+        if (!module_file.has_value())
             return std::nullopt;
 
-        std::optional<h::Module> core_module = deserialize_module(
-            data.value()
-        );
+        h::Module core_module = read_module_declarations(module_file.value());
+        read_module_definitions(module_file.value(), core_module);
 
         return core_module;
     }
@@ -1,3 +1,4 @@
+#include <filesystem>
 #include <memory_resource>
 #include <string>
 #include <vector>
@@ -256,4 +257,32 @@ namespace h::binary_serializer
 
         CHECK(input == output.value());
     }
+
+    TEST_CASE("Test binary serialization of Module only reads declarations when requested")
+    {
+        h::Module const input = create_core_module();
+
+        std::filesystem::path const file_path = std::filesystem::temp_directory_path() / "hlang_binary_serializer_declarations.hlb";
+        REQUIRE(write_module_to_file(file_path, input, {}));
+
+        std::optional<Module_file> const module_file = open_module_file(file_path);
+        REQUIRE(module_file.has_value());
+
+        h::Module output = read_module_declarations(module_file.value());
+        CHECK(output.name == input.name);
+        CHECK(output.dependencies == input.dependencies);
+        CHECK(output.export_declarations == input.export_declarations);
+        CHECK(output.definitions.function_definitions.empty());
+
+        read_module_definitions(module_file.value(), output);
+        CHECK(input == output);
+    }
+
+    TEST_CASE("Test binary deserialization of Module rejects data without a section table")
+    {
+        std::pmr::vector<std::byte> const data(16, std::byte{0});
+
+        std::optional<h::Module> const output = deserialize_module(data);
+        CHECK(!output.has_value());
+    }
 }
@@ -243,6 +243,20 @@ namespace h::binary_serializer
         deserialize(deserializer, value.name);
     }
 
+    export template <>
+    void serialize(Serializer& serializer, Vector_type const& value)
+    {
+        serialize(serializer, value.element_type);
+        serialize(serializer, value.size);
+    }
+
+    export template <>
+    void deserialize(Deserializer& deserializer, Vector_type& value)
+    {
+        deserialize(deserializer, value.element_type);
+        deserialize(deserializer, value.size);
+    }
+
     export template <>
     void serialize(Serializer& serializer, Type_reference const& value)
     {
@@ -389,8 +403,10 @@ namespace h::binary_serializer
         serialize(serializer, value.member_types);
         serialize(serializer, value.member_names);
         serialize(serializer, value.member_bit_fields);
+        serialize(serializer, value.member_alignments);
         serialize(serializer, value.member_default_values);
         serialize(serializer, value.is_packed);
+        serialize(serializer, value.alignment);
         serialize(serializer, value.is_literal);
         serialize(serializer, value.comment);
         serialize(serializer, value.member_comments);
@@ -406,8 +422,10 @@ namespace h::binary_serializer
         deserialize(deserializer, value.member_types);
         deserialize(deserializer, value.member_names);
         deserialize(deserializer, value.member_bit_fields);
+        deserialize(deserializer, value.member_alignments);
         deserialize(deserializer, value.member_default_values);
         deserialize(deserializer, value.is_packed);
+        deserialize(deserializer, value.alignment);
         deserialize(deserializer, value.is_literal);
         deserialize(deserializer, value.comment);
         deserialize(deserializer, value.member_comments);
@@ -457,6 +475,20 @@ namespace h::binary_serializer
         deserialize(deserializer, value.source_range);
     }
 
+    export template <>
+    void serialize(Serializer& serializer, Named_parameter_attribute const& value)
+    {
+        serialize(serializer, value.parameter_name);
+        serialize(serializer, value.attribute);
+    }
+
+    export template <>
+    void deserialize(Deserializer& deserializer, Named_parameter_attribute& value)
+    {
+        deserialize(deserializer, value.parameter_name);
+        deserialize(deserializer, value.attribute);
+    }
+
     export template <>
     void serialize(Serializer& serializer, Function_declaration const& value)
     {
@@ -466,6 +498,8 @@ namespace h::binary_serializer
         serialize(serializer, value.input_parameter_names);
         serialize(serializer, value.output_parameter_names);
         serialize(serializer, value.linkage);
+        serialize(serializer, value.attributes);
+        serialize(serializer, value.parameter_attributes);
         serialize(serializer, value.preconditions);
         serialize(serializer, value.postconditions);
         serialize(serializer, value.comment);
@@ -483,6 +517,8 @@ namespace h::binary_serializer
         deserialize(deserializer, value.input_parameter_names);
         deserialize(deserializer, value.output_parameter_names);
         deserialize(deserializer, value.linkage);
+        deserialize(deserializer, value.attributes);
+        deserialize(deserializer, value.parameter_attributes);
         deserialize(deserializer, value.preconditions);
         deserialize(deserializer, value.postconditions);
         deserialize(deserializer, value.comment);
@@ -1,16 +1,21 @@
 #include <argparse/argparse.hpp>
 
+#include <chrono>
+#include <cstdint>
 #include <filesystem>
 #include <iostream>
 #include <map>
 #include <memory_resource>
+#include <optional>
 #include <span>
 #include <string>
 #include <vector>
 
 import h.c_header_converter;
 import h.compiler;
+import h.compiler.build_database;
 import h.compiler.builder;
+import h.compiler.core_module_layer;
 import h.compiler.expressions;
 import h.compiler.jit_runner;
 import h.compiler.linker;
@@ -113,6 +118,74 @@ argparse::Argument& add_output_llvm_ir_argument(argparse::ArgumentParser& comman
         .flag();
 }
 
+argparse::Argument& add_jobs_argument(argparse::ArgumentParser& command)
+{
+    return command.add_argument("-j", "--jobs")
+        .help("Number of parallel jobs. 0 uses one job per hardware thread.")
+        .default_value(std::size_t{0})
+        .scan<'u', std::size_t>();
+}
+
+argparse::Argument& add_debounce_window_argument(argparse::ArgumentParser& command)
+{
+    return command.add_argument("--debounce-window")
+        .help("Milliseconds to wait after the last file change before recompiling the changed files together.")
+        .default_value(std::uint64_t{50})
+        .scan<'u', std::uint64_t>();
+}
+
+argparse::Argument& add_profile_output_argument(argparse::ArgumentParser& command)
+{
+    return command.add_argument("--profile-output")
+        .help("Write a trace of the build in Chrome trace format to this file. It can be opened in chrome://tracing or Perfetto.");
+}
+
+std::optional<std::filesystem::path> get_profile_output_path(argparse::ArgumentParser const& subprogram)
+{
+    std::optional<std::string> const value = subprogram.present<std::string>("--profile-output");
+    if (!value.has_value())
+        return std::nullopt;
+
+    return std::filesystem::path{value.value()};
+}
+
+argparse::Argument& add_report_memory_usage_argument(argparse::ArgumentParser& command)
+{
+    return command.add_argument("--report-memory-usage")
+        .help("Report the peak number of bytes held by each memory arena of the build")
+        .flag();
+}
+
+argparse::Argument& add_function_cache_argument(argparse::ArgumentParser& command)
+{
+    return command.add_argument("--function-cache")
+        .help("Cache the object code of each function in the build directory, so that only changed functions are compiled again")
+        .flag();
+}
+
+argparse::Argument& add_function_cache_size_argument(argparse::ArgumentParser& command)
+{
+    return command.add_argument("--function-cache-size")
+        .help("Maximum size of the function cache in megabytes. The least recently used entries are removed first.")
+        .default_value(std::uint64_t{1024})
+        .scan<'u', std::uint64_t>();
+}
+
+argparse::Argument& add_no_object_cache_argument(argparse::ArgumentParser& command)
+{
+    return command.add_argument("--no-object-cache")
+        .help("Do not reuse the object code that previous runs stored in the build directory")
+        .flag();
+}
+
+argparse::Argument& add_object_cache_size_argument(argparse::ArgumentParser& command)
+{
+    return command.add_argument("--object-cache-size")
+        .help("Maximum size of the JIT object cache in megabytes. The least recently used entries are removed first.")
+        .default_value(std::uint64_t{1024})
+        .scan<'u', std::uint64_t>();
+}
+
 argparse::Argument& add_function_contract_options_argument(argparse::ArgumentParser& command)
 {
     return command.add_argument("--function-contracts")
@@ -129,6 +202,139 @@ h::compiler::Contract_options get_function_contract_options_argument(argparse::A
     return h::compiler::Contract_options::Log_error_and_abort;
 }
 
+argparse::Argument& add_optimization_level_argument(argparse::ArgumentParser& command)
+{
+    return command.add_argument("-O", "--optimization-level")
+        .help("Optimization level. Possible values are 'O0', 'O1', 'O2', 'O3', 'Os' and 'Oz'. Artifacts can override it with their 'optimization_level' field.")
+        .default_value("O0");
+}
+
+h::compiler::Optimization_level parse_optimization_level_argument(std::string const& value)
+{
+    std::optional<h::compiler::Optimization_level> const optimization_level = h::compiler::parse_optimization_level(value);
+    if (!optimization_level.has_value())
+    {
+        std::cerr << std::format("Invalid optimization level '{}'. Possible values are 'O0', 'O1', 'O2', 'O3', 'Os' and 'Oz'.\n", value);
+        std::exit(1);
+    }
+
+    return optimization_level.value();
+}
+
+h::compiler::Optimization_level get_optimization_level_argument(argparse::ArgumentParser const& subprogram)
+{
+    return parse_optimization_level_argument(subprogram.get<std::string>("--optimization-level"));
+}
+
+argparse::Argument& add_tiered_compilation_argument(argparse::ArgumentParser& command)
+{
+    return command.add_argument("--tiered-compilation")
+        .help("Compile functions without optimizations first and recompile them with optimizations in the background once they are hot.")
+        .flag();
+}
+
+argparse::Argument& add_tier_up_call_count_argument(argparse::ArgumentParser& command)
+{
+    return command.add_argument("--tier-up-call-count")
+        .help("Number of calls after which a function is recompiled with optimizations when using tiered compilation.")
+        .default_value(std::uint64_t{10000})
+        .scan<'u', std::uint64_t>();
+}
+
+argparse::Argument& add_tier_up_optimization_level_argument(argparse::ArgumentParser& command)
+{
+    return command.add_argument("--tier-up-optimization-level")
+        .help("Optimization level of hot functions when using tiered compilation. Possible values are 'O1', 'O2', 'O3', 'Os' and 'Oz'.")
+        .default_value("O2");
+}
+
+std::optional<h::compiler::Tiered_compilation_options> get_tiered_compilation_options(argparse::ArgumentParser const& subprogram)
+{
+    if (!subprogram.get<bool>("--tiered-compilation"))
+        return std::nullopt;
+
+    return h::compiler::Tiered_compilation_options
+    {
+        .tier_up_call_count = subprogram.get<std::uint64_t>("--tier-up-call-count"),
+        .tier_up_optimization_level = parse_optimization_level_argument(subprogram.get<std::string>("--tier-up-optimization-level")),
+    };
+}
+
+argparse::Argument& add_lto_argument(argparse::ArgumentParser& command)
+{
+    return command.add_argument("--lto")
+        .help("Link time optimization mode. Possible values are 'none' and 'thin'. 'thin' optimizes executables across modules and artifacts.")
+        .default_value("none");
+}
+
+h::compiler::Lto_mode get_lto_argument(argparse::ArgumentParser const& subprogram)
+{
+    std::string const value = subprogram.get<std::string>("--lto");
+    if (value == "none")
+        return h::compiler::Lto_mode::None;
+
+    if (value == "thin")
+        return h::compiler::Lto_mode::Thin;
+
+    std::cerr << std::format("Invalid LTO mode '{}'. Possible values are 'none' and 'thin'.\n", value);
+    std::exit(1);
+}
+
+argparse::Argument& add_pgo_argument(argparse::ArgumentParser& command)
+{
+    return command.add_argument("--pgo")
+        .help("Profile-guided optimization. Possible values are 'none', 'instrument' and 'use=<file.profdata>'. Instrumented executables write raw profiles to <build-directory>/pgo when they exit, which are merged with 'llvm-profdata merge'.")
+        .default_value("none");
+}
+
+h::compiler::Pgo_options get_pgo_argument(argparse::ArgumentParser const& subprogram, std::filesystem::path const& build_directory_path)
+{
+    std::string const value = subprogram.get<std::string>("--pgo");
+    if (value == "none")
+        return {};
+
+    if (value == "instrument")
+    {
+        return h::compiler::Pgo_options
+        {
+            .mode = h::compiler::Pgo_mode::Instrument,
+            .profile_path = std::filesystem::absolute(build_directory_path / "pgo"),
+        };
+    }
+
+    std::string_view const use_prefix = "use=";
+    if (value.starts_with(use_prefix) && value.size() > use_prefix.size())
+    {
+        std::filesystem::path const profile_path = std::filesystem::absolute(value.substr(use_prefix.size()));
+        if (!std::filesystem::exists(profile_path))
+        {
+            std::cerr << std::format("Profile '{}' does not exist.\n", profile_path.generic_string());
+            std::exit(1);
+        }
+
+        return h::compiler::Pgo_options
+        {
+            .mode = h::compiler::Pgo_mode::Use,
+            .profile_path = profile_path,
+        };
+    }
+
+    std::cerr << std::format("Invalid PGO mode '{}'. Possible values are 'none', 'instrument' and 'use=<file.profdata>'.\n", value);
+    std::exit(1);
+}
+
+argparse::Argument& add_cpu_argument(argparse::ArgumentParser& command)
+{
+    return command.add_argument("--cpu")
+        .help("Target CPU, for example 'x86-64-v3' or 'znver4'. 'native' selects the CPU of this machine. Defaults to a generic CPU.");
+}
+
+argparse::Argument& add_target_features_argument(argparse::ArgumentParser& command)
+{
+    return command.add_argument("--target-features")
+        .help("Comma-separated list of target features to enable or disable, for example '+avx2,-avx512f'.");
+}
+
 argparse::Argument& add_target_triple_argument(argparse::ArgumentParser& command)
 {
     return command.add_argument("--target")
@@ -156,10 +362,24 @@ void print_arguments(int const argc, char const* const* argv)
     std::fflush(stdout);
 }
 
+std::optional<std::pmr::string> get_optional_string_argument(argparse::ArgumentParser const& subprogram, std::string_view const name)
+{
+    std::optional<std::string> const value = subprogram.present<std::string>(name);
+    if (!value.has_value())
+        return std::nullopt;
+
+    return std::pmr::string{value.value()};
+}
+
 h::compiler::Compilation_options create_compilation_options(
     h::compiler::Target const& target,
     bool const no_debug,
-    h::compiler::Contract_options const contract_options
+    h::compiler::Contract_options const contract_options,
+    std::optional<std::pmr::string> cpu = std::nullopt,
+    std::optional<std::pmr::string> target_features = std::nullopt,
+    h::compiler::Optimization_level const optimization_level = h::compiler::Optimization_level::O0,
+    h::compiler::Lto_mode const lto_mode = h::compiler::Lto_mode::None,
+    h::compiler::Pgo_options pgo_options = {}
 )
 {
     bool const output_debug_code_view = !no_debug && target.operating_system == "windows";
@@ -167,10 +387,14 @@ h::compiler::Compilation_options create_compilation_options(
     h::compiler::Compilation_options const compilation_options =
     {
         .target_triple = std::nullopt, // TODO
-        .is_optimized = false, // TODO
+        .cpu = std::move(cpu),
+        .target_features = std::move(target_features),
+        .optimization_level = optimization_level,
         .debug = !no_debug,
         .output_debug_code_view = output_debug_code_view,
         .contract_options = contract_options,
+        .lto_mode = lto_mode,
+        .pgo_options = std::move(pgo_options),
     };
 
     return compilation_options;
@@ -180,7 +404,7 @@ int main(int const argc, char const* const* argv)
 {
     argparse::ArgumentParser program("hlang");
 
-    // hlang build-artifact [--artifact-file=<artifact_file>] [--build-directory=<build_directory>] [--header-search-path=<header_search_path>]... [--repository=<repository_path>]...
+    // hlang build-artifact [--artifact-file=<artifact_file>] [--build-directory=<build_directory>] [--header-search-path=<header_search_path>]... [--repository=<repository_path>]... [--jobs=<jobs>] [--optimization-level=<level>] [--lto=<mode>] [--pgo=<mode>] [--cpu=<cpu>] [--target-features=<features>] [--profile-output=<trace_file>] [--report-memory-usage] [--function-cache] [--function-cache-size=<megabytes>]
     argparse::ArgumentParser build_artifact_command("build-artifact");
     build_artifact_command.add_description("Build an artifact");
     add_artifact_file_argument(build_artifact_command);
@@ -189,10 +413,20 @@ int main(int const argc, char const* const* argv)
     add_repository_argument(build_artifact_command);
     add_no_debug_argument(build_artifact_command);
     add_output_llvm_ir_argument(build_artifact_command);
+    add_jobs_argument(build_artifact_command);
+    add_optimization_level_argument(build_artifact_command);
+    add_lto_argument(build_artifact_command);
+    add_pgo_argument(build_artifact_command);
+    add_cpu_argument(build_artifact_command);
+    add_target_features_argument(build_artifact_command);
+    add_profile_output_argument(build_artifact_command);
+    add_report_memory_usage_argument(build_artifact_command);
+    add_function_cache_argument(build_artifact_command);
+    add_function_cache_size_argument(build_artifact_command);
     add_function_contract_options_argument(build_artifact_command);
     program.add_subparser(build_artifact_command);
 
-    // hlang run-with-jit [--artifact-file=<artifact_file>] [--build-directory=<build_directory>] [--header-search-path=<header_search_path>]... [--repository=<repository_path>]...
+    // hlang run-with-jit [--artifact-file=<artifact_file>] [--build-directory=<build_directory>] [--header-search-path=<header_search_path>]... [--repository=<repository_path>]... [--cpu=<cpu>] [--target-features=<features>] [--profile-output=<trace_file>] [--jobs=<jobs>] [--debounce-window=<milliseconds>] [--tiered-compilation] [--tier-up-call-count=<count>] [--tier-up-optimization-level=<level>] [--no-object-cache] [--object-cache-size=<megabytes>]
     argparse::ArgumentParser run_with_jit_command("run-with-jit");
     run_with_jit_command.add_description("Use Just-in-time (JIT) compilation and run the program. Any changes detected during runtime will be applied.");
     add_artifact_file_argument(run_with_jit_command);
@@ -201,6 +435,16 @@ int main(int const argc, char const* const* argv)
     add_repository_argument(run_with_jit_command);
     add_no_debug_argument(run_with_jit_command);
     add_function_contract_options_argument(run_with_jit_command);
+    add_profile_output_argument(run_with_jit_command);
+    add_cpu_argument(run_with_jit_command);
+    add_target_features_argument(run_with_jit_command);
+    add_jobs_argument(run_with_jit_command);
+    add_debounce_window_argument(run_with_jit_command);
+    add_tiered_compilation_argument(run_with_jit_command);
+    add_tier_up_call_count_argument(run_with_jit_command);
+    add_tier_up_optimization_level_argument(run_with_jit_command);
+    add_no_object_cache_argument(run_with_jit_command);
+    add_object_cache_size_argument(run_with_jit_command);
     program.add_subparser(run_with_jit_command);
 
     // hlang import-c-header <module_name> <header> <output>
@@ -241,6 +485,12 @@ int main(int const argc, char const* const* argv)
     add_target_triple_argument(generate_compile_commands_command);
     program.add_subparser(generate_compile_commands_command);
 
+    // hlang print-build-database [--build-directory=<build_directory>]
+    argparse::ArgumentParser print_build_database_command("print-build-database");
+    print_build_database_command.add_description("Print the content hashes recorded for each module and why it was rebuilt in the last build.");
+    add_build_directory_argument(print_build_database_command);
+    program.add_subparser(print_build_database_command);
+
     try
     {
         program.parse_args(argc, argv);
@@ -264,13 +514,19 @@ int main(int const argc, char const* const* argv)
         std::pmr::vector<std::filesystem::path> const repository_paths = convert_to_path(subprogram.get<std::vector<std::string>>("--repository"));
         bool const no_debug = subprogram.get<bool>("--no-debug");
         h::compiler::Contract_options const contract_options = get_function_contract_options_argument(subprogram);
+        h::compiler::Optimization_level const optimization_level = get_optimization_level_argument(subprogram);
 
         h::compiler::Target const target = h::compiler::get_default_target();
-        h::compiler::Compilation_options const compilation_options = create_compilation_options(target, no_debug, contract_options);
+        h::compiler::Compilation_options const compilation_options = create_compilation_options(target, no_debug, contract_options, get_optional_string_argument(subprogram, "--cpu"), get_optional_string_argument(subprogram, "--target-features"), optimization_level, get_lto_argument(subprogram), get_pgo_argument(subprogram, build_directory_path));
 
         h::compiler::Builder_options const builder_options =
         {
             .output_llvm_ir = subprogram.get<bool>("--output-llvm-ir"),
+            .jobs = subprogram.get<std::size_t>("--jobs"),
+            .profile_output_path = get_profile_output_path(subprogram),
+            .report_memory_usage = subprogram.get<bool>("--report-memory-usage"),
+            .use_function_cache = subprogram.get<bool>("--function-cache"),
+            .function_cache_maximum_size_in_bytes = subprogram.get<std::uint64_t>("--function-cache-size") * 1024ull * 1024ull,
         };
 
         h::compiler::Builder builder = h::compiler::create_builder(
@@ -309,9 +565,17 @@ int main(int const argc, char const* const* argv)
         h::compiler::Contract_options const contract_options = get_function_contract_options_argument(subprogram);
 
         h::compiler::Target const target = h::compiler::get_default_target();
-        h::compiler::Compilation_options const compilation_options = create_compilation_options(target, no_debug, contract_options);
+        h::compiler::Compilation_options const compilation_options = create_compilation_options(target, no_debug, contract_options, get_optional_string_argument(subprogram, "--cpu"), get_optional_string_argument(subprogram, "--target-features"));
+
+        std::optional<std::filesystem::path> const profile_output_path = get_profile_output_path(subprogram);
+        std::chrono::milliseconds const debounce_window{ subprogram.get<std::uint64_t>("--debounce-window") };
+        std::size_t const jobs = subprogram.get<std::size_t>("--jobs");
+        std::optional<h::compiler::Tiered_compilation_options> const tiered_compilation_options = get_tiered_compilation_options(subprogram);
+        std::optional<std::uint64_t> const object_cache_maximum_size_in_bytes = subprogram.get<bool>("--no-object-cache") ?
+            std::nullopt :
+            std::optional<std::uint64_t>{ subprogram.get<std::uint64_t>("--object-cache-size") * 1024ull * 1024ull };
 
-        std::unique_ptr<h::compiler::JIT_runner> const jit_runner = h::compiler::setup_jit_and_watch(artifact_file_path, repository_paths, build_directory_path, header_search_paths, target, compilation_options);
+        std::unique_ptr<h::compiler::JIT_runner> const jit_runner = h::compiler::setup_jit_and_watch(artifact_file_path, repository_paths, build_directory_path, header_search_paths, target, compilation_options, profile_output_path, debounce_window, jobs, tiered_compilation_options, object_cache_maximum_size_in_bytes);
 
         void(*function_pointer)() = h::compiler::get_entry_point_function<void(*)()>(*jit_runner, artifact_file_path);
         if (function_pointer == nullptr)
@@ -397,6 +661,18 @@ int main(int const argc, char const* const* argv)
             output_file_path
         );
     }
+    else if (program.is_subcommand_used("print-build-database"))
+    {
+        argparse::ArgumentParser const& subprogram = program.at<argparse::ArgumentParser>("print-build-database");
+
+        std::filesystem::path const build_directory_path = subprogram.get<std::string>("--build-directory");
+
+        h::compiler::Build_database const build_database = h::compiler::read_build_database(
+            h::compiler::get_build_database_path(build_directory_path)
+        );
+
+        h::compiler::print_build_database(build_database);
+    }
 
     return 0;
 }
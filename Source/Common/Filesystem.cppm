@@ -1,6 +1,14 @@
 module;
 
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <format>
+#include <functional>
+#include <optional>
+#include <span>
+#include <thread>
+#include <utility>
 #include <vector>
 
 export module h.common.filesystem;
@@ -15,6 +23,55 @@ namespace h::common
     
     export std::pmr::vector<std::filesystem::path> get_default_library_directories();
 
+    // Read-only view of a file mapped into memory. The view is unmapped when the object is destroyed.
+    export struct Mapped_file
+    {
+        std::span<std::byte const> data;
+        void* file_handle = nullptr;
+        void* mapping_handle = nullptr;
+
+        Mapped_file() = default;
+
+        Mapped_file(Mapped_file const&) = delete;
+        Mapped_file& operator=(Mapped_file const&) = delete;
+
+        Mapped_file(Mapped_file&& other) noexcept :
+            data{ std::exchange(other.data, {}) },
+            file_handle{ std::exchange(other.file_handle, nullptr) },
+            mapping_handle{ std::exchange(other.mapping_handle, nullptr) }
+        {
+        }
+
+        Mapped_file& operator=(Mapped_file&& other) noexcept
+        {
+            std::swap(data, other.data);
+            std::swap(file_handle, other.file_handle);
+            std::swap(mapping_handle, other.mapping_handle);
+            return *this;
+        }
+
+        ~Mapped_file();
+    };
+
+    export std::optional<Mapped_file> map_file(
+        std::filesystem::path const& path
+    );
+
+    export std::uint64_t get_current_process_id();
+
+    // Path next to file_path that no other process or thread writes to, so that a file can be
+    // written there and then renamed over file_path.
+    export std::filesystem::path get_temporary_file_path(
+        std::filesystem::path const& file_path
+    )
+    {
+        std::size_t const thread_hash = std::hash<std::thread::id>{}(std::this_thread::get_id());
+
+        std::filesystem::path temporary_file_path = file_path;
+        temporary_file_path += std::format(".{}.{:x}.tmp", get_current_process_id(), thread_hash);
+        return temporary_file_path;
+    }
+
     export std::filesystem::path get_builtin_include_directory()
     {
         std::filesystem::path const current_directory_include_path = std::filesystem::current_path().parent_path() / "share" / "hlang" / "include";
@@ -1,7 +1,16 @@
 module;
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <memory_resource>
+#include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 
@@ -35,4 +44,53 @@ namespace h::common
 
         return library_directories;
     }
+
+    Mapped_file::~Mapped_file()
+    {
+        if (!this->data.empty())
+            ::munmap(const_cast<std::byte*>(this->data.data()), this->data.size());
+    }
+
+    std::optional<Mapped_file> map_file(
+        std::filesystem::path const& path
+    )
+    {
+        int const file_descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (file_descriptor == -1)
+            return std::nullopt;
+
+        struct stat file_status = {};
+        if (::fstat(file_descriptor, &file_status) == -1)
+        {
+            ::close(file_descriptor);
+            return std::nullopt;
+        }
+
+        std::size_t const size = static_cast<std::size_t>(file_status.st_size);
+
+        Mapped_file mapped_file;
+
+        // mmap does not accept empty mappings:
+        if (size > 0)
+        {
+            void* const address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+            if (address == MAP_FAILED)
+            {
+                ::close(file_descriptor);
+                return std::nullopt;
+            }
+
+            mapped_file.data = std::span<std::byte const>{ static_cast<std::byte const*>(address), size };
+        }
+
+        // The mapping stays valid after the file descriptor is closed:
+        ::close(file_descriptor);
+
+        return mapped_file;
+    }
+
+    std::uint64_t get_current_process_id()
+    {
+        return static_cast<std::uint64_t>(::getpid());
+    }
 }
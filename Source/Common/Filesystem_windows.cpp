@@ -1,7 +1,11 @@
 module;
 
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <memory_resource>
+#include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 
@@ -75,4 +79,55 @@ namespace h::common
 
         return library_directories;
     }
+
+    Mapped_file::~Mapped_file()
+    {
+        if (!this->data.empty())
+            UnmapViewOfFile(this->data.data());
+
+        if (this->mapping_handle != nullptr)
+            CloseHandle(this->mapping_handle);
+
+        if (this->file_handle != nullptr)
+            CloseHandle(this->file_handle);
+    }
+
+    std::optional<Mapped_file> map_file(
+        std::filesystem::path const& path
+    )
+    {
+        HANDLE const file_handle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_handle == INVALID_HANDLE_VALUE)
+            return std::nullopt;
+
+        Mapped_file mapped_file;
+        mapped_file.file_handle = file_handle;
+
+        LARGE_INTEGER file_size = {};
+        if (!GetFileSizeEx(file_handle, &file_size))
+            return std::nullopt;
+
+        // Empty files cannot be mapped:
+        if (file_size.QuadPart == 0)
+            return mapped_file;
+
+        HANDLE const mapping_handle = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping_handle == nullptr)
+            return std::nullopt;
+
+        mapped_file.mapping_handle = mapping_handle;
+
+        void const* const address = MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+        if (address == nullptr)
+            return std::nullopt;
+
+        mapped_file.data = std::span<std::byte const>{ static_cast<std::byte const*>(address), static_cast<std::size_t>(file_size.QuadPart) };
+
+        return mapped_file;
+    }
+
+    std::uint64_t get_current_process_id()
+    {
+        return static_cast<std::uint64_t>(GetCurrentProcessId());
+    }
 }
@@ -2,6 +2,7 @@ module;
 
 #include <algorithm>
 #include <cassert>
+#include <cstdlib>
 #include <format>
 #include <memory_resource>
 #include <optional>
@@ -14,6 +15,7 @@ module;
 module h.compiler.analysis;
 
 import h.compiler.diagnostic;
+import h.compiler.parallel;
 import h.compiler.validation;
 import h.core;
 import h.core.declarations;
@@ -85,6 +87,46 @@ namespace h::compiler
         return result;
     }
 
+    std::pmr::vector<Analysis_result> process_modules_per_rank(
+        std::size_t const worker_count,
+        std::span<h::Module> const core_modules,
+        std::span<std::pmr::vector<std::size_t> const> const ranks,
+        h::Declaration_database& declaration_database,
+        Analysis_options const& options,
+        std::pmr::polymorphic_allocator<> const& temporaries_allocator
+    )
+    {
+        std::pmr::vector<Analysis_result> results;
+        results.resize(core_modules.size());
+
+        for (std::pmr::vector<std::size_t> const& rank : ranks)
+        {
+            parallel_for(
+                worker_count,
+                rank.size(),
+                [&](std::size_t const worker_index, std::size_t const index) -> void
+                {
+                    std::size_t const core_module_index = rank[index];
+                    results[core_module_index] = process_module(core_modules[core_module_index], declaration_database, options, temporaries_allocator);
+                }
+            );
+
+            if (options.validate)
+            {
+                bool const contains_diagnostics = std::any_of(
+                    rank.begin(),
+                    rank.end(),
+                    [&](std::size_t const core_module_index) -> bool { return !results[core_module_index].diagnostics.empty(); }
+                );
+
+                if (contains_diagnostics)
+                    break;
+            }
+        }
+
+        return results;
+    }
+
     void process_declarations(
         Analysis_result& result,
         h::Module& core_module,
@@ -616,7 +658,7 @@ namespace h::compiler
                 );
 
                 add_instantiated_type_instances(declaration_database, call_instance);
-                declaration_database.call_instances.emplace(std::move(key), std::move(call_instance));
+                add_instance_call(declaration_database, std::move(key), std::move(call_instance));
 
                 h::Expression& left_side_expression = statement.expressions[data.expression.expression_index];
 
@@ -1224,7 +1266,11 @@ namespace h::compiler
             else if (std::holds_alternative<h::Type_instance>(type_reference.value().data))
             {
                 Type_instance const& type_instance = std::get<h::Type_instance>(type_reference.value().data);
-                Declaration_instance_storage const& storage = declaration_database.instances.at(type_instance);
+                Declaration_instance_storage const* const storage_pointer = find_type_instance_storage(declaration_database, type_instance);
+                if (storage_pointer == nullptr)
+                    return std::nullopt;
+
+                Declaration_instance_storage const& storage = *storage_pointer;
                 if (std::holds_alternative<h::Struct_declaration>(storage.data))
                 {
                     Struct_declaration const& struct_declaration = std::get<h::Struct_declaration>(storage.data);
@@ -1298,6 +1344,18 @@ namespace h::compiler
                     .is_mutable = lhs_type_info->is_mutable,
                 };
             }
+            else if (std::holds_alternative<h::Vector_type>(lhs_type_reference->data))
+            {
+                h::Vector_type const& vector_type = std::get<h::Vector_type>(lhs_type_reference->data);
+                if (vector_type.element_type.empty())
+                    return std::nullopt;
+
+                return Type_info
+                {
+                    .type = vector_type.element_type[0],
+                    .is_mutable = lhs_type_info->is_mutable,
+                };
+            }
             else if (std::holds_alternative<h::Pointer_type>(lhs_type_reference->data))
             {
                 h::Pointer_type const& pointer_type = std::get<h::Pointer_type>(lhs_type_reference->data);
@@ -1317,6 +1375,26 @@ namespace h::compiler
         {
             Binary_expression const& data = std::get<h::Binary_expression>(expression.data);
 
+            std::optional<h::Type_reference> left_hand_side_type = get_expression_type(core_module, nullptr, scope, statement, statement.expressions[data.left_hand_side.expression_index], std::nullopt, declaration_database);
+
+            // Operations with a vector operand produce a vector, even if the other operand is a scalar.
+            {
+                std::optional<h::Type_reference> vector_type = left_hand_side_type;
+                if (!vector_type.has_value() || !is_vector_type_reference(vector_type.value()))
+                    vector_type = get_expression_type(core_module, nullptr, scope, statement, statement.expressions[data.right_hand_side.expression_index], std::nullopt, declaration_database);
+
+                if (vector_type.has_value() && is_vector_type_reference(vector_type.value()))
+                {
+                    bool const is_bool_operation = is_equality_binary_operation(data.operation) || is_comparison_binary_operation(data.operation) || is_logical_binary_operation(data.operation);
+
+                    return Type_info
+                    {
+                        .type = is_bool_operation ? create_vector_type_reference({create_bool_type_reference()}, get_vector_type_size(vector_type.value())) : std::move(vector_type.value()),
+                        .is_mutable = false,
+                    };
+                }
+            }
+
             switch (data.operation)
             {
                 case h::Binary_operation::Equal:
@@ -1345,13 +1423,12 @@ namespace h::compiler
                 case h::Binary_operation::Bit_shift_left:
                 case h::Binary_operation::Bit_shift_right:
                 default: {
-                    std::optional<h::Type_reference> type = get_expression_type(core_module, nullptr, scope, statement, statement.expressions[data.left_hand_side.expression_index], std::nullopt, declaration_database);
-                    if (!type.has_value())
+                    if (!left_hand_side_type.has_value())
                         return std::nullopt;
 
                     return Type_info
                     {
-                        .type = std::move(type.value()),
+                        .type = std::move(left_hand_side_type.value()),
                         .is_mutable = false,
                     };
                 }
@@ -1418,6 +1495,69 @@ namespace h::compiler
                         .is_mutable = false,
                     };
                 }
+                else if (builtin_type_reference.value == "vector_shuffle")
+                {
+                    if (data.arguments.size() != 3)
+                        return std::nullopt;
+
+                    std::optional<Type_info> const first_argument_type_info = get_expression_type_info(core_module, nullptr, scope, statement, statement.expressions[data.arguments[0].expression_index], std::nullopt, declaration_database);
+                    if (!first_argument_type_info.has_value() || !std::holds_alternative<h::Vector_type>(first_argument_type_info->type.data))
+                        return std::nullopt;
+
+                    h::Expression const& mask_expression = statement.expressions[data.arguments[2].expression_index];
+                    if (!std::holds_alternative<h::Constant_array_expression>(mask_expression.data))
+                        return std::nullopt;
+
+                    h::Vector_type const& vector_type = std::get<h::Vector_type>(first_argument_type_info->type.data);
+                    h::Constant_array_expression const& mask = std::get<h::Constant_array_expression>(mask_expression.data);
+
+                    return Type_info
+                    {
+                        .type = create_vector_type_reference(vector_type.element_type, mask.array_data.size()),
+                        .is_mutable = false,
+                    };
+                }
+                else if (builtin_type_reference.value == "vector_store")
+                {
+                    return std::nullopt;
+                }
+                else if (
+                    builtin_type_reference.value == "assume_aligned" ||
+                    builtin_type_reference.value == "byte_swap" ||
+                    builtin_type_reference.value == "count_leading_zeros" ||
+                    builtin_type_reference.value == "expect" ||
+                    builtin_type_reference.value == "population_count"
+                )
+                {
+                    if (data.arguments.size() == 0)
+                        return std::nullopt;
+
+                    std::optional<Type_info> const first_argument_type_info = get_expression_type_info(core_module, nullptr, scope, statement, statement.expressions[data.arguments[0].expression_index], std::nullopt, declaration_database);
+                    if (!first_argument_type_info.has_value())
+                        return std::nullopt;
+
+                    return Type_info
+                    {
+                        .type = first_argument_type_info->type,
+                        .is_mutable = false,
+                    };
+                }
+                else if (builtin_type_reference.value == "likely" || builtin_type_reference.value == "unlikely")
+                {
+                    return Type_info
+                    {
+                        .type = create_bool_type_reference(),
+                        .is_mutable = false,
+                    };
+                }
+                else if (
+                    builtin_type_reference.value == "assume" ||
+                    builtin_type_reference.value == "prefetch" ||
+                    builtin_type_reference.value == "unreachable"
+                )
+                {
+                    return std::nullopt;
+                }
             }
             else if (!type_reference.has_value() || !std::holds_alternative<h::Function_pointer_type>(type_reference.value().data))
             {
@@ -1572,10 +1712,10 @@ namespace h::compiler
         {
             Instance_call_expression const& data = std::get<h::Instance_call_expression>(expression.data);
 
-            // Check builtin functions:
+            // Check builtin functions, unless the module declares a function constructor with the same name:
             {
                 h::Expression const& left_hand_side = statement.expressions[data.left_hand_side.expression_index];
-                if (std::holds_alternative<h::Variable_expression>(left_hand_side.data))
+                if (std::holds_alternative<h::Variable_expression>(left_hand_side.data) && !find_declaration(declaration_database, core_module.name, std::get<h::Variable_expression>(left_hand_side.data).name).has_value())
                 {
                     h::Variable_expression const& variable_expression = std::get<h::Variable_expression>(left_hand_side.data);
                     
@@ -1631,6 +1771,40 @@ namespace h::compiler
                             .is_mutable = false,
                         };
                     }
+                    else if (variable_expression.name == "vector_load")
+                    {
+                        std::pmr::vector<h::Type_reference> element_type;
+                        std::uint64_t lane_count = 0;
+                        if (data.arguments.size() == 2)
+                        {
+                            h::Statement const& element_type_argument = data.arguments[0];
+                            if (!element_type_argument.expressions.empty() && std::holds_alternative<h::Type_expression>(element_type_argument.expressions[0].data))
+                            {
+                                h::Type_expression const& type_expression = std::get<h::Type_expression>(element_type_argument.expressions[0].data);
+                                element_type.push_back(type_expression.type);
+                            }
+
+                            h::Statement const& lane_count_argument = data.arguments[1];
+                            if (!lane_count_argument.expressions.empty() && std::holds_alternative<h::Constant_expression>(lane_count_argument.expressions[0].data))
+                            {
+                                h::Constant_expression const& constant_expression = std::get<h::Constant_expression>(lane_count_argument.expressions[0].data);
+                                lane_count = std::strtoull(constant_expression.data.c_str(), nullptr, 10);
+                            }
+                        }
+
+                        h::Function_type function_type
+                        {
+                            .input_parameter_types = {create_array_slice_type_reference(element_type, false), create_integer_type_type_reference(64, false)},
+                            .output_parameter_types = {create_vector_type_reference(element_type, lane_count)},
+                            .is_variadic = false,
+                        };
+
+                        return Type_info
+                        {
+                            .type = create_function_type_type_reference(std::move(function_type), {"values", "index"}, {"result"}),
+                            .is_mutable = false,
+                        };
+                    }
                 }
             }
 
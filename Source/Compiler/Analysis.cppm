@@ -69,6 +69,19 @@ namespace h::compiler
         std::pmr::polymorphic_allocator<> const& temporaries_allocator
     );
 
+    // Processes core_modules one rank at a time. Each rank contains indices into core_modules,
+    // and the modules of a rank must only depend on modules of previous ranks, so that they can be processed in parallel.
+    // The results are indexed like core_modules.
+    // If options.validate is true, the ranks after the first one that produced diagnostics are skipped.
+    export std::pmr::vector<Analysis_result> process_modules_per_rank(
+        std::size_t const worker_count,
+        std::span<h::Module> const core_modules,
+        std::span<std::pmr::vector<std::size_t> const> const ranks,
+        h::Declaration_database& declaration_database,
+        Analysis_options const& options,
+        std::pmr::polymorphic_allocator<> const& temporaries_allocator
+    );
+
     void process_declarations(
         Analysis_result& result,
         h::Module& core_module,
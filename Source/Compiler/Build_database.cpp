@@ -0,0 +1,190 @@
+module;
+
+#include <nlohmann/json.hpp>
+#include <xxhash.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <format>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+module h.compiler.build_database;
+
+import h.common;
+
+namespace h::compiler
+{
+    std::filesystem::path get_build_database_path(
+        std::filesystem::path const& build_directory_path
+    )
+    {
+        return build_directory_path / "build_database.json";
+    }
+
+    Build_database read_build_database(
+        std::filesystem::path const& build_database_path
+    )
+    {
+        if (!std::filesystem::exists(build_database_path))
+            return {};
+
+        std::optional<std::pmr::string> const json_data = h::common::get_file_contents(build_database_path);
+        if (!json_data.has_value())
+            return {};
+
+        // A corrupted database only means that everything is rebuilt:
+        nlohmann::json const json = nlohmann::json::parse(json_data.value(), nullptr, false);
+        if (json.is_discarded() || !json.contains("modules"))
+            return {};
+
+        Build_database build_database;
+
+        try
+        {
+            for (nlohmann::json const& element : json.at("modules"))
+            {
+                std::pmr::string name = element.at("name").get<std::string>().c_str();
+
+                Build_database_entry entry
+                {
+                    .source_hash = element.at("source_hash").get<std::uint64_t>(),
+                    .interface_hash = element.at("interface_hash").get<std::uint64_t>(),
+                    .dependencies_interface_hash = element.at("dependencies_interface_hash").get<std::uint64_t>(),
+                    .compilation_options_hash = element.at("compilation_options_hash").get<std::uint64_t>(),
+                    .output_hash = element.at("output_hash").get<std::uint64_t>(),
+                    .rebuild_reason = element.at("rebuild_reason").get<std::string>().c_str(),
+                };
+
+                build_database.entries.insert(std::make_pair(std::move(name), std::move(entry)));
+            }
+
+            if (json.contains("header_imports"))
+            {
+                for (nlohmann::json const& element : json.at("header_imports"))
+                {
+                    std::pmr::string name = element.at("name").get<std::string>().c_str();
+                    build_database.header_import_hashes.insert(std::make_pair(std::move(name), element.at("hash").get<std::uint64_t>()));
+                }
+            }
+        }
+        catch (nlohmann::json::exception const&)
+        {
+            return {};
+        }
+
+        return build_database;
+    }
+
+    static std::pmr::vector<std::pair<std::pmr::string const, Build_database_entry> const*> get_sorted_entries(
+        Build_database const& build_database
+    )
+    {
+        std::pmr::vector<std::pair<std::pmr::string const, Build_database_entry> const*> entries;
+        entries.reserve(build_database.entries.size());
+
+        for (auto const& pair : build_database.entries)
+            entries.push_back(&pair);
+
+        std::sort(entries.begin(), entries.end(), [](auto const* lhs, auto const* rhs) -> bool { return lhs->first < rhs->first; });
+
+        return entries;
+    }
+
+    void write_build_database(
+        std::filesystem::path const& build_database_path,
+        Build_database const& build_database
+    )
+    {
+        nlohmann::json modules = nlohmann::json::array();
+
+        for (auto const* pair : get_sorted_entries(build_database))
+        {
+            Build_database_entry const& entry = pair->second;
+
+            modules.push_back(
+                {
+                    {"name", std::string_view{pair->first}},
+                    {"source_hash", entry.source_hash},
+                    {"interface_hash", entry.interface_hash},
+                    {"dependencies_interface_hash", entry.dependencies_interface_hash},
+                    {"compilation_options_hash", entry.compilation_options_hash},
+                    {"output_hash", entry.output_hash},
+                    {"rebuild_reason", std::string_view{entry.rebuild_reason}},
+                }
+            );
+        }
+
+        std::pmr::vector<std::pair<std::pmr::string const, std::uint64_t> const*> header_imports;
+        header_imports.reserve(build_database.header_import_hashes.size());
+        for (auto const& pair : build_database.header_import_hashes)
+            header_imports.push_back(&pair);
+        std::sort(header_imports.begin(), header_imports.end(), [](auto const* lhs, auto const* rhs) -> bool { return lhs->first < rhs->first; });
+
+        nlohmann::json header_imports_json = nlohmann::json::array();
+        for (auto const* pair : header_imports)
+        {
+            header_imports_json.push_back(
+                {
+                    {"name", std::string_view{pair->first}},
+                    {"hash", pair->second},
+                }
+            );
+        }
+
+        nlohmann::json const json
+        {
+            {"modules", std::move(modules)},
+            {"header_imports", std::move(header_imports_json)},
+        };
+
+        h::common::write_to_file(build_database_path, json.dump(4));
+    }
+
+    void print_build_database(
+        Build_database const& build_database
+    )
+    {
+        for (auto const* pair : get_sorted_entries(build_database))
+        {
+            Build_database_entry const& entry = pair->second;
+
+            std::string const message = std::format(
+                "{}\n    rebuild reason: {}\n    source hash: {:016x}\n    interface hash: {:016x}\n    dependencies interface hash: {:016x}\n    output hash: {:016x}\n",
+                pair->first,
+                entry.rebuild_reason,
+                entry.source_hash,
+                entry.interface_hash,
+                entry.dependencies_interface_hash,
+                entry.output_hash
+            );
+            ::fputs(message.c_str(), stdout);
+        }
+    }
+
+    std::uint64_t hash_bytes(
+        std::string_view const bytes
+    )
+    {
+        XXH64_hash_t const seed = 0;
+        return XXH64(bytes.data(), bytes.size(), seed);
+    }
+
+    std::optional<std::uint64_t> hash_file_contents(
+        std::filesystem::path const& file_path
+    )
+    {
+        std::optional<std::pmr::vector<std::byte>> const contents = h::common::read_binary_file(file_path);
+        if (!contents.has_value())
+            return std::nullopt;
+
+        return hash_bytes(std::string_view{reinterpret_cast<char const*>(contents->data()), contents->size()});
+    }
+}
@@ -0,0 +1,56 @@
+module;
+
+#include <cstdint>
+#include <filesystem>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+export module h.compiler.build_database;
+
+namespace h::compiler
+{
+    export struct Build_database_entry
+    {
+        std::uint64_t source_hash = 0;
+        std::uint64_t interface_hash = 0;
+        std::uint64_t dependencies_interface_hash = 0;
+        std::uint64_t compilation_options_hash = 0;
+        std::uint64_t output_hash = 0;
+        std::pmr::string rebuild_reason;
+    };
+
+    // Records, per module, the content hashes that the builder uses to decide what to rebuild.
+    export struct Build_database
+    {
+        std::pmr::unordered_map<std::pmr::string, Build_database_entry> entries;
+        std::pmr::unordered_map<std::pmr::string, std::uint64_t> header_import_hashes; // Per C header module, hash of the header contents and import options
+    };
+
+    export std::filesystem::path get_build_database_path(
+        std::filesystem::path const& build_directory_path
+    );
+
+    export Build_database read_build_database(
+        std::filesystem::path const& build_database_path
+    );
+
+    export void write_build_database(
+        std::filesystem::path const& build_database_path,
+        Build_database const& build_database
+    );
+
+    export void print_build_database(
+        Build_database const& build_database
+    );
+
+    export std::uint64_t hash_bytes(
+        std::string_view const bytes
+    );
+
+    export std::optional<std::uint64_t> hash_file_contents(
+        std::filesystem::path const& file_path
+    );
+}
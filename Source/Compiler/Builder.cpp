@@ -1,8 +1,15 @@
 module;
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <format>
 #include <filesystem>
+#include <memory>
 #include <memory_resource>
+#include <mutex>
+#include <optional>
 #include <span>
 #include <string>
 #include <unordered_map>
@@ -11,21 +18,28 @@ module;
 #include <vector>
 
 #include <llvm/IR/Module.h>
+#include <llvm/TargetParser/Host.h>
 
 module h.compiler.builder;
 
 import h.binary_serializer;
 import h.core;
+import h.core.hash;
 import h.core.struct_layout;
 import h.common;
 import h.common.filesystem;
 import h.compiler;
 import h.compiler.analysis;
 import h.compiler.artifact;
+import h.compiler.build_database;
 import h.compiler.clang_code_generation;
 import h.compiler.clang_compiler;
 import h.compiler.compile_commands_generator;
+import h.compiler.function_cache;
 import h.compiler.linker;
+import h.compiler.lto;
+import h.compiler.memory;
+import h.compiler.parallel;
 import h.compiler.profiler;
 import h.compiler.repository;
 import h.compiler.target;
@@ -45,6 +59,33 @@ namespace h::compiler
         return build_directory_path / "artifacts";
     }
 
+    // Object files keep CodeView debug information on Windows. ThinLTO needs bitcode, so it takes precedence.
+    static bool use_object_files(
+        Compilation_options const& compilation_options
+    )
+    {
+        return compilation_options.output_debug_code_view && compilation_options.lto_mode == Lto_mode::None;
+    }
+
+    // ThinLTO already caches its backends, and needs the whole module bitcode.
+    static bool use_function_cache(
+        Builder const& builder
+    )
+    {
+        return builder.use_function_cache && builder.compilation_options.lto_mode == Lto_mode::None;
+    }
+
+    // With the function cache, the output of a module is an archive of the cached objects of its functions.
+    static std::string_view get_module_output_extension(
+        Builder const& builder
+    )
+    {
+        if (use_function_cache(builder))
+            return builder.target.operating_system == "windows" ? "lib" : "a";
+
+        return use_object_files(builder.compilation_options) ? "obj" : "bc";
+    }
+
     static std::filesystem::path get_bitcode_build_directory(
         std::filesystem::path const& build_directory_path
     )
@@ -89,8 +130,13 @@ namespace h::compiler
             .compilation_options = compilation_options,
             .profiler = {},
             .use_profiler = true,
+            .profile_output_path = builder_options.profile_output_path,
+            .report_memory_usage = builder_options.report_memory_usage,
             .output_module_json = false,
             .output_llvm_ir = builder_options.output_llvm_ir,
+            .jobs = builder_options.jobs,
+            .use_function_cache = builder_options.use_function_cache,
+            .function_cache_maximum_size_in_bytes = builder_options.function_cache_maximum_size_in_bytes,
         };
     }
 
@@ -99,10 +145,18 @@ namespace h::compiler
         std::filesystem::path const& artifact_file_path
     )
     {
-        start_timer(get_profiler(builder), "build_artifact");
+        // Modules and other results live in one arena, and temporaries in another. Both are released
+        // at once when the build ends. Workers of the parallel phases allocate from both concurrently,
+        // so the arenas must be thread-safe. They are declared first so that they outlive everything else.
+        Tracked_memory_resource output_memory_usage;
+        std::pmr::synchronized_pool_resource output_arena{&output_memory_usage};
+        Tracked_memory_resource temporaries_memory_usage;
+        std::pmr::synchronized_pool_resource temporaries_arena{&temporaries_memory_usage};
 
-        std::pmr::polymorphic_allocator<> output_allocator;
-        std::pmr::polymorphic_allocator<> temporaries_allocator;
+        std::optional<Profile_zone> profile_zone{std::in_place, get_profiler(builder), "build_artifact"};
+
+        std::pmr::polymorphic_allocator<> output_allocator{&output_arena};
+        std::pmr::polymorphic_allocator<> temporaries_allocator{&temporaries_arena};
 
         std::filesystem::path const hl_build_directory = get_hl_build_directory(
             builder.build_directory_path
@@ -140,7 +194,7 @@ namespace h::compiler
         std::span<h::Module const> const header_modules = modules_and_declaration_database.header_modules;
         std::span<h::Module const* const> const sorted_modules = modules_and_declaration_database.sorted_modules;
 
-        validate_modules_and_exit_if_needed(core_modules, modules_and_declaration_database.declaration_database, temporaries_allocator);
+        validate_modules_and_exit_if_needed(builder, core_modules, modules_and_declaration_database.core_module_ranks, modules_and_declaration_database.declaration_database, temporaries_allocator);
 
         Compilation_options const& compilation_options = builder.compilation_options;
 
@@ -151,32 +205,40 @@ namespace h::compiler
         if (!compile_cpp_and_write_to_bitcode_files(builder, artifacts, llvm_data, compilation_options, temporaries_allocator))
             h::common::print_message_and_exit(std::format("Failed to compile c++."));
 
-        start_timer(get_profiler(builder), "process_modules_and_create_compilation_database");
         // TODO make const
-        Compilation_database compilation_database = process_modules_and_create_compilation_database(
-            llvm_data,
-            sorted_modules,
-            modules_and_declaration_database.declaration_database, // TODO this does a copy
-            output_allocator,
-            temporaries_allocator
-        );
-        end_timer(get_profiler(builder), "process_modules_and_create_compilation_database");
+        Compilation_database compilation_database = [&]() -> Compilation_database
+        {
+            Profile_zone const profile_zone{get_profiler(builder), "process_modules_and_create_compilation_database"};
+            return process_modules_and_create_compilation_database(
+                llvm_data,
+                sorted_modules,
+                modules_and_declaration_database.declaration_database, // TODO this does a copy
+                output_allocator,
+                temporaries_allocator
+            );
+        }();
 
-        std::pmr::unordered_map<std::pmr::string, std::filesystem::path> const module_name_to_file_path_map = create_module_name_to_file_path_map(
-            builder,
+        Module_cache const module_cache = create_module_cache(
             header_modules,
             core_modules,
-            output_allocator,
+            output_allocator
+        );
+
+        std::pmr::unordered_map<std::pmr::string, Optimization_level> const module_optimization_levels = get_module_optimization_levels(
+            artifacts,
+            temporaries_allocator,
             temporaries_allocator
         );
 
         compile_and_write_to_bitcode_files(
             builder,
             core_modules,
-            module_name_to_file_path_map,
+            sorted_modules,
+            module_cache,
             llvm_data,
             compilation_database,
-            compilation_options
+            compilation_options,
+            module_optimization_levels
         );
 
         link_artifacts(
@@ -195,9 +257,18 @@ namespace h::compiler
             );
         }
 
-        end_timer(get_profiler(builder), "build_artifact");
+        profile_zone.reset();
+
+        if (builder.report_memory_usage)
+        {
+            add_to_counter(get_profiler(builder), "output_arena_peak_bytes", output_memory_usage.get_peak_bytes());
+            add_to_counter(get_profiler(builder), "temporaries_arena_peak_bytes", temporaries_memory_usage.get_peak_bytes());
+        }
 
         print_profiler_timings(get_profiler(builder));
+
+        if (builder.profile_output_path.has_value() && builder.use_profiler)
+            write_chrome_trace(builder.profiler, builder.profile_output_path.value());
     }
 
     void add_artifact_dependencies(
@@ -344,13 +415,44 @@ namespace h::compiler
         };
     }
 
+    // Only the contents of the header itself are hashed, not the headers that it includes.
+    static std::uint64_t hash_c_header_import(
+        std::filesystem::path const& header_path,
+        std::uint64_t const header_contents_hash,
+        h::c::Options const& options,
+        std::string_view const header_module_name
+    )
+    {
+        std::string value = std::format(
+            "{};{};{:016x};{}",
+            header_module_name,
+            header_path.generic_string(),
+            header_contents_hash,
+            options.allow_errors
+        );
+
+        for (std::filesystem::path const& include_directory : options.include_directories)
+            value += std::format(";I{}", include_directory.generic_string());
+
+        for (std::pmr::string const& prefix : options.public_prefixes)
+            value += std::format(";P{}", prefix);
+
+        for (std::pmr::string const& prefix : options.remove_prefixes)
+            value += std::format(";R{}", prefix);
+
+        return hash_bytes(value);
+    }
+
     static std::optional<h::Module> parse_c_header_and_cache(
         std::filesystem::path const& build_directory_path,
         bool const output_module_json,
         std::span<std::filesystem::path const> const header_search_paths,
         C_header const& c_header,
         Import_c_header_source_group const& source_group,
-        bool const force_allow_errors
+        bool const force_allow_errors,
+        std::optional<std::uint64_t> const previous_header_import_hash,
+        std::uint64_t& header_import_hash,
+        std::string& log
     )
     {
         std::string_view const header_module_name = c_header.module_name;
@@ -363,19 +465,6 @@ namespace h::compiler
         std::filesystem::path const header_module_filename = std::format("{}.hlb", header_module_name);
         std::filesystem::path const output_header_module_path = build_directory_path / "artifacts" / header_module_filename;
 
-        if (std::filesystem::exists(output_header_module_path))
-        {
-            if (is_file_newer_than(output_header_module_path, header_path.value()))
-            {
-                std::optional<Module> header_module = h::binary_serializer::read_module_from_file(output_header_module_path);
-
-                if (!header_module.has_value())
-                    h::common::print_message_and_exit(std::format("Failed to read cached module {}.", output_header_module_path.generic_string()));
-
-                return header_module.value();
-            }
-        }
-
         h::c::Options const options
         {
             .target_triple = std::nullopt,
@@ -385,13 +474,24 @@ namespace h::compiler
             .allow_errors = force_allow_errors ? true : (c_header.allow_errors.has_value() ? c_header.allow_errors.value() : false),
         };
 
-        ::printf("Importing c header \"%s\"\n    output is \"%s\"\n", header_path->generic_string().c_str(), output_header_module_path.generic_string().c_str());
+        std::optional<std::uint64_t> const header_contents_hash = hash_file_contents(header_path.value());
+        header_import_hash = header_contents_hash.has_value() ? hash_c_header_import(header_path.value(), header_contents_hash.value(), options, header_module_name) : 0;
+
+        if (header_contents_hash.has_value() && previous_header_import_hash == header_import_hash && std::filesystem::exists(output_header_module_path))
+        {
+            // Modules written with an older format version fail to load and are imported again:
+            std::optional<Module> header_module = h::binary_serializer::read_module_from_file(output_header_module_path);
+            if (header_module.has_value())
+                return header_module.value();
+        }
+
+        log += std::format("Importing c header \"{}\"\n    output is \"{}\"\n", header_path->generic_string(), output_header_module_path.generic_string());
         if (!options.include_directories.empty())
         {
-            ::printf("    header search paths\n");
+            log += "    header search paths\n";
             for (std::filesystem::path const& include_directory : options.include_directories)
             {
-                ::printf("    - \"%s\"\n", include_directory.generic_string().c_str());
+                log += std::format("    - \"{}\"\n", include_directory.generic_string());
             }
         }
 
@@ -474,6 +574,7 @@ namespace h::compiler
         h::Module const& core_module,
         std::pmr::unordered_map<std::pmr::string, std::filesystem::path> const& output_header_paths,
         h::Declaration_database const& declaration_database,
+        std::string& log,
         std::pmr::polymorphic_allocator<> const& temporaries_allocator
     )
     {
@@ -495,11 +596,11 @@ namespace h::compiler
 
         create_directory_if_it_does_not_exist(output_c_header_path.parent_path());
         
-        ::printf("Generating c header \"%s\"\n", output_c_header_path.generic_string().c_str());
+        log += std::format("Generating c header \"{}\"\n", output_c_header_path.generic_string());
         h::c::Exported_c_header const c_header = h::c::export_module_as_c_header(core_module, declaration_database, output_header_paths, temporaries_allocator, temporaries_allocator);
         h::common::write_to_file(output_c_header_path, c_header.content);
 
-        ::printf("Generating c++ header \"%s\"\n", output_cpp_header_path.generic_string().c_str());
+        log += std::format("Generating c++ header \"{}\"\n", output_cpp_header_path.generic_string());
         h::c::Exported_cpp_header const cpp_header = h::c::export_module_as_cpp_header(core_module, output_c_header_path, temporaries_allocator, temporaries_allocator);
         h::common::write_to_file(output_cpp_header_path, cpp_header.content);
     }
@@ -642,10 +743,13 @@ namespace h::compiler
         std::pmr::polymorphic_allocator<> const& temporaries_allocator
     )
     {
-        start_timer(get_profiler(builder), "import_and_export_c_headers");
+        Profile_zone const profile_zone{get_profiler(builder), "import_and_export_c_headers"};
 
         Declaration_database declaration_database = create_declaration_database();
 
+        std::filesystem::path const build_database_path = get_build_database_path(builder.build_directory_path);
+        Build_database build_database = read_build_database(build_database_path);
+
         C_header_groups const c_header_groups = get_c_headers(artifacts, builder.header_search_paths, temporaries_allocator, temporaries_allocator);
         std::pmr::unordered_map<std::pmr::string, std::filesystem::path> const output_header_paths = create_output_header_paths(builder, artifacts, core_modules, temporaries_allocator, temporaries_allocator);
 
@@ -654,6 +758,8 @@ namespace h::compiler
         std::pmr::vector<h::Module> header_modules{output_allocator};
         header_modules.resize(c_header_groups.c_headers.size());
 
+        std::pmr::vector<std::uint64_t> header_import_hashes(c_header_groups.c_headers.size(), 0, temporaries_allocator);
+
         for (Source_file_graph_rank_range const rank : graph.ranks)
         {
             for (std::size_t index = 0; index < rank.count; ++index)
@@ -668,41 +774,64 @@ namespace h::compiler
                 }
             }
 
-            // TODO can be done in parallel
-            for (std::size_t index = 0; index < rank.count; ++index)
-            {
-                std::size_t const node_index = rank.start_index + index;
-                Source_file_node const node = graph.nodes[node_index];
-
-                if (node.type == Source_file_node_type::Export_c_header)
-                {
-                    h::Module const& core_module = core_modules[node.index];
-                    
-                    generate_c_header_file(
-                        core_module,
-                        output_header_paths,
-                        declaration_database,
-                        temporaries_allocator
-                    );
-                }
-                else if (node.type == Source_file_node_type::Import_c_header)
+            // Nodes of the same rank do not depend on each other, so they are processed in parallel.
+            // Each header import creates its own libclang index, and only reads the declaration database.
+            // parallel_for only returns once the whole rank is done, which acts as a barrier between ranks.
+            parallel_for(
+                builder.jobs,
+                rank.count,
+                [&](std::size_t const worker_index, std::size_t const index) -> void
                 {
-                    C_header const& c_header = c_header_groups.c_headers[node.index];
-                    std::span<std::filesystem::path const> const header_search_paths = c_header_groups.header_search_paths[node.index];
-                    Import_c_header_source_group const& source_group = *c_header_groups.source_groups[node.index];
-
-                    std::optional<h::Module> header_module = parse_c_header_and_cache(
-                        builder.build_directory_path,
-                        builder.output_module_json,
-                        header_search_paths,
-                        c_header,
-                        source_group,
-                        force_allow_errors
-                    );
-                    if (header_module.has_value())
-                        header_modules[node.index] = std::move(header_module.value());
+                    std::size_t const node_index = rank.start_index + index;
+                    Source_file_node const node = graph.nodes[node_index];
+
+                    // Collect the output of each node and print it at once, so that logs stay readable:
+                    std::string log;
+
+                    if (node.type == Source_file_node_type::Export_c_header)
+                    {
+                        h::Module const& core_module = core_modules[node.index];
+                        Profile_zone const header_zone{get_profiler(builder), "export_c_header", core_module.name};
+
+                        generate_c_header_file(
+                            core_module,
+                            output_header_paths,
+                            declaration_database,
+                            log,
+                            temporaries_allocator
+                        );
+                    }
+                    else if (node.type == Source_file_node_type::Import_c_header)
+                    {
+                        C_header const& c_header = c_header_groups.c_headers[node.index];
+                        std::span<std::filesystem::path const> const header_search_paths = c_header_groups.header_search_paths[node.index];
+                        Import_c_header_source_group const& source_group = *c_header_groups.source_groups[node.index];
+                        Profile_zone const header_zone{get_profiler(builder), "import_c_header", c_header.module_name};
+
+                        auto const previous_hash_location = build_database.header_import_hashes.find(c_header.module_name);
+                        std::optional<std::uint64_t> const previous_header_import_hash = previous_hash_location != build_database.header_import_hashes.end() ?
+                            std::optional<std::uint64_t>{previous_hash_location->second} :
+                            std::nullopt;
+
+                        std::optional<h::Module> header_module = parse_c_header_and_cache(
+                            builder.build_directory_path,
+                            builder.output_module_json,
+                            header_search_paths,
+                            c_header,
+                            source_group,
+                            force_allow_errors,
+                            previous_header_import_hash,
+                            header_import_hashes[node.index],
+                            log
+                        );
+                        if (header_module.has_value())
+                            header_modules[node.index] = std::move(header_module.value());
+                    }
+
+                    if (!log.empty())
+                        ::fputs(log.c_str(), stdout);
                 }
-            }
+            );
 
             for (std::size_t index = 0; index < rank.count; ++index)
             {
@@ -717,6 +846,15 @@ namespace h::compiler
             }
         }
 
+        // The build database is only modified once all headers were imported, since the workers read it:
+        build_database.header_import_hashes.clear();
+        for (std::size_t index = 0; index < c_header_groups.c_headers.size(); ++index)
+        {
+            if (header_import_hashes[index] != 0)
+                build_database.header_import_hashes.insert(std::make_pair(c_header_groups.c_headers[index].module_name, header_import_hashes[index]));
+        }
+        write_build_database(build_database_path, build_database);
+
         std::pmr::vector<h::Module const*> sorted_modules{output_allocator};
         sorted_modules.resize(graph.nodes.size());
 
@@ -729,34 +867,63 @@ namespace h::compiler
                 sorted_modules[index] = &header_modules[node.index];
         }
 
-        for (h::Module& core_module : core_modules)
-            h::compiler::add_import_usages(core_module, output_allocator);
+        std::pmr::vector<std::pmr::vector<std::size_t>> core_module_ranks{output_allocator};
+        core_module_ranks.reserve(graph.ranks.size());
 
-        // TODO can be done in parallel but declaration_database.call_instances needs to be guarded...
-        for (Module& core_module : core_modules)
+        for (Source_file_graph_rank_range const rank : graph.ranks)
         {
-            process_module(core_module, declaration_database, {.validate=false}, temporaries_allocator);
+            std::pmr::vector<std::size_t> core_module_indices{output_allocator};
+
+            for (std::size_t index = 0; index < rank.count; ++index)
+            {
+                Source_file_node const& node = graph.nodes[rank.start_index + index];
+                if (node.type == Source_file_node_type::Module || node.type == Source_file_node_type::Export_c_header)
+                    core_module_indices.push_back(node.index);
+            }
+
+            if (!core_module_indices.empty())
+                core_module_ranks.push_back(std::move(core_module_indices));
         }
 
-        end_timer(get_profiler(builder), "import_and_export_c_headers");
+        for (h::Module& core_module : core_modules)
+            h::compiler::add_import_usages(core_module, output_allocator);
+
+        process_modules_per_rank(
+            builder.jobs,
+            core_modules,
+            core_module_ranks,
+            declaration_database,
+            {.validate=false},
+            temporaries_allocator
+        );
 
         return Modules_and_declaration_database {
             .header_modules = std::move(header_modules),
             .sorted_modules = std::move(sorted_modules),
+            .core_module_ranks = std::move(core_module_ranks),
             .declaration_database = std::move(declaration_database),
         };
     }
 
     void validate_modules_and_exit_if_needed(
+        Builder const& builder,
         std::span<h::Module> const core_modules,
+        std::span<std::pmr::vector<std::size_t> const> const core_module_ranks,
         Declaration_database& declaration_database,
         std::pmr::polymorphic_allocator<> const& temporaries_allocator
     )
     {
-        for (Module& core_module : core_modules)
-        {
-            Analysis_result result = process_module(core_module, declaration_database, {.validate=true}, temporaries_allocator);
+        std::pmr::vector<Analysis_result> const results = process_modules_per_rank(
+            builder.jobs,
+            core_modules,
+            core_module_ranks,
+            declaration_database,
+            {.validate=true},
+            temporaries_allocator
+        );
 
+        for (Analysis_result const& result : results)
+        {
             if (!result.diagnostics.empty())
             {
                 print_diagnostics_and_exit_if_needed(result.diagnostics, temporaries_allocator);
@@ -829,6 +996,93 @@ namespace h::compiler
         return true;
     }
 
+    static Compilation_options get_artifact_compilation_options(
+        Compilation_options const& compilation_options,
+        Artifact const& artifact
+    )
+    {
+        Compilation_options artifact_compilation_options = compilation_options;
+        if (artifact.optimization_level.has_value())
+            artifact_compilation_options.optimization_level = artifact.optimization_level.value();
+        return artifact_compilation_options;
+    }
+
+    // Modules inherit the optimization level of the artifact whose sources they belong to.
+    // Only artifacts that override the build level are added to the map.
+    static std::pmr::unordered_map<std::pmr::string, Optimization_level> get_module_optimization_levels(
+        std::span<Artifact const> const artifacts,
+        std::pmr::polymorphic_allocator<> const& output_allocator,
+        std::pmr::polymorphic_allocator<> const& temporaries_allocator
+    )
+    {
+        std::pmr::unordered_map<std::pmr::string, Optimization_level> module_optimization_levels{output_allocator};
+
+        for (Artifact const& artifact : artifacts)
+        {
+            if (!artifact.optimization_level.has_value())
+                continue;
+
+            std::pmr::vector<std::filesystem::path> const source_file_paths = get_artifact_hlang_source_files(
+                artifact,
+                temporaries_allocator,
+                temporaries_allocator
+            );
+
+            for (std::filesystem::path const& source_file_path : source_file_paths)
+            {
+                std::optional<std::pmr::string> module_name = h::parser::read_module_name(source_file_path);
+                if (module_name.has_value())
+                    module_optimization_levels.insert(std::make_pair(std::move(module_name.value()), artifact.optimization_level.value()));
+            }
+        }
+
+        return module_optimization_levels;
+    }
+
+    // The CPU is resolved first, so that "native" builds on different hosts do not share outputs:
+    static std::uint64_t hash_compilation_options(
+        Compilation_options const& compilation_options
+    )
+    {
+        Target_cpu const target_cpu = get_target_cpu(compilation_options);
+
+        std::string const value = std::format(
+            "{};{};{};{};{};{};{};{}",
+            compilation_options.target_triple.value_or(""),
+            target_cpu.name,
+            target_cpu.features,
+            to_string(compilation_options.optimization_level),
+            compilation_options.debug,
+            compilation_options.output_debug_code_view,
+            static_cast<int>(compilation_options.contract_options),
+            static_cast<int>(compilation_options.lto_mode)
+        );
+
+        // Hashing the profile contents rebuilds the modules when a new profile is merged, and only then:
+        Pgo_options const& pgo_options = compilation_options.pgo_options;
+        std::uint64_t const profile_hash = pgo_options.mode == Pgo_mode::Use && pgo_options.profile_path.has_value() ?
+            hash_file_contents(pgo_options.profile_path.value()).value_or(0) :
+            0;
+
+        std::string const pgo_value = std::format(
+            "{};{};{:016x}",
+            static_cast<int>(pgo_options.mode),
+            pgo_options.profile_path.has_value() ? pgo_options.profile_path->generic_string() : std::string{},
+            profile_hash
+        );
+
+        return hash_bytes(value + pgo_value);
+    }
+
+    static bool is_compiled_cpp_built_with_options(
+        std::filesystem::path const& output_options_file,
+        std::uint64_t const compilation_options_hash
+    )
+    {
+        std::optional<std::pmr::string> const file_contents = h::common::get_file_contents(output_options_file);
+        return file_contents.has_value() && file_contents.value() == std::format("{:016x}", compilation_options_hash);
+    }
+
     bool compile_cpp_and_write_to_bitcode_files(
         Builder& builder,
         std::span<Artifact const> const artifacts,
@@ -837,16 +1091,21 @@ namespace h::compiler
         std::pmr::polymorphic_allocator<> const& temporaries_allocator
     )
     {
-        start_timer(get_profiler(builder), "compile_cpp_and_write_to_bitcode_files");
+        Profile_zone const profile_zone{get_profiler(builder), "compile_cpp_and_write_to_bitcode_files"};
 
-        bool const use_objects = builder.compilation_options.output_debug_code_view;
+        bool const use_objects = use_object_files(builder.compilation_options);
         std::string_view const extension = use_objects ? "obj" : "bc";
         std::filesystem::path const build_directory_path = get_hl_build_directory(builder.build_directory_path);
 
         bool const use_clang_cl = builder.target.operating_system == "windows";
 
+        Target_cpu const target_cpu = get_target_cpu(compilation_options);
+
         for (Artifact const& artifact : artifacts)
         {
+            Compilation_options const artifact_compilation_options = get_artifact_compilation_options(compilation_options, artifact);
+            std::uint64_t const compilation_options_hash = hash_compilation_options(artifact_compilation_options);
+
             std::pmr::vector<std::filesystem::path> const public_include_directories = get_public_include_directories(artifact, artifacts, temporaries_allocator, temporaries_allocator);
             std::pmr::vector<std::pmr::string> const public_include_directories_strings = h::common::convert_path_to_string(public_include_directories, temporaries_allocator);
 
@@ -867,10 +1126,13 @@ namespace h::compiler
                     std::filesystem::path const output_assembly_file = build_directory_path / std::format("{}.{}.{}", artifact.name, source_file_path.stem().generic_string(), extension);
                     std::filesystem::path const output_llvm_ir_file = build_directory_path / std::format("{}.{}.ll", artifact.name, source_file_path.stem().generic_string());
                     std::filesystem::path const output_dependency_file = build_directory_path / std::format("{}.{}.d", artifact.name, source_file_path.stem().generic_string());
+                    std::filesystem::path const output_options_file = build_directory_path / std::format("{}.{}.options", artifact.name, source_file_path.stem().generic_string());
 
-                    if (is_compiled_cpp_up_to_date(output_dependency_file))
+                    if (is_compiled_cpp_up_to_date(output_dependency_file) && is_compiled_cpp_built_with_options(output_options_file, compilation_options_hash))
                         continue;
 
+                    Profile_zone const source_zone{get_profiler(builder), "compile_cpp", source_file_path.filename().generic_string()};
+
                     if (builder.output_llvm_ir)
                     {
                         std::filesystem::path const output_file_path = build_directory_path / std::format("{}.{}.{}", artifact.name, source_file_path.stem().generic_string(), "ll");
@@ -883,15 +1145,17 @@ namespace h::compiler
                             build_directory_path,
                             public_include_directories_strings,
                             group.additional_flags,
+                            target_cpu.name,
+                            target_cpu.features,
+                            artifact_compilation_options.optimization_level,
+                            artifact_compilation_options.lto_mode,
+                            artifact_compilation_options.pgo_options,
                             use_clang_cl,
                             compilation_options.debug,
                             temporaries_allocator
                         );
                         if (!success)
-                        {
-                            end_timer(get_profiler(builder), "compile_cpp_and_write_to_bitcode_files");
                             return false;
-                        } 
                     }
 
                     bool const success = compile_cpp(
@@ -903,23 +1167,90 @@ namespace h::compiler
                         build_directory_path,
                         public_include_directories_strings,
                         group.additional_flags,
+                        target_cpu.name,
+                        target_cpu.features,
+                        artifact_compilation_options.optimization_level,
+                        artifact_compilation_options.lto_mode,
+                        artifact_compilation_options.pgo_options,
                         use_clang_cl,
                         compilation_options.debug,
                         temporaries_allocator
                     );
                     if (!success)
-                    {
-                        end_timer(get_profiler(builder), "compile_cpp_and_write_to_bitcode_files");
                         return false;
-                    }
+
+                    h::common::write_to_file(output_options_file, std::format("{:016x}", compilation_options_hash));
                 }
             }
         }
 
-        end_timer(get_profiler(builder), "compile_cpp_and_write_to_bitcode_files");
         return true;
     }
 
+    static h::Module parse_source_file_and_cache(
+        Builder const& builder,
+        std::optional<h::parser::Parser>& parser,
+        std::filesystem::path const& source_file_path,
+        std::pmr::polymorphic_allocator<> const& output_allocator,
+        std::pmr::polymorphic_allocator<> const& temporaries_allocator
+    )
+    {
+        std::optional<std::pmr::string> const module_name = h::parser::read_module_name(source_file_path);
+        if (!module_name.has_value())
+            h::common::print_message_and_exit(std::format("Could not read module name of source file {}.", source_file_path.generic_string()));
+
+        std::filesystem::path const output_module_filename = std::format("{}.hlb", module_name.value());
+        std::filesystem::path const output_module_path = get_hl_build_directory(builder.build_directory_path) / output_module_filename;
+
+        std::optional<std::pmr::string> const source_content = h::common::get_file_contents(source_file_path);
+        if (!source_content.has_value())
+            h::common::print_message_and_exit(std::format("Could not read source file {}.", source_file_path.generic_string()));
+
+        // The cached module stores the hash of the source it was parsed from:
+        std::uint64_t const source_hash = hash_bytes(source_content.value());
+
+        if (std::filesystem::exists(output_module_path))
+        {
+            std::optional<Module> core_module = h::binary_serializer::read_module_from_file(output_module_path);
+            if (core_module.has_value() && core_module->content_hash == source_hash)
+                return std::move(core_module.value());
+        }
+
+        // Parsers are created lazily so that workers that only read cached modules do not pay for it:
+        if (!parser.has_value())
+            parser = h::parser::create_parser();
+
+        std::pmr::u8string const utf_8_source_content{reinterpret_cast<char8_t const*>(source_content->data()), source_content->size(), temporaries_allocator};
+        h::parser::Parse_tree parse_tree = h::parser::parse(parser.value(), std::move(utf_8_source_content));
+
+        h::parser::Parse_node const root = get_root_node(parse_tree);
+
+        std::optional<h::Module> core_module = h::parser::parse_node_to_module(
+            parse_tree,
+            root,
+            source_file_path,
+            output_allocator,
+            temporaries_allocator
+        );
+        if (!core_module.has_value())
+            h::common::print_message_and_exit(std::format("Could not parse source file {}.", source_file_path.generic_string()));
+
+        core_module->content_hash = source_hash;
+
+        h::binary_serializer::write_module_to_file(output_module_path, core_module.value(), {});
+
+        if (builder.output_module_json)
+        {
+            std::filesystem::path const output_module_json_filename = std::format("{}.hlb.json", module_name.value());
+            std::filesystem::path const output_module_json_path = get_hl_build_directory(builder.build_directory_path) / output_module_json_filename;
+            h::json::write<h::Module>(output_module_json_path, core_module.value());
+        }
+
+        h::parser::destroy_tree(std::move(parse_tree));
+
+        return std::move(core_module.value());
+    }
+
     std::pmr::vector<h::Module> parse_source_files_and_cache(
         Builder& builder,
         std::span<std::filesystem::path const> const source_files_paths,
@@ -927,121 +1258,273 @@ namespace h::compiler
         std::pmr::polymorphic_allocator<> const& temporaries_allocator
     )
     {
-        start_timer(get_profiler(builder), "parse_source_files_and_cache");
+        Profile_zone const profile_zone{get_profiler(builder), "parse_source_files_and_cache"};
 
         std::pmr::vector<h::Module> core_modules{output_allocator};
         core_modules.resize(source_files_paths.size(), h::Module{});
 
-        h::parser::Parser parser = h::parser::create_parser();
-
-        for (std::size_t index = 0; index < source_files_paths.size(); ++index)
-        {
-            std::filesystem::path const& source_file_path = source_files_paths[index];
-
-            std::optional<std::pmr::string> const module_name = h::parser::read_module_name(source_file_path);
-            if (!module_name.has_value())
-                h::common::print_message_and_exit(std::format("Could not read module name of source file {}.", source_file_path.generic_string()));
+        // Each worker owns a tree-sitter parser, as they cannot be shared between threads.
+        // Each module is written to its own slot, so the output order matches the input order.
+        std::size_t const worker_count = get_worker_count(builder.jobs);
+        std::pmr::vector<std::optional<h::parser::Parser>> parsers{temporaries_allocator};
+        parsers.resize(worker_count);
 
-            std::filesystem::path const output_module_filename = std::format("{}.hlb", module_name.value());
-            std::filesystem::path const output_module_path = get_hl_build_directory(builder.build_directory_path) / output_module_filename;
-
-            if (std::filesystem::exists(output_module_path))
+        parallel_for(
+            worker_count,
+            source_files_paths.size(),
+            [&](std::size_t const worker_index, std::size_t const index) -> void
             {
-                if (is_file_newer_than(output_module_path, source_file_path))
-                {
-                    std::optional<Module> core_module = h::binary_serializer::read_module_from_file(output_module_path);
-                    if (!core_module.has_value())
-                        h::common::print_message_and_exit(std::format("Failed to read cached module {}.", output_module_path.generic_string()));
-
-                    core_modules[index] = std::move(core_module.value());
+                Profile_zone const source_zone{get_profiler(builder), "parse_source_file", source_files_paths[index].filename().generic_string()};
 
-                    continue;
-                }
+                core_modules[index] = parse_source_file_and_cache(
+                    builder,
+                    parsers[worker_index],
+                    source_files_paths[index],
+                    output_allocator,
+                    temporaries_allocator
+                );
             }
+        );
 
-            std::optional<std::pmr::string> const source_content = h::common::get_file_contents(source_file_path);
-            if (!source_content.has_value())
-                h::common::print_message_and_exit(std::format("Could not read source file {}.", source_file_path.generic_string()));
+        for (std::optional<h::parser::Parser>& parser : parsers)
+        {
+            if (parser.has_value())
+                h::parser::destroy_parser(std::move(parser.value()));
+        }
 
-            std::pmr::u8string const utf_8_source_content{reinterpret_cast<char8_t const*>(source_content->data()), source_content->size(), temporaries_allocator};
-            h::parser::Parse_tree parse_tree = h::parser::parse(parser, std::move(utf_8_source_content));
+        return core_modules;
+    }
 
-            h::parser::Parse_node const root = get_root_node(parse_tree);
-    
-            std::optional<h::Module> core_module = h::parser::parse_node_to_module(
-                parse_tree,
-                root,
-                source_file_path,
-                output_allocator,
-                temporaries_allocator
-            );
-            if (!core_module.has_value())
-                h::common::print_message_and_exit(std::format("Could not parse source file {}.", source_file_path.generic_string()));
+    static std::pmr::unordered_map<std::string_view, std::uint64_t> hash_module_interfaces(
+        std::size_t const jobs,
+        Module_cache const& module_cache
+    )
+    {
+        std::pmr::vector<h::Module const*> modules;
+        modules.reserve(module_cache.modules.size());
+        for (auto const& pair : module_cache.modules)
+            modules.push_back(pair.second);
 
-            h::binary_serializer::write_module_to_file(output_module_path, core_module.value(), {});
+        std::pmr::vector<std::uint64_t> hashes(modules.size(), 0);
 
-            if (builder.output_module_json)
+        parallel_for(
+            jobs,
+            modules.size(),
+            [&](std::size_t const worker_index, std::size_t const index) -> void
             {
-                std::filesystem::path const output_module_json_filename = std::format("{}.hlb.json", module_name.value());
-                std::filesystem::path const output_module_json_path = get_hl_build_directory(builder.build_directory_path) / output_module_json_filename;
-                h::json::write<h::Module>(output_module_json_path, core_module.value());
+                hashes[index] = hash_module_interface(*modules[index]);
             }
+        );
+
+        std::pmr::unordered_map<std::string_view, std::uint64_t> interface_hashes;
+        interface_hashes.reserve(modules.size());
+        for (std::size_t index = 0; index < modules.size(); ++index)
+            interface_hashes.insert(std::make_pair(std::string_view{modules[index]->name}, hashes[index]));
 
-            core_modules[index] = std::move(core_module.value());
+        return interface_hashes;
+    }
+
+    static void add_dependency_module_names(
+        Module_cache const& module_cache,
+        h::Module const& core_module,
+        std::pmr::unordered_set<std::string_view>& module_names
+    )
+    {
+        for (Import_module_with_alias const& alias_import : core_module.dependencies.alias_imports)
+        {
+            if (!module_names.insert(alias_import.module_name).second)
+                continue;
 
-            h::parser::destroy_tree(std::move(parse_tree));
+            auto const location = module_cache.modules.find(alias_import.module_name);
+            if (location != module_cache.modules.end())
+                add_dependency_module_names(module_cache, *location->second, module_names);
         }
+    }
 
-        h::parser::destroy_parser(std::move(parser));
+    // Combines the interface hashes of all modules that core_module depends on, directly or not.
+    static std::uint64_t hash_dependency_interfaces(
+        Module_cache const& module_cache,
+        std::pmr::unordered_map<std::string_view, std::uint64_t> const& interface_hashes,
+        h::Module const& core_module
+    )
+    {
+        std::pmr::unordered_set<std::string_view> module_names;
+        if (core_module.name != "H.Builtin")
+            module_names.insert("H.Builtin");
 
-        end_timer(get_profiler(builder), "parse_source_files_and_cache");
+        add_dependency_module_names(module_cache, core_module, module_names);
 
-        return core_modules;
+        std::pmr::vector<std::string_view> sorted_module_names{module_names.begin(), module_names.end()};
+        std::sort(sorted_module_names.begin(), sorted_module_names.end());
+
+        std::string buffer;
+        for (std::string_view const module_name : sorted_module_names)
+        {
+            auto const location = interface_hashes.find(module_name);
+            std::uint64_t const interface_hash = location != interface_hashes.end() ? location->second : 0;
+            buffer += std::format("{}:{:x};", module_name, interface_hash);
+        }
+
+        return hash_bytes(buffer);
     }
 
-    std::pmr::unordered_map<std::pmr::string, std::filesystem::path> create_module_name_to_file_path_map(
+    static std::optional<std::string_view> get_rebuild_reason(
         Builder const& builder,
-        std::span<h::Module const> const header_modules,
-        std::span<h::Module const> const core_modules,
-        std::pmr::polymorphic_allocator<> const& output_allocator,
-        std::pmr::polymorphic_allocator<> const& temporaries_allocator
+        Build_database_entry const* const previous_entry,
+        Build_database_entry const& current_entry,
+        std::filesystem::path const& output_assembly_file,
+        std::filesystem::path const& output_llvm_ir_file
     )
     {
-        std::pmr::unordered_map<std::pmr::string, std::filesystem::path> map{temporaries_allocator};
+        if (previous_entry == nullptr)
+            return "not built before";
+
+        if (previous_entry->source_hash != current_entry.source_hash)
+            return "source changed";
+
+        if (previous_entry->dependencies_interface_hash != current_entry.dependencies_interface_hash)
+            return "interface of a dependency changed";
+
+        if (previous_entry->compilation_options_hash != current_entry.compilation_options_hash)
+            return "compilation options changed";
+
+        if (builder.output_llvm_ir && !std::filesystem::exists(output_llvm_ir_file))
+            return "llvm IR output is missing";
+
+        std::optional<std::uint64_t> const output_hash = hash_file_contents(output_assembly_file);
+        if (!output_hash.has_value())
+            return "output is missing";
+
+        if (output_hash.value() != previous_entry->output_hash)
+            return "output was modified";
+
+        return std::nullopt;
+    }
+
+    struct Code_generation_worker_data
+    {
+        std::unique_ptr<LLVM_data> owned_llvm_data;
+        std::unique_ptr<Compilation_database> owned_compilation_database;
+        LLVM_data* llvm_data = nullptr;
+        Compilation_database* compilation_database = nullptr;
+    };
+
+    struct Function_cache_statistics
+    {
+        std::atomic_uint64_t hits = 0;
+        std::atomic_uint64_t misses = 0;
+    };
 
-        auto const insert_entries = [&](std::span<h::Module const> const elements) -> void {
-            for (h::Module const& core_module : elements)
+    // Only the functions whose partition is not in the cache yet are optimized and compiled.
+    static void write_module_using_function_cache(
+        Builder& builder,
+        LLVM_data& llvm_data,
+        llvm::Module& llvm_module,
+        std::string_view const module_name,
+        Optimization_level const optimization_level,
+        std::uint64_t const compilation_options_hash,
+        Function_cache const& function_cache,
+        Function_cache_statistics& statistics,
+        std::filesystem::path const& output_file_path
+    )
+    {
+        bool const use_coff_format = builder.target.operating_system == "windows";
+        std::string_view const object_file_extension = use_coff_format ? "obj" : "o";
+
+        std::pmr::vector<Function_partition> const partitions = [&]() -> std::pmr::vector<Function_partition>
+        {
+            Profile_zone const split_zone{get_profiler(builder), "split_module_into_function_partitions", module_name};
+            return split_module_into_function_partitions(llvm_module, module_name, optimization_level != Optimization_level::O0);
+        }();
+
+        std::pmr::vector<std::filesystem::path> object_file_paths;
+        object_file_paths.reserve(partitions.size());
+
+        for (Function_partition const& partition : partitions)
+        {
+            std::uint64_t const key = hash_function_partition(*partition.module, compilation_options_hash, builder.compilation_options.debug);
+            std::filesystem::path const entry_path = get_function_cache_entry_path(function_cache, key, object_file_extension);
+
+            if (use_function_cache_entry(entry_path))
+            {
+                statistics.hits.fetch_add(1, std::memory_order_relaxed);
+            }
+            else
             {
-                std::string_view const module_name = core_module.name;
+                Profile_zone const function_zone{get_profiler(builder), "compile_function", partition.name};
+                statistics.misses.fetch_add(1, std::memory_order_relaxed);
 
-                std::filesystem::path const module_filename = std::format("{}.hlb", module_name);
-                std::filesystem::path const output_module_path = get_hl_build_directory(builder.build_directory_path) / module_filename;
+                optimize_llvm_module(llvm_data, *partition.module, optimization_level);
+                set_code_generation_optimization_level(llvm_data, optimization_level);
 
-                map.insert(std::make_pair(std::pmr::string{ module_name }, output_module_path));
+                // Write next to the entry and rename, so that an interrupted build never leaves a truncated entry:
+                std::filesystem::path const temporary_path = h::common::get_temporary_file_path(entry_path);
+                write_object_file(llvm_data, *partition.module, temporary_path);
+                std::filesystem::rename(temporary_path, entry_path);
             }
-        };
 
-        insert_entries(header_modules);
-        insert_entries(core_modules);
+            object_file_paths.push_back(entry_path);
+        }
 
-        return std::pmr::unordered_map<std::pmr::string, std::filesystem::path>{std::move(map), output_allocator};
+        if (!write_object_archive(object_file_paths, output_file_path, use_coff_format))
+            h::common::print_message_and_exit(std::format("Failed to write archive of module '{}'.", module_name));
     }
 
     void compile_and_write_to_bitcode_files(
         Builder& builder,
         std::span<h::Module const> const core_modules,
-        std::pmr::unordered_map<std::pmr::string, std::filesystem::path> const& module_name_to_file_path_map,
+        std::span<h::Module const* const> const sorted_modules,
+        Module_cache const& module_cache,
         LLVM_data& llvm_data,
         Compilation_database& compilation_database,
-        Compilation_options const& compilation_options
+        Compilation_options const& compilation_options,
+        std::pmr::unordered_map<std::pmr::string, Optimization_level> const& module_optimization_levels
     )
     {
-        start_timer(get_profiler(builder), "compile_and_write_to_bitcode_files");
+        Profile_zone const profile_zone{get_profiler(builder), "compile_and_write_to_bitcode_files"};
 
-        // TODO to paralelize, llvm_data and compilation_database should be const
+        bool const use_objects = use_object_files(builder.compilation_options);
+        std::string_view const extension = get_module_output_extension(builder);
 
-        bool const use_objects = builder.compilation_options.output_debug_code_view;
-        std::string_view const extension = use_objects ? "obj" : "bc";
+        std::optional<Function_cache> const function_cache = use_function_cache(builder) ?
+            std::optional<Function_cache>{Function_cache{ .directory = builder.build_directory_path / "function_cache", .maximum_size_in_bytes = builder.function_cache_maximum_size_in_bytes }} :
+            std::nullopt;
+        if (function_cache.has_value())
+            create_directory_if_it_does_not_exist(function_cache->directory);
+
+        std::filesystem::path const build_database_path = get_build_database_path(builder.build_directory_path);
+        Build_database const previous_build_database = read_build_database(build_database_path);
+
+        std::pmr::unordered_map<std::string_view, std::uint64_t> const interface_hashes = hash_module_interfaces(builder.jobs, module_cache);
+
+        auto const get_module_compilation_options = [&](h::Module const& core_module) -> Compilation_options
+        {
+            Compilation_options module_compilation_options = compilation_options;
+            auto const location = module_optimization_levels.find(core_module.name);
+            if (location != module_optimization_levels.end())
+                module_compilation_options.optimization_level = location->second;
+            return module_compilation_options;
+        };
+
+        // Options only differ by optimization level between modules, so hash each level once:
+        std::pmr::unordered_map<Optimization_level, std::uint64_t> compilation_options_hashes;
+        auto const get_compilation_options_hash = [&](Compilation_options const& module_compilation_options) -> std::uint64_t
+        {
+            auto const location = compilation_options_hashes.find(module_compilation_options.optimization_level);
+            if (location != compilation_options_hashes.end())
+                return location->second;
+
+            std::uint64_t const hash = hash_compilation_options(module_compilation_options);
+            compilation_options_hashes.insert(std::make_pair(module_compilation_options.optimization_level, hash));
+            return hash;
+        };
+
+        Build_database build_database;
+        build_database.entries.reserve(core_modules.size());
+        build_database.header_import_hashes = previous_build_database.header_import_hashes;
+
+        std::pmr::vector<h::Module const*> modules_to_compile;
+        modules_to_compile.reserve(core_modules.size());
 
         for (std::size_t index = 0; index < core_modules.size(); ++index)
         {
@@ -1050,44 +1533,210 @@ namespace h::compiler
             std::filesystem::path const output_assembly_file = get_bitcode_build_directory(builder.build_directory_path) / std::format("{}.{}", core_module.name, extension);
             std::filesystem::path const output_llvm_ir_file = get_bitcode_build_directory(builder.build_directory_path) / std::format("{}.{}", core_module.name, "ll");
 
-            if (std::filesystem::exists(output_assembly_file))
+            Build_database_entry entry
             {
-                if (!builder.output_llvm_ir || std::filesystem::exists(output_llvm_ir_file))
-                {
-                    std::filesystem::path const& input_module_file = module_name_to_file_path_map.at(core_module.name);
+                .source_hash = core_module.content_hash.value_or(0),
+                .interface_hash = interface_hashes.at(core_module.name),
+                .dependencies_interface_hash = hash_dependency_interfaces(module_cache, interface_hashes, core_module),
+                .compilation_options_hash = get_compilation_options_hash(get_module_compilation_options(core_module)),
+                .output_hash = 0,
+                .rebuild_reason = {},
+            };
+
+            auto const previous_entry_location = previous_build_database.entries.find(core_module.name);
+            Build_database_entry const* const previous_entry = previous_entry_location != previous_build_database.entries.end() ? &previous_entry_location->second : nullptr;
+
+            std::optional<std::string_view> const rebuild_reason = get_rebuild_reason(
+                builder,
+                previous_entry,
+                entry,
+                output_assembly_file,
+                output_llvm_ir_file
+            );
+
+            if (rebuild_reason.has_value())
+            {
+                entry.rebuild_reason = rebuild_reason.value();
+                modules_to_compile.push_back(&core_module);
+            }
+            else
+            {
+                entry.output_hash = previous_entry->output_hash;
+                entry.rebuild_reason = "up to date";
+            }
+
+            build_database.entries.insert(std::make_pair(core_module.name, std::move(entry)));
+        }
+
+        // LLVM contexts, target machines and pass managers cannot be shared between threads.
+        // The first worker uses the given llvm_data and compilation_database.
+        // The others lazily create their own, as the types and clang declarations of a
+        // compilation database belong to the LLVM context they were created with.
+        std::size_t const worker_count = std::min(get_worker_count(builder.jobs), modules_to_compile.size());
+
+        std::pmr::vector<Code_generation_worker_data> workers_data;
+        workers_data.resize(worker_count);
+        if (!workers_data.empty())
+        {
+            workers_data[0].llvm_data = &llvm_data;
+            workers_data[0].compilation_database = &compilation_database;
+        }
+
+        std::mutex initialize_llvm_mutex;
+        std::atomic_uint64_t avoided_module_loads = 0;
+        Function_cache_statistics function_cache_statistics;
+        std::pmr::vector<std::uint64_t> output_hashes(modules_to_compile.size(), 0);
 
-                    if (is_file_newer_than(output_assembly_file, input_module_file))
+        auto const get_worker_data = [&](std::size_t const worker_index) -> Code_generation_worker_data&
+        {
+            Code_generation_worker_data& worker_data = workers_data[worker_index];
+            if (worker_data.llvm_data != nullptr)
+                return worker_data;
+
+            Profile_zone const worker_zone{get_profiler(builder), "initialize_code_generation_worker"};
+
+            {
+                // Registering the LLVM targets is not thread-safe:
+                std::lock_guard<std::mutex> const lock{initialize_llvm_mutex};
+                worker_data.owned_llvm_data = std::make_unique<LLVM_data>(initialize_llvm(compilation_options));
+            }
+
+            worker_data.owned_compilation_database = std::make_unique<Compilation_database>(
+                process_modules_and_create_compilation_database(
+                    *worker_data.owned_llvm_data,
+                    sorted_modules,
+                    compilation_database.declaration_database,
+                    {},
+                    {}
+                )
+            );
+
+            worker_data.llvm_data = worker_data.owned_llvm_data.get();
+            worker_data.compilation_database = worker_data.owned_compilation_database.get();
+            return worker_data;
+        };
+
+        parallel_for(
+            worker_count,
+            modules_to_compile.size(),
+            [&](std::size_t const worker_index, std::size_t const index) -> void
+            {
+                h::Module const& core_module = *modules_to_compile[index];
+                Profile_zone const module_zone{get_profiler(builder), "compile_module", core_module.name};
+
+                Code_generation_worker_data& worker_data = get_worker_data(worker_index);
+
+                std::filesystem::path const output_assembly_file = get_bitcode_build_directory(builder.build_directory_path) / std::format("{}.{}", core_module.name, extension);
+                std::filesystem::path const output_llvm_ir_file = get_bitcode_build_directory(builder.build_directory_path) / std::format("{}.{}", core_module.name, "ll");
+
+                // Print the whole message at once so that the output of different workers does not interleave:
+                std::string message = std::format("Compiling '{}'\n", core_module.name);
+                if (core_module.source_file_path.has_value())
+                    message += std::format("    input is \"{}\"\n", core_module.source_file_path->generic_string());
+                if (builder.output_llvm_ir)
+                    message += std::format("    output llvm IR is \"{}\"\n", output_llvm_ir_file.generic_string());
+                message += std::format("    output is \"{}\"\n", output_assembly_file.generic_string());
+                ::fputs(message.c_str(), stdout);
+
+                std::pmr::unordered_map<std::pmr::string, h::Module const*> const core_module_dependencies = get_dependency_core_modules(
+                    module_cache,
+                    core_module
+                );
+                avoided_module_loads.fetch_add(core_module_dependencies.size(), std::memory_order_relaxed);
+
+                Compilation_options const module_compilation_options = get_module_compilation_options(core_module);
+
+                if (function_cache.has_value())
+                {
+                    // Functions are optimized separately after the lookup in the cache:
+                    std::unique_ptr<llvm::Module> llvm_module = [&]() -> std::unique_ptr<llvm::Module>
                     {
-                        continue;
-                    }
+                        Profile_zone const code_generation_zone{get_profiler(builder), "create_llvm_module", core_module.name};
+                        return create_unoptimized_llvm_module(
+                            *worker_data.llvm_data,
+                            core_module,
+                            core_module_dependencies,
+                            *worker_data.compilation_database,
+                            module_compilation_options
+                        );
+                    }();
+
+                    Profile_zone const write_zone{get_profiler(builder), "write_module_output", core_module.name};
+
+                    if (builder.output_llvm_ir)
+                        h::compiler::write_llvm_ir_to_file(*llvm_module, output_llvm_ir_file);
+
+                    write_module_using_function_cache(
+                        builder,
+                        *worker_data.llvm_data,
+                        *llvm_module,
+                        core_module.name,
+                        module_compilation_options.optimization_level,
+                        build_database.entries.at(core_module.name).compilation_options_hash,
+                        function_cache.value(),
+                        function_cache_statistics,
+                        output_assembly_file
+                    );
+
+                    output_hashes[index] = hash_file_contents(output_assembly_file).value_or(0);
+                    return;
                 }
+
+                std::unique_ptr<llvm::Module> llvm_module = [&]() -> std::unique_ptr<llvm::Module>
+                {
+                    Profile_zone const code_generation_zone{get_profiler(builder), "create_llvm_module", core_module.name};
+                    return create_llvm_module(
+                        *worker_data.llvm_data,
+                        core_module,
+                        core_module_dependencies,
+                        *worker_data.compilation_database,
+                        module_compilation_options
+                    );
+                }();
+
+                Profile_zone const write_zone{get_profiler(builder), "write_module_output", core_module.name};
+
+                if (builder.output_llvm_ir)
+                    h::compiler::write_llvm_ir_to_file(*llvm_module, output_llvm_ir_file);
+
+                if (use_objects)
+                {
+                    h::compiler::set_code_generation_optimization_level(*worker_data.llvm_data, module_compilation_options.optimization_level);
+                    h::compiler::write_object_file(*worker_data.llvm_data, *llvm_module, output_assembly_file);
+                }
+                else if (compilation_options.lto_mode == Lto_mode::Thin)
+                    h::compiler::write_thin_lto_bitcode_to_file(*worker_data.llvm_data, *llvm_module, output_assembly_file);
+                else
+                    h::compiler::write_bitcode_to_file(*worker_data.llvm_data, *llvm_module, output_assembly_file);
+
+                output_hashes[index] = hash_file_contents(output_assembly_file).value_or(0);
             }
+        );
 
-            ::printf("Compiling '%s'\n", core_module.name.c_str());
-            if (core_module.source_file_path.has_value())
-                ::printf("    input is \"%s\"\n", core_module.source_file_path->generic_string().c_str());
-            if (builder.output_llvm_ir)
-                ::printf("    output llvm IR is \"%s\"\n", output_llvm_ir_file.generic_string().c_str());
-            ::printf("    output is \"%s\"\n", output_assembly_file.generic_string().c_str());
+        for (std::size_t index = 0; index < modules_to_compile.size(); ++index)
+            build_database.entries.at(modules_to_compile[index]->name).output_hash = output_hashes[index];
 
-            std::unique_ptr<llvm::Module> llvm_module = create_llvm_module(
-                llvm_data,
-                core_module,
-                module_name_to_file_path_map,
-                compilation_database,
-                compilation_options
-            );
+        write_build_database(build_database_path, build_database);
 
-            if (builder.output_llvm_ir)
-                h::compiler::write_llvm_ir_to_file(*llvm_module, output_llvm_ir_file);
+        // Destroy the compilation databases before their LLVM contexts:
+        for (Code_generation_worker_data& worker_data : workers_data)
+            worker_data.owned_compilation_database.reset();
 
-            if (use_objects)
-                h::compiler::write_object_file(llvm_data, *llvm_module, output_assembly_file);
-            else
-                h::compiler::write_bitcode_to_file(llvm_data, *llvm_module, output_assembly_file);
-        }
+        add_to_counter(get_profiler(builder), "avoided_module_loads", avoided_module_loads.load());
+
+        if (function_cache.has_value())
+        {
+            std::uint64_t const evicted_count = evict_function_cache_entries(function_cache.value());
+
+            std::uint64_t const hits = function_cache_statistics.hits.load();
+            std::uint64_t const misses = function_cache_statistics.misses.load();
+            add_to_counter(get_profiler(builder), "function_cache_hits", hits);
+            add_to_counter(get_profiler(builder), "function_cache_misses", misses);
+            add_to_counter(get_profiler(builder), "function_cache_evictions", evicted_count);
 
-        end_timer(get_profiler(builder), "compile_and_write_to_bitcode_files");
+            std::string const message = std::format("Function cache: {} hits, {} misses, {} evicted\n", hits, misses, evicted_count);
+            ::fputs(message.c_str(), stdout);
+        }
     }
 
     std::pmr::vector<std::filesystem::path> get_artifact_bitcode_files(
@@ -1106,8 +1755,9 @@ namespace h::compiler
             temporaries_allocator
         );
 
-        bool const use_objects = builder.compilation_options.output_debug_code_view;
+        bool const use_objects = use_object_files(builder.compilation_options);
         std::string_view const extension = use_objects ? "obj" : "bc";
+        std::string_view const module_extension = get_module_output_extension(builder);
 
         for (std::filesystem::path const& source_file_path : hlang_source_files)
         {
@@ -1115,7 +1765,7 @@ namespace h::compiler
             if (!module_name.has_value())
                 h::common::print_message_and_exit(std::format("Could not read module name of source file {}.", source_file_path.generic_string()));
 
-            std::filesystem::path bitcode_file = build_directory_path / std::format("{}.{}", module_name.value(), extension);
+            std::filesystem::path bitcode_file = build_directory_path / std::format("{}.{}", module_name.value(), module_extension);
             bitcode_files.push_back(std::move(bitcode_file));
         }
         
@@ -1146,7 +1796,8 @@ namespace h::compiler
         std::span<Artifact const> const artifacts,
         h::compiler::Target const& target,
         std::filesystem::path const& build_directory_path,
-        h::compiler::Compilation_options const& compilation_options
+        h::compiler::Compilation_options const& compilation_options,
+        bool const link_dependency_artifacts
     )
     {
         if (artifact.info.has_value())
@@ -1180,7 +1831,7 @@ namespace h::compiler
             if (location == artifacts.end())
                 continue;
 
-            if (contains_any_compilable_source(*location))
+            if (link_dependency_artifacts && contains_any_compilable_source(*location))
             {
                 std::filesystem::path const output_path = build_directory_path / "lib" / location->name;
                 artifact_libraries.libraries.push_back(std::pmr::string{output_path.generic_string()});
@@ -1192,7 +1843,8 @@ namespace h::compiler
                 artifacts,
                 target,
                 build_directory_path,
-                compilation_options
+                compilation_options,
+                link_dependency_artifacts
             );
         }
     }
@@ -1203,6 +1855,7 @@ namespace h::compiler
         h::compiler::Target const& target,
         std::filesystem::path const& build_directory_path,
         h::compiler::Compilation_options const& compilation_options,
+        bool const link_dependency_artifacts,
         std::pmr::polymorphic_allocator<> const& output_allocator,
         std::pmr::polymorphic_allocator<> const& temporaries_allocator
     )
@@ -1219,7 +1872,8 @@ namespace h::compiler
             artifacts,
             target,
             build_directory_path,
-            compilation_options
+            compilation_options,
+            link_dependency_artifacts
         );
 
         return
@@ -1229,6 +1883,85 @@ namespace h::compiler
         };
     }
 
+    // The bitcode of the executable and of every artifact it depends on goes through a single thin link,
+    // so that functions of libraries can be inlined into the executable.
+    static std::pmr::vector<std::filesystem::path> run_thin_lto_for_executable(
+        Builder& builder,
+        Artifact const& artifact,
+        std::span<Artifact const> const artifacts,
+        Executable_info const& executable_info,
+        std::span<std::filesystem::path const> const native_file_paths,
+        h::compiler::Compilation_options const& compilation_options,
+        std::pmr::polymorphic_allocator<> const& output_allocator,
+        std::pmr::polymorphic_allocator<> const& temporaries_allocator
+    )
+    {
+        Profile_zone const profile_zone{get_profiler(builder), "run_thin_lto", artifact.name};
+
+        std::pmr::vector<std::filesystem::path> bitcode_files = get_artifact_bitcode_files(
+            builder,
+            artifact,
+            temporaries_allocator
+        );
+
+        std::pmr::vector<Artifact const*> const dependencies = get_artifact_dependencies(artifact, artifacts, true, temporaries_allocator, temporaries_allocator);
+        for (Artifact const* const dependency : dependencies)
+        {
+            std::pmr::vector<std::filesystem::path> const dependency_bitcode_files = get_artifact_bitcode_files(
+                builder,
+                *dependency,
+                temporaries_allocator
+            );
+            bitcode_files.insert(bitcode_files.end(), dependency_bitcode_files.begin(), dependency_bitcode_files.end());
+        }
+
+        Compilation_options const artifact_compilation_options = get_artifact_compilation_options(compilation_options, artifact);
+        Target_cpu const target_cpu = get_target_cpu(artifact_compilation_options);
+        std::string const target_triple = std::string{artifact_compilation_options.target_triple.value_or(std::string_view{})};
+        std::string_view const preserved_symbols[] = { executable_info.entry_point };
+
+        Thin_lto_options const thin_lto_options
+        {
+            .target_triple = target_triple,
+            .cpu = target_cpu.name,
+            .features = target_cpu.features,
+            .optimization_level = artifact_compilation_options.optimization_level,
+            .preserved_symbols = preserved_symbols,
+            .native_file_paths = native_file_paths,
+            .output_directory = get_hl_build_directory(builder.build_directory_path) / "lto",
+            .output_prefix = artifact.name,
+            .object_file_extension = builder.target.operating_system == "windows" ? "obj" : "o",
+            .cache_directory = builder.build_directory_path / "lto_cache",
+            .jobs = builder.jobs,
+        };
+
+        std::optional<std::pmr::vector<std::filesystem::path>> object_files = run_thin_lto(
+            bitcode_files,
+            thin_lto_options,
+            output_allocator
+        );
+        if (!object_files.has_value())
+            h::common::print_message_and_exit(std::format("ThinLTO of executable '{}' failed.", artifact.name));
+
+        return std::move(object_files.value());
+    }
+
+    static std::filesystem::path find_profile_runtime(
+        Builder const& builder
+    )
+    {
+        bool const use_clang_cl = builder.target.operating_system == "windows";
+        std::string const target_triple = builder.compilation_options.target_triple.has_value() ?
+            std::string{builder.compilation_options.target_triple.value()} :
+            llvm::sys::getDefaultTargetTriple();
+
+        std::optional<std::filesystem::path> const profile_runtime = find_clang_profile_runtime(target_triple, use_clang_cl);
+        if (!profile_runtime.has_value())
+            h::common::print_message_and_exit("Could not find the clang profile runtime, which instrumented executables need to write their profiles.");
+
+        return profile_runtime.value();
+    }
+
     void link_artifacts(
         Builder& builder,
         std::span<Artifact const> const artifacts,
@@ -1236,11 +1969,12 @@ namespace h::compiler
         std::pmr::polymorphic_allocator<> const& temporaries_allocator
     )
     {
-        start_timer(get_profiler(builder), "link_artifacts");
+        Profile_zone const profile_zone{get_profiler(builder), "link_artifacts"};
 
         for (std::size_t index = 0; index < artifacts.size(); ++index)
         {
             Artifact const& artifact = artifacts[index];
+            Profile_zone const artifact_zone{get_profiler(builder), "link_artifact", artifact.name};
 
             std::pmr::vector<std::filesystem::path> const bitcode_files = get_artifact_bitcode_files(
                 builder,
@@ -1250,12 +1984,17 @@ namespace h::compiler
             if (bitcode_files.empty())
                 continue;
 
+            bool const is_executable = artifact.info.has_value() && std::holds_alternative<h::compiler::Executable_info>(*artifact.info);
+            bool const use_thin_lto = is_executable && compilation_options.lto_mode == Lto_mode::Thin;
+
+            // With ThinLTO, the bitcode of dependency artifacts is linked into the executable instead of their libraries:
             Artifact_libraries const artifact_libraries = get_artifact_libraries_for_linking(
                 artifact,
                 artifacts,
                 builder.target,
                 builder.build_directory_path,
                 compilation_options,
+                !use_thin_lto,
                 temporaries_allocator,
                 temporaries_allocator
             );
@@ -1281,22 +2020,50 @@ namespace h::compiler
                 if (!result)
                     h::common::print_message_and_exit(std::format("Failed to link static library '{}'.", artifact.name));
             }
-            else if (artifact.info.has_value() && std::holds_alternative<h::compiler::Executable_info>(*artifact.info))
+            else if (is_executable)
             {
                 h::compiler::Executable_info const& executable_info = std::get<h::compiler::Executable_info>(*artifact.info);
 
+                bool const is_instrumented = compilation_options.pgo_options.mode == Pgo_mode::Instrument;
+                std::optional<std::filesystem::path> const profile_runtime = is_instrumented ? std::optional<std::filesystem::path>{find_profile_runtime(builder)} : std::nullopt;
+
+                std::pmr::vector<std::filesystem::path> object_files{temporaries_allocator};
+                if (use_thin_lto)
+                {
+                    // The symbols that libraries and the profile runtime reference must survive the thin link:
+                    std::pmr::vector<std::filesystem::path> native_file_paths{temporaries_allocator};
+                    native_file_paths.reserve(artifact_libraries.libraries.size() + 1);
+                    for (std::pmr::string const& library : artifact_libraries.libraries)
+                        native_file_paths.push_back(std::filesystem::path{library});
+                    if (profile_runtime.has_value())
+                        native_file_paths.push_back(profile_runtime.value());
+
+                    object_files = run_thin_lto_for_executable(builder, artifact, artifacts, executable_info, native_file_paths, compilation_options, temporaries_allocator, temporaries_allocator);
+                }
+                else
+                {
+                    object_files = bitcode_files;
+                }
+
+                if (profile_runtime.has_value())
+                    object_files.push_back(profile_runtime.value());
+
+                // The runtime is only pulled from its archive through this symbol:
+                std::array<std::string_view, 1> const profile_runtime_symbols = { "__llvm_profile_runtime" };
+
                 h::compiler::Linker_options const linker_options
                 {
                     .entry_point = executable_info.entry_point,
                     .debug = compilation_options.debug,
-                    .link_type = h::compiler::Link_type::Executable
+                    .link_type = h::compiler::Link_type::Executable,
+                    .undefined_symbols = is_instrumented ? std::span<std::string_view const>{profile_runtime_symbols} : std::span<std::string_view const>{},
                 };
 
                 std::filesystem::path const output = builder.build_directory_path / "bin" / artifact.name;
                 create_directory_if_it_does_not_exist(output.parent_path());
 
                 bool const result = h::compiler::link(
-                    bitcode_files,
+                    object_files,
                     artifact_libraries.libraries,
                     output,
                     linker_options
@@ -1305,8 +2072,6 @@ namespace h::compiler
                     h::common::print_message_and_exit(std::format("Failed to link executable '{}'.", artifact.name));
             }
         }
-
-        end_timer(get_profiler(builder), "link_artifacts");
     }
 
     void copy_dll(
@@ -1402,7 +2167,7 @@ namespace h::compiler
         h::compiler::Compilation_options const options
         {
             .target_triple = target_triple,
-            .is_optimized = false,
+            .optimization_level = Optimization_level::O0,
             .debug = true,
         };
         h::compiler::LLVM_data llvm_data = h::compiler::initialize_llvm(options);
@@ -1419,18 +2184,13 @@ namespace h::compiler
             declaration_database
         );
 
-        h::compiler::Type_database type_database = h::compiler::create_type_database(*llvm_data.context);
-        h::compiler::add_module_types(type_database, *llvm_data.context, llvm_data.data_layout, clang_module_data, *core_module);
+        h::Struct_layout const struct_layout = h::compiler::calculate_struct_layout(clang_module_data, core_module->name, struct_name);
 
-        std::optional<h::Struct_layout> const struct_layout = h::compiler::calculate_struct_layout(llvm_data.data_layout, type_database, core_module->name, struct_name);
-        if (!struct_layout.has_value())
-        {
-            std::puts("<error>");
-            return;
-        }
+        std::uint64_t const cache_line_size = 64;
+        h::Struct_layout_analysis const analysis = h::analyze_struct_layout(struct_layout, cache_line_size);
 
         std::stringstream string_stream;
-        string_stream << struct_layout.value();
+        h::write_struct_layout_report(string_stream, struct_layout, analysis);
         std::string const output = string_stream.str();
         std::puts(output.c_str());
     }
@@ -1446,7 +2206,7 @@ namespace h::compiler
 
         std::filesystem::path const build_directory_path = get_hl_build_directory(builder.build_directory_path);
         bool const use_clang_cl = builder.target.operating_system == "windows";
-        bool const use_objects = builder.compilation_options.output_debug_code_view;
+        bool const use_objects = use_object_files(builder.compilation_options);
 
         std::pmr::vector<Artifact> const artifacts = get_sorted_artifacts(
             { &artifact_file_path, 1 },
@@ -1,7 +1,9 @@
 module;
 
+#include <cstdint>
 #include <filesystem>
 #include <memory_resource>
+#include <optional>
 #include <span>
 #include <string>
 #include <unordered_map>
@@ -22,6 +24,11 @@ namespace h::compiler
     export struct Builder_options
     {
         bool output_llvm_ir = false;
+        std::size_t jobs = 0; // 0 means one job per hardware thread
+        std::optional<std::filesystem::path> profile_output_path; // Chrome trace format
+        bool report_memory_usage = false;
+        bool use_function_cache = false;
+        std::uint64_t function_cache_maximum_size_in_bytes = 1024ull * 1024ull * 1024ull;
     };
 
     export struct Builder
@@ -33,8 +40,13 @@ namespace h::compiler
         h::compiler::Compilation_options compilation_options;
         Profiler profiler;
         bool use_profiler = true;
+        std::optional<std::filesystem::path> profile_output_path;
+        bool report_memory_usage = false;
         bool output_module_json = false;
         bool output_llvm_ir = false;
+        std::size_t jobs = 0;
+        bool use_function_cache = false;
+        std::uint64_t function_cache_maximum_size_in_bytes = 0;
     };
 
     export Builder create_builder(
@@ -69,6 +81,7 @@ namespace h::compiler
     {
         std::pmr::vector<h::Module> header_modules;
         std::pmr::vector<h::Module const*> sorted_modules;
+        std::pmr::vector<std::pmr::vector<std::size_t>> core_module_ranks;
         Declaration_database declaration_database;
     };
 
@@ -82,7 +95,9 @@ namespace h::compiler
     );
 
     void validate_modules_and_exit_if_needed(
+        Builder const& builder,
         std::span<h::Module> const core_modules,
+        std::span<std::pmr::vector<std::size_t> const> const core_module_ranks,
         Declaration_database& declaration_database,
         std::pmr::polymorphic_allocator<> const& temporaries_allocator
     );
@@ -102,21 +117,15 @@ namespace h::compiler
         std::pmr::polymorphic_allocator<> const& temporaries_allocator
     );
 
-    std::pmr::unordered_map<std::pmr::string, std::filesystem::path> create_module_name_to_file_path_map(
-        Builder const& builder,
-        std::span<h::Module const> const header_modules,
-        std::span<h::Module const> const core_modules,
-        std::pmr::polymorphic_allocator<> const& output_allocator,
-        std::pmr::polymorphic_allocator<> const& temporaries_allocator
-    );
-
     void compile_and_write_to_bitcode_files(
         Builder& builder,
         std::span<h::Module const> const core_modules,
-        std::pmr::unordered_map<std::pmr::string, std::filesystem::path> const& module_name_to_file_path_map,
+        std::span<h::Module const* const> const sorted_modules,
+        Module_cache const& module_cache,
         LLVM_data& llvm_data,
         Compilation_database& compilation_database,
-        Compilation_options const& compilation_options
+        Compilation_options const& compilation_options,
+        std::pmr::unordered_map<std::pmr::string, Optimization_level> const& module_optimization_levels
     );
 
     void link_artifacts(
@@ -1,6 +1,7 @@
 import h.common;
 import h.common.filesystem;
 import h.compiler;
+import h.compiler.build_database;
 import h.compiler.builder;
 import h.compiler.compile_commands_generator;
 import h.compiler.target;
@@ -163,6 +164,94 @@ namespace h::compiler
         test_builder("Hello_world", "hlang_artifact.json", target, {}, expected_output_paths);
     }
 
+    TEST_CASE("Build Hello_world twice does not rebuild modules", "[Builder]")
+    {
+        h::compiler::Target const target = h::compiler::get_default_target();
+
+        std::pmr::vector<std::filesystem::path> const expected_output_paths
+        {
+            std::filesystem::path{"bin"} / get_binary_name("Hello_world", target)
+        };
+
+        test_builder("Hello_world", "hlang_artifact.json", target, {}, expected_output_paths);
+
+        std::filesystem::path const build_directory_path = std::filesystem::temp_directory_path() / "Hello_world";
+        std::filesystem::path const artifact_file_path = g_examples_directory / "Hello_world" / "hlang_artifact.json";
+
+        Builder builder = create_builder(
+            target,
+            build_directory_path,
+            h::common::get_default_header_search_directories(),
+            std::pmr::vector<std::filesystem::path>{ g_standard_repository_file_path },
+            {},
+            {},
+            {}
+        );
+        build_artifact(builder, artifact_file_path);
+
+        Build_database const build_database = read_build_database(get_build_database_path(build_directory_path));
+        CHECK(!build_database.entries.empty());
+
+        for (auto const& pair : build_database.entries)
+            CHECK(pair.second.rebuild_reason == "up to date");
+    }
+
+    static std::size_t count_files(
+        std::filesystem::path const& directory_path
+    )
+    {
+        std::size_t count = 0;
+        for (std::filesystem::directory_entry const& entry : std::filesystem::directory_iterator{directory_path})
+        {
+            if (entry.is_regular_file())
+                count += 1;
+        }
+        return count;
+    }
+
+    TEST_CASE("Build Hello_world with the function cache reuses the cached functions", "[Builder]")
+    {
+        h::compiler::Target const target = h::compiler::get_default_target();
+
+        std::filesystem::path const build_directory_path = std::filesystem::temp_directory_path() / "Hello_world_function_cache";
+        std::filesystem::path const artifact_file_path = g_examples_directory / "Hello_world" / "hlang_artifact.json";
+        std::filesystem::path const function_cache_directory_path = build_directory_path / "function_cache";
+
+        std::filesystem::remove_all(build_directory_path);
+
+        Builder_options const builder_options
+        {
+            .use_function_cache = true,
+        };
+
+        auto const build = [&]() -> void
+        {
+            Builder builder = create_builder(
+                target,
+                build_directory_path,
+                h::common::get_default_header_search_directories(),
+                std::pmr::vector<std::filesystem::path>{ g_standard_repository_file_path },
+                {},
+                builder_options,
+                {}
+            );
+            build_artifact(builder, artifact_file_path);
+        };
+
+        build();
+        CHECK(std::filesystem::exists(build_directory_path / "bin" / get_binary_name("Hello_world", target)));
+
+        std::size_t const cached_function_count = count_files(function_cache_directory_path);
+        CHECK(cached_function_count > 0);
+
+        // Forget about the previous build, so that every module is compiled again:
+        std::filesystem::remove(get_build_database_path(build_directory_path));
+
+        build();
+        CHECK(std::filesystem::exists(build_directory_path / "bin" / get_binary_name("Hello_world", target)));
+        CHECK(count_files(function_cache_directory_path) == cached_function_count);
+    }
+
     TEST_CASE("Build Link_with_library", "[Builder]")
     {
         h::compiler::Target const target = h::compiler::get_default_target();
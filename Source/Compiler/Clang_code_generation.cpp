@@ -1,9 +1,11 @@
 module;
 
 #include <clang/AST/ASTContext.h>
+#include <clang/AST/Attr.h>
 #include <clang/AST/Decl.h>
 #include <clang/AST/DeclBase.h>
 #include <clang/AST/DeclCXX.h>
+#include <clang/AST/RecordLayout.h>
 #include <clang/AST/Type.h>
 #include <clang/Basic/Builtins.h>
 #include <clang/Basic/CodeGenOptions.h>
@@ -21,17 +23,20 @@ module;
 #include <clang/lib/CodeGen/CodeGenTypes.h>
 #include <clang/lib/CodeGen/CGRecordLayout.h>
 #include <llvm/ADT/APSInt.h>
+#include <llvm/ADT/StringExtras.h>
 #include <llvm/IR/Function.h>
 #include <llvm/IR/IRBuilder.h>
 #include <clang/Lex/HeaderSearchOptions.h>
 #include <clang/Lex/PreprocessorOptions.h>
 #include <llvm/Support/VirtualFileSystem.h>
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <compare>
 #include <exception>
 #include <iterator>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -213,6 +218,24 @@ namespace h::compiler
         return record_declaration;
     }
 
+    static clang::AlignedAttr* create_clang_aligned_attribute(
+        clang::ASTContext& clang_ast_context,
+        std::uint32_t const alignment
+    )
+    {
+        llvm::APInt const alignment_value{32, alignment};
+        clang::QualType const alignment_type = clang_ast_context.getIntTypeForBitwidth(32, 0);
+
+        clang::IntegerLiteral* const alignment_expression = clang::IntegerLiteral::Create(
+            clang_ast_context,
+            alignment_value,
+            alignment_type,
+            {}
+        );
+
+        return clang::AlignedAttr::CreateImplicit(clang_ast_context, true, alignment_expression);
+    }
+
     void set_clang_struct_definition(
         clang::ASTContext& clang_ast_context,
         clang::RecordDecl& record_declaration,
@@ -270,9 +293,18 @@ namespace h::compiler
                 field->setBitWidth(bit_width_expression);    
             }
 
+            if (member_index < struct_declaration.member_alignments.size() && struct_declaration.member_alignments[member_index].has_value())
+                field->addAttr(create_clang_aligned_attribute(clang_ast_context, struct_declaration.member_alignments[member_index].value()));
+
             record_declaration.addDecl(field);
         }
 
+        if (struct_declaration.is_packed)
+            record_declaration.addAttr(clang::PackedAttr::CreateImplicit(clang_ast_context));
+
+        if (struct_declaration.alignment.has_value())
+            record_declaration.addAttr(create_clang_aligned_attribute(clang_ast_context, struct_declaration.alignment.value()));
+
         record_declaration.completeDefinition();
     }
 
@@ -682,6 +714,26 @@ namespace h::compiler
         return static_cast<llvm::FunctionType*>(llvm_type);
     }
 
+    bool passes_values_through_memory(
+        Clang_module_data& clang_module_data,
+        Declaration_database const& declaration_database,
+        h::Function_type const& function_type
+    )
+    {
+        clang::CodeGen::CGFunctionInfo const& function_info = create_clang_function_info(clang_module_data, function_type, declaration_database);
+
+        if (function_type.output_parameter_types.size() > 0 && function_info.getReturnInfo().isIndirect())
+            return true;
+
+        for (clang::CodeGen::CGFunctionInfoArgInfo const& argument_info : function_info.arguments())
+        {
+            if (argument_info.info.isIndirect())
+                return true;
+        }
+
+        return false;
+    }
+
     std::pmr::vector<llvm::Attribute> create_llvm_function_return_type_argument_attributes(
         llvm::LLVMContext& llvm_context,
         llvm::Type* return_llvm_type,
@@ -712,6 +764,21 @@ namespace h::compiler
         return attributes;
     }
 
+    static bool has_parameter_attribute(
+        h::Function_declaration const& function_declaration,
+        std::string_view const parameter_name,
+        h::Parameter_attribute const attribute
+    )
+    {
+        for (h::Named_parameter_attribute const& parameter_attribute : function_declaration.parameter_attributes)
+        {
+            if (parameter_attribute.parameter_name == parameter_name && parameter_attribute.attribute == attribute)
+                return true;
+        }
+
+        return false;
+    }
+
     void set_llvm_function_argument_names(
         llvm::LLVMContext& llvm_context,
         llvm::DataLayout const& llvm_data_layout,
@@ -790,6 +857,9 @@ namespace h::compiler
                         argument->setName(argument_name.c_str());
                         argument->addAttr(llvm::Attribute::NoUndef);
 
+                        if (new_type->isPointerTy() && has_parameter_attribute(function_declaration, name, h::Parameter_attribute::No_alias))
+                            argument->addAttr(llvm::Attribute::NoAlias);
+
                         if (argument_info.info.isExtend())
                         {
                             if (argument_info.info.isSignExt())
@@ -1429,7 +1499,8 @@ namespace h::compiler
                     new_return_llvm_type,
                     std::nullopt,
                     return_info,
-                    Convertion_type::From_original_to_abi
+                    Convertion_type::From_original_to_abi,
+                    value_to_return.alignment
                 );
                 
                 llvm::Value* const instruction = llvm_builder.CreateRet(converted_value);
@@ -1611,14 +1682,15 @@ namespace h::compiler
         llvm::Type* const destination_llvm_type,
         std::optional<std::string_view> const alloca_name,
         clang::CodeGen::ABIArgInfo const& abi_argument_info,
-        Convertion_type const convertion_type
+        Convertion_type const convertion_type,
+        llvm::MaybeAlign const source_alignment
     )
     {   
         if (source_llvm_type == destination_llvm_type)
         {
             if (source_llvm_value->getType() != source_llvm_type && source_llvm_value->getType()->isPointerTy())
             {
-                llvm::Value* const loaded_value = create_load_instruction(llvm_builder, llvm_data_layout, destination_llvm_type, source_llvm_value);
+                llvm::Value* const loaded_value = create_load_instruction(llvm_builder, llvm_data_layout, destination_llvm_type, source_llvm_value, source_alignment);
                 return loaded_value;
             }
             else
@@ -1635,7 +1707,7 @@ namespace h::compiler
                     {
                         if (!is_taking_address_of_source_llvm_value)
                         {
-                            llvm::Value* const loaded_value = create_load_instruction(llvm_builder, llvm_data_layout, destination_llvm_type, source_llvm_value);
+                            llvm::Value* const loaded_value = create_load_instruction(llvm_builder, llvm_data_layout, destination_llvm_type, source_llvm_value, source_alignment);
                             return loaded_value;
                         }
                     }
@@ -1783,6 +1855,30 @@ namespace h::compiler
         return clang_type;
     }
 
+    std::uint64_t get_record_alignment(
+        Clang_module_data const& clang_module_data,
+        clang::RecordDecl* const record_declaration
+    )
+    {
+        clang::QualType const qual_type = clang_module_data.ast_context.getRecordType(record_declaration);
+        return clang_module_data.ast_context.getTypeAlignInChars(qual_type).getQuantity();
+    }
+
+    std::optional<std::uint64_t> get_struct_alignment(
+        Clang_module_data const& clang_module_data,
+        std::string_view const module_name,
+        std::string_view const struct_name
+    )
+    {
+        Clang_module_declarations const& clang_declarations = clang_module_data.declaration_database.map.find(module_name)->second;
+
+        auto const location = clang_declarations.struct_declarations.find(struct_name);
+        if (location == clang_declarations.struct_declarations.end() || !location->second->isCompleteDefinition())
+            return std::nullopt;
+
+        return get_record_alignment(clang_module_data, location->second);
+    }
+
     llvm::FunctionType* convert_function_type(
         Clang_module_data const& clang_module_data,
         clang::FunctionDecl* const function_declaration
@@ -1946,6 +2042,31 @@ namespace h::compiler
         return output;
     }
 
+    // Alignment of a member with the given offset, computed from the clang record layout so that members of packed structs are not over-aligned.
+    static llvm::Align get_struct_member_alignment(
+        clang::ASTContext const& ast_context,
+        clang::RecordDecl const* const record_declaration,
+        std::uint64_t const member_offset_in_bytes,
+        llvm::MaybeAlign const struct_alignment
+    )
+    {
+        clang::ASTRecordLayout const& record_layout = ast_context.getASTRecordLayout(record_declaration);
+        llvm::Align const record_alignment{static_cast<std::uint64_t>(record_layout.getAlignment().getQuantity())};
+        llvm::Align const base_alignment = struct_alignment.has_value() ? std::min(record_alignment, struct_alignment.value()) : record_alignment;
+        return llvm::commonAlignment(base_alignment, member_offset_in_bytes);
+    }
+
+    static std::uint64_t get_field_offset_in_bytes(
+        clang::ASTContext const& ast_context,
+        clang::RecordDecl const* const record_declaration,
+        clang::FieldDecl const* const field_declaration
+    )
+    {
+        clang::ASTRecordLayout const& record_layout = ast_context.getASTRecordLayout(record_declaration);
+        std::uint64_t const field_offset_in_bits = record_layout.getFieldOffset(field_declaration->getFieldIndex());
+        return static_cast<std::uint64_t>(ast_context.toCharUnitsFromBits(field_offset_in_bits).getQuantity());
+    }
+
     Value_and_type generate_load_struct_member_instructions(
         Clang_module_data const& clang_module_data,
         llvm::LLVMContext& llvm_context,
@@ -1956,7 +2077,8 @@ namespace h::compiler
         std::string_view const module_name,
         Struct_declaration const& struct_declaration,
         std::optional<h::Type_instance> const& type_instance,
-        Type_database const& type_database
+        Type_database const& type_database,
+        llvm::MaybeAlign const struct_alignment
     )
     {
         auto const member_location = std::find(struct_declaration.member_names.begin(), struct_declaration.member_names.end(), access_member_name);
@@ -2011,7 +2133,8 @@ namespace h::compiler
 
             std::uint64_t const storage_size_in_bits = 8*llvm_data_layout.getTypeAllocSize(member_llvm_type);
             llvm::Type* const member_storage_llvm_type = member_llvm_type;
-            llvm::Value* const loaded_value = llvm_builder.CreateLoad(member_storage_llvm_type, get_element_pointer_instruction);
+            llvm::Align const storage_alignment = get_struct_member_alignment(clang_module_data.ast_context, record_declaration, bit_field_info.StorageOffset.getQuantity(), struct_alignment);
+            llvm::Value* const loaded_value = create_load_instruction(llvm_builder, llvm_data_layout, member_storage_llvm_type, get_element_pointer_instruction, storage_alignment);
 
             unsigned const bit_field_offset = bit_field_info.Offset;
             unsigned const bit_field_size = bit_field_info.Size;
@@ -2061,12 +2184,14 @@ namespace h::compiler
             };
 
             llvm::Value* const get_element_pointer_instruction = llvm_builder.CreateGEP(struct_llvm_type, struct_alloca, indices, "", true);
-            
+            std::uint64_t const field_offset_in_bytes = get_field_offset_in_bytes(clang_module_data.ast_context, record_declaration, field_declaration);
+
             return
             {
                 .name = "",
                 .value = get_element_pointer_instruction,
-                .type = member_type
+                .type = member_type,
+                .alignment = get_struct_member_alignment(clang_module_data.ast_context, record_declaration, field_offset_in_bytes, struct_alignment)
             };
         }
     }
@@ -2082,7 +2207,8 @@ namespace h::compiler
         Struct_declaration const& struct_declaration,
         std::optional<h::Type_instance> const& type_instance,
         Value_and_type const& value_to_store,
-        Type_database const& type_database
+        Type_database const& type_database,
+        llvm::MaybeAlign const struct_alignment
     )
     {
         auto const member_location = std::find(struct_declaration.member_names.begin(), struct_declaration.member_names.end(), access_member_name);
@@ -2136,8 +2262,9 @@ namespace h::compiler
             llvm::Value* const get_element_pointer_instruction = llvm_builder.CreateGEP(struct_llvm_type, struct_alloca, indices, "", true);
 
             llvm::Type* const member_storage_llvm_type = member_llvm_type;
+            llvm::Align const storage_alignment = get_struct_member_alignment(clang_module_data.ast_context, record_declaration, bit_field_info.StorageOffset.getQuantity(), struct_alignment);
 
-            llvm::Value* const loaded_value = llvm_builder.CreateLoad(member_storage_llvm_type, get_element_pointer_instruction);
+            llvm::Value* const loaded_value = create_load_instruction(llvm_builder, llvm_data_layout, member_storage_llvm_type, get_element_pointer_instruction, storage_alignment);
 
             unsigned const bit_field_offset = bit_field_info.Offset;
             unsigned const bit_field_size = bit_field_info.Size;
@@ -2157,7 +2284,7 @@ namespace h::compiler
 
             llvm::Value* const new_value_to_store = llvm_builder.CreateOr(reset_loaded_value, masked_value);
             
-            llvm::Value* const store_instruction = create_store_instruction(llvm_builder, llvm_data_layout, new_value_to_store, get_element_pointer_instruction);
+            llvm::Value* const store_instruction = create_store_instruction(llvm_builder, llvm_data_layout, new_value_to_store, get_element_pointer_instruction, storage_alignment);
 
             return
             {
@@ -2175,7 +2302,9 @@ namespace h::compiler
             };
 
             llvm::Value* const get_element_pointer_instruction = llvm_builder.CreateGEP(struct_llvm_type, struct_alloca, indices, "", true);
-            llvm::Value* const store_instruction = create_store_instruction(llvm_builder, llvm_data_layout, value_to_store.value, get_element_pointer_instruction);
+            std::uint64_t const field_offset_in_bytes = get_field_offset_in_bytes(clang_module_data.ast_context, record_declaration, field_declaration);
+            llvm::Align const field_alignment = get_struct_member_alignment(clang_module_data.ast_context, record_declaration, field_offset_in_bytes, struct_alignment);
+            llvm::Value* const store_instruction = create_store_instruction(llvm_builder, llvm_data_layout, value_to_store.value, get_element_pointer_instruction, field_alignment);
             
             return
             {
@@ -2411,6 +2540,25 @@ namespace h::compiler
             
             return std::nullopt;
         }
+        else if (std::holds_alternative<h::Vector_type>(type_reference.data))
+        {
+            h::Vector_type const& vector_type = std::get<h::Vector_type>(type_reference.data);
+
+            if (vector_type.element_type.empty())
+                throw std::runtime_error{"Cannot create vector type if element_type is not specified."};
+
+            std::optional<clang::QualType> const element_type = create_type(
+                clang_ast_context,
+                vector_type.element_type[0],
+                true,
+                declaration_database,
+                clang_declaration_database
+            );
+            if (!element_type.has_value())
+                throw std::runtime_error{"Cannot create vector type. Failed to create element type."};
+
+            return clang_ast_context.getVectorType(*element_type, static_cast<unsigned>(vector_type.size), clang::VectorKind::Generic);
+        }
 
         return std::nullopt;
     }
@@ -2433,7 +2581,10 @@ namespace h::compiler
     Clang_data create_clang_data(
         llvm::LLVMContext& llvm_context,
         llvm::Triple const& llvm_triple,
-        unsigned int const optimization_level
+        std::string_view const cpu,
+        std::string_view const features,
+        unsigned int const optimization_level,
+        unsigned int const size_level
     )
     {
         std::unique_ptr<clang::CompilerInstance> compiler_instance = std::make_unique<clang::CompilerInstance>();
@@ -2445,6 +2596,12 @@ namespace h::compiler
 
         std::shared_ptr<clang::TargetOptions> target_options = std::make_shared<clang::TargetOptions>();
         target_options->Triple = llvm_triple.str();
+        target_options->CPU = std::string{cpu};
+        for (llvm::StringRef const feature : llvm::split(llvm::StringRef{features}, ','))
+        {
+            if (!feature.empty())
+                target_options->FeaturesAsWritten.push_back(feature.str());
+        }
         clang::TargetInfo* target_info = clang::TargetInfo::CreateTargetInfo(compiler_instance->getDiagnostics(), target_options);
         compiler_instance->setTarget(target_info);
 
@@ -2455,6 +2612,9 @@ namespace h::compiler
         std::vector<std::string> language_option_includes;
         clang::LangOptions::setLangDefaults(language_options, clang::Language::C, llvm_triple, language_option_includes, clang::LangStandard::Kind::lang_c17);
 
+        compiler_instance->getCodeGenOpts().OptimizationLevel = optimization_level;
+        compiler_instance->getCodeGenOpts().OptimizeSize = size_level;
+
         compiler_instance->createPreprocessor(clang::TU_Complete);
         compiler_instance->getPreprocessorOpts().UsePredefines = false;
 
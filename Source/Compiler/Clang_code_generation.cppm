@@ -23,6 +23,7 @@ module;
 
 #include <memory>
 #include <memory_resource>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -52,6 +53,13 @@ namespace h::compiler
         h::Function_type const& function_type
     );
 
+    // True if the platform ABI returns the value or passes an argument through a pointer to memory:
+    export bool passes_values_through_memory(
+        Clang_module_data& clang_module_data,
+        Declaration_database const& declaration_database,
+        h::Function_type const& function_type
+    );
+
     export void set_llvm_function_argument_names(
         llvm::LLVMContext& llvm_context,
         llvm::DataLayout const& llvm_data_layout,
@@ -159,6 +167,17 @@ namespace h::compiler
         clang::RecordDecl* const record_declaration
     );
 
+    export std::uint64_t get_record_alignment(
+        Clang_module_data const& clang_module_data,
+        clang::RecordDecl* const record_declaration
+    );
+
+    export std::optional<std::uint64_t> get_struct_alignment(
+        Clang_module_data const& clang_module_data,
+        std::string_view const module_name,
+        std::string_view const struct_name
+    );
+
     export llvm::FunctionType* convert_function_type(
         Clang_module_data const& clang_module_data,
         clang::FunctionDecl* const function_declaration
@@ -199,7 +218,8 @@ namespace h::compiler
         std::string_view const module_name,
         Struct_declaration const& struct_declaration,
         std::optional<h::Type_instance> const& type_instance,
-        Type_database const& type_database
+        Type_database const& type_database,
+        llvm::MaybeAlign const struct_alignment = {}
     );
 
     export Value_and_type generate_store_struct_member_instructions(
@@ -213,7 +233,8 @@ namespace h::compiler
         Struct_declaration const& struct_declaration,
         std::optional<h::Type_instance> const& type_instance,
         Value_and_type const& value_to_store,
-        Type_database const& type_database
+        Type_database const& type_database,
+        llvm::MaybeAlign const struct_alignment = {}
     );
 
     std::optional<clang::QualType> create_type(
@@ -249,13 +270,17 @@ namespace h::compiler
         llvm::Type* const destination_llvm_type,
         std::optional<std::string_view> const alloca_name,
         clang::CodeGen::ABIArgInfo const& abi_argument_info,
-        Convertion_type const convertion_type
+        Convertion_type const convertion_type,
+        llvm::MaybeAlign const source_alignment = {}
     );
 
     export Clang_data create_clang_data(
         llvm::LLVMContext& llvm_context,
         llvm::Triple const& llvm_triple,
-        unsigned int const optimization_level
+        std::string_view const cpu,
+        std::string_view const features,
+        unsigned int const optimization_level,
+        unsigned int const size_level
     );
 
     export Clang_declaration_database create_clang_declaration_database(
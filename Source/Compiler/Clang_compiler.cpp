@@ -10,16 +10,22 @@ module;
 #include <clang/Frontend/TextDiagnosticPrinter.h>
 #include <clang/Lex/PreprocessorOptions.h>
 #include <llvm/Support/VirtualFileSystem.h>
+#include <llvm/TargetParser/Triple.h>
 
 #include <cstdio>
 #include <filesystem>
+#include <format>
+#include <optional>
+#include <ranges>
 #include <span>
 #include <string>
+#include <string_view>
 
 module h.compiler.clang_compiler;
 
 import h.common;
 import h.common.filesystem;
+import h.compiler.target;
 
 namespace h::compiler
 {
@@ -33,6 +39,31 @@ namespace h::compiler
         return absolute_path;
     }
 
+    std::optional<std::filesystem::path> find_clang_profile_runtime(
+        std::string_view const target_triple,
+        bool const use_clang_cl
+    )
+    {
+        std::filesystem::path const clang_path = find_clang(use_clang_cl);
+        std::filesystem::path const resource_directory = clang::driver::Driver::GetResourcesPath(clang_path.generic_string());
+        std::string const architecture = llvm::Triple{target_triple}.getArchName().str();
+
+        // Newer installations have one directory per target, older ones one per operating system:
+        std::filesystem::path const candidates[] =
+        {
+            resource_directory / "lib" / target_triple / (use_clang_cl ? "clang_rt.profile.lib" : "libclang_rt.profile.a"),
+            resource_directory / "lib" / (use_clang_cl ? "windows" : "linux") / (use_clang_cl ? std::format("clang_rt.profile-{}.lib", architecture) : std::format("libclang_rt.profile-{}.a", architecture)),
+        };
+
+        for (std::filesystem::path const& candidate : candidates)
+        {
+            if (std::filesystem::exists(candidate))
+                return candidate;
+        }
+
+        return std::nullopt;
+    }
+
     static void add_argument(std::pmr::vector<std::pmr::string>& arguments, std::string_view const& value, bool const use_clang_cl)
     {
         if (use_clang_cl)
@@ -93,6 +124,11 @@ namespace h::compiler
         std::filesystem::path const& build_artifacts_directory,
         std::span<std::pmr::string const> const include_directories,
         std::span<std::pmr::string const> const additional_flags,
+        std::string_view const target_cpu,
+        std::string_view const target_features,
+        Optimization_level const optimization_level,
+        Lto_mode const lto_mode,
+        Pgo_options const& pgo_options,
         bool const use_clang_cl,
         bool const debug,
         std::pmr::polymorphic_allocator<> const& output_allocator
@@ -121,8 +157,42 @@ namespace h::compiler
         for (std::pmr::string const& additional_flag : additional_flags)
             add_argument(arguments, additional_flag, use_clang_cl);
 
+        // Pass the CPU and features straight to the frontend, so that C++ sources are compiled for exactly
+        // the same target as the hlang modules they are linked with:
+        if (!target_cpu.empty() && target_cpu != "generic")
+        {
+            add_argument(arguments, "-Xclang", use_clang_cl);
+            add_argument(arguments, "-target-cpu", use_clang_cl);
+            add_argument(arguments, "-Xclang", use_clang_cl);
+            add_argument(arguments, target_cpu, use_clang_cl);
+        }
+
+        for (std::string_view const feature : std::views::split(target_features, ',') | std::views::transform([](auto const range) { return std::string_view{range.begin(), range.end()}; }))
+        {
+            if (feature.empty())
+                continue;
+
+            add_argument(arguments, "-Xclang", use_clang_cl);
+            add_argument(arguments, "-target-feature", use_clang_cl);
+            add_argument(arguments, "-Xclang", use_clang_cl);
+            add_argument(arguments, feature, use_clang_cl);
+        }
+
         add_output_argument(arguments, output_file_path_string, use_clang_cl);
 
+        add_argument(arguments, std::format("-{}", to_string(optimization_level)), use_clang_cl);
+
+        if (lto_mode == Lto_mode::Thin)
+            add_argument(arguments, "-flto=thin", use_clang_cl);
+
+        if (pgo_options.profile_path.has_value())
+        {
+            if (pgo_options.mode == Pgo_mode::Instrument)
+                add_argument(arguments, std::format("-fprofile-generate={}", pgo_options.profile_path->generic_string()), use_clang_cl);
+            else if (pgo_options.mode == Pgo_mode::Use)
+                add_argument(arguments, std::format("-fprofile-use={}", pgo_options.profile_path->generic_string()), use_clang_cl);
+        }
+
         if (debug)
             add_argument(arguments, "-g", use_clang_cl);
 
@@ -170,6 +240,11 @@ namespace h::compiler
         std::filesystem::path const& build_artifacts_directory,
         std::span<std::pmr::string const> const include_directories,
         std::span<std::pmr::string const> const additional_flags,
+        std::string_view const target_cpu,
+        std::string_view const target_features,
+        Optimization_level const optimization_level,
+        Lto_mode const lto_mode,
+        Pgo_options const& pgo_options,
         bool const use_clang_cl,
         bool const debug,
         std::pmr::polymorphic_allocator<> const& temporaries_allocator
@@ -190,6 +265,11 @@ namespace h::compiler
             build_artifacts_directory,
             include_directories,
             additional_flags,
+            target_cpu,
+            target_features,
+            optimization_level,
+            lto_mode,
+            pgo_options,
             use_clang_cl,
             debug,
             temporaries_allocator
@@ -7,14 +7,23 @@ module;
 #include <optional>
 #include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 export module h.compiler.clang_compiler;
 
+import h.compiler.target;
+
 namespace h::compiler
 {
     export std::filesystem::path find_clang(bool const use_clang_cl);
 
+    // Instrumented programs link with this library to write their profiles when they exit.
+    export std::optional<std::filesystem::path> find_clang_profile_runtime(
+        std::string_view const target_triple,
+        bool const use_clang_cl
+    );
+
     export bool compile_cpp(
         clang::CompilerInstance& clang_compiler_instance,
         std::string_view const target_triple,
@@ -24,6 +33,11 @@ namespace h::compiler
         std::filesystem::path const& build_artifacts_directory,
         std::span<std::pmr::string const> const include_directories,
         std::span<std::pmr::string const> const additional_flags,
+        std::string_view const target_cpu,
+        std::string_view const target_features,
+        Optimization_level const optimization_level,
+        Lto_mode const lto_mode,
+        Pgo_options const& pgo_options,
         bool const use_clang_cl,
         bool const debug,
         std::pmr::polymorphic_allocator<> const& temporaries_allocator
@@ -37,6 +51,11 @@ namespace h::compiler
         std::filesystem::path const& build_artifacts_directory,
         std::span<std::pmr::string const> const include_directories,
         std::span<std::pmr::string const> const additional_flags,
+        std::string_view const target_cpu,
+        std::string_view const target_features,
+        Optimization_level const optimization_level,
+        Lto_mode const lto_mode,
+        Pgo_options const& pgo_options,
         bool const use_clang_cl,
         bool const debug,
         std::pmr::polymorphic_allocator<> const& output_allocator
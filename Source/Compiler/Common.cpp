@@ -117,7 +117,7 @@ namespace h::compiler
     h::Module const* get_module(
         std::string_view const module_name,
         h::Module const& core_module,
-        std::pmr::unordered_map<std::pmr::string, h::Module> const& core_module_dependencies
+        std::pmr::unordered_map<std::pmr::string, h::Module const*> const& core_module_dependencies
     )
     {
         if (core_module.name == module_name)
@@ -126,8 +126,26 @@ namespace h::compiler
         // TODO this allocates memory unnecessarily
         auto const location = core_module_dependencies.find(std::pmr::string{module_name});
         if (location != core_module_dependencies.end())
-            return &location->second;
+            return location->second;
 
         return nullptr;
     }
+
+    h::Module copy_module_declarations(
+        h::Module const& core_module
+    )
+    {
+        return h::Module
+        {
+            .language_version = core_module.language_version,
+            .name = core_module.name,
+            .content_hash = core_module.content_hash,
+            .dependencies = core_module.dependencies,
+            .export_declarations = core_module.export_declarations,
+            .internal_declarations = core_module.internal_declarations,
+            .definitions = {},
+            .comment = core_module.comment,
+            .source_file_path = core_module.source_file_path,
+        };
+    }
 }
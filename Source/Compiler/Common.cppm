@@ -61,6 +61,10 @@ namespace h::compiler
     export h::Module const* get_module(
         std::string_view const module_name,
         h::Module const& core_module,
-        std::pmr::unordered_map<std::pmr::string, h::Module> const& core_module_dependencies
+        std::pmr::unordered_map<std::pmr::string, h::Module const*> const& core_module_dependencies
+    );
+
+    export h::Module copy_module_declarations(
+        h::Module const& core_module
     );
 }
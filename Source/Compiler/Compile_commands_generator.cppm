@@ -14,6 +14,7 @@ export module h.compiler.compile_commands_generator;
 import h.common;
 import h.compiler.artifact;
 import h.compiler.clang_compiler;
+import h.compiler.target;
 
 namespace h::compiler
 {
@@ -71,6 +72,11 @@ namespace h::compiler
                         build_directory_path,
                         public_include_directories_strings,
                         group.additional_flags,
+                        {},
+                        {},
+                        artifact.optimization_level.value_or(Optimization_level::O0),
+                        Lto_mode::None,
+                        {},
                         use_clang_cl,
                         false,
                         temporaries_allocator
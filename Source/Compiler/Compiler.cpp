@@ -1,9 +1,15 @@
 module;
 
 #include <clang/AST/Decl.h>
+#include <clang/Basic/CodeGenOptions.h>
+#include <clang/Frontend/CompilerInstance.h>
+#include <llvm/ADT/StringMap.h>
 #include <llvm/Analysis/ConstantFolding.h>
+#include <llvm/Analysis/ModuleSummaryAnalysis.h>
 #include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/IR/DIBuilder.h>
+#include <llvm/IR/DiagnosticHandler.h>
+#include <llvm/IR/DiagnosticInfo.h>
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/LLVMContext.h>
@@ -14,7 +20,9 @@ module;
 #include <llvm/Passes/PassBuilder.h>
 #include <llvm/Passes/StandardInstrumentations.h>
 #include <llvm/Support/FileSystem.h>
+#include <llvm/Support/PGOOptions.h>
 #include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/VirtualFileSystem.h>
 #include <llvm/Support/raw_ostream.h>
 #include <llvm/Target/TargetMachine.h>
 #include <llvm/Target/TargetOptions.h>
@@ -26,6 +34,7 @@ module;
 #include <llvm/Transforms/Scalar/Reassociate.h>
 #include <llvm/Transforms/Scalar/SimplifyCFG.h>
 
+#include <algorithm>
 #include <bit>
 #include <cassert>
 #include <cstdlib>
@@ -57,6 +66,7 @@ import h.compiler.debug_info;
 import h.compiler.diagnostic;
 import h.compiler.expressions;
 import h.compiler.instructions;
+import h.compiler.target;
 import h.compiler.types;
 import h.parser.convertor;
 import h.parser.parse_tree;
@@ -156,6 +166,48 @@ namespace h::compiler
         );
     }
 
+    static void set_function_attributes(
+        llvm::Function& llvm_function,
+        Function_declaration const& function_declaration,
+        bool const passes_values_through_memory
+    )
+    {
+        // The callee writes an indirect return value and reads indirect arguments through pointer arguments:
+        llvm::MemoryEffects const argument_memory_effects = passes_values_through_memory ? llvm::MemoryEffects::argMemOnly() : llvm::MemoryEffects::none();
+
+        for (Function_attribute const attribute : function_declaration.attributes)
+        {
+            switch (attribute)
+            {
+            case Function_attribute::Always_inline:
+                llvm_function.addFnAttr(llvm::Attribute::AlwaysInline);
+                break;
+            case Function_attribute::Cold:
+                llvm_function.addFnAttr(llvm::Attribute::Cold);
+                break;
+            case Function_attribute::Const:
+                llvm_function.setMemoryEffects(argument_memory_effects);
+                llvm_function.setDoesNotThrow();
+                llvm_function.setWillReturn();
+                break;
+            case Function_attribute::Hot:
+                llvm_function.addFnAttr(llvm::Attribute::Hot);
+                break;
+            case Function_attribute::No_inline:
+                llvm_function.addFnAttr(llvm::Attribute::NoInline);
+                break;
+            case Function_attribute::Pure:
+                llvm_function.setMemoryEffects(llvm::MemoryEffects::readOnly() | argument_memory_effects);
+                llvm_function.setDoesNotThrow();
+                llvm_function.setWillReturn();
+                break;
+            case Function_attribute::Must_tail:
+                // Applied to the calls of the function's return statements.
+                break;
+            }
+        }
+    }
+
     llvm::Function& to_function(
         llvm::LLVMContext& llvm_context,
         llvm::DataLayout const& llvm_data_layout,
@@ -196,6 +248,13 @@ namespace h::compiler
         llvm_function->setCallingConv(llvm::CallingConv::C);
 
         set_function_definition_attributes(llvm_context, clang_module_data, *llvm_function);
+        bool const is_memory_attribute_needed = std::any_of(
+            function_declaration.attributes.begin(),
+            function_declaration.attributes.end(),
+            [](Function_attribute const attribute) -> bool { return attribute == Function_attribute::Const || attribute == Function_attribute::Pure; }
+        );
+        bool const passes_memory = is_memory_attribute_needed && passes_values_through_memory(clang_module_data, declaration_database, function_declaration.type);
+        set_function_attributes(*llvm_function, function_declaration, passes_memory);
 
         return *llvm_function;
     }
@@ -351,9 +410,10 @@ namespace h::compiler
         llvm::LLVMContext& llvm_context,
         llvm::DataLayout const& llvm_data_layout,
         llvm::Module& llvm_module,
+        Read_only_globals& read_only_globals,
         Clang_module_data& clang_module_data,
         Module const& core_module,
-        std::pmr::unordered_map<std::pmr::string, Module> const& core_module_dependencies,
+        std::pmr::unordered_map<std::pmr::string, Module const*> const& core_module_dependencies,
         Declaration_database& declaration_database,
         Type_database& type_database,
         std::pmr::polymorphic_allocator<> const& temporaries_allocator
@@ -376,6 +436,7 @@ namespace h::compiler
             .declaration_database = declaration_database,
             .type_database = type_database,
             .enum_value_constants = enum_value_constants,
+            .read_only_globals = read_only_globals,
             .blocks = {},
             .defer_expressions_per_block = {},
             .function_declaration = {},
@@ -388,10 +449,10 @@ namespace h::compiler
             .temporaries_allocator = temporaries_allocator,
         };
 
-        for (std::pair<std::pmr::string const, Module> const& module : core_module_dependencies)
+        for (std::pair<std::pmr::string const, Module const*> const& module : core_module_dependencies)
         {
-            add_enum_constants(enum_value_constants, module.second.name, module.second.export_declarations.enum_declarations, expression_parameters);
-            add_enum_constants(enum_value_constants, module.second.name, module.second.internal_declarations.enum_declarations, expression_parameters);
+            add_enum_constants(enum_value_constants, module.second->name, module.second->export_declarations.enum_declarations, expression_parameters);
+            add_enum_constants(enum_value_constants, module.second->name, module.second->internal_declarations.enum_declarations, expression_parameters);
         }
 
         add_enum_constants(enum_value_constants, core_module.name, core_module.export_declarations.enum_declarations, expression_parameters);
@@ -404,12 +465,13 @@ namespace h::compiler
         llvm::LLVMContext& llvm_context,
         llvm::DataLayout const& llvm_data_layout,
         llvm::Module& llvm_module,
+        Read_only_globals& read_only_globals,
         llvm::Function& llvm_function,
         Clang_module_data& clang_module_data,
         Module const& core_module,
         Function_declaration const& function_declaration,
         Function_definition const& function_definition,
-        std::pmr::unordered_map<std::pmr::string, Module> const& core_module_dependencies,
+        std::pmr::unordered_map<std::pmr::string, Module const*> const& core_module_dependencies,
         Declaration_database& declaration_database,
         Type_database& type_database,
         Enum_value_constants const& enum_value_constants,
@@ -504,6 +566,7 @@ namespace h::compiler
                 .declaration_database = declaration_database,
                 .type_database = type_database,
                 .enum_value_constants = enum_value_constants,
+                .read_only_globals = read_only_globals,
                 .blocks = block_infos,
                 .defer_expressions_per_block = defer_expressions_per_block,
                 .function_declaration = &function_declaration,
@@ -594,9 +657,10 @@ namespace h::compiler
         llvm::LLVMContext& llvm_context,
         llvm::DataLayout const& llvm_data_layout,
         llvm::Module& llvm_module,
+        Read_only_globals& read_only_globals,
         Clang_module_data& clang_module_data,
         Module const& core_module,
-        std::pmr::unordered_map<std::pmr::string, Module> const& core_module_dependencies,
+        std::pmr::unordered_map<std::pmr::string, Module const*> const& core_module_dependencies,
         std::optional<std::span<std::string_view const>> const functions_to_compile,
         Declaration_database& declaration_database,
         Type_database& type_database,
@@ -635,6 +699,7 @@ namespace h::compiler
                 llvm_context,
                 llvm_data_layout,
                 llvm_module,
+                read_only_globals,
                 *llvm_function,
                 clang_module_data,
                 core_module,
@@ -683,6 +748,7 @@ namespace h::compiler
                 llvm_context,
                 llvm_data_layout,
                 llvm_module,
+                read_only_globals,
                 *llvm_function,
                 clang_module_data,
                 *instance_module,
@@ -780,7 +846,7 @@ namespace h::compiler
             if (!std::filesystem::exists(file_path))
                 throw std::runtime_error{ std::format("Module '{}' file '{}' does not exist!", alias_import.module_name, file_path.generic_string()) };
 
-            std::optional<Module> import_core_module = read_core_module(file_path);
+            std::optional<Module> import_core_module = read_core_module_declarations(file_path);
             if (!import_core_module.has_value())
                 throw std::runtime_error{ std::format("Failed to read Module '{}' from binary file '{}' .", alias_import.module_name, file_path.generic_string()) };
 
@@ -829,8 +895,12 @@ namespace h::compiler
 
         if (core_module.name != "H.Builtin")
         {
-            std::filesystem::path const builtin_file_path = BUILTIN_SOURCE_FILE_PATH;
-            std::optional<h::Module> builtin_module = parse_and_convert(builtin_file_path);
+            // Prefer the cached binary builtin module over parsing its source again:
+            auto const builtin_location = module_name_to_file_path_map.find(std::pmr::string{"H.Builtin"});
+            std::optional<h::Module> builtin_module =
+                (builtin_location != module_name_to_file_path_map.end() && std::filesystem::exists(builtin_location->second)) ?
+                read_core_module_declarations(builtin_location->second) :
+                parse_and_convert(BUILTIN_SOURCE_FILE_PATH);
             if (!builtin_module.has_value())
                 throw std::runtime_error{"Failed to read builtin module!"};
             core_module_dependencies.insert(std::make_pair(builtin_module->name, std::move(builtin_module.value())));
@@ -845,9 +915,10 @@ namespace h::compiler
         llvm::LLVMContext& llvm_context,
         llvm::DataLayout const& llvm_data_layout,
         llvm::Module& llvm_module,
+        Read_only_globals& read_only_globals,
         Clang_module_data& clang_module_data,
         Module const& core_module,
-        std::pmr::unordered_map<std::pmr::string, Module> const& core_module_dependencies,
+        std::pmr::unordered_map<std::pmr::string, Module const*> const& core_module_dependencies,
         std::span<Function_declaration const> const function_declarations,
         std::optional<std::span<std::pmr::string const> const> const functions_to_add,
         std::span<Global_variable_declaration const> const global_variable_declarations,
@@ -917,6 +988,7 @@ namespace h::compiler
                     .declaration_database = declaration_database,
                     .type_database = type_database,
                     .enum_value_constants = {},
+                    .read_only_globals = read_only_globals,
                     .blocks = {},
                     .defer_expressions_per_block = {},
                     .function_declaration = {},
@@ -947,7 +1019,7 @@ namespace h::compiler
                     type_database
                 );
 
-                new llvm::GlobalVariable(
+                llvm::GlobalVariable* const global_variable = new llvm::GlobalVariable(
                     llvm_module,
                     llvm_type,
                     false,
@@ -955,6 +1027,9 @@ namespace h::compiler
                     initial_value,
                     mangled_name
                 );
+
+                if (type_database.llvm_type_alignments.contains(llvm_type))
+                    global_variable->setAlignment(get_type_alignment(llvm_data_layout, type_database, llvm_type));
             }
         }
     }
@@ -1009,17 +1084,18 @@ namespace h::compiler
         llvm::LLVMContext& llvm_context,
         llvm::DataLayout const& llvm_data_layout,
         llvm::Module& llvm_module,
+        Read_only_globals& read_only_globals,
         Clang_module_data& clang_module_data,
         Type_database& type_database,
         Declaration_database& declaration_database,
         Module const& core_module,
-        std::pmr::unordered_map<std::pmr::string, Module> const& core_module_dependencies,
+        std::pmr::unordered_map<std::pmr::string, Module const*> const& core_module_dependencies,
         std::pmr::polymorphic_allocator<> const& temporaries_allocator
     )
     {
-        for (std::pair<std::pmr::string const, Module> const& pair : core_module_dependencies)
+        for (std::pair<std::pmr::string const, Module const*> const& pair : core_module_dependencies)
         {
-            Module const& core_module_dependency = pair.second;
+            Module const& core_module_dependency = *pair.second;
 
             auto const alias_import_location = std::find_if(
                 core_module.dependencies.alias_imports.begin(),
@@ -1033,6 +1109,7 @@ namespace h::compiler
                     llvm_context,
                     llvm_data_layout,
                     llvm_module,
+                    read_only_globals,
                     clang_module_data,
                     core_module_dependency,
                     core_module_dependencies,
@@ -1052,7 +1129,7 @@ namespace h::compiler
         llvm::Module& llvm_module,
         Clang_module_data const& clang_module_data,
         Module const& core_module,
-        std::pmr::unordered_map<std::pmr::string, Module> const& core_module_dependencies,
+        std::pmr::unordered_map<std::pmr::string, Module const*> const& core_module_dependencies,
         Type_database& type_database,
         Enum_value_constants const& enum_value_constants,
         Compilation_options const& compilation_options
@@ -1087,7 +1164,7 @@ namespace h::compiler
             llvm::dwarf::DW_LANG_C,
             llvm_debug_file,
             "Hlang Compiler",
-            compilation_options.is_optimized,
+            compilation_options.optimization_level != Optimization_level::O0,
             "",
             0
         );
@@ -1154,7 +1231,7 @@ namespace h::compiler
         llvm::DataLayout const& llvm_data_layout,
         Clang_module_data& clang_module_data,
         Module const& core_module,
-        std::pmr::unordered_map<std::pmr::string, Module> const& core_module_dependencies,
+        std::pmr::unordered_map<std::pmr::string, Module const*> const& core_module_dependencies,
         std::optional<std::span<std::string_view const>> const functions_to_compile,
         Declaration_database& declaration_database,
         Type_database& type_database,
@@ -1165,16 +1242,19 @@ namespace h::compiler
         llvm_module->setTargetTriple(target_triple);
         llvm_module->setDataLayout(llvm_data_layout);
 
-        add_module_declarations(llvm_context, llvm_data_layout, *llvm_module, clang_module_data, core_module, core_module_dependencies, core_module.export_declarations.function_declarations, std::nullopt, core_module.export_declarations.global_variable_declarations, type_database, declaration_database, {});
-        add_module_declarations(llvm_context, llvm_data_layout, *llvm_module, clang_module_data, core_module, core_module_dependencies, core_module.internal_declarations.function_declarations, std::nullopt, core_module.internal_declarations.global_variable_declarations, type_database, declaration_database, {});
+        Read_only_globals read_only_globals;
+
+        add_module_declarations(llvm_context, llvm_data_layout, *llvm_module, read_only_globals, clang_module_data, core_module, core_module_dependencies, core_module.export_declarations.function_declarations, std::nullopt, core_module.export_declarations.global_variable_declarations, type_database, declaration_database, {});
+        add_module_declarations(llvm_context, llvm_data_layout, *llvm_module, read_only_globals, clang_module_data, core_module, core_module_dependencies, core_module.internal_declarations.function_declarations, std::nullopt, core_module.internal_declarations.global_variable_declarations, type_database, declaration_database, {});
         add_instance_call_declarations(llvm_context, llvm_data_layout, *llvm_module, clang_module_data, type_database, declaration_database, {});
 
-        add_dependency_module_declarations(llvm_context, llvm_data_layout, *llvm_module, clang_module_data, type_database, declaration_database, core_module, core_module_dependencies, {});
+        add_dependency_module_declarations(llvm_context, llvm_data_layout, *llvm_module, read_only_globals, clang_module_data, type_database, declaration_database, core_module, core_module_dependencies, {});
 
         Enum_value_constants const enum_value_constants = create_enum_value_constants_map(
             llvm_context,
             llvm_data_layout,
             *llvm_module,
+            read_only_globals,
             clang_module_data,
             core_module,
             core_module_dependencies,
@@ -1198,6 +1278,7 @@ namespace h::compiler
             llvm_context,
             llvm_data_layout,
             *llvm_module,
+            read_only_globals,
             clang_module_data,
             core_module,
             core_module_dependencies,
@@ -1239,10 +1320,197 @@ namespace h::compiler
         std::filesystem::path const& path
     )
     {
-        // TODO read only declarations
-        return read_core_module(path);
+        return h::binary_serializer::read_module_declarations_from_file(path);
+    }
+
+    static std::pmr::string get_host_cpu_features()
+    {
+        llvm::StringMap<bool> host_features;
+        if (!llvm::sys::getHostCPUFeatures(host_features))
+            return {};
+
+        std::pmr::vector<std::pmr::string> features;
+        features.reserve(host_features.size());
+
+        for (llvm::StringMapEntry<bool> const& feature : host_features)
+            features.push_back(std::pmr::string{feature.getValue() ? "+" : "-"} + std::pmr::string{feature.getKey()});
+
+        // StringMap iteration order is unspecified, so sort to get a stable string for cache keys:
+        std::sort(features.begin(), features.end());
+
+        std::pmr::string output;
+        for (std::pmr::string const& feature : features)
+        {
+            if (!output.empty())
+                output += ',';
+            output += feature;
+        }
+
+        return output;
+    }
+
+    Target_cpu get_target_cpu(
+        Compilation_options const& compilation_options
+    )
+    {
+        std::pmr::string const explicit_features = compilation_options.target_features.value_or("");
+
+        if (!compilation_options.cpu.has_value())
+            return Target_cpu{ .name = "generic", .features = explicit_features };
+
+        if (compilation_options.cpu.value() != "native")
+            return Target_cpu{ .name = compilation_options.cpu.value(), .features = explicit_features };
+
+        // Explicit features come last so that they override the host ones:
+        std::pmr::string features = get_host_cpu_features();
+        if (!explicit_features.empty())
+        {
+            if (!features.empty())
+                features += ',';
+            features += explicit_features;
+        }
+
+        return Target_cpu
+        {
+            .name = std::pmr::string{llvm::sys::getHostCPUName()},
+            .features = std::move(features),
+        };
+    }
+
+    static llvm::OptimizationLevel to_llvm_optimization_level(
+        Optimization_level const optimization_level
+    )
+    {
+        switch (optimization_level)
+        {
+        case Optimization_level::O0:
+            return llvm::OptimizationLevel::O0;
+        case Optimization_level::O1:
+            return llvm::OptimizationLevel::O1;
+        case Optimization_level::O2:
+            return llvm::OptimizationLevel::O2;
+        case Optimization_level::O3:
+            return llvm::OptimizationLevel::O3;
+        case Optimization_level::Os:
+            return llvm::OptimizationLevel::Os;
+        case Optimization_level::Oz:
+        default:
+            return llvm::OptimizationLevel::Oz;
+        }
+    }
+
+    // Size levels only affect the IR pipeline, code generation treats them like O2:
+    llvm::CodeGenOptLevel to_llvm_code_generation_optimization_level(
+        Optimization_level const optimization_level
+    )
+    {
+        switch (optimization_level)
+        {
+        case Optimization_level::O0:
+            return llvm::CodeGenOptLevel::None;
+        case Optimization_level::O1:
+            return llvm::CodeGenOptLevel::Less;
+        case Optimization_level::O3:
+            return llvm::CodeGenOptLevel::Aggressive;
+        case Optimization_level::O2:
+        case Optimization_level::Os:
+        case Optimization_level::Oz:
+        default:
+            return llvm::CodeGenOptLevel::Default;
+        }
     }
 
+    static unsigned int get_clang_optimization_level(
+        Optimization_level const optimization_level
+    )
+    {
+        switch (optimization_level)
+        {
+        case Optimization_level::O0:
+            return 0;
+        case Optimization_level::O1:
+            return 1;
+        case Optimization_level::O3:
+            return 3;
+        case Optimization_level::O2:
+        case Optimization_level::Os:
+        case Optimization_level::Oz:
+        default:
+            return 2;
+        }
+    }
+
+    static unsigned int get_clang_size_level(
+        Optimization_level const optimization_level
+    )
+    {
+        if (optimization_level == Optimization_level::Os)
+            return 1;
+        else if (optimization_level == Optimization_level::Oz)
+            return 2;
+
+        return 0;
+    }
+
+    // Clang code generation reads these options while lowering, so they follow the level of the module being created:
+    static void set_clang_code_generation_optimization_level(
+        Clang_data const& clang_data,
+        Optimization_level const optimization_level
+    )
+    {
+        clang::CodeGenOptions& code_generation_options = clang_data.compiler_instance->getCodeGenOpts();
+        code_generation_options.OptimizationLevel = get_clang_optimization_level(optimization_level);
+        code_generation_options.OptimizeSize = get_clang_size_level(optimization_level);
+    }
+
+    static std::optional<llvm::PGOOptions> create_pgo_options(
+        Pgo_options const& pgo_options
+    )
+    {
+        if (pgo_options.mode == Pgo_mode::None || !pgo_options.profile_path.has_value())
+            return std::nullopt;
+
+        llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> file_system = llvm::vfs::getRealFileSystem();
+
+        if (pgo_options.mode == Pgo_mode::Instrument)
+        {
+            // %m is replaced by a signature of the binary, so that programs sharing the directory do not overwrite each other:
+            std::string const profile_file_path = (pgo_options.profile_path.value() / "default_%m.profraw").generic_string();
+            return llvm::PGOOptions{profile_file_path, "", "", "", std::move(file_system), llvm::PGOOptions::IRInstr};
+        }
+
+        return llvm::PGOOptions{pgo_options.profile_path->generic_string(), "", "", "", std::move(file_system), llvm::PGOOptions::IRUse};
+    }
+
+    // Profile warnings are emitted once per function whose control flow changed since the profile was collected.
+    // They are counted instead, and reported once per module.
+    // LLVM gives stale profiles no diagnostic kind of their own. With its default options, the only profile warnings
+    // are hash and counter mismatches, because warnings about functions without profile data are disabled.
+    // Profile errors, such as an unreadable profile, are left to the default handler.
+    class Profile_diagnostic_handler final : public llvm::DiagnosticHandler
+    {
+    public:
+
+        explicit Profile_diagnostic_handler(
+            Profile_diagnostics& profile_diagnostics
+        ) :
+            m_profile_diagnostics{&profile_diagnostics}
+        {
+        }
+
+        bool handleDiagnostics(llvm::DiagnosticInfo const& diagnostic) override
+        {
+            if (diagnostic.getKind() != llvm::DK_PGOProfile || diagnostic.getSeverity() != llvm::DS_Warning)
+                return false;
+
+            m_profile_diagnostics->mismatched_function_count += 1;
+            return true;
+        }
+
+    private:
+        Profile_diagnostics* m_profile_diagnostics = nullptr;
+    };
+
     LLVM_data initialize_llvm(
         Compilation_options const& options
     )
@@ -1273,48 +1541,52 @@ namespace h::compiler
             return *target;
         }();
 
-        char const* const cpu = "generic";
-        char const* const features = "";
+        Target_cpu const target_cpu = get_target_cpu(options);
         llvm::TargetOptions const target_options;
         std::optional<llvm::Reloc::Model> const code_model;
         // TODO investigate JIT argument to createTargetMachine
-        llvm::TargetMachine* target_machine = target.createTargetMachine(target_triple, cpu, features, target_options, code_model);
+        llvm::TargetMachine* target_machine = target.createTargetMachine(target_triple, target_cpu.name, target_cpu.features, target_options, code_model);
 
-        // TODO set according to optimization level
-        target_machine->setOptLevel(llvm::CodeGenOptLevel::Default);
+        target_machine->setOptLevel(to_llvm_code_generation_optimization_level(options.optimization_level));
 
         llvm::DataLayout llvm_data_layout = target_machine->createDataLayout();
 
         std::unique_ptr<llvm::LLVMContext> llvm_context = std::make_unique<llvm::LLVMContext>();
 
+        std::unique_ptr<Profile_diagnostics> profile_diagnostics = std::make_unique<Profile_diagnostics>();
+        if (options.pgo_options.mode == Pgo_mode::Use)
+            llvm_context->setDiagnosticHandler(std::make_unique<Profile_diagnostic_handler>(*profile_diagnostics));
+
         std::unique_ptr<llvm::LoopAnalysisManager> loop_analysis_manager = std::make_unique<llvm::LoopAnalysisManager>();
         std::unique_ptr<llvm::FunctionAnalysisManager> function_analysis_manager = std::make_unique<llvm::FunctionAnalysisManager>();
         std::unique_ptr<llvm::CGSCCAnalysisManager> cgscc_analysis_manager = std::make_unique<llvm::CGSCCAnalysisManager>();
         std::unique_ptr<llvm::ModuleAnalysisManager> module_analysis_manager = std::make_unique<llvm::ModuleAnalysisManager>();
 
-        // TODO set according to optimization level
-        llvm::PassBuilder pass_builder;
-        pass_builder.registerModuleAnalyses(*module_analysis_manager);
-        pass_builder.registerCGSCCAnalyses(*cgscc_analysis_manager);
-        pass_builder.registerFunctionAnalyses(*function_analysis_manager);
-        pass_builder.registerLoopAnalyses(*loop_analysis_manager);
-        pass_builder.crossRegisterProxies(
+        // The analysis managers keep references to the pass builder, so it must not move.
+        // Giving it the target machine lets the pipeline use the target's cost model.
+        std::unique_ptr<llvm::PassBuilder> pass_builder = std::make_unique<llvm::PassBuilder>(
+            target_machine,
+            llvm::PipelineTuningOptions{},
+            create_pgo_options(options.pgo_options)
+        );
+        pass_builder->registerModuleAnalyses(*module_analysis_manager);
+        pass_builder->registerCGSCCAnalyses(*cgscc_analysis_manager);
+        pass_builder->registerFunctionAnalyses(*function_analysis_manager);
+        pass_builder->registerLoopAnalyses(*loop_analysis_manager);
+        pass_builder->crossRegisterProxies(
             *loop_analysis_manager,
             *function_analysis_manager,
             *cgscc_analysis_manager,
             *module_analysis_manager
         );
 
-        llvm::OptimizationLevel const optimization_level = options.is_optimized ? llvm::OptimizationLevel::O2 : llvm::OptimizationLevel::O0;
-        llvm::ModulePassManager module_pass_manager = pass_builder.buildPerModuleDefaultPipeline(optimization_level);
-
-        // This merges identical functions. We might have a lot of these when generating functions using function constructors that only use pointers.
-        module_pass_manager.addPass(llvm::MergeFunctionsPass());
-
         Clang_data clang_data = create_clang_data(
             *llvm_context,
             llvm::Triple{ target_triple },
-            options.is_optimized ? 2 : 0
+            target_cpu.name,
+            target_cpu.features,
+            get_clang_optimization_level(options.optimization_level),
+            get_clang_size_level(options.optimization_level)
         );
 
         return LLVM_data
@@ -1324,69 +1596,61 @@ namespace h::compiler
             .target_machine = target_machine,
             .data_layout = std::move(llvm_data_layout),
             .context = std::move(llvm_context),
+            .optimization_level = options.optimization_level,
+            .lto_mode = options.lto_mode,
             .optimization_managers =
             {
                 .loop_analysis_manager = std::move(loop_analysis_manager),
                 .function_analysis_manager = std::move(function_analysis_manager),
                 .cgscc_analysis_manager = std::move(cgscc_analysis_manager),
                 .module_analysis_manager = std::move(module_analysis_manager),
-                .module_pass_manager = std::move(module_pass_manager),
+                .pass_builder = std::move(pass_builder),
+                .module_pass_managers = {},
             },
             .clang_data = std::move(clang_data),
+            .profile_diagnostics = std::move(profile_diagnostics),
         };
     }
 
     std::pmr::vector<h::Module const*> sort_core_modules(
-        std::pmr::unordered_map<std::pmr::string, h::Module> const& core_module_dependencies,
+        std::pmr::unordered_map<std::pmr::string, h::Module const*> const& core_module_dependencies,
         std::pmr::polymorphic_allocator<> const& output_allocator,
         std::pmr::polymorphic_allocator<> const& temporaries_allocator
     )
     {
-        std::pmr::vector<h::Module const*> remaining{ temporaries_allocator };
-        remaining.reserve(core_module_dependencies.size());
+        std::pmr::vector<h::Module const*> core_modules{ temporaries_allocator };
+        core_modules.reserve(core_module_dependencies.size());
 
         for (auto const& pair : core_module_dependencies)
-        {
-            remaining.push_back(&pair.second);
-        }
-
-        std::pmr::vector<h::Module const*> sorted{ output_allocator };
-        sorted.reserve(core_module_dependencies.size());
-
-        while (!remaining.empty())
-        {
-            for (std::size_t remaining_index = 0; remaining_index < remaining.size(); ++remaining_index)
-            {
-                h::Module const* core_module = remaining[remaining_index];
+            core_modules.push_back(pair.second);
 
-                bool const all_dependencies_are_in_sorted = std::all_of(
-                    core_module->dependencies.alias_imports.begin(),
-                    core_module->dependencies.alias_imports.end(),
-                    [&](Import_module_with_alias const& alias_import) -> bool
-                {
-                    auto const location = std::find_if(sorted.begin(), sorted.end(), [&](h::Module const* sorted_module) -> bool { return sorted_module->name == alias_import.module_name; });
-                    return location != sorted.end();
-                }
-                );
+        Sorted_core_modules sorted = sort_core_modules_and_compute_ranks(
+            core_modules,
+            output_allocator,
+            temporaries_allocator
+        );
 
-                if (all_dependencies_are_in_sorted)
-                {
-                    sorted.push_back(core_module);
-                    remaining.erase(remaining.begin() + remaining_index);
-                    break;
-                }
-            }
-        }
+        if (!sorted.diagnostics.empty())
+            throw std::runtime_error{ std::string{sorted.diagnostics[0].message} };
 
-        return sorted;
+        return std::move(sorted.sorted_core_modules);
     }
 
-    std::unique_ptr<llvm::Module> create_llvm_module(
+    std::unique_ptr<Prepared_core_module> prepare_core_module(
         LLVM_data& llvm_data,
         Module const& core_module,
-        std::pmr::unordered_map<std::pmr::string, Module> const& core_module_dependencies,
-        std::optional<std::span<std::string_view const>> const functions_to_compile,
-        Compilation_options const& compilation_options
+        std::pmr::unordered_map<std::pmr::string, Module const*> const& core_module_dependencies
+    )
+    {
+        // TODO do this a different place so we can modify original
+        return prepare_core_module(llvm_data, core_module, Module{ core_module }, core_module_dependencies);
+    }
+
+    std::unique_ptr<Prepared_core_module> prepare_core_module(
+        LLVM_data& llvm_data,
+        Module const& declarations_module,
+        Module core_module,
+        std::pmr::unordered_map<std::pmr::string, Module const*> const& core_module_dependencies
     )
     {
         std::pmr::vector<h::Module const*> const sorted_core_module_dependencies = sort_core_modules(core_module_dependencies, {}, {});
@@ -1394,10 +1658,9 @@ namespace h::compiler
         Declaration_database declaration_database = create_declaration_database();
         for (Module const* module_dependency : sorted_core_module_dependencies)
             add_declarations(declaration_database, *module_dependency);
-        add_declarations(declaration_database, core_module);
+        add_declarations(declaration_database, declarations_module);
 
-        // TODO do this a different place so we can modify original
-        Module new_core_module = core_module;
+        Module new_core_module = std::move(core_module);
         add_import_usages(new_core_module, {});
         {
             Analysis_result const result = process_module(new_core_module, declaration_database, {}, {});
@@ -1427,73 +1690,198 @@ namespace h::compiler
             add_module_types(type_database, *llvm_data.context, llvm_data.data_layout, clang_module_data, *module_dependency);
         add_module_types(type_database, *llvm_data.context, llvm_data.data_layout, clang_module_data, new_core_module);
 
-        std::unique_ptr<llvm::Module> llvm_module = create_module(*llvm_data.context, llvm_data.target_triple, llvm_data.data_layout, clang_module_data, new_core_module, core_module_dependencies, functions_to_compile, declaration_database, type_database, compilation_options);
+        return std::make_unique<Prepared_core_module>(
+            Prepared_core_module
+            {
+                .core_module = std::move(new_core_module),
+                .compilation_database =
+                {
+                    .declaration_database = std::move(declaration_database),
+                    .clang_module_data = std::move(clang_module_data),
+                    .type_database = std::move(type_database),
+                },
+            }
+        );
+    }
+
+    std::unique_ptr<llvm::Module> create_llvm_module(
+        LLVM_data& llvm_data,
+        Prepared_core_module& prepared_core_module,
+        std::pmr::unordered_map<std::pmr::string, Module const*> const& core_module_dependencies,
+        std::optional<std::span<std::string_view const>> const functions_to_compile,
+        Compilation_options const& compilation_options
+    )
+    {
+        Compilation_database& compilation_database = prepared_core_module.compilation_database;
+
+        set_clang_code_generation_optimization_level(llvm_data.clang_data, compilation_options.optimization_level);
+
+        std::unique_ptr<llvm::Module> llvm_module = create_module(*llvm_data.context, llvm_data.target_triple, llvm_data.data_layout, compilation_database.clang_module_data, prepared_core_module.core_module, core_module_dependencies, functions_to_compile, compilation_database.declaration_database, compilation_database.type_database, compilation_options);
         
-        optimize_llvm_module(llvm_data, *llvm_module);
+        optimize_llvm_module(llvm_data, *llvm_module, compilation_options.optimization_level);
         
         return llvm_module;
     }
 
-    static void add_sorted_core_module(
-        std::pmr::vector<h::Module const*>& sorted,
+    std::unique_ptr<llvm::Module> create_llvm_module(
+        LLVM_data& llvm_data,
+        Module const& core_module,
+        std::pmr::unordered_map<std::pmr::string, Module const*> const& core_module_dependencies,
+        std::optional<std::span<std::string_view const>> const functions_to_compile,
+        Compilation_options const& compilation_options
+    )
+    {
+        std::unique_ptr<Prepared_core_module> prepared_core_module = prepare_core_module(llvm_data, core_module, core_module_dependencies);
+        return create_llvm_module(llvm_data, *prepared_core_module, core_module_dependencies, functions_to_compile, compilation_options);
+    }
+
+    static Diagnostic create_sort_diagnostic(
         h::Module const& core_module,
-        std::span<h::Module const> const core_modules
+        Import_module_with_alias const& alias_import,
+        std::pmr::string message
     )
     {
-        auto const location = std::find_if(
-            sorted.begin(),
-            sorted.end(),
-            [&](h::Module const* current) -> bool { return current == &core_module; }
-        );
-        if (location != sorted.end())
-            return;
+        return Diagnostic
+        {
+            .file_path = core_module.source_file_path,
+            .range = alias_import.source_range.value_or(Source_range{}),
+            .source = Diagnostic_source::Compiler,
+            .severity = Diagnostic_severity::Error,
+            .message = std::move(message),
+        };
+    }
+
+    Sorted_core_modules sort_core_modules_and_compute_ranks(
+        std::span<h::Module const* const> const core_modules,
+        std::pmr::polymorphic_allocator<> const& output_allocator,
+        std::pmr::polymorphic_allocator<> const& temporaries_allocator
+    )
+    {
+        std::pmr::unordered_map<std::string_view, std::size_t> module_name_to_index{ temporaries_allocator };
+        module_name_to_index.reserve(core_modules.size());
+        for (std::size_t core_module_index = 0; core_module_index < core_modules.size(); ++core_module_index)
+            module_name_to_index.emplace(core_modules[core_module_index]->name, core_module_index);
+
+        std::pmr::vector<Diagnostic> diagnostics{ output_allocator };
+
+        // For each module, the number of imports that are not sorted yet and the modules that import it:
+        std::pmr::vector<std::size_t> remaining_import_counts(core_modules.size(), 0, temporaries_allocator);
+        std::pmr::vector<std::pmr::vector<std::size_t>> dependents(core_modules.size(), temporaries_allocator);
 
-        for (std::size_t import_index = 0; import_index < core_module.dependencies.alias_imports.size(); ++import_index)
+        for (std::size_t core_module_index = 0; core_module_index < core_modules.size(); ++core_module_index)
         {
-            Import_module_with_alias const& alias_import = core_module.dependencies.alias_imports[import_index];
-            
-            auto const location = std::find_if(
-                core_modules.begin(),
-                core_modules.end(),
-                [&](h::Module const& current) -> bool { return current.name == alias_import.module_name; }
-            );
-            if (location == core_modules.end())
+            h::Module const& core_module = *core_modules[core_module_index];
+
+            for (Import_module_with_alias const& alias_import : core_module.dependencies.alias_imports)
+            {
+                auto const location = module_name_to_index.find(alias_import.module_name);
+                if (location == module_name_to_index.end())
+                    continue;
+
+                remaining_import_counts[core_module_index] += 1;
+                dependents[location->second].push_back(core_module_index);
+            }
+        }
+
+        Sorted_core_modules output
+        {
+            .sorted_core_modules = std::pmr::vector<h::Module const*>{ output_allocator },
+            .ranks = std::pmr::vector<std::pmr::vector<std::size_t>>{ output_allocator },
+            .diagnostics = {},
+        };
+        output.sorted_core_modules.reserve(core_modules.size());
+
+        std::pmr::vector<std::size_t> current_rank{ output_allocator };
+        for (std::size_t core_module_index = 0; core_module_index < core_modules.size(); ++core_module_index)
+        {
+            if (remaining_import_counts[core_module_index] == 0)
+                current_rank.push_back(core_module_index);
+        }
+
+        while (!current_rank.empty())
+        {
+            std::pmr::vector<std::size_t> next_rank{ output_allocator };
+
+            for (std::size_t const core_module_index : current_rank)
+            {
+                output.sorted_core_modules.push_back(core_modules[core_module_index]);
+
+                for (std::size_t const dependent_index : dependents[core_module_index])
+                {
+                    remaining_import_counts[dependent_index] -= 1;
+                    if (remaining_import_counts[dependent_index] == 0)
+                        next_rank.push_back(dependent_index);
+                }
+            }
+
+            std::sort(next_rank.begin(), next_rank.end());
+
+            output.ranks.push_back(std::move(current_rank));
+            current_rank = std::move(next_rank);
+        }
+
+        // Modules that were never ready are part of an import cycle or depend on one.
+        // They are still appended, so that callers see every module:
+        for (std::size_t core_module_index = 0; core_module_index < core_modules.size(); ++core_module_index)
+        {
+            if (remaining_import_counts[core_module_index] == 0)
                 continue;
 
-            h::Module const& dependency_module = *location;
+            h::Module const& core_module = *core_modules[core_module_index];
+            output.sorted_core_modules.push_back(&core_module);
 
-            add_sorted_core_module(
-                sorted,
-                dependency_module,
-                core_modules
-            );
+            for (Import_module_with_alias const& alias_import : core_module.dependencies.alias_imports)
+            {
+                auto const location = module_name_to_index.find(alias_import.module_name);
+                if (location == module_name_to_index.end() || remaining_import_counts[location->second] == 0)
+                    continue;
+
+                diagnostics.push_back(
+                    create_sort_diagnostic(
+                        core_module,
+                        alias_import,
+                        std::pmr::string{ std::format("Module '{}' imports module '{}' which is part of an import cycle.", core_module.name, alias_import.module_name), output_allocator }
+                    )
+                );
+            }
         }
 
-        sorted.push_back(&core_module);
+        output.diagnostics = std::move(diagnostics);
+        return output;
     }
 
-    std::pmr::vector<h::Module const*> sort_core_modules(
+    Sorted_core_modules sort_core_modules_and_compute_ranks(
         std::span<h::Module const> const core_modules,
         std::pmr::polymorphic_allocator<> const& output_allocator,
         std::pmr::polymorphic_allocator<> const& temporaries_allocator
     )
     {
-        std::pmr::vector<h::Module const*> sorted{ output_allocator };
-        sorted.reserve(core_modules.size());
+        std::pmr::vector<h::Module const*> core_module_pointers{ temporaries_allocator };
+        core_module_pointers.reserve(core_modules.size());
 
-        for (std::size_t core_module_index = 0; core_module_index < core_modules.size(); ++core_module_index)
-        {
-            h::Module const& core_module = core_modules[core_module_index];
+        for (h::Module const& core_module : core_modules)
+            core_module_pointers.push_back(&core_module);
 
-            add_sorted_core_module(
-                sorted,
-                core_module,
-                core_modules
-            );
-        }
+        return sort_core_modules_and_compute_ranks(
+            core_module_pointers,
+            output_allocator,
+            temporaries_allocator
+        );
+    }
 
-        assert(sorted.size() == core_modules.size());
-        return sorted;
+    std::pmr::vector<h::Module const*> sort_core_modules(
+        std::span<h::Module const> const core_modules,
+        std::pmr::polymorphic_allocator<> const& output_allocator,
+        std::pmr::polymorphic_allocator<> const& temporaries_allocator
+    )
+    {
+        Sorted_core_modules sorted = sort_core_modules_and_compute_ranks(
+            core_modules,
+            output_allocator,
+            temporaries_allocator
+        );
+
+        return std::move(sorted.sorted_core_modules);
     }
 
     void add_import_usages(
@@ -1610,22 +1998,39 @@ namespace h::compiler
 
         std::pmr::unordered_map<std::string_view, std::pmr::vector<std::pmr::string>> usages_per_module;
 
-        std::pmr::vector<h::Module const*> sorted_core_modules = sort_core_modules(
+        Sorted_core_modules sorted = sort_core_modules_and_compute_ranks(
             core_modules,
             output_allocator,
-            output_allocator
+            temporaries_allocator
         );
+        std::pmr::vector<h::Module const*>& sorted_core_modules = sorted.sorted_core_modules;
 
         Declaration_database declaration_database = create_declaration_database_and_add_modules(
             header_modules,
             sorted_core_modules
         );
 
-        // TODO can be done in parallel but declaration_database.call_instances needs to be guarded...
-        for (Module& core_module : core_modules)
+        if (!sorted.diagnostics.empty())
         {
-            Analysis_result result = process_module(core_module, declaration_database, {}, temporaries_allocator);
+            return Declaration_database_and_sorted_modules
+            {
+                .sorted_core_modules = std::move(sorted_core_modules),
+                .declaration_database = std::move(declaration_database),
+                .diagnostics = std::move(sorted.diagnostics),
+            };
+        }
+
+        std::pmr::vector<Analysis_result> results = process_modules_per_rank(
+            0,
+            core_modules,
+            sorted.ranks,
+            declaration_database,
+            {},
+            temporaries_allocator
+        );
 
+        for (Analysis_result& result : results)
+        {
             if (!result.diagnostics.empty())
             {
                 return Declaration_database_and_sorted_modules
@@ -1710,20 +2115,99 @@ namespace h::compiler
         };
     }
 
-    std::unique_ptr<llvm::Module> create_llvm_module(
+    Module_cache create_module_cache(
+        std::span<h::Module const> const header_modules,
+        std::span<h::Module const> const core_modules,
+        std::pmr::polymorphic_allocator<> const& output_allocator
+    )
+    {
+        Module_cache module_cache
+        {
+            .modules = std::pmr::unordered_map<std::pmr::string, h::Module const*>{output_allocator},
+        };
+        module_cache.modules.reserve(header_modules.size() + core_modules.size());
+
+        for (h::Module const& header_module : header_modules)
+            module_cache.modules.insert(std::make_pair(header_module.name, &header_module));
+
+        for (h::Module const& core_module : core_modules)
+            module_cache.modules.insert(std::make_pair(core_module.name, &core_module));
+
+        return module_cache;
+    }
+
+    static h::Module const& get_cached_module(
+        Module_cache const& module_cache,
+        std::string_view const module_name
+    )
+    {
+        auto const location = module_cache.modules.find(std::pmr::string{module_name});
+        if (location == module_cache.modules.end())
+            throw std::runtime_error{ std::format("Could not find module '{}' in the module cache.", module_name) };
+
+        return *location->second;
+    }
+
+    static void add_dependency_core_modules(
+        Module_cache const& module_cache,
+        Module const& core_module,
+        std::pmr::unordered_map<std::pmr::string, h::Module const*>& core_module_dependencies
+    )
+    {
+        for (Import_module_with_alias const& alias_import : core_module.dependencies.alias_imports)
+        {
+            if (core_module_dependencies.contains(alias_import.module_name))
+                continue;
+
+            h::Module const& import_core_module = get_cached_module(module_cache, alias_import.module_name);
+            core_module_dependencies.insert(std::make_pair(alias_import.module_name, &import_core_module));
+
+            add_dependency_core_modules(module_cache, import_core_module, core_module_dependencies);
+        }
+    }
+
+    std::pmr::unordered_map<std::pmr::string, h::Module const*> get_dependency_core_modules(
+        Module_cache const& module_cache,
+        h::Module const& core_module
+    )
+    {
+        std::pmr::unordered_map<std::pmr::string, h::Module const*> core_module_dependencies;
+
+        if (core_module.name != "H.Builtin")
+        {
+            h::Module const& builtin_module = get_cached_module(module_cache, "H.Builtin");
+            core_module_dependencies.insert(std::make_pair(builtin_module.name, &builtin_module));
+        }
+
+        add_dependency_core_modules(module_cache, core_module, core_module_dependencies);
+
+        return core_module_dependencies;
+    }
+
+    std::pmr::unordered_map<std::pmr::string, h::Module const*> create_module_references(
+        std::pmr::unordered_map<std::pmr::string, h::Module> const& modules
+    )
+    {
+        std::pmr::unordered_map<std::pmr::string, h::Module const*> references;
+        references.reserve(modules.size());
+
+        for (std::pair<std::pmr::string const, h::Module> const& pair : modules)
+            references.insert(std::make_pair(pair.first, &pair.second));
+
+        return references;
+    }
+
+    std::unique_ptr<llvm::Module> create_unoptimized_llvm_module(
         LLVM_data& llvm_data,
         h::Module const& core_module,
-        std::pmr::unordered_map<std::pmr::string, std::filesystem::path> const& module_name_to_file_path_map,
+        std::pmr::unordered_map<std::pmr::string, h::Module const*> const& core_module_dependencies,
         Compilation_database& compilation_database,
         Compilation_options const& compilation_options
     )
     {
-        std::pmr::unordered_map<std::pmr::string, h::Module> core_module_dependencies = create_dependency_core_modules(
-            core_module,
-            module_name_to_file_path_map
-        );
+        set_clang_code_generation_optimization_level(llvm_data.clang_data, compilation_options.optimization_level);
 
-        std::unique_ptr<llvm::Module> llvm_module = create_module(
+        return create_module(
             *llvm_data.context,
             llvm_data.target_triple,
             llvm_data.data_layout,
@@ -1735,8 +2219,25 @@ namespace h::compiler
             compilation_database.type_database,
             compilation_options
         );
+    }
+
+    std::unique_ptr<llvm::Module> create_llvm_module(
+        LLVM_data& llvm_data,
+        h::Module const& core_module,
+        std::pmr::unordered_map<std::pmr::string, h::Module const*> const& core_module_dependencies,
+        Compilation_database& compilation_database,
+        Compilation_options const& compilation_options
+    )
+    {
+        std::unique_ptr<llvm::Module> llvm_module = create_unoptimized_llvm_module(
+            llvm_data,
+            core_module,
+            core_module_dependencies,
+            compilation_database,
+            compilation_options
+        );
         
-        optimize_llvm_module(llvm_data, *llvm_module);
+        optimize_llvm_module(llvm_data, *llvm_module, compilation_options.optimization_level);
         
         return llvm_module;
     }
@@ -1744,7 +2245,7 @@ namespace h::compiler
     std::unique_ptr<llvm::Module> create_llvm_module(
         LLVM_data& llvm_data,
         Module const& core_module,
-        std::pmr::unordered_map<std::pmr::string, Module> const& core_module_dependencies,
+        std::pmr::unordered_map<std::pmr::string, Module const*> const& core_module_dependencies,
         Compilation_options const& compilation_options
     )
     {
@@ -1760,7 +2261,7 @@ namespace h::compiler
     {
         std::pmr::unordered_map<std::pmr::string, h::Module> core_module_dependencies = create_dependency_core_modules(core_module, module_name_to_file_path_map);
 
-        std::unique_ptr<llvm::Module> llvm_module = create_llvm_module(llvm_data, core_module, core_module_dependencies, compilation_options);
+        std::unique_ptr<llvm::Module> llvm_module = create_llvm_module(llvm_data, core_module, create_module_references(core_module_dependencies), compilation_options);
 
         return {
             .dependencies = std::move(core_module_dependencies),
@@ -1768,12 +2269,58 @@ namespace h::compiler
         };
     }
 
+    static llvm::ModulePassManager& get_module_pass_manager(
+        Optimization_managers& optimization_managers,
+        Optimization_level const optimization_level,
+        Lto_mode const lto_mode
+    )
+    {
+        auto const location = optimization_managers.module_pass_managers.find(optimization_level);
+        if (location != optimization_managers.module_pass_managers.end())
+            return location->second;
+
+        // With ThinLTO, inlining across modules and the late optimizations happen in the thin link backends:
+        llvm::ModulePassManager module_pass_manager = lto_mode == Lto_mode::Thin ?
+            optimization_managers.pass_builder->buildThinLTOPreLinkDefaultPipeline(to_llvm_optimization_level(optimization_level)) :
+            optimization_managers.pass_builder->buildPerModuleDefaultPipeline(to_llvm_optimization_level(optimization_level));
+
+        // This merges identical functions. We might have a lot of these when generating functions using function constructors that only use pointers.
+        module_pass_manager.addPass(llvm::MergeFunctionsPass());
+
+        auto const result = optimization_managers.module_pass_managers.emplace(optimization_level, std::move(module_pass_manager));
+        return result.first->second;
+    }
+
     void optimize_llvm_module(
         LLVM_data& llvm_data,
-        llvm::Module& llvm_module
+        llvm::Module& llvm_module,
+        Optimization_level const optimization_level
+    )
+    {
+        llvm::ModulePassManager& module_pass_manager = get_module_pass_manager(llvm_data.optimization_managers, optimization_level, llvm_data.lto_mode);
+        module_pass_manager.run(llvm_module, *llvm_data.optimization_managers.module_analysis_manager);
+
+        // Cached analyses are keyed by module and function addresses, which later modules may reuse:
+        llvm_data.optimization_managers.module_analysis_manager->clear();
+
+        Profile_diagnostics& profile_diagnostics = *llvm_data.profile_diagnostics;
+        if (profile_diagnostics.mismatched_function_count > 0)
+        {
+            std::cerr << std::format(
+                "Warning: the profile data of {} functions in '{}' does not match their code anymore, so they are optimized without it. Run the instrumented build again to refresh the profile.\n",
+                profile_diagnostics.mismatched_function_count,
+                std::string_view{llvm_module.getName()}
+            );
+            profile_diagnostics.mismatched_function_count = 0;
+        }
+    }
+
+    void set_code_generation_optimization_level(
+        LLVM_data const& llvm_data,
+        Optimization_level const optimization_level
     )
     {
-        llvm_data.optimization_managers.module_pass_manager.run(llvm_module, *llvm_data.optimization_managers.module_analysis_manager);
+        llvm_data.target_machine->setOptLevel(to_llvm_code_generation_optimization_level(optimization_level));
     }
 
     std::string to_string(
@@ -1805,6 +2352,26 @@ namespace h::compiler
         llvm::WriteBitcodeToFile(llvm_module, output_stream);
     }
 
+    void write_thin_lto_bitcode_to_file(
+        LLVM_data const& llvm_data,
+        llvm::Module& llvm_module,
+        std::filesystem::path const& output_file_path
+    )
+    {
+        std::error_code error_code;
+        llvm::raw_fd_ostream output_stream(output_file_path.generic_string(), error_code, llvm::sys::fs::OF_None);
+
+        if (error_code)
+        {
+            std::string const error_message = error_code.message();
+            llvm::errs() << "Could not open file: " << error_message;
+            throw std::runtime_error{ error_message };
+        }
+
+        llvm::ModuleSummaryIndex const summary_index = llvm::buildModuleSummaryIndex(llvm_module, nullptr, nullptr);
+        llvm::WriteBitcodeToFile(llvm_module, output_stream, false, &summary_index, true);
+    }
+
     void write_llvm_ir_to_file(
         llvm::Module& llvm_module,
         std::filesystem::path const& output_file_path
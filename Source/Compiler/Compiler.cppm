@@ -6,9 +6,11 @@ module;
 #include <llvm/IR/Module.h>
 #include <llvm/IR/PassInstrumentation.h>
 #include <llvm/IR/PassManager.h>
+#include <llvm/Passes/PassBuilder.h>
 #include <llvm/Passes/StandardInstrumentations.h>
 #include <llvm/Target/TargetMachine.h>
 
+#include <cstdint>
 #include <filesystem>
 #include <memory>
 #include <memory_resource>
@@ -23,6 +25,7 @@ import h.core.declarations;
 import h.compiler.clang_data;
 import h.compiler.diagnostic;
 import h.compiler.expressions;
+import h.compiler.target;
 import h.compiler.types;
 
 namespace h::compiler
@@ -33,7 +36,14 @@ namespace h::compiler
         std::unique_ptr<llvm::FunctionAnalysisManager> function_analysis_manager;
         std::unique_ptr<llvm::CGSCCAnalysisManager> cgscc_analysis_manager;
         std::unique_ptr<llvm::ModuleAnalysisManager> module_analysis_manager;
-        llvm::ModulePassManager module_pass_manager;
+        std::unique_ptr<llvm::PassBuilder> pass_builder;
+        std::pmr::unordered_map<Optimization_level, llvm::ModulePassManager> module_pass_managers; // Built on first use
+    };
+
+    // Filled by the LLVM context while optimizing with a profile, and reported once per module.
+    export struct Profile_diagnostics
+    {
+        std::uint64_t mismatched_function_count = 0;
     };
 
     export struct LLVM_data
@@ -43,8 +53,11 @@ namespace h::compiler
         llvm::TargetMachine* target_machine;
         llvm::DataLayout data_layout;
         std::unique_ptr<llvm::LLVMContext> context;
+        Optimization_level optimization_level;
+        Lto_mode lto_mode;
         Optimization_managers optimization_managers;
         Clang_data clang_data;
+        std::unique_ptr<Profile_diagnostics> profile_diagnostics;
     };
 
     export struct LLVM_module_data
@@ -56,10 +69,14 @@ namespace h::compiler
     export struct Compilation_options
     {
         std::optional<std::string_view> target_triple;
-        bool is_optimized = false;
+        std::optional<std::pmr::string> cpu; // "native" selects the host CPU
+        std::optional<std::pmr::string> target_features; // e.g. "+avx2,-avx512f"
+        Optimization_level optimization_level = Optimization_level::O0;
         bool debug = true;
         bool output_debug_code_view = false;
         Contract_options contract_options = Contract_options::Log_error_and_abort;
+        Lto_mode lto_mode = Lto_mode::None; // With Thin, bitcode outputs carry a summary and are optimized across modules when linking
+        Pgo_options pgo_options = {};
     };
 
     export std::optional<h::Module> read_core_module(
@@ -70,6 +87,16 @@ namespace h::compiler
         std::filesystem::path const& path
     );
 
+    export struct Target_cpu
+    {
+        std::pmr::string name;
+        std::pmr::string features;
+    };
+
+    export Target_cpu get_target_cpu(
+        Compilation_options const& compilation_options
+    );
+
     export LLVM_data initialize_llvm(
         Compilation_options const& compilation_options
     );
@@ -77,7 +104,7 @@ namespace h::compiler
     export std::unique_ptr<llvm::Module> create_llvm_module(
         LLVM_data& llvm_data,
         Module const& core_module,
-        std::pmr::unordered_map<std::pmr::string, Module> const& core_module_dependencies,
+        std::pmr::unordered_map<std::pmr::string, Module const*> const& core_module_dependencies,
         std::optional<std::span<std::string_view const>> const functions_to_compile,
         Compilation_options const& compilation_options
     );
@@ -85,7 +112,7 @@ namespace h::compiler
     export std::unique_ptr<llvm::Module> create_llvm_module(
         LLVM_data& llvm_data,
         Module const& core_module,
-        std::pmr::unordered_map<std::pmr::string, Module> const& core_module_dependencies,
+        std::pmr::unordered_map<std::pmr::string, Module const*> const& core_module_dependencies,
         Compilation_options const& compilation_options
     );
 
@@ -96,6 +123,29 @@ namespace h::compiler
         Compilation_options const& compilation_options
     );
 
+    export struct Sorted_core_modules
+    {
+        std::pmr::vector<h::Module const*> sorted_core_modules;
+        std::pmr::vector<std::pmr::vector<std::size_t>> ranks; // Indices of the input modules. Modules of a rank only import modules of previous ranks.
+        std::pmr::vector<Diagnostic> diagnostics;
+    };
+
+    // Sorts modules so that each module comes after the modules it imports.
+    // Imports of modules that are not in core_modules, such as header modules, are ignored. Missing modules
+    // are reported by validation. Modules that are part of or depend on an import cycle are reported and
+    // appended at the end of sorted_core_modules, without a rank.
+    export Sorted_core_modules sort_core_modules_and_compute_ranks(
+        std::span<h::Module const* const> const core_modules,
+        std::pmr::polymorphic_allocator<> const& output_allocator,
+        std::pmr::polymorphic_allocator<> const& temporaries_allocator
+    );
+
+    export Sorted_core_modules sort_core_modules_and_compute_ranks(
+        std::span<h::Module const> const core_modules,
+        std::pmr::polymorphic_allocator<> const& output_allocator,
+        std::pmr::polymorphic_allocator<> const& temporaries_allocator
+    );
+
     export std::pmr::vector<h::Module const*> sort_core_modules(
         std::span<h::Module const> const core_modules,
         std::pmr::polymorphic_allocator<> const& output_allocator,
@@ -103,7 +153,7 @@ namespace h::compiler
     );
 
     std::pmr::vector<h::Module const*> sort_core_modules(
-        std::pmr::unordered_map<std::pmr::string, h::Module> const& core_module_dependencies,
+        std::pmr::unordered_map<std::pmr::string, h::Module const*> const& core_module_dependencies,
         std::pmr::polymorphic_allocator<> const& output_allocator,
         std::pmr::polymorphic_allocator<> const& temporaries_allocator
     );
@@ -140,17 +190,93 @@ namespace h::compiler
         std::pmr::polymorphic_allocator<> const& temporaries_allocator
     );
 
+    // Build-wide view of every module of a build, so that the dependencies of each compiled
+    // module are not read from disk again. The referenced modules must outlive the cache.
+    export struct Module_cache
+    {
+        std::pmr::unordered_map<std::pmr::string, h::Module const*> modules;
+    };
+
+    export Module_cache create_module_cache(
+        std::span<h::Module const> const header_modules,
+        std::span<h::Module const> const core_modules,
+        std::pmr::polymorphic_allocator<> const& output_allocator
+    );
+
+    // The returned modules point into the cache, so nothing is copied.
+    export std::pmr::unordered_map<std::pmr::string, h::Module const*> get_dependency_core_modules(
+        Module_cache const& module_cache,
+        h::Module const& core_module
+    );
+
+    export std::pmr::unordered_map<std::pmr::string, h::Module const*> create_module_references(
+        std::pmr::unordered_map<std::pmr::string, h::Module> const& modules
+    );
+
     export std::unique_ptr<llvm::Module> create_llvm_module(
         LLVM_data& llvm_data,
         h::Module const& core_module,
-        std::pmr::unordered_map<std::pmr::string, std::filesystem::path> const& module_name_to_file_path_map,
+        std::pmr::unordered_map<std::pmr::string, h::Module const*> const& core_module_dependencies,
+        Compilation_database& compilation_database,
+        Compilation_options const& compilation_options
+    );
+
+    // A module that was already analyzed, together with the databases needed to lower it.
+    // It can be passed to create_llvm_module several times to compile different functions of
+    // the module, for example when functions are compiled lazily.
+    export struct Prepared_core_module
+    {
+        h::Module core_module;
+        Compilation_database compilation_database;
+    };
+
+    export std::unique_ptr<Prepared_core_module> prepare_core_module(
+        LLVM_data& llvm_data,
+        h::Module const& core_module,
+        std::pmr::unordered_map<std::pmr::string, h::Module const*> const& core_module_dependencies
+    );
+
+    // Same as above, but processes core_module instead of a copy. The declaration database points into
+    // declarations_module, so it must outlive the prepared module and declare the same as core_module.
+    export std::unique_ptr<Prepared_core_module> prepare_core_module(
+        LLVM_data& llvm_data,
+        h::Module const& declarations_module,
+        h::Module core_module,
+        std::pmr::unordered_map<std::pmr::string, h::Module const*> const& core_module_dependencies
+    );
+
+    export std::unique_ptr<llvm::Module> create_llvm_module(
+        LLVM_data& llvm_data,
+        Prepared_core_module& prepared_core_module,
+        std::pmr::unordered_map<std::pmr::string, h::Module const*> const& core_module_dependencies,
+        std::optional<std::span<std::string_view const>> const functions_to_compile,
+        Compilation_options const& compilation_options
+    );
+
+    // Same as create_llvm_module, but leaves optimizing to the caller.
+    export std::unique_ptr<llvm::Module> create_unoptimized_llvm_module(
+        LLVM_data& llvm_data,
+        h::Module const& core_module,
+        std::pmr::unordered_map<std::pmr::string, h::Module const*> const& core_module_dependencies,
         Compilation_database& compilation_database,
         Compilation_options const& compilation_options
     );
 
     export void optimize_llvm_module(
         LLVM_data& llvm_data,
-        llvm::Module& llvm_module
+        llvm::Module& llvm_module,
+        Optimization_level optimization_level
+    );
+
+    // Selects the code generation level used by write_object_file. Modules of one LLVM_data may be
+    // optimized at different levels, for example when an artifact overrides the build level.
+    export llvm::CodeGenOptLevel to_llvm_code_generation_optimization_level(
+        Optimization_level optimization_level
+    );
+
+    export void set_code_generation_optimization_level(
+        LLVM_data const& llvm_data,
+        Optimization_level optimization_level
     );
 
     export std::string to_string(
@@ -163,6 +289,13 @@ namespace h::compiler
         std::filesystem::path const& output_file_path
     );
 
+    // Also writes the ThinLTO summary and module hash that the thin link and its cache need.
+    export void write_thin_lto_bitcode_to_file(
+        LLVM_data const& llvm_data,
+        llvm::Module& llvm_module,
+        std::filesystem::path const& output_file_path
+    );
+
     export void write_llvm_ir_to_file(
         llvm::Module& llvm_module,
         std::filesystem::path const& output_file_path
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cstdint>
 #include <cstdio>
 #include <filesystem>
 #include <memory_resource>
@@ -5,14 +7,21 @@
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <llvm/Analysis/CGSCCPassManager.h>
 #include <llvm/Analysis/LoopAnalysisManager.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Instructions.h>
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/PassInstrumentation.h>
 #include <llvm/IR/PassManager.h>
+#include <llvm/IR/ProfDataUtils.h>
 #include <llvm/Passes/StandardInstrumentations.h>
+#include <llvm/ProfileData/InstrProf.h>
+#include <llvm/ProfileData/InstrProfWriter.h>
+#include <llvm/Support/raw_ostream.h>
 #include <llvm/Target/TargetMachine.h>
 
 import h.binary_serializer;
@@ -27,6 +36,7 @@ import h.compiler.clang_code_generation;
 import h.compiler.clang_data;
 import h.compiler.common;
 import h.compiler.expressions;
+import h.compiler.target;
 import h.compiler.types;
 import h.json_serializer.operators;
 import h.c_header_converter;
@@ -167,7 +177,7 @@ namespace h
     h::compiler::Compilation_options const compilation_options
     {
       .target_triple = test_options.target_triple,
-      .is_optimized = false,
+      .optimization_level = h::compiler::Optimization_level::O0,
       .debug = test_options.debug,
       .contract_options = test_options.contract_options,
     };
@@ -231,6 +241,9 @@ attributes #0 = { convergent "no-trapping-math"="true" "stack-protector-buffer-s
     std::string const expected_llvm_ir = std::format(R"(
 %struct.H_Builtin_Generic_array_slice = type {{ ptr, i64 }}
 
+@array = private unnamed_addr constant [4 x i32] [i32 0, i32 1, i32 2, i32 3]
+@array.1 = private unnamed_addr constant [1 x i32] [i32 4]
+
 ; Function Attrs: convergent
 define void @Array_slices_take(ptr %"arguments[0].integers_0", i64 %"arguments[0].integers_1") #0 !dbg !3 {{
 entry:
@@ -288,11 +301,9 @@ entry:
 ; Function Attrs: convergent
 define void @Array_slices_run() #0 !dbg !35 {{
 entry:
-  %array = alloca [4 x i32], i64 4, align 4, !dbg !39
   %a = alloca [4 x i32], align 4, !dbg !39
   %0 = alloca %struct.H_Builtin_Generic_array_slice, align 8, !dbg !40
   %1 = alloca %struct.H_Builtin_Generic_array_slice, align 8, !dbg !41
-  %array4 = alloca [1 x i32], i64 1, align 4, !dbg !42
   %2 = alloca %struct.H_Builtin_Generic_array_slice, align 8, !dbg !42
   %b = alloca i32, align 4, !dbg !43
   %c = alloca ptr, align 8, !dbg !43
@@ -304,15 +315,7 @@ entry:
   %h = alloca %struct.H_Builtin_Generic_array_slice, align 8, !dbg !47
   %i = alloca ptr, align 8, !dbg !48
   %j = alloca ptr, align 8, !dbg !49
-  %array_element_pointer = getelementptr [4 x i32], ptr %array, i32 0, i32 0, !dbg !39
-  store i32 0, ptr %array_element_pointer, align 4, !dbg !39
-  %array_element_pointer1 = getelementptr [4 x i32], ptr %array, i32 0, i32 1, !dbg !39
-  store i32 1, ptr %array_element_pointer1, align 4, !dbg !39
-  %array_element_pointer2 = getelementptr [4 x i32], ptr %array, i32 0, i32 2, !dbg !39
-  store i32 2, ptr %array_element_pointer2, align 4, !dbg !39
-  %array_element_pointer3 = getelementptr [4 x i32], ptr %array, i32 0, i32 3, !dbg !39
-  store i32 3, ptr %array_element_pointer3, align 4, !dbg !39
-  %5 = load [4 x i32], ptr %array, align 4, !dbg !39
+  %5 = load [4 x i32], ptr @array, align 4, !dbg !39
   call void @llvm.dbg.declare(metadata ptr %a, metadata !50, metadata !DIExpression()), !dbg !40
   store [4 x i32] %5, ptr %a, align 4, !dbg !40
   %data_pointer = getelementptr [4 x i32], ptr %a, i32 0, i32 0, !dbg !40
@@ -334,11 +337,8 @@ entry:
   %16 = getelementptr inbounds {{ ptr, i64 }}, ptr %1, i32 0, i32 1, !dbg !42
   %17 = load i64, ptr %16, align 8, !dbg !42
   call void @Array_slices_take(ptr %15, i64 %17), !dbg !42
-  %array_element_pointer5 = getelementptr [1 x i32], ptr %array4, i32 0, i32 0, !dbg !42
-  store i32 4, ptr %array_element_pointer5, align 4, !dbg !42
-  %data_pointer6 = getelementptr [1 x i32], ptr %array4, i32 0, i32 0, !dbg !42
   %18 = getelementptr inbounds %struct.H_Builtin_Generic_array_slice, ptr %2, i32 0, i32 0, !dbg !42
-  store ptr %data_pointer6, ptr %18, align 8, !dbg !42
+  store ptr @array.1, ptr %18, align 8, !dbg !42
   %19 = getelementptr inbounds %struct.H_Builtin_Generic_array_slice, ptr %2, i32 0, i32 1, !dbg !42
   store i64 1, ptr %19, align 8, !dbg !42
   %20 = getelementptr inbounds {{ ptr, i64 }}, ptr %2, i32 0, i32 0, !dbg !52
@@ -381,9 +381,9 @@ entry:
   store ptr %37, ptr %i, align 8, !dbg !49
   %38 = getelementptr inbounds %struct.H_Builtin_Generic_array_slice, ptr %h, i32 0, i32 0, !dbg !49
   %39 = load ptr, ptr %38, align 8, !dbg !49
-  %array_element_pointer7 = getelementptr i32, ptr %39, i32 0, !dbg !49
+  %array_element_pointer = getelementptr i32, ptr %39, i32 0, !dbg !49
   call void @llvm.dbg.declare(metadata ptr %j, metadata !65, metadata !DIExpression()), !dbg !66
-  store ptr %array_element_pointer7, ptr %j, align 8, !dbg !66
+  store ptr %array_element_pointer, ptr %j, align 8, !dbg !66
   ret void, !dbg !66
 }}
 
@@ -1325,6 +1325,37 @@ entry:
   ret void
 }
 
+attributes #0 = { convergent "no-trapping-math"="true" "stack-protector-buffer-size"="0" "target-features"="+cx8,+mmx,+sse,+sse2,+x87" }
+)";
+
+    test_create_llvm_module(input_file, module_name_to_file_path_map, expected_llvm_ir);
+  }
+
+  TEST_CASE("Compile Builtin Name Shadowing", "[LLVM_IR]")
+  {
+    char const* const input_file = "builtin_name_shadowing.hltxt";
+
+    std::pmr::unordered_map<std::pmr::string, std::filesystem::path> const module_name_to_file_path_map
+    {
+    };
+
+    char const* const expected_llvm_ir = R"(
+; Function Attrs: convergent
+define i32 @Builtin_name_shadowing_expect(i32 noundef %"arguments[0].value") #0 {
+entry:
+  %value = alloca i32, align 4
+  store i32 %"arguments[0].value", ptr %value, align 4
+  %0 = load i32, ptr %value, align 4
+  ret i32 %0
+}
+
+; Function Attrs: convergent
+define i32 @Builtin_name_shadowing_run() #0 {
+entry:
+  %0 = call i32 @Builtin_name_shadowing_expect(i32 noundef 1)
+  ret i32 %0
+}
+
 attributes #0 = { convergent "no-trapping-math"="true" "stack-protector-buffer-size"="0" "target-features"="+cx8,+mmx,+sse,+sse2,+x87" }
 )";
 
@@ -1341,7 +1372,7 @@ attributes #0 = { convergent "no-trapping-math"="true" "stack-protector-buffer-s
     };
 
     char const* const expected_llvm_ir = R"(
-@global_0 = internal constant [3 x i8] c"%d\00"
+@global_0 = private unnamed_addr constant [3 x i8] c"%d\00"
 
 ; Function Attrs: convergent
 define void @Break_expressions_run_breaks(i32 noundef %"arguments[0].size") #0 {
@@ -1642,53 +1673,38 @@ attributes #0 = { convergent "no-trapping-math"="true" "stack-protector-buffer-s
     char const* const expected_llvm_ir = R"(
 %struct.Constant_array_expressions_My_struct = type { [4 x i32] }
 
+@array = private unnamed_addr constant [4 x i32] [i32 0, i32 1, i32 2, i32 3]
+@array.1 = private unnamed_addr constant [4 x i32] [i32 0, i32 2, i32 4, i32 6]
+
 ; Function Attrs: convergent
 define void @Constant_array_expressions_foo() #0 {
 entry:
   %a = alloca [0 x i32], align 4
   %b = alloca [0 x i32], align 4
-  %array = alloca [4 x i32], i64 4, align 4
   %c = alloca [4 x i32], align 4
   %d = alloca i32, align 4
   %instance = alloca %struct.Constant_array_expressions_My_struct, align 4
-  %array7 = alloca [4 x i32], i64 4, align 4
   %e = alloca i32, align 4
-  %array13 = alloca [8 x i32], i64 8, align 4
+  %array = alloca [8 x i32], i64 8, align 4
   %f = alloca [8 x i32], align 4
-  %array_element_pointer = getelementptr [4 x i32], ptr %array, i32 0, i32 0
+  %0 = load [4 x i32], ptr @array, align 4
+  store [4 x i32] %0, ptr %c, align 4
+  %array_element_pointer = getelementptr [4 x i32], ptr %c, i32 0, i32 0
   store i32 0, ptr %array_element_pointer, align 4
-  %array_element_pointer1 = getelementptr [4 x i32], ptr %array, i32 0, i32 1
+  %array_element_pointer1 = getelementptr [4 x i32], ptr %c, i32 0, i32 1
   store i32 1, ptr %array_element_pointer1, align 4
-  %array_element_pointer2 = getelementptr [4 x i32], ptr %array, i32 0, i32 2
-  store i32 2, ptr %array_element_pointer2, align 4
-  %array_element_pointer3 = getelementptr [4 x i32], ptr %array, i32 0, i32 3
-  store i32 3, ptr %array_element_pointer3, align 4
-  %0 = load [4 x i32], ptr %array, align 4
-  store [4 x i32] %0, ptr %c, align 4
-  %array_element_pointer4 = getelementptr [4 x i32], ptr %c, i32 0, i32 0
-  store i32 0, ptr %array_element_pointer4, align 4
-  %array_element_pointer5 = getelementptr [4 x i32], ptr %c, i32 0, i32 1
-  store i32 1, ptr %array_element_pointer5, align 4
-  %array_element_pointer6 = getelementptr [4 x i32], ptr %c, i32 0, i32 3
-  %1 = load i32, ptr %array_element_pointer6, align 4
+  %array_element_pointer2 = getelementptr [4 x i32], ptr %c, i32 0, i32 3
+  %1 = load i32, ptr %array_element_pointer2, align 4
   store i32 %1, ptr %d, align 4
-  %array_element_pointer8 = getelementptr [4 x i32], ptr %array7, i32 0, i32 0
-  store i32 0, ptr %array_element_pointer8, align 4
-  %array_element_pointer9 = getelementptr [4 x i32], ptr %array7, i32 0, i32 1
-  store i32 2, ptr %array_element_pointer9, align 4
-  %array_element_pointer10 = getelementptr [4 x i32], ptr %array7, i32 0, i32 2
-  store i32 4, ptr %array_element_pointer10, align 4
-  %array_element_pointer11 = getelementptr [4 x i32], ptr %array7, i32 0, i32 3
-  store i32 6, ptr %array_element_pointer11, align 4
-  %2 = load [4 x i32], ptr %array7, align 4
+  %2 = load [4 x i32], ptr @array.1, align 4
   %3 = getelementptr inbounds %struct.Constant_array_expressions_My_struct, ptr %instance, i32 0, i32 0
   store [4 x i32] %2, ptr %3, align 4
   %4 = getelementptr inbounds %struct.Constant_array_expressions_My_struct, ptr %instance, i32 0, i32 0
-  %array_element_pointer12 = getelementptr [4 x i32], ptr %4, i32 0, i32 0
-  %5 = load i32, ptr %array_element_pointer12, align 4
+  %array_element_pointer3 = getelementptr [4 x i32], ptr %4, i32 0, i32 0
+  %5 = load i32, ptr %array_element_pointer3, align 4
   store i32 %5, ptr %e, align 4
-  call void @llvm.memset.p0.i64(ptr align 4 %array13, i8 0, i64 32, i1 false)
-  %6 = load [8 x i32], ptr %array13, align 4
+  call void @llvm.memset.p0.i64(ptr align 4 %array, i8 0, i64 32, i1 false)
+  %6 = load [8 x i32], ptr %array, align 4
   store [8 x i32] %6, ptr %f, align 4
   ret void
 }
@@ -3108,7 +3124,7 @@ attributes #0 = { convergent "no-trapping-math"="true" "stack-protector-buffer-s
     };
 
     char const* const expected_llvm_ir = R"(
-@global_0 = internal constant [3 x i8] c"%d\00"
+@global_0 = private unnamed_addr constant [3 x i8] c"%d\00"
 
 ; Function Attrs: convergent
 define void @For_loop_expressions_run_for_loops() #0 {
@@ -3281,7 +3297,7 @@ attributes #0 = { convergent "no-trapping-math"="true" "stack-protector-buffer-s
     };
 
     char const* const expected_llvm_ir = R"(
-@global_0 = internal constant [13 x i8] c"Hello world!\00"
+@global_0 = private unnamed_addr constant [13 x i8] c"Hello world!\00"
 
 ; Function Attrs: convergent
 define i32 @hello_world_main() #0 {
@@ -3309,17 +3325,13 @@ attributes #0 = { convergent "no-trapping-math"="true" "stack-protector-buffer-s
     };
 
     char const* const expected_llvm_ir = R"(
-@global_0 = internal constant [4 x i8] c"%s\0A\00"
-@global_1 = internal constant [5 x i8] c"zero\00"
-@global_2 = internal constant [9 x i8] c"negative\00"
-@global_3 = internal constant [13 x i8] c"non-negative\00"
-@global_4 = internal constant [9 x i8] c"negative\00"
-@global_5 = internal constant [9 x i8] c"positive\00"
-@global_6 = internal constant [9 x i8] c"negative\00"
-@global_7 = internal constant [9 x i8] c"positive\00"
-@global_8 = internal constant [5 x i8] c"zero\00"
-@global_9 = internal constant [5 x i8] c"true\00"
-@global_10 = internal constant [6 x i8] c"false\00"
+@global_0 = private unnamed_addr constant [4 x i8] c"%s\0A\00"
+@global_1 = private unnamed_addr constant [5 x i8] c"zero\00"
+@global_2 = private unnamed_addr constant [9 x i8] c"negative\00"
+@global_3 = private unnamed_addr constant [13 x i8] c"non-negative\00"
+@global_4 = private unnamed_addr constant [9 x i8] c"positive\00"
+@global_5 = private unnamed_addr constant [5 x i8] c"true\00"
+@global_6 = private unnamed_addr constant [6 x i8] c"false\00"
 
 ; Function Attrs: convergent
 define void @If_expressions_run_ifs(i32 noundef %"arguments[0].value") #0 {
@@ -3354,7 +3366,7 @@ if_s2_after:                                      ; preds = %if_s1_else, %if_s0_
   br i1 %5, label %if_s0_then2, label %if_s1_else3
 
 if_s0_then2:                                      ; preds = %if_s2_after
-  call void @If_expressions_print_message(ptr noundef @global_4)
+  call void @If_expressions_print_message(ptr noundef @global_2)
   br label %if_s3_after
 
 if_s1_else3:                                      ; preds = %if_s2_after
@@ -3363,7 +3375,7 @@ if_s1_else3:                                      ; preds = %if_s2_after
   br i1 %7, label %if_s2_then, label %if_s3_after
 
 if_s2_then:                                       ; preds = %if_s1_else3
-  call void @If_expressions_print_message(ptr noundef @global_5)
+  call void @If_expressions_print_message(ptr noundef @global_4)
   br label %if_s3_after
 
 if_s3_after:                                      ; preds = %if_s2_then, %if_s1_else3, %if_s0_then2
@@ -3372,7 +3384,7 @@ if_s3_after:                                      ; preds = %if_s2_then, %if_s1_
   br i1 %9, label %if_s0_then4, label %if_s1_else5
 
 if_s0_then4:                                      ; preds = %if_s3_after
-  call void @If_expressions_print_message(ptr noundef @global_6)
+  call void @If_expressions_print_message(ptr noundef @global_2)
   br label %if_s4_after
 
 if_s1_else5:                                      ; preds = %if_s3_after
@@ -3381,11 +3393,11 @@ if_s1_else5:                                      ; preds = %if_s3_after
   br i1 %11, label %if_s2_then6, label %if_s3_else
 
 if_s2_then6:                                      ; preds = %if_s1_else5
-  call void @If_expressions_print_message(ptr noundef @global_7)
+  call void @If_expressions_print_message(ptr noundef @global_4)
   br label %if_s4_after
 
 if_s3_else:                                       ; preds = %if_s1_else5
-  call void @If_expressions_print_message(ptr noundef @global_8)
+  call void @If_expressions_print_message(ptr noundef @global_1)
   br label %if_s4_after
 
 if_s4_after:                                      ; preds = %if_s3_else, %if_s2_then6, %if_s0_then4
@@ -3395,7 +3407,7 @@ if_s4_after:                                      ; preds = %if_s3_else, %if_s2_
   br i1 %13, label %if_s0_then7, label %if_s1_after8
 
 if_s0_then7:                                      ; preds = %if_s4_after
-  call void @If_expressions_print_message(ptr noundef @global_9)
+  call void @If_expressions_print_message(ptr noundef @global_5)
   br label %if_s1_after8
 
 if_s1_after8:                                     ; preds = %if_s0_then7, %if_s4_after
@@ -3405,7 +3417,7 @@ if_s1_after8:                                     ; preds = %if_s0_then7, %if_s4
   br i1 %16, label %if_s0_then9, label %if_s1_after10
 
 if_s0_then9:                                      ; preds = %if_s1_after8
-  call void @If_expressions_print_message(ptr noundef @global_10)
+  call void @If_expressions_print_message(ptr noundef @global_6)
   br label %if_s1_after10
 
 if_s1_after10:                                    ; preds = %if_s0_then9, %if_s1_after8
@@ -3632,6 +3644,95 @@ attributes #1 = { nocallback nofree nounwind willreturn memory(argmem: write) }
   }
 
 
+  TEST_CASE("Compile Intrinsic Builtins", "[LLVM_IR]")
+  {
+    char const* const input_file = "intrinsic_builtins.hltxt";
+
+    std::pmr::unordered_map<std::pmr::string, std::filesystem::path> const module_name_to_file_path_map
+    {
+    };
+
+    char const* const expected_llvm_ir = R"(
+; Function Attrs: convergent
+define void @Intrinsic_builtins_run(ptr noundef %"arguments[0].data", i32 noundef %"arguments[1].value", i1 noundef zeroext %"arguments[2].flag") #0 {
+entry:
+  %data = alloca ptr, align 8
+  %value = alloca i32, align 4
+  %flag = alloca i8, align 1
+  %a = alloca i1, align 1
+  %b = alloca i32, align 4
+  %c = alloca ptr, align 8
+  %d = alloca i32, align 4
+  %e = alloca i32, align 4
+  %f = alloca i32, align 4
+  store ptr %"arguments[0].data", ptr %data, align 8
+  store i32 %"arguments[1].value", ptr %value, align 4
+  %0 = zext i1 %"arguments[2].flag" to i8
+  store i8 %0, ptr %flag, align 1
+  %1 = load ptr, ptr %data, align 8
+  call void @llvm.prefetch.p0(ptr %1, i32 0, i32 3, i32 1)
+  %2 = load i8, ptr %flag, align 1
+  %3 = trunc i8 %2 to i1
+  %4 = call i1 @llvm.expect.i1(i1 %3, i1 true)
+  store i1 %4, ptr %a, align 1
+  %5 = load i32, ptr %value, align 4
+  %6 = call i32 @llvm.expect.i32(i32 %5, i32 0)
+  store i32 %6, ptr %b, align 4
+  %7 = load i8, ptr %flag, align 1
+  %8 = trunc i8 %7 to i1
+  call void @llvm.assume(i1 %8)
+  %9 = load ptr, ptr %data, align 8
+  call void @llvm.assume(i1 true) [ "align"(ptr %9, i64 16) ]
+  store ptr %9, ptr %c, align 8
+  %10 = load i32, ptr %value, align 4
+  %11 = call i32 @llvm.ctpop.i32(i32 %10)
+  store i32 %11, ptr %d, align 4
+  %12 = load i32, ptr %value, align 4
+  %13 = call i32 @llvm.ctlz.i32(i32 %12, i1 false)
+  store i32 %13, ptr %e, align 4
+  %14 = load i32, ptr %value, align 4
+  %15 = call i32 @llvm.bswap.i32(i32 %14)
+  store i32 %15, ptr %f, align 4
+  ret void
+}
+
+; Function Attrs: convergent
+define void @Intrinsic_builtins_fail() #0 {
+entry:
+  unreachable
+}
+
+; Function Attrs: nocallback nofree nosync nounwind willreturn memory(argmem: readwrite, inaccessiblemem: readwrite)
+declare void @llvm.prefetch.p0(ptr nocapture readonly, i32 immarg, i32 immarg, i32) #1
+
+; Function Attrs: nocallback nofree nosync nounwind willreturn memory(none)
+declare i1 @llvm.expect.i1(i1, i1) #2
+
+; Function Attrs: nocallback nofree nosync nounwind willreturn memory(none)
+declare i32 @llvm.expect.i32(i32, i32) #2
+
+; Function Attrs: nocallback nofree nosync nounwind willreturn memory(inaccessiblemem: write)
+declare void @llvm.assume(i1 noundef) #3
+
+; Function Attrs: nocallback nofree nosync nounwind speculatable willreturn memory(none)
+declare i32 @llvm.ctpop.i32(i32) #4
+
+; Function Attrs: nocallback nofree nosync nounwind speculatable willreturn memory(none)
+declare i32 @llvm.ctlz.i32(i32, i1 immarg) #4
+
+; Function Attrs: nocallback nofree nosync nounwind speculatable willreturn memory(none)
+declare i32 @llvm.bswap.i32(i32) #4
+
+attributes #0 = { convergent "no-trapping-math"="true" "stack-protector-buffer-size"="0" "target-features"="+cx8,+mmx,+sse,+sse2,+x87" }
+attributes #1 = { nocallback nofree nosync nounwind willreturn memory(argmem: readwrite, inaccessiblemem: readwrite) }
+attributes #2 = { nocallback nofree nosync nounwind willreturn memory(none) }
+attributes #3 = { nocallback nofree nosync nounwind willreturn memory(inaccessiblemem: write) }
+attributes #4 = { nocallback nofree nosync nounwind speculatable willreturn memory(none) }
+)";
+
+    test_create_llvm_module(input_file, module_name_to_file_path_map, expected_llvm_ir);
+  }
+
   TEST_CASE("Compile Load Pointers", "[LLVM_IR]")
   {
     char const* const input_file = "load_pointers.hltxt";
@@ -4036,6 +4137,36 @@ entry:
   ret void
 }
 
+attributes #0 = { convergent "no-trapping-math"="true" "stack-protector-buffer-size"="0" "target-features"="+cx8,+mmx,+sse,+sse2,+x87" }
+)";
+
+    test_create_llvm_module(input_file, module_name_to_file_path_map, expected_llvm_ir);
+  }
+
+  TEST_CASE("Compile Packed Structs", "[LLVM_IR]")
+  {
+    char const* const input_file = "packed_structs.hltxt";
+
+    std::pmr::unordered_map<std::pmr::string, std::filesystem::path> const module_name_to_file_path_map
+    {
+    };
+
+    char const* const expected_llvm_ir = R"(
+%struct.Packed_structs_Packed = type <{ i8, i32 }>
+
+; Function Attrs: convergent
+define i32 @Packed_structs_get_b() #0 {
+entry:
+  %instance = alloca %struct.Packed_structs_Packed, align 1
+  %0 = getelementptr inbounds %struct.Packed_structs_Packed, ptr %instance, i32 0, i32 0
+  store i8 0, ptr %0, align 1
+  %1 = getelementptr inbounds %struct.Packed_structs_Packed, ptr %instance, i32 0, i32 1
+  store i32 0, ptr %1, align 1
+  %2 = getelementptr inbounds %struct.Packed_structs_Packed, ptr %instance, i32 0, i32 1
+  %3 = load i32, ptr %2, align 1
+  ret i32 %3
+}
+
 attributes #0 = { convergent "no-trapping-math"="true" "stack-protector-buffer-size"="0" "target-features"="+cx8,+mmx,+sse,+sse2,+x87" }
 )";
 
@@ -4133,6 +4264,149 @@ attributes #0 = { convergent "no-trapping-math"="true" "stack-protector-buffer-s
     test_create_llvm_module(input_file, module_name_to_file_path_map, expected_llvm_ir);
   }
 
+  TEST_CASE("Compile Profile Guided Optimization", "[LLVM_IR]")
+  {
+    std::filesystem::path const input_file_path = g_test_source_files_path / "profile_guided_optimization.hltxt";
+    std::optional<h::Module> const core_module = h::parser::parse_and_convert_to_module(input_file_path, {}, {});
+    REQUIRE(core_module.has_value());
+
+    std::pmr::unordered_map<std::pmr::string, std::filesystem::path> const module_name_to_file_path_map
+    {
+    };
+
+    std::filesystem::path const output_directory_path = g_tests_output_directory_path / "profile_guided_optimization";
+    std::filesystem::create_directories(output_directory_path);
+
+    // Instrumenting the function gives the hash and the number of counters that its profile must have:
+    std::string function_name;
+    std::uint64_t function_hash = 0;
+    std::uint64_t counter_count = 0;
+    {
+      h::compiler::Compilation_options const compilation_options
+      {
+        .target_triple = "x86_64-pc-linux-gnu",
+        .optimization_level = h::compiler::Optimization_level::O0,
+        .debug = false,
+        .pgo_options = { .mode = h::compiler::Pgo_mode::Instrument, .profile_path = output_directory_path },
+      };
+
+      h::compiler::LLVM_data llvm_data = h::compiler::initialize_llvm(compilation_options);
+      h::compiler::LLVM_module_data llvm_module_data = h::compiler::create_llvm_module(llvm_data, core_module.value(), module_name_to_file_path_map, compilation_options);
+
+      llvm::Function const* const function = llvm_module_data.module->getFunction("Profile_guided_optimization_choose");
+      REQUIRE(function != nullptr);
+      function_name = llvm::getPGOFuncName(*function);
+
+      for (llvm::GlobalVariable const& global_variable : llvm_module_data.module->globals())
+      {
+        if (global_variable.getName().starts_with("__profc_"))
+        {
+          counter_count = global_variable.getValueType()->getArrayNumElements();
+        }
+        else if (global_variable.getName().starts_with("__profd_"))
+        {
+          llvm::ConstantInt const* const hash = llvm::cast<llvm::ConstantInt>(global_variable.getInitializer()->getAggregateElement(1u));
+          function_hash = hash->getZExtValue();
+        }
+      }
+    }
+
+    // Each path through the branch has one counter:
+    REQUIRE(counter_count == 2);
+
+    std::filesystem::path const profile_file_path = output_directory_path / "default.profdata";
+    {
+      llvm::InstrProfWriter writer;
+      REQUIRE(!writer.mergeProfileKind(llvm::InstrProfKind::IRInstrumentation));
+
+      llvm::NamedInstrProfRecord record{function_name, function_hash, std::vector<std::uint64_t>{1000, 10}};
+      writer.addRecord(std::move(record), [](llvm::Error error) -> void { FAIL(llvm::toString(std::move(error))); });
+
+      std::error_code error_code;
+      llvm::raw_fd_ostream output_stream{profile_file_path.generic_string(), error_code, llvm::sys::fs::OF_None};
+      REQUIRE(!error_code);
+      REQUIRE(!writer.write(output_stream));
+    }
+
+    h::compiler::Compilation_options const compilation_options
+    {
+      .target_triple = "x86_64-pc-linux-gnu",
+      .optimization_level = h::compiler::Optimization_level::O0,
+      .debug = false,
+      .pgo_options = { .mode = h::compiler::Pgo_mode::Use, .profile_path = profile_file_path },
+    };
+
+    h::compiler::LLVM_data llvm_data = h::compiler::initialize_llvm(compilation_options);
+    h::compiler::LLVM_module_data llvm_module_data = h::compiler::create_llvm_module(llvm_data, core_module.value(), module_name_to_file_path_map, compilation_options);
+
+    llvm::Function const* const function = llvm_module_data.module->getFunction("Profile_guided_optimization_choose");
+    REQUIRE(function != nullptr);
+
+    std::optional<llvm::Function::ProfileCount> const entry_count = function->getEntryCount();
+    REQUIRE(entry_count.has_value());
+    CHECK(entry_count->getCount() == 1010);
+
+    llvm::BranchInst const* const branch = llvm::dyn_cast<llvm::BranchInst>(function->getEntryBlock().getTerminator());
+    REQUIRE(branch != nullptr);
+    REQUIRE(branch->isConditional());
+
+    llvm::SmallVector<std::uint32_t> branch_weights;
+    REQUIRE(llvm::extractBranchWeights(*branch, branch_weights));
+
+    // Which counter belongs to which path depends on where LLVM places the counters:
+    std::sort(branch_weights.begin(), branch_weights.end());
+    CHECK(branch_weights == llvm::SmallVector<std::uint32_t>{10, 1000});
+  }
+
+  TEST_CASE("Compile Pure Functions", "[LLVM_IR]")
+  {
+    char const* const input_file = "pure_functions.hltxt";
+
+    std::pmr::unordered_map<std::pmr::string, std::filesystem::path> const module_name_to_file_path_map
+    {
+    };
+
+    char const* const expected_llvm_ir = R"(
+%struct.Pure_functions_Big = type { i32, i32, i32, i32, i32 }
+
+; Function Attrs: convergent nounwind willreturn memory(read, argmem: readwrite)
+define void @Pure_functions_create_big(ptr dead_on_unwind noalias writable sret(%struct.Pure_functions_Big) align 4 %return.result) #0 {
+entry:
+  %0 = alloca %struct.Pure_functions_Big, align 4
+  %1 = getelementptr inbounds %struct.Pure_functions_Big, ptr %0, i32 0, i32 0
+  store i32 0, ptr %1, align 4
+  %2 = getelementptr inbounds %struct.Pure_functions_Big, ptr %0, i32 0, i32 1
+  store i32 0, ptr %2, align 4
+  %3 = getelementptr inbounds %struct.Pure_functions_Big, ptr %0, i32 0, i32 2
+  store i32 0, ptr %3, align 4
+  %4 = getelementptr inbounds %struct.Pure_functions_Big, ptr %0, i32 0, i32 3
+  store i32 0, ptr %4, align 4
+  %5 = getelementptr inbounds %struct.Pure_functions_Big, ptr %0, i32 0, i32 4
+  store i32 0, ptr %5, align 4
+  call void @llvm.memcpy.p0.p0.i64(ptr align 4 %return.result, ptr align 4 %0, i64 20, i1 false)
+  ret void
+}
+
+; Function Attrs: convergent nounwind willreturn memory(none)
+define i32 @Pure_functions_identity(i32 noundef %"arguments[0].value") #1 {
+entry:
+  %value = alloca i32, align 4
+  store i32 %"arguments[0].value", ptr %value, align 4
+  %0 = load i32, ptr %value, align 4
+  ret i32 %0
+}
+
+; Function Attrs: nocallback nofree nounwind willreturn memory(argmem: readwrite)
+declare void @llvm.memcpy.p0.p0.i64(ptr noalias nocapture writeonly, ptr noalias nocapture readonly, i64, i1 immarg) #2
+
+attributes #0 = { convergent nounwind willreturn memory(read, argmem: readwrite) "no-trapping-math"="true" "stack-protector-buffer-size"="0" "target-features"="+cx8,+mmx,+sse,+sse2,+x87" }
+attributes #1 = { convergent nounwind willreturn memory(none) "no-trapping-math"="true" "stack-protector-buffer-size"="0" "target-features"="+cx8,+mmx,+sse,+sse2,+x87" }
+attributes #2 = { nocallback nofree nounwind willreturn memory(argmem: readwrite) }
+)";
+
+    test_create_llvm_module(input_file, module_name_to_file_path_map, expected_llvm_ir);
+  }
+
   TEST_CASE("Compile Reinterpret_as", "[LLVM_IR]")
   {
     char const* const input_file = "reinterpret_as.hltxt";
@@ -4629,7 +4903,7 @@ attributes #0 = { convergent "no-trapping-math"="true" "stack-protector-buffer-s
     };
 
     char const* const expected_llvm_ir = R"(
-@global_0 = internal constant [24 x i8] c"Value: %d, pointer: %p\0A\00"
+@global_0 = private unnamed_addr constant [24 x i8] c"Value: %d, pointer: %p\0A\00"
 
 ; Function Attrs: convergent
 define void @Use_printf_run() #0 {
@@ -5374,6 +5648,70 @@ entry:
   ret i32 0
 }
 
+attributes #0 = { convergent "no-trapping-math"="true" "stack-protector-buffer-size"="0" "target-features"="+cx8,+mmx,+sse,+sse2,+x87" }
+)";
+
+    test_create_llvm_module(input_file, module_name_to_file_path_map, expected_llvm_ir);
+  }
+
+  TEST_CASE("Compile Vector Types", "[LLVM_IR]")
+  {
+    char const* const input_file = "vector_types.hltxt";
+
+    std::pmr::unordered_map<std::pmr::string, std::filesystem::path> const module_name_to_file_path_map
+    {
+    };
+
+    char const* const expected_llvm_ir = R"(
+%struct.H_Builtin_Generic_array_slice = type { ptr, i64 }
+
+; Function Attrs: convergent
+define void @Vector_types_add_and_shuffle(ptr %"arguments[0].values_0", i64 %"arguments[0].values_1", float noundef %"arguments[1].factor") #0 {
+entry:
+  %values = alloca %struct.H_Builtin_Generic_array_slice, align 8
+  %factor = alloca float, align 4
+  %a = alloca <4 x float>, align 16
+  %b = alloca <4 x float>, align 16
+  %sum = alloca <4 x float>, align 16
+  %scaled = alloca <4 x float>, align 16
+  %interleaved = alloca <4 x float>, align 16
+  %0 = getelementptr inbounds { ptr, i64 }, ptr %values, i32 0, i32 0
+  store ptr %"arguments[0].values_0", ptr %0, align 8
+  %1 = getelementptr inbounds { ptr, i64 }, ptr %values, i32 0, i32 1
+  store i64 %"arguments[0].values_1", ptr %1, align 8
+  store float %"arguments[1].factor", ptr %factor, align 4
+  %2 = load %struct.H_Builtin_Generic_array_slice, ptr %values, align 8
+  %3 = extractvalue %struct.H_Builtin_Generic_array_slice %2, 0
+  %array_slice_element_pointer = getelementptr float, ptr %3, i64 0
+  %4 = load <4 x float>, ptr %array_slice_element_pointer, align 4
+  store <4 x float> %4, ptr %a, align 16
+  %5 = load %struct.H_Builtin_Generic_array_slice, ptr %values, align 8
+  %6 = extractvalue %struct.H_Builtin_Generic_array_slice %5, 0
+  %array_slice_element_pointer1 = getelementptr float, ptr %6, i64 4
+  %7 = load <4 x float>, ptr %array_slice_element_pointer1, align 4
+  store <4 x float> %7, ptr %b, align 16
+  %8 = load <4 x float>, ptr %a, align 16
+  %9 = load <4 x float>, ptr %b, align 16
+  %10 = fadd <4 x float> %8, %9
+  store <4 x float> %10, ptr %sum, align 16
+  %11 = load <4 x float>, ptr %sum, align 16
+  %12 = load float, ptr %factor, align 4
+  %.splatinsert = insertelement <4 x float> poison, float %12, i64 0
+  %.splat = shufflevector <4 x float> %.splatinsert, <4 x float> poison, <4 x i32> zeroinitializer
+  %13 = fmul <4 x float> %11, %.splat
+  store <4 x float> %13, ptr %scaled, align 16
+  %14 = load <4 x float>, ptr %a, align 16
+  %15 = load <4 x float>, ptr %b, align 16
+  %16 = shufflevector <4 x float> %14, <4 x float> %15, <4 x i32> <i32 0, i32 4, i32 1, i32 5>
+  store <4 x float> %16, ptr %interleaved, align 16
+  %17 = load %struct.H_Builtin_Generic_array_slice, ptr %values, align 8
+  %18 = load <4 x float>, ptr %scaled, align 16
+  %19 = extractvalue %struct.H_Builtin_Generic_array_slice %17, 0
+  %array_slice_element_pointer2 = getelementptr float, ptr %19, i64 0
+  store <4 x float> %18, ptr %array_slice_element_pointer2, align 4
+  ret void
+}
+
 attributes #0 = { convergent "no-trapping-math"="true" "stack-protector-buffer-size"="0" "target-features"="+cx8,+mmx,+sse,+sse2,+x87" }
 )";
 
@@ -5390,7 +5728,7 @@ attributes #0 = { convergent "no-trapping-math"="true" "stack-protector-buffer-s
     };
 
     char const* const expected_llvm_ir = R"(
-@global_0 = internal constant [3 x i8] c"%d\00"
+@global_0 = private unnamed_addr constant [3 x i8] c"%d\00"
 
 ; Function Attrs: convergent
 define void @While_loop_expressions_run_while_loops(i32 noundef %"arguments[0].size") #0 {
@@ -5666,7 +6004,7 @@ std::filesystem::path const header_module_file_path = create_and_import_c_header
     h::compiler::Type_database type_database = h::compiler::create_type_database(*llvm_data.context);
     h::compiler::add_module_types(type_database, *llvm_data.context, llvm_data.data_layout, clang_module_data, *core_module);
 
-    h::Struct_layout const actual_struct_layout = h::compiler::calculate_struct_layout(llvm_data.data_layout, type_database, "my_module", "My_struct");
+    h::Struct_layout const actual_struct_layout = h::compiler::calculate_struct_layout(clang_module_data, "my_module", "My_struct");
 
     CHECK(actual_struct_layout == expected_struct_layout.value());
   }
@@ -6917,4 +7255,69 @@ attributes #1 = { nocallback nofree nounwind willreturn memory(argmem: readwrite
 
     test_c_interoperability_common("c_interoperability_function_with_small_struct.hltxt", "x86_64-pc-windows-msvc", expected_llvm_ir);
   }
+
+  static h::Module create_sort_test_module(
+    std::string_view const name,
+    std::initializer_list<std::string_view> const imports
+  )
+  {
+    h::Module core_module{};
+    core_module.name = name;
+    for (std::string_view const import_name : imports)
+      core_module.dependencies.alias_imports.push_back({ .module_name = std::pmr::string{import_name}, .alias = std::pmr::string{import_name} });
+    return core_module;
+  }
+
+  TEST_CASE("Sort core modules computes ranks", "[Sort_core_modules]")
+  {
+    std::pmr::vector<h::Module> const core_modules
+    {
+      create_sort_test_module("D", { "B", "C" }),
+      create_sort_test_module("B", { "A" }),
+      create_sort_test_module("A", {}),
+      create_sort_test_module("C", { "A", "C_header" }),
+    };
+
+    h::compiler::Sorted_core_modules const sorted = h::compiler::sort_core_modules_and_compute_ranks(core_modules, {}, {});
+
+    CHECK(sorted.diagnostics.empty());
+
+    std::pmr::vector<std::pmr::vector<std::size_t>> const expected_ranks
+    {
+      { 2 },
+      { 1, 3 },
+      { 0 },
+    };
+    CHECK(sorted.ranks == expected_ranks);
+
+    REQUIRE(sorted.sorted_core_modules.size() == 4);
+    CHECK(sorted.sorted_core_modules[0]->name == "A");
+    CHECK(sorted.sorted_core_modules[3]->name == "D");
+  }
+
+  TEST_CASE("Sort core modules reports import cycles", "[Sort_core_modules]")
+  {
+    std::pmr::vector<h::Module> const core_modules
+    {
+      create_sort_test_module("A", {}),
+      create_sort_test_module("B", { "C" }),
+      create_sort_test_module("C", { "B" }),
+      create_sort_test_module("D", { "Missing" }),
+    };
+
+    h::compiler::Sorted_core_modules const sorted = h::compiler::sort_core_modules_and_compute_ranks(core_modules, {}, {});
+
+    CHECK(sorted.sorted_core_modules.size() == 4);
+
+    std::pmr::vector<std::pmr::vector<std::size_t>> const expected_ranks
+    {
+      { 0, 3 },
+    };
+    CHECK(sorted.ranks == expected_ranks);
+
+    // Missing modules are left to validation:
+    REQUIRE(sorted.diagnostics.size() == 2);
+    CHECK(sorted.diagnostics[0].message == "Module 'B' imports module 'C' which is part of an import cycle.");
+    CHECK(sorted.diagnostics[1].message == "Module 'C' imports module 'B' which is part of an import cycle.");
+  }
 }
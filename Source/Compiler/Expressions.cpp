@@ -9,6 +9,7 @@ module;
 #include <llvm/IR/LLVMContext.h>
 
 #include <array>
+#include <cstdlib>
 #include <format>
 #include <functional>
 #include <memory_resource>
@@ -58,6 +59,7 @@ namespace h::compiler
             .declaration_database = parameters.declaration_database,
             .type_database = parameters.type_database,
             .enum_value_constants = parameters.enum_value_constants,
+            .read_only_globals = parameters.read_only_globals,
             .blocks = parameters.blocks,
             .defer_expressions_per_block = parameters.defer_expressions_per_block,
             .function_declaration = parameters.function_declaration,
@@ -71,13 +73,13 @@ namespace h::compiler
         };
     }
 
-    std::optional<Module const*> get_module(std::pmr::unordered_map<std::pmr::string, Module> const& core_module_dependencies, std::string_view const name)
+    std::optional<Module const*> get_module(std::pmr::unordered_map<std::pmr::string, Module const*> const& core_module_dependencies, std::string_view const name)
     {
         auto const location = core_module_dependencies.find(name.data());
         if (location == core_module_dependencies.end())
             return std::nullopt;
 
-        return &location->second;
+        return location->second;
     }
 
     std::optional<std::string_view> get_module_name_from_alias(Module const& module, std::string_view const alias_name)
@@ -275,7 +277,7 @@ namespace h::compiler
         return {};
     }
 
-    llvm::Constant* fold_constant(
+    static llvm::Constant* try_fold_constant(
         llvm::Value* const value,
         llvm::DataLayout const& llvm_data_layout
     )
@@ -284,20 +286,20 @@ namespace h::compiler
         {
             llvm::BinaryOperator* const binary_operator = static_cast<llvm::BinaryOperator*>(value);
 
-            llvm::Constant* const left_hand_side = fold_constant(binary_operator->getOperand(0), llvm_data_layout);
-            llvm::Constant* const right_hand_side = fold_constant(binary_operator->getOperand(1), llvm_data_layout);
+            llvm::Constant* const left_hand_side = try_fold_constant(binary_operator->getOperand(0), llvm_data_layout);
+            if (left_hand_side == nullptr)
+                return nullptr;
+
+            llvm::Constant* const right_hand_side = try_fold_constant(binary_operator->getOperand(1), llvm_data_layout);
+            if (right_hand_side == nullptr)
+                return nullptr;
 
-            llvm::Constant* const folded_constant = llvm::ConstantFoldBinaryOpOperands(
+            return llvm::ConstantFoldBinaryOpOperands(
                 binary_operator->getOpcode(),
                 left_hand_side,
                 right_hand_side,
                 llvm_data_layout
             );
-
-            if (folded_constant == nullptr)
-                throw std::runtime_error{ "Could not unfold binary operation constant!" };
-
-            return folded_constant;
         }
         else if (llvm::Constant::classof(value))
         {
@@ -305,10 +307,50 @@ namespace h::compiler
         }
         else
         {
-            throw std::runtime_error{ "Could not unfold constant!" };
+            return nullptr;
         }
     }
 
+    llvm::Constant* fold_constant(
+        llvm::Value* const value,
+        llvm::DataLayout const& llvm_data_layout
+    )
+    {
+        llvm::Constant* const folded_constant = try_fold_constant(value, llvm_data_layout);
+        if (folded_constant == nullptr)
+            throw std::runtime_error{ "Could not unfold constant!" };
+
+        return folded_constant;
+    }
+
+    // Read-only data is emitted once per module: LLVM uniques constants, so identical literals share the same initializer.
+    static llvm::GlobalVariable* get_or_create_read_only_global(
+        Read_only_globals& read_only_globals,
+        llvm::Module& llvm_module,
+        llvm::Constant* const initializer,
+        std::string_view const name
+    )
+    {
+        auto const location = read_only_globals.map.find(initializer);
+        if (location != read_only_globals.map.end())
+            return location->second;
+
+        bool const is_constant = true;
+        llvm::GlobalVariable* const global_variable = new llvm::GlobalVariable(
+            llvm_module,
+            initializer->getType(),
+            is_constant,
+            llvm::GlobalValue::PrivateLinkage,
+            initializer,
+            name
+        );
+        global_variable->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
+
+        read_only_globals.map.emplace(initializer, global_variable);
+
+        return global_variable;
+    }
+
     llvm::Constant* fold_statement_constant(
         Statement const& statement,
         Expression_parameters const& parameters
@@ -357,7 +399,7 @@ namespace h::compiler
         Value_and_type const& left_hand_side,
         Statement const& statement,
         Module const& core_module,
-        std::pmr::unordered_map<std::pmr::string, Module> const& core_module_dependencies
+        std::pmr::unordered_map<std::pmr::string, Module const*> const& core_module_dependencies
     )
     {
         if (left_hand_side.value == nullptr)
@@ -446,7 +488,8 @@ namespace h::compiler
             module_name,
             struct_declaration,
             type_instance,
-            parameters.type_database
+            parameters.type_database,
+            left_hand_side.alignment
         );
 
         return value;
@@ -509,7 +552,7 @@ namespace h::compiler
     )
     {
         Module const& core_module = parameters.core_module;
-        std::pmr::unordered_map<std::pmr::string, Module> const& core_module_dependencies = parameters.core_module_dependencies;
+        std::pmr::unordered_map<std::pmr::string, Module const*> const& core_module_dependencies = parameters.core_module_dependencies;
         llvm::Module& llvm_module = parameters.llvm_module;
         Declaration_database const& declaration_database = parameters.declaration_database;
         Enum_value_constants const& enum_value_constants = parameters.enum_value_constants;
@@ -762,6 +805,16 @@ namespace h::compiler
         if (!element_type.has_value())
             throw std::runtime_error{"Cannot find element type of array access."};
 
+        if (h::is_vector_type_reference(*left_hand_side_expression_value.type) && !left_hand_side_expression_value.value->getType()->isPointerTy())
+        {
+            return Value_and_type
+            {
+                .name = "",
+                .value = llvm_builder.CreateExtractElement(left_hand_side_expression_value.value, index_llvm_value),
+                .type = element_type
+            };
+        }
+
         if (h::is_array_slice_type_reference(*left_hand_side_expression_value.type))
         {
             llvm::Type* const array_slice_llvm_type = type_reference_to_llvm_type(llvm_context, llvm_data_layout, left_hand_side_expression_value.type.value(), type_database);
@@ -947,14 +1000,15 @@ namespace h::compiler
                             struct_declaration,
                             std::nullopt,
                             result,
-                            parameters.type_database
+                            parameters.type_database,
+                            access_left_hand_side.alignment
                         );
                     }
                 }
             }
         }
 
-        llvm::Value* store_instruction = create_store_instruction(llvm_builder, llvm_data_layout, result.value, left_hand_side.value);
+        llvm::Value* store_instruction = create_store_instruction(llvm_builder, llvm_data_layout, result.value, left_hand_side.value, left_hand_side.alignment);
 
         return
         {
@@ -989,6 +1043,58 @@ namespace h::compiler
         return first == second;
     }
 
+    // Vector operations are applied to each lane. A scalar operand is broadcast to all lanes.
+    static Value_and_type create_vector_binary_operation_instruction(
+        llvm::IRBuilder<>& llvm_builder,
+        Value_and_type const& left_hand_side,
+        Type_reference const& left_hand_side_type,
+        Value_and_type const& right_hand_side,
+        Type_reference const& right_hand_side_type,
+        Binary_operation const operation,
+        Declaration_database const& declaration_database
+    )
+    {
+        if (is_vector_type_reference(left_hand_side_type) && is_vector_type_reference(right_hand_side_type) && !are_types_compatible(declaration_database, left_hand_side_type, right_hand_side_type))
+            throw std::runtime_error{ "Left and right side vector types do not match!" };
+
+        Type_reference const& vector_type_reference = is_vector_type_reference(left_hand_side_type) ? left_hand_side_type : right_hand_side_type;
+        Vector_type const& vector_type = std::get<Vector_type>(vector_type_reference.data);
+        if (vector_type.element_type.empty())
+            throw std::runtime_error{ "Vector element type is empty!" };
+
+        Type_reference const& element_type = vector_type.element_type[0];
+
+        auto const get_lanes = [&](Value_and_type const& operand, Type_reference const& operand_type) -> Value_and_type
+        {
+            llvm::Value* const llvm_value =
+                is_vector_type_reference(operand_type) ?
+                operand.value :
+                llvm_builder.CreateVectorSplat(static_cast<unsigned>(vector_type.size), operand.value);
+
+            return Value_and_type
+            {
+                .name = operand.name,
+                .value = llvm_value,
+                .type = is_vector_type_reference(operand_type) ? element_type : operand_type
+            };
+        };
+
+        Value_and_type const result = create_binary_operation_instruction(
+            llvm_builder,
+            get_lanes(left_hand_side, left_hand_side_type),
+            get_lanes(right_hand_side, right_hand_side_type),
+            operation,
+            declaration_database
+        );
+
+        return Value_and_type
+        {
+            .name = "",
+            .value = result.value,
+            .type = create_vector_type_reference({result.type.value()}, vector_type.size)
+        };
+    }
+
     Value_and_type create_binary_operation_instruction(
         llvm::IRBuilder<>& llvm_builder,
         Value_and_type const& left_hand_side,
@@ -1000,6 +1106,16 @@ namespace h::compiler
         if (!left_hand_side.type.has_value() || !right_hand_side.type.has_value())
             throw std::runtime_error{ "Left or right side type is null!" };
 
+        {
+            std::optional<Type_reference> const underlying_left_hand_side_type = get_underlying_type(declaration_database, left_hand_side.type.value());
+            std::optional<Type_reference> const underlying_right_hand_side_type = get_underlying_type(declaration_database, right_hand_side.type.value());
+            Type_reference const& left_hand_side_type = underlying_left_hand_side_type.has_value() ? underlying_left_hand_side_type.value() : left_hand_side.type.value();
+            Type_reference const& right_hand_side_type = underlying_right_hand_side_type.has_value() ? underlying_right_hand_side_type.value() : right_hand_side.type.value();
+
+            if (is_vector_type_reference(left_hand_side_type) || is_vector_type_reference(right_hand_side_type))
+                return create_vector_binary_operation_instruction(llvm_builder, left_hand_side, left_hand_side_type, right_hand_side, right_hand_side_type, operation, declaration_database);
+        }
+
         if (!are_types_compatible(declaration_database, *left_hand_side.type, *right_hand_side.type))
             throw std::runtime_error{ "Left and right side types do not match!" };
 
@@ -1641,6 +1757,347 @@ namespace h::compiler
         );
     }
 
+    static llvm::Value* get_array_slice_element_pointer(
+        Value_and_type const& array_slice_value,
+        llvm::Value* const index_value,
+        Expression_parameters const& parameters
+    )
+    {
+        llvm::IRBuilder<>& llvm_builder = parameters.llvm_builder;
+
+        std::optional<Type_reference> const element_type = get_element_or_pointee_type(array_slice_value.type.value());
+        if (!element_type.has_value())
+            throw std::runtime_error{"Cannot find element type of array slice."};
+
+        llvm::Value* const data_pointer = [&]() -> llvm::Value*
+        {
+            if (array_slice_value.value->getType()->isStructTy())
+                return llvm_builder.CreateExtractValue(array_slice_value.value, {0});
+
+            llvm::Type* const array_slice_llvm_type = type_reference_to_llvm_type(parameters.llvm_context, parameters.llvm_data_layout, array_slice_value.type.value(), parameters.type_database);
+            llvm::Value* const pointer_to_data_pointer = llvm_builder.CreateStructGEP(array_slice_llvm_type, array_slice_value.value, 0);
+            return create_load_instruction(llvm_builder, parameters.llvm_data_layout, llvm::PointerType::get(parameters.llvm_context, 0), pointer_to_data_pointer);
+        }();
+
+        llvm::Type* const element_llvm_type = type_reference_to_llvm_type(parameters.llvm_context, parameters.llvm_data_layout, element_type.value(), parameters.type_database);
+
+        return llvm_builder.CreateGEP(
+            element_llvm_type,
+            data_pointer,
+            llvm::ArrayRef<llvm::Value*>{index_value},
+            "array_slice_element_pointer"
+        );
+    }
+
+    // Slices only guarantee the alignment of their elements, so vectors are loaded and stored with that alignment.
+    static llvm::Align get_vector_element_alignment(
+        Type_reference const& vector_type,
+        Expression_parameters const& parameters
+    )
+    {
+        std::optional<Type_reference> const element_type = get_element_or_pointee_type(vector_type);
+        if (!element_type.has_value())
+            throw std::runtime_error{"Cannot find element type of vector."};
+
+        llvm::Type* const element_llvm_type = type_reference_to_llvm_type(parameters.llvm_context, parameters.llvm_data_layout, element_type.value(), parameters.type_database);
+        return parameters.llvm_data_layout.getABITypeAlign(element_llvm_type);
+    }
+
+    static Value_and_type create_vector_load(
+        Call_expression const& call_expression,
+        h::Instance_call_expression const& instance_call_expression,
+        Statement const& statement,
+        Expression_parameters const& parameters
+    )
+    {
+        if (call_expression.arguments.size() != 2 || instance_call_expression.arguments.size() != 2)
+            throw std::runtime_error{"vector_load::<Element_type, Lane_count>() expects two arguments!"};
+
+        Value_and_type const element_type_value = create_statement_value(instance_call_expression.arguments[0], parameters);
+
+        h::Statement const& lane_count_argument = instance_call_expression.arguments[1];
+        if (lane_count_argument.expressions.empty() || !std::holds_alternative<h::Constant_expression>(lane_count_argument.expressions[0].data))
+            throw std::runtime_error{"vector_load() lane count must be a constant!"};
+
+        std::uint64_t const lane_count = std::strtoull(std::get<h::Constant_expression>(lane_count_argument.expressions[0].data).data.c_str(), nullptr, 10);
+        Type_reference const vector_type = create_vector_type_reference({element_type_value.type.value()}, lane_count);
+
+        Value_and_type const array_slice_value = create_loaded_expression_value(call_expression.arguments[0].expression_index, statement, parameters);
+        Value_and_type const index_value = create_loaded_expression_value(call_expression.arguments[1].expression_index, statement, parameters);
+
+        llvm::Value* const element_pointer = get_array_slice_element_pointer(array_slice_value, index_value.value, parameters);
+        llvm::Type* const vector_llvm_type = type_reference_to_llvm_type(parameters.llvm_context, parameters.llvm_data_layout, vector_type, parameters.type_database);
+
+        return Value_and_type
+        {
+            .name = "",
+            .value = parameters.llvm_builder.CreateAlignedLoad(vector_llvm_type, element_pointer, get_vector_element_alignment(vector_type, parameters)),
+            .type = vector_type
+        };
+    }
+
+    static Value_and_type create_vector_store(
+        Call_expression const& call_expression,
+        Statement const& statement,
+        Expression_parameters const& parameters
+    )
+    {
+        if (call_expression.arguments.size() != 3)
+            throw std::runtime_error{"vector_store() expects three arguments!"};
+
+        Value_and_type const array_slice_value = create_loaded_expression_value(call_expression.arguments[0].expression_index, statement, parameters);
+        Value_and_type const index_value = create_loaded_expression_value(call_expression.arguments[1].expression_index, statement, parameters);
+        Value_and_type const vector_value = create_loaded_expression_value(call_expression.arguments[2].expression_index, statement, parameters);
+
+        llvm::Value* const element_pointer = get_array_slice_element_pointer(array_slice_value, index_value.value, parameters);
+        parameters.llvm_builder.CreateAlignedStore(vector_value.value, element_pointer, get_vector_element_alignment(vector_value.type.value(), parameters));
+
+        return Value_and_type
+        {
+            .name = "",
+            .value = nullptr,
+            .type = std::nullopt
+        };
+    }
+
+    static Value_and_type create_vector_shuffle(
+        Call_expression const& call_expression,
+        Statement const& statement,
+        Expression_parameters const& parameters
+    )
+    {
+        if (call_expression.arguments.size() != 3)
+            throw std::runtime_error{"vector_shuffle() expects three arguments!"};
+
+        Value_and_type const first_value = create_loaded_expression_value(call_expression.arguments[0].expression_index, statement, parameters);
+        Value_and_type const second_value = create_loaded_expression_value(call_expression.arguments[1].expression_index, statement, parameters);
+
+        h::Expression const& mask_expression = statement.expressions[call_expression.arguments[2].expression_index];
+        if (!std::holds_alternative<h::Constant_array_expression>(mask_expression.data))
+            throw std::runtime_error{"vector_shuffle() mask must be a constant array!"};
+
+        h::Constant_array_expression const& mask_array = std::get<h::Constant_array_expression>(mask_expression.data);
+
+        std::pmr::vector<int> mask{parameters.temporaries_allocator};
+        mask.reserve(mask_array.array_data.size());
+
+        for (h::Statement const& lane_statement : mask_array.array_data)
+        {
+            if (lane_statement.expressions.empty() || !std::holds_alternative<h::Constant_expression>(lane_statement.expressions[0].data))
+                throw std::runtime_error{"vector_shuffle() mask must only contain constants!"};
+
+            h::Constant_expression const& lane = std::get<h::Constant_expression>(lane_statement.expressions[0].data);
+            mask.push_back(static_cast<int>(std::strtol(lane.data.c_str(), nullptr, 10)));
+        }
+
+        std::optional<Type_reference> const element_type = get_element_or_pointee_type(first_value.type.value());
+
+        return Value_and_type
+        {
+            .name = "",
+            .value = parameters.llvm_builder.CreateShuffleVector(first_value.value, second_value.value, mask),
+            .type = create_vector_type_reference({element_type.value()}, mask.size())
+        };
+    }
+
+    static Value_and_type create_expect_value(
+        Call_expression const& call_expression,
+        std::string_view const builtin_name,
+        Statement const& statement,
+        Expression_parameters const& parameters
+    )
+    {
+        llvm::LLVMContext& llvm_context = parameters.llvm_context;
+        llvm::IRBuilder<>& llvm_builder = parameters.llvm_builder;
+
+        std::size_t const expected_argument_count = builtin_name == "expect" ? 2 : 1;
+        if (call_expression.arguments.size() != expected_argument_count)
+            throw std::runtime_error{std::format("{}() expects {} arguments!", builtin_name, expected_argument_count)};
+
+        Value_and_type const value = create_loaded_expression_value(call_expression.arguments[0].expression_index, statement, parameters);
+        bool const is_boolean = builtin_name != "expect" || (value.type.has_value() && (is_bool(value.type.value()) || is_c_bool(value.type.value())));
+
+        llvm::Value* const llvm_value = is_boolean ? convert_to_boolean(llvm_context, llvm_builder, value.value, value.type) : value.value;
+
+        llvm::Value* const llvm_expected_value = [&]() -> llvm::Value*
+        {
+            if (builtin_name == "likely")
+                return llvm_builder.getTrue();
+            else if (builtin_name == "unlikely")
+                return llvm_builder.getFalse();
+
+            Value_and_type const expected_value = create_loaded_expression_value(call_expression.arguments[1].expression_index, statement, parameters);
+            return is_boolean ? convert_to_boolean(llvm_context, llvm_builder, expected_value.value, expected_value.type) : expected_value.value;
+        }();
+
+        llvm::Function* const expect_function = llvm::Intrinsic::getDeclaration(&parameters.llvm_module, llvm::Intrinsic::expect, {llvm_value->getType()});
+
+        return Value_and_type
+        {
+            .name = "",
+            .value = llvm_builder.CreateCall(expect_function, {llvm_value, llvm_expected_value}),
+            .type = is_boolean ? create_bool_type_reference() : value.type
+        };
+    }
+
+    static Value_and_type create_prefetch_value(
+        Call_expression const& call_expression,
+        Statement const& statement,
+        Expression_parameters const& parameters
+    )
+    {
+        if (call_expression.arguments.size() != 3)
+            throw std::runtime_error{"prefetch() expects three arguments!"};
+
+        h::Expression const& is_write_expression = statement.expressions[call_expression.arguments[1].expression_index];
+        h::Expression const& locality_expression = statement.expressions[call_expression.arguments[2].expression_index];
+        if (!std::holds_alternative<h::Constant_expression>(is_write_expression.data) || !std::holds_alternative<h::Constant_expression>(locality_expression.data))
+            throw std::runtime_error{"prefetch() is_write and locality must be constants!"};
+
+        bool const is_write = std::get<h::Constant_expression>(is_write_expression.data).data == "true";
+        std::uint64_t const locality = std::strtoull(std::get<h::Constant_expression>(locality_expression.data).data.c_str(), nullptr, 10);
+
+        Value_and_type const address_value = create_loaded_expression_value(call_expression.arguments[0].expression_index, statement, parameters);
+
+        llvm::IRBuilder<>& llvm_builder = parameters.llvm_builder;
+        llvm::Function* const prefetch_function = llvm::Intrinsic::getDeclaration(&parameters.llvm_module, llvm::Intrinsic::prefetch, {address_value.value->getType()});
+
+        // The last argument selects the data cache:
+        llvm_builder.CreateCall(prefetch_function, {address_value.value, llvm_builder.getInt32(is_write ? 1 : 0), llvm_builder.getInt32(locality), llvm_builder.getInt32(1)});
+
+        return Value_and_type
+        {
+            .name = "",
+            .value = nullptr,
+            .type = std::nullopt
+        };
+    }
+
+    static Value_and_type create_assume_value(
+        Call_expression const& call_expression,
+        Statement const& statement,
+        Expression_parameters const& parameters
+    )
+    {
+        if (call_expression.arguments.size() != 1)
+            throw std::runtime_error{"assume() expects one argument!"};
+
+        Value_and_type const condition_value = create_loaded_expression_value(call_expression.arguments[0].expression_index, statement, parameters);
+        llvm::Value* const condition_converted_value = convert_to_boolean(parameters.llvm_context, parameters.llvm_builder, condition_value.value, condition_value.type);
+
+        parameters.llvm_builder.CreateAssumption(condition_converted_value);
+
+        return Value_and_type
+        {
+            .name = "",
+            .value = nullptr,
+            .type = std::nullopt
+        };
+    }
+
+    static Value_and_type create_unreachable_value(
+        Expression_parameters const& parameters
+    )
+    {
+        llvm::IRBuilder<>& llvm_builder = parameters.llvm_builder;
+        llvm_builder.CreateUnreachable();
+
+        // Statements that follow are dead, but they still need a block to be emitted into:
+        llvm::BasicBlock* const after_block = llvm::BasicBlock::Create(parameters.llvm_context, "after_unreachable", parameters.llvm_parent_function);
+        llvm_builder.SetInsertPoint(after_block);
+
+        return Value_and_type
+        {
+            .name = "",
+            .value = nullptr,
+            .type = std::nullopt
+        };
+    }
+
+    static Value_and_type create_assume_aligned_value(
+        Call_expression const& call_expression,
+        Statement const& statement,
+        Expression_parameters const& parameters
+    )
+    {
+        if (call_expression.arguments.size() != 2)
+            throw std::runtime_error{"assume_aligned() expects two arguments!"};
+
+        h::Expression const& alignment_expression = statement.expressions[call_expression.arguments[1].expression_index];
+        if (!std::holds_alternative<h::Constant_expression>(alignment_expression.data))
+            throw std::runtime_error{"assume_aligned() alignment must be a constant!"};
+
+        std::uint64_t const alignment = std::strtoull(std::get<h::Constant_expression>(alignment_expression.data).data.c_str(), nullptr, 10);
+
+        Value_and_type const pointer_value = create_loaded_expression_value(call_expression.arguments[0].expression_index, statement, parameters);
+        parameters.llvm_builder.CreateAlignmentAssumption(parameters.llvm_data_layout, pointer_value.value, static_cast<unsigned>(alignment));
+
+        return Value_and_type
+        {
+            .name = "",
+            .value = pointer_value.value,
+            .type = pointer_value.type
+        };
+    }
+
+    static Value_and_type create_bit_manipulation_value(
+        Call_expression const& call_expression,
+        std::string_view const builtin_name,
+        Statement const& statement,
+        Expression_parameters const& parameters
+    )
+    {
+        if (call_expression.arguments.size() != 1)
+            throw std::runtime_error{std::format("{}() expects one argument!", builtin_name)};
+
+        Value_and_type const value = create_loaded_expression_value(call_expression.arguments[0].expression_index, statement, parameters);
+
+        llvm::IRBuilder<>& llvm_builder = parameters.llvm_builder;
+        llvm::Type* const llvm_type = value.value->getType();
+
+        llvm::Value* const result = [&]() -> llvm::Value*
+        {
+            if (builtin_name == "population_count")
+            {
+                llvm::Function* const function = llvm::Intrinsic::getDeclaration(&parameters.llvm_module, llvm::Intrinsic::ctpop, {llvm_type});
+                return llvm_builder.CreateCall(function, {value.value});
+            }
+            else if (builtin_name == "count_leading_zeros")
+            {
+                // A zero input is defined and returns the number of bits:
+                llvm::Function* const function = llvm::Intrinsic::getDeclaration(&parameters.llvm_module, llvm::Intrinsic::ctlz, {llvm_type});
+                return llvm_builder.CreateCall(function, {value.value, llvm_builder.getFalse()});
+            }
+            else
+            {
+                llvm::Function* const function = llvm::Intrinsic::getDeclaration(&parameters.llvm_module, llvm::Intrinsic::bswap, {llvm_type});
+                return llvm_builder.CreateCall(function, {value.value});
+            }
+        }();
+
+        return Value_and_type
+        {
+            .name = "",
+            .value = result,
+            .type = value.type
+        };
+    }
+
+    // Like in analysis, variables and declarations of the module take precedence over builtins with the same name:
+    static bool is_builtin_function_call(
+        std::string_view const name,
+        Expression_parameters const& parameters
+    )
+    {
+        if (!is_builtin_function_name(name))
+            return false;
+
+        if (search_in_function_scope(name, parameters.function_arguments, parameters.local_variables).has_value())
+            return false;
+
+        return !find_declaration(parameters.declaration_database, parameters.core_module.name, name).has_value();
+    }
+
     std::optional<Value_and_type> create_builtin_call_expression_value(
         Call_expression const& expression,
         Statement const& statement,
@@ -1657,6 +2114,8 @@ namespace h::compiler
             if (std::holds_alternative<h::Variable_expression>(instance_call_left_expression.data))
             {
                 h::Variable_expression const& variable_expression = std::get<h::Variable_expression>(instance_call_left_expression.data);
+                if (!is_builtin_function_call(variable_expression.name, parameters))
+                    return std::nullopt;
                 
                 if (variable_expression.name == "create_stack_array_uninitialized")
                 {
@@ -1679,11 +2138,22 @@ namespace h::compiler
                         .type = destination_type_value.type
                     };
                 }
+                else if (variable_expression.name == "vector_load")
+                {
+                    return create_vector_load(
+                        expression,
+                        instance_call_expression,
+                        statement,
+                        parameters
+                    );
+                }
             }
         }
         else if (std::holds_alternative<h::Variable_expression>(left_hand_side.data))
         {
             h::Variable_expression const& variable_expression = std::get<h::Variable_expression>(left_hand_side.data);
+            if (!is_builtin_function_call(variable_expression.name, parameters))
+                return std::nullopt;
             
             if (variable_expression.name == "create_array_slice_from_pointer")
             {
@@ -1746,6 +2216,38 @@ namespace h::compiler
                     .type = pointer_value.type
                 };
             }
+            else if (variable_expression.name == "vector_shuffle")
+            {
+                return create_vector_shuffle(expression, statement, parameters);
+            }
+            else if (variable_expression.name == "vector_store")
+            {
+                return create_vector_store(expression, statement, parameters);
+            }
+            else if (variable_expression.name == "expect" || variable_expression.name == "likely" || variable_expression.name == "unlikely")
+            {
+                return create_expect_value(expression, variable_expression.name, statement, parameters);
+            }
+            else if (variable_expression.name == "prefetch")
+            {
+                return create_prefetch_value(expression, statement, parameters);
+            }
+            else if (variable_expression.name == "assume")
+            {
+                return create_assume_value(expression, statement, parameters);
+            }
+            else if (variable_expression.name == "unreachable")
+            {
+                return create_unreachable_value(parameters);
+            }
+            else if (variable_expression.name == "assume_aligned")
+            {
+                return create_assume_aligned_value(expression, statement, parameters);
+            }
+            else if (variable_expression.name == "population_count" || variable_expression.name == "count_leading_zeros" || variable_expression.name == "byte_swap")
+            {
+                return create_bit_manipulation_value(expression, variable_expression.name, statement, parameters);
+            }
         }
 
         return std::nullopt;
@@ -2011,6 +2513,7 @@ namespace h::compiler
         llvm::LLVMContext& llvm_context,
         llvm::DataLayout const& llvm_data_layout,
         llvm::Module& llvm_module,
+        Read_only_globals& read_only_globals,
         Module const& core_module,
         Declaration_database const& declaration_database,
         Type_database const& type_database
@@ -2146,18 +2649,13 @@ namespace h::compiler
             std::pmr::string const& string_data = expression.data;
             std::pmr::string const final_string = replace_string_literal_special_values(string_data);
 
-            std::uint64_t const null_terminator_size = 1;
-            std::uint64_t const array_size = final_string.size() + null_terminator_size;
-            llvm::ArrayType* const array_type = llvm::ArrayType::get(llvm::IntegerType::get(llvm_context, 8), array_size);
+            llvm::Constant* const string_constant = llvm::ConstantDataArray::getString(llvm_context, final_string.c_str());
 
-            bool const is_constant = true;
             std::string const global_variable_name = std::format("global_{}", llvm_module.global_size());
-            llvm::GlobalVariable* const global_variable = new llvm::GlobalVariable(
+            llvm::GlobalVariable* const global_variable = get_or_create_read_only_global(
+                read_only_globals,
                 llvm_module,
-                array_type,
-                is_constant,
-                llvm::GlobalValue::InternalLinkage,
-                llvm::ConstantDataArray::getString(llvm_context, final_string.c_str()),
+                string_constant,
                 global_variable_name
             );
 
@@ -2174,6 +2672,26 @@ namespace h::compiler
         throw std::runtime_error{ "Constant expression not handled!" };
     }
 
+    static std::optional<std::pmr::vector<llvm::Constant*>> fold_constant_array_elements(
+        std::span<Value_and_type const> const array_data_values,
+        llvm::DataLayout const& llvm_data_layout
+    )
+    {
+        std::pmr::vector<llvm::Constant*> constant_elements;
+        constant_elements.reserve(array_data_values.size());
+
+        for (Value_and_type const& array_data_value : array_data_values)
+        {
+            llvm::Constant* const constant_element = try_fold_constant(array_data_value.value, llvm_data_layout);
+            if (constant_element == nullptr)
+                return std::nullopt;
+
+            constant_elements.push_back(constant_element);
+        }
+
+        return constant_elements;
+    }
+
     Value_and_type create_constant_array_expression_value(
         Constant_array_expression const& expression,
         Statement const& statement,
@@ -2265,6 +2783,67 @@ namespace h::compiler
         llvm::ArrayType* const array_type = llvm::ArrayType::get(llvm_element_type, array_length);
         llvm::ConstantInt* const array_length_constant = llvm::ConstantInt::get(llvm::Type::getInt64Ty(llvm_context), array_length);
 
+        std::optional<std::pmr::vector<llvm::Constant*>> const constant_elements = fold_constant_array_elements(array_data_values, llvm_data_layout);
+        if (constant_elements.has_value())
+        {
+            llvm::Constant* const constant_array = llvm::ConstantArray::get(array_type, constant_elements.value());
+
+            if (parameters.llvm_parent_function == nullptr)
+            {
+                return Value_and_type
+                {
+                    .name = "",
+                    .value = constant_array,
+                    .type = create_constant_array_type_reference({element_type}, array_length),
+                };
+            }
+
+            llvm::GlobalVariable* const read_only_array = get_or_create_read_only_global(
+                parameters.read_only_globals,
+                parameters.llvm_module,
+                constant_array,
+                "array"
+            );
+
+            bool const is_taken_as_mutable =
+                parameters.expression_type.has_value() &&
+                std::holds_alternative<Array_slice_type>(parameters.expression_type->data) &&
+                std::get<Array_slice_type>(parameters.expression_type->data).is_mutable;
+
+            if (!is_taken_as_mutable)
+            {
+                Value_and_type const constant_array_value
+                {
+                    .name = "",
+                    .value = read_only_array,
+                    .type = create_constant_array_type_reference({element_type}, array_length),
+                };
+
+                return convert_to_expected_type_if_needed(
+                    constant_array_value,
+                    parameters
+                );
+            }
+
+            std::uint64_t const array_alloc_size_in_bytes = llvm_data_layout.getTypeAllocSize(array_type);
+            llvm::Align const alignment = llvm_data_layout.getABITypeAlign(array_type);
+
+            llvm::AllocaInst* const array_alloca = create_alloca_instruction(llvm_builder, llvm_data_layout, *parameters.llvm_parent_function, array_type, "array", array_length_constant);
+            create_memcpy_call(llvm_context, llvm_builder, parameters.llvm_module, array_alloca, read_only_array, array_alloc_size_in_bytes, alignment);
+
+            Value_and_type const constant_array_value
+            {
+                .name = "",
+                .value = array_alloca,
+                .type = create_constant_array_type_reference({element_type}, array_length),
+            };
+
+            return convert_to_expected_type_if_needed(
+                constant_array_value,
+                parameters
+            );
+        }
+
         llvm::AllocaInst* const array_alloca = create_alloca_instruction(llvm_builder, llvm_data_layout, *parameters.llvm_parent_function, array_type, "array", array_length_constant);
 
         for (std::uint64_t index = 0; index < array_length; ++index)
@@ -2386,7 +2965,11 @@ namespace h::compiler
                     else if (std::holds_alternative<Type_instance>(value_type.value().data))
                     {
                         Type_instance const& type_instance = std::get<Type_instance>(value_type.value().data);
-                        Declaration_instance_storage const& storage = parameters.declaration_database.instances.at(type_instance);
+                        Declaration_instance_storage const* const storage_pointer = find_type_instance_storage(parameters.declaration_database, type_instance);
+                        if (storage_pointer == nullptr)
+                            throw std::runtime_error{ std::format("Could not find type instance of '{}'.", type_instance.type_constructor.name) };
+
+                        Declaration_instance_storage const& storage = *storage_pointer;
                         
                         if (std::holds_alternative<Struct_declaration>(storage.data))
                         {
@@ -2530,7 +3113,7 @@ namespace h::compiler
             Value_and_type const step_by_value =
                 expression.step_by.has_value() ?
                 create_loaded_expression_value(expression.step_by.value().expression_index, statement, parameters) :
-                create_constant_expression_value(default_step_constant, llvm_context, llvm_data_layout, llvm_module, core_module, parameters.declaration_database, type_database);
+                create_constant_expression_value(default_step_constant, llvm_context, llvm_data_layout, llvm_module, parameters.read_only_globals, core_module, parameters.declaration_database, type_database);
 
             if (parameters.debug_info != nullptr)
                 set_debug_location(parameters.llvm_builder, *parameters.debug_info, parameters.source_position->line, parameters.source_position->column);
@@ -2707,6 +3290,7 @@ namespace h::compiler
         llvm::Type* const llvm_struct_type = type_reference_to_llvm_type(llvm_context, llvm_data_layout, struct_type_reference, type_database);
 
         llvm::AllocaInst* const struct_alloca = create_alloca_instruction(llvm_builder, llvm_data_layout, *parameters.llvm_parent_function, llvm_struct_type);
+        struct_alloca->setAlignment(get_type_alignment(llvm_data_layout, type_database, llvm_struct_type));
 
         if (expression.type == Instantiate_expression_type::Default)
         {
@@ -2742,7 +3326,7 @@ namespace h::compiler
                     h::Module const& struct_core_module =
                         module_name == parameters.core_module.name ?
                         parameters.core_module :
-                        parameters.core_module_dependencies.at(module_name.data());
+                        *parameters.core_module_dependencies.at(module_name.data());
                     Expression_parameters new_parameters = set_core_module(parameters, struct_core_module);
                     new_parameters.expression_type = member_type;
 
@@ -3124,6 +3708,90 @@ namespace h::compiler
         }
     }
 
+    static llvm::Attribute get_call_parameter_attribute(
+        llvm::CallInst const& llvm_call_instruction,
+        unsigned const parameter_index,
+        llvm::Attribute::AttrKind const attribute_kind
+    )
+    {
+        llvm::Attribute const call_attribute = llvm_call_instruction.getParamAttr(parameter_index, attribute_kind);
+        if (call_attribute.isValid())
+            return call_attribute;
+
+        llvm::Function const* const llvm_called_function = llvm_call_instruction.getCalledFunction();
+        if (llvm_called_function == nullptr)
+            return {};
+
+        return llvm_called_function->getParamAttribute(parameter_index, attribute_kind);
+    }
+
+    static bool has_same_abi_parameter_attributes(
+        llvm::CallInst const& llvm_call_instruction,
+        llvm::Function const& llvm_parent_function
+    )
+    {
+        static constexpr std::array<llvm::Attribute::AttrKind, 10> abi_attribute_kinds
+        {
+            llvm::Attribute::StructRet,
+            llvm::Attribute::ByVal,
+            llvm::Attribute::ByRef,
+            llvm::Attribute::InAlloca,
+            llvm::Attribute::Preallocated,
+            llvm::Attribute::InReg,
+            llvm::Attribute::StackAlignment,
+            llvm::Attribute::SwiftSelf,
+            llvm::Attribute::SwiftAsync,
+            llvm::Attribute::SwiftError,
+        };
+
+        for (unsigned parameter_index = 0; parameter_index < llvm_parent_function.arg_size(); ++parameter_index)
+        {
+            for (llvm::Attribute::AttrKind const attribute_kind : abi_attribute_kinds)
+            {
+                llvm::Attribute const call_attribute = get_call_parameter_attribute(llvm_call_instruction, parameter_index, attribute_kind);
+                llvm::Attribute const function_attribute = llvm_parent_function.getParamAttribute(parameter_index, attribute_kind);
+                if (call_attribute != function_attribute)
+                    return false;
+            }
+
+            bool const is_passed_in_memory =
+                llvm_parent_function.hasParamAttribute(parameter_index, llvm::Attribute::ByVal) ||
+                llvm_parent_function.hasParamAttribute(parameter_index, llvm::Attribute::ByRef);
+
+            if (is_passed_in_memory && get_call_parameter_attribute(llvm_call_instruction, parameter_index, llvm::Attribute::Alignment) != llvm_parent_function.getParamAttribute(parameter_index, llvm::Attribute::Alignment))
+                return false;
+        }
+
+        return true;
+    }
+
+    // A call can only be marked musttail if the return immediately follows it and both functions have the same signature, calling convention and ABI parameter attributes.
+    static void set_returned_call_as_tail_call(
+        llvm::Value* const return_instruction,
+        llvm::Function const& llvm_parent_function
+    )
+    {
+        llvm::ReturnInst* const llvm_return_instruction = llvm::dyn_cast_or_null<llvm::ReturnInst>(return_instruction);
+        if (llvm_return_instruction == nullptr)
+            return;
+
+        llvm::CallInst* const llvm_call_instruction = llvm::dyn_cast_or_null<llvm::CallInst>(llvm_return_instruction->getPrevNode());
+        if (llvm_call_instruction == nullptr)
+            return;
+
+        llvm::Value* const returned_value = llvm_return_instruction->getReturnValue();
+        bool const returns_call_result = returned_value != nullptr ? returned_value == llvm_call_instruction : llvm_call_instruction->getType()->isVoidTy();
+        if (!returns_call_result)
+            return;
+
+        bool const is_same_signature =
+            llvm_call_instruction->getFunctionType() == llvm_parent_function.getFunctionType() &&
+            llvm_call_instruction->getCallingConv() == llvm_parent_function.getCallingConv() &&
+            has_same_abi_parameter_attributes(*llvm_call_instruction, llvm_parent_function);
+
+        llvm_call_instruction->setTailCallKind(is_same_signature ? llvm::CallInst::TCK_MustTail : llvm::CallInst::TCK_Tail);
+    }
+
     Value_and_type create_return_expression_value(
         Return_expression const& expression,
         Statement const& statement,
@@ -3209,6 +3877,10 @@ namespace h::compiler
             is_taking_address_of
         );
 
+        h::Function_declaration const& function_declaration = *parameters.function_declaration.value();
+        if (std::find(function_declaration.attributes.begin(), function_declaration.attributes.end(), Function_attribute::Must_tail) != function_declaration.attributes.end())
+            set_returned_call_as_tail_call(instruction, *parameters.llvm_parent_function);
+
         return
         {
             .name = "",
@@ -3472,13 +4144,13 @@ namespace h::compiler
                 bool const is_increment = (operation == Unary_operation::Pre_increment) || (operation == Unary_operation::Post_increment);
                 bool const is_post = (operation == Unary_operation::Post_decrement) || (operation == Unary_operation::Post_increment);
 
-                llvm::Value* const current_value = create_load_instruction(llvm_builder, llvm_data_layout, llvm_value_type, value_expression.value);
+                llvm::Value* const current_value = create_load_instruction(llvm_builder, llvm_data_layout, llvm_value_type, value_expression.value, value_expression.alignment);
 
                 llvm::Value* const new_value = is_increment ?
                     llvm_builder.CreateAdd(current_value, llvm::ConstantInt::get(current_value->getType(), 1)) :
                     llvm_builder.CreateSub(current_value, llvm::ConstantInt::get(current_value->getType(), 1));
 
-                create_store_instruction(llvm_builder, llvm_data_layout, new_value, value_expression.value);
+                create_store_instruction(llvm_builder, llvm_data_layout, new_value, value_expression.value, value_expression.alignment);
 
                 llvm::Value* const returned_value = is_post ? current_value : new_value;
 
@@ -3676,6 +4348,7 @@ namespace h::compiler
         llvm::Value* const loaded_value = store_value ? load_if_needed(right_hand_side, expression.right_hand_side.expression_index, statement, new_parameters).value : right_hand_side.value;
 
         llvm::AllocaInst* const alloca = create_alloca_instruction(llvm_builder, llvm_data_layout, *parameters.llvm_parent_function, llvm_type, expression.name.c_str());
+        alloca->setAlignment(get_type_alignment(llvm_data_layout, type_database, llvm_type));
 
         if (parameters.debug_info != nullptr)
             create_local_variable_debug_description(*parameters.debug_info, parameters, expression.name, alloca, core_type);
@@ -4131,7 +4804,7 @@ namespace h::compiler
         else if (std::holds_alternative<Constant_expression>(expression.data))
         {
             Constant_expression const& data = std::get<Constant_expression>(expression.data);
-            return create_constant_expression_value(data, new_parameters.llvm_context, new_parameters.llvm_data_layout, new_parameters.llvm_module, new_parameters.core_module, new_parameters.declaration_database, new_parameters.type_database);
+            return create_constant_expression_value(data, new_parameters.llvm_context, new_parameters.llvm_data_layout, new_parameters.llvm_module, new_parameters.read_only_globals, new_parameters.core_module, new_parameters.declaration_database, new_parameters.type_database);
         }
         else if (std::holds_alternative<Constant_array_expression>(expression.data))
         {
@@ -4278,7 +4951,7 @@ namespace h::compiler
                 else
                 {
                     llvm::Type* const destination_llvm_type = type_reference_to_llvm_type(parameters.llvm_context, parameters.llvm_data_layout, value.type.value(), parameters.type_database);
-                    llvm::Value* const loaded_value = create_load_instruction(parameters.llvm_builder, parameters.llvm_data_layout, destination_llvm_type, value.value);
+                    llvm::Value* const loaded_value = create_load_instruction(parameters.llvm_builder, parameters.llvm_data_layout, destination_llvm_type, value.value, value.alignment);
                     return Value_and_type
                     {
                         .name = value.name,
@@ -4294,7 +4967,7 @@ namespace h::compiler
                 return value;
             }
 
-            llvm::Value* const loaded_value = parameters.llvm_builder.CreateLoad(llvm_type, value.value);
+            llvm::Value* const loaded_value = create_load_instruction(parameters.llvm_builder, parameters.llvm_data_layout, llvm_type, value.value, value.alignment);
             return Value_and_type
             {
                 .name = value.name,
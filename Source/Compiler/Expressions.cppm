@@ -48,6 +48,11 @@ namespace h::compiler
         std::pmr::unordered_map<std::pmr::string, Enum_constants> map;
     };
 
+    export struct Read_only_globals
+    {
+        std::pmr::unordered_map<llvm::Constant*, llvm::GlobalVariable*> map;
+    };
+
     export enum class Contract_options
     {
         Disabled,
@@ -63,10 +68,11 @@ namespace h::compiler
         llvm::Module& llvm_module;
         Clang_module_data& clang_module_data;
         Module const& core_module;
-        std::pmr::unordered_map<std::pmr::string, Module> const& core_module_dependencies;
+        std::pmr::unordered_map<std::pmr::string, Module const*> const& core_module_dependencies;
         Declaration_database& declaration_database;
         Type_database& type_database;
         Enum_value_constants const& enum_value_constants;
+        Read_only_globals& read_only_globals;
         std::span<Block_info> blocks;
         std::span<std::pmr::vector<Statement>> defer_expressions_per_block;
         std::optional<Function_declaration const*> function_declaration;
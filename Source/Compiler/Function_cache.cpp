@@ -0,0 +1,561 @@
+module;
+
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/DebugInfo.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/Metadata.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Object/ArchiveWriter.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Transforms/Utils/Cloning.h>
+#include <llvm/Transforms/Utils/ValueMapper.h>
+
+#include <xxhash.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+module h.compiler.function_cache;
+
+namespace h::compiler
+{
+    // Callees with more instructions than this are not worth copying for inlining:
+    static constexpr unsigned int maximum_copied_callee_instruction_count = 64;
+
+    static bool is_duplicable_constant(
+        llvm::GlobalValue const& global_value
+    )
+    {
+        llvm::GlobalVariable const* const variable = llvm::dyn_cast<llvm::GlobalVariable>(&global_value);
+        if (variable == nullptr)
+            return false;
+
+        return variable->hasLocalLinkage()
+            && variable->isConstant()
+            && variable->hasInitializer()
+            && !variable->isThreadLocal()
+            && variable->hasAtLeastLocalUnnamedAddr();
+    }
+
+    static bool can_split_module(
+        llvm::Module const& llvm_module
+    )
+    {
+        return llvm_module.alias_empty()
+            && llvm_module.ifunc_empty()
+            && llvm_module.getComdatSymbolTable().empty()
+            && llvm_module.getModuleInlineAsm().empty();
+    }
+
+    static void externalize_local_symbols(
+        llvm::Module& llvm_module,
+        std::string_view const module_name
+    )
+    {
+        std::size_t unnamed_index = 0;
+
+        auto const externalize = [&](llvm::GlobalValue& global_value) -> void
+        {
+            std::string const name = global_value.hasName() ?
+                std::format("{}.{}", module_name, std::string_view{global_value.getName()}) :
+                std::format("{}.unnamed.{}", module_name, unnamed_index++);
+
+            global_value.setName(name);
+            global_value.setLinkage(llvm::GlobalValue::ExternalLinkage);
+            global_value.setVisibility(llvm::GlobalValue::HiddenVisibility);
+        };
+
+        for (llvm::Function& function : llvm_module)
+        {
+            if (!function.isDeclaration() && function.hasLocalLinkage())
+                externalize(function);
+        }
+
+        for (llvm::GlobalVariable& variable : llvm_module.globals())
+        {
+            if (variable.hasLocalLinkage() && !is_duplicable_constant(variable))
+                externalize(variable);
+        }
+    }
+
+    static void collect_referenced_global_values(
+        llvm::Constant const& constant,
+        std::pmr::vector<llvm::GlobalValue const*>& global_values,
+        std::unordered_set<llvm::Constant const*>& visited
+    )
+    {
+        if (!visited.insert(&constant).second)
+            return;
+
+        if (llvm::GlobalValue const* const global_value = llvm::dyn_cast<llvm::GlobalValue>(&constant))
+        {
+            global_values.push_back(global_value);
+
+            if (is_duplicable_constant(*global_value))
+                collect_referenced_global_values(*llvm::cast<llvm::GlobalVariable>(global_value)->getInitializer(), global_values, visited);
+
+            return;
+        }
+
+        for (llvm::Use const& operand : constant.operands())
+        {
+            if (llvm::Constant const* const operand_constant = llvm::dyn_cast<llvm::Constant>(operand.get()))
+                collect_referenced_global_values(*operand_constant, global_values, visited);
+        }
+    }
+
+    static void collect_referenced_global_values(
+        llvm::Function const& function,
+        std::pmr::vector<llvm::GlobalValue const*>& global_values,
+        std::unordered_set<llvm::Constant const*>& visited
+    )
+    {
+        if (function.hasPersonalityFn())
+            collect_referenced_global_values(*function.getPersonalityFn(), global_values, visited);
+
+        for (llvm::BasicBlock const& block : function)
+        {
+            for (llvm::Instruction const& instruction : block)
+            {
+                for (llvm::Use const& operand : instruction.operands())
+                {
+                    if (llvm::Constant const* const constant = llvm::dyn_cast<llvm::Constant>(operand.get()))
+                        collect_referenced_global_values(*constant, global_values, visited);
+                }
+            }
+        }
+    }
+
+    static std::unique_ptr<llvm::Module> create_partition_module(
+        llvm::Module const& llvm_module,
+        llvm::StringRef const name
+    )
+    {
+        std::unique_ptr<llvm::Module> partition = std::make_unique<llvm::Module>(name, llvm_module.getContext());
+        partition->setSourceFileName(llvm_module.getSourceFileName());
+        partition->setDataLayout(llvm_module.getDataLayout());
+        partition->setTargetTriple(llvm_module.getTargetTriple());
+        return partition;
+    }
+
+    static void copy_module_flags(
+        llvm::Module const& llvm_module,
+        llvm::Module& partition,
+        llvm::ValueToValueMapTy& value_map
+    )
+    {
+        llvm::NamedMDNode const* const flags = llvm_module.getModuleFlagsMetadata();
+        if (flags == nullptr)
+            return;
+
+        llvm::NamedMDNode* const partition_flags = partition.getOrInsertModuleFlagsMetadata();
+        for (llvm::MDNode const* const flag : flags->operands())
+            partition_flags->addOperand(llvm::MapMetadata(flag, value_map));
+    }
+
+    static llvm::Function* create_function_declaration(
+        llvm::Module& partition,
+        llvm::Function const& function,
+        llvm::GlobalValue::LinkageTypes const linkage
+    )
+    {
+        llvm::Function* const declaration = llvm::Function::Create(
+            function.getFunctionType(),
+            linkage,
+            function.getAddressSpace(),
+            function.getName(),
+            &partition
+        );
+        declaration->copyAttributesFrom(&function);
+        return declaration;
+    }
+
+    static llvm::GlobalVariable* create_global_variable_declaration(
+        llvm::Module& partition,
+        llvm::GlobalVariable const& variable,
+        llvm::GlobalValue::LinkageTypes const linkage,
+        std::string_view const name
+    )
+    {
+        llvm::GlobalVariable* const declaration = new llvm::GlobalVariable(
+            partition,
+            variable.getValueType(),
+            variable.isConstant(),
+            linkage,
+            nullptr,
+            llvm::StringRef{name.data(), name.size()},
+            nullptr,
+            variable.getThreadLocalMode(),
+            variable.getAddressSpace()
+        );
+        declaration->copyAttributesFrom(&variable);
+        return declaration;
+    }
+
+    // Declares the referenced global values in the partition, except for private constants which are
+    // copied with their initializers. Global values that are already mapped are skipped.
+    static void map_referenced_global_values(
+        llvm::Module& partition,
+        std::span<llvm::GlobalValue const* const> const global_values,
+        llvm::ValueToValueMapTy& value_map
+    )
+    {
+        std::pmr::vector<std::pair<llvm::GlobalVariable const*, llvm::GlobalVariable*>> copied_constants;
+
+        for (llvm::GlobalValue const* const global_value : global_values)
+        {
+            if (value_map.count(global_value) > 0)
+                continue;
+
+            if (llvm::Function const* const function = llvm::dyn_cast<llvm::Function>(global_value))
+            {
+                llvm::Function* const declaration = create_function_declaration(partition, *function, llvm::GlobalValue::ExternalLinkage);
+                if (declaration->hasPersonalityFn())
+                    declaration->setPersonalityFn(nullptr);
+                value_map[global_value] = declaration;
+                continue;
+            }
+
+            llvm::GlobalVariable const& variable = *llvm::cast<llvm::GlobalVariable>(global_value);
+            if (is_duplicable_constant(variable))
+            {
+                llvm::GlobalVariable* const copy = create_global_variable_declaration(partition, variable, variable.getLinkage(), "");
+                copied_constants.push_back(std::make_pair(&variable, copy));
+                value_map[global_value] = copy;
+            }
+            else
+            {
+                value_map[global_value] = create_global_variable_declaration(partition, variable, llvm::GlobalValue::ExternalLinkage, variable.getName().str());
+            }
+        }
+
+        for (auto const& [variable, copy] : copied_constants)
+            copy->setInitializer(llvm::MapValue(variable->getInitializer(), value_map));
+    }
+
+    static void clone_function_body(
+        llvm::Function& clone,
+        llvm::Function const& function,
+        llvm::ValueToValueMapTy& value_map
+    )
+    {
+        llvm::Function::arg_iterator clone_argument = clone.arg_begin();
+        for (llvm::Argument const& argument : function.args())
+        {
+            clone_argument->setName(argument.getName());
+            value_map[&argument] = &*clone_argument;
+            ++clone_argument;
+        }
+
+        llvm::GlobalValue::LinkageTypes const linkage = clone.getLinkage();
+
+        llvm::SmallVector<llvm::ReturnInst*, 8> returns;
+        llvm::CloneFunctionInto(&clone, &function, value_map, llvm::CloneFunctionChangeType::DifferentModule, returns);
+
+        clone.setLinkage(linkage);
+    }
+
+    static bool should_copy_callee_body(
+        llvm::Function const& callee
+    )
+    {
+        return !callee.isDeclaration()
+            && !callee.hasFnAttribute(llvm::Attribute::NoInline)
+            && callee.getInstructionCount() <= maximum_copied_callee_instruction_count;
+    }
+
+    static Function_partition create_function_partition(
+        llvm::Module const& llvm_module,
+        llvm::Function const& function,
+        bool const copy_callee_bodies
+    )
+    {
+        std::unique_ptr<llvm::Module> partition = create_partition_module(llvm_module, function.getName());
+        llvm::ValueToValueMapTy value_map;
+
+        std::pmr::vector<llvm::GlobalValue const*> referenced_global_values;
+        std::unordered_set<llvm::Constant const*> visited;
+        visited.insert(&function);
+        collect_referenced_global_values(function, referenced_global_values, visited);
+
+        llvm::Function* const clone = create_function_declaration(*partition, function, function.getLinkage());
+        value_map[&function] = clone;
+
+        // Callee bodies are part of the partition, so a change in a callee that may be inlined also changes the hash of its callers:
+        std::pmr::vector<std::pair<llvm::Function const*, llvm::Function*>> copied_callees;
+        if (copy_callee_bodies)
+        {
+            std::size_t const direct_reference_count = referenced_global_values.size();
+            for (std::size_t index = 0; index < direct_reference_count; ++index)
+            {
+                llvm::Function const* const callee = llvm::dyn_cast<llvm::Function>(referenced_global_values[index]);
+                if (callee == nullptr || !should_copy_callee_body(*callee))
+                    continue;
+
+                llvm::Function* const callee_clone = create_function_declaration(*partition, *callee, llvm::GlobalValue::AvailableExternallyLinkage);
+                value_map[callee] = callee_clone;
+                copied_callees.push_back(std::make_pair(callee, callee_clone));
+
+                collect_referenced_global_values(*callee, referenced_global_values, visited);
+            }
+        }
+
+        map_referenced_global_values(*partition, referenced_global_values, value_map);
+
+        clone_function_body(*clone, function, value_map);
+
+        for (auto const& [callee, callee_clone] : copied_callees)
+        {
+            clone_function_body(*callee_clone, *callee, value_map);
+            callee_clone->setVisibility(llvm::GlobalValue::DefaultVisibility);
+        }
+
+        copy_module_flags(llvm_module, *partition, value_map);
+
+        return Function_partition
+        {
+            .name = std::pmr::string{std::string_view{function.getName()}},
+            .module = std::move(partition),
+        };
+    }
+
+    static std::optional<Function_partition> create_global_variables_partition(
+        llvm::Module const& llvm_module
+    )
+    {
+        std::unique_ptr<llvm::Module> partition = create_partition_module(llvm_module, "globals");
+        llvm::ValueToValueMapTy value_map;
+
+        std::pmr::vector<std::pair<llvm::GlobalVariable const*, llvm::GlobalVariable*>> definitions;
+        std::pmr::vector<llvm::GlobalValue const*> referenced_global_values;
+        std::unordered_set<llvm::Constant const*> visited;
+
+        for (llvm::GlobalVariable const& variable : llvm_module.globals())
+        {
+            if (variable.isDeclaration() || is_duplicable_constant(variable))
+                continue;
+
+            llvm::GlobalVariable* const definition = create_global_variable_declaration(*partition, variable, variable.getLinkage(), variable.getName().str());
+            value_map[&variable] = definition;
+            definitions.push_back(std::make_pair(&variable, definition));
+
+            visited.insert(&variable);
+            collect_referenced_global_values(*variable.getInitializer(), referenced_global_values, visited);
+        }
+
+        if (definitions.empty())
+            return std::nullopt;
+
+        map_referenced_global_values(*partition, referenced_global_values, value_map);
+
+        for (auto const& [variable, definition] : definitions)
+        {
+            definition->setInitializer(llvm::MapValue(variable->getInitializer(), value_map));
+
+            llvm::SmallVector<std::pair<unsigned int, llvm::MDNode*>, 1> attachments;
+            variable->getAllMetadata(attachments);
+            for (auto const& [kind, node] : attachments)
+                definition->addMetadata(kind, *llvm::MapMetadata(node, value_map));
+        }
+
+        if (llvm::NamedMDNode const* const compile_units = llvm_module.getNamedMetadata("llvm.dbg.cu"))
+        {
+            llvm::NamedMDNode* const partition_compile_units = partition->getOrInsertNamedMetadata("llvm.dbg.cu");
+            for (llvm::MDNode const* const compile_unit : compile_units->operands())
+                partition_compile_units->addOperand(llvm::MapMetadata(compile_unit, value_map));
+        }
+
+        copy_module_flags(llvm_module, *partition, value_map);
+
+        return Function_partition
+        {
+            .name = "globals",
+            .module = std::move(partition),
+        };
+    }
+
+    std::pmr::vector<Function_partition> split_module_into_function_partitions(
+        llvm::Module& llvm_module,
+        std::string_view const module_name,
+        bool const copy_callee_bodies
+    )
+    {
+        std::pmr::vector<Function_partition> partitions;
+
+        if (!can_split_module(llvm_module))
+        {
+            partitions.push_back(
+                Function_partition
+                {
+                    .name = std::pmr::string{module_name},
+                    .module = llvm::CloneModule(llvm_module),
+                }
+            );
+            return partitions;
+        }
+
+        externalize_local_symbols(llvm_module, module_name);
+
+        for (llvm::Function const& function : llvm_module)
+        {
+            if (!function.isDeclaration())
+                partitions.push_back(create_function_partition(llvm_module, function, copy_callee_bodies));
+        }
+
+        std::optional<Function_partition> globals_partition = create_global_variables_partition(llvm_module);
+        if (globals_partition.has_value())
+            partitions.push_back(std::move(globals_partition.value()));
+
+        return partitions;
+    }
+
+    std::uint64_t hash_function_partition(
+        llvm::Module const& partition,
+        std::uint64_t const compilation_options_hash,
+        bool const include_debug_info
+    )
+    {
+        std::string text;
+        llvm::raw_string_ostream stream{text};
+
+        // The object embeds the line numbers and files of the debug information, so they are part of the key when it is emitted:
+        if (include_debug_info)
+        {
+            partition.print(stream, nullptr);
+        }
+        else
+        {
+            std::unique_ptr<llvm::Module> const partition_without_debug_info = llvm::CloneModule(partition);
+            llvm::StripDebugInfo(*partition_without_debug_info);
+            partition_without_debug_info->print(stream, nullptr);
+        }
+
+        stream.flush();
+
+        return XXH64(text.data(), text.size(), compilation_options_hash);
+    }
+
+    std::filesystem::path get_function_cache_entry_path(
+        Function_cache const& function_cache,
+        std::uint64_t const key,
+        std::string_view const object_file_extension
+    )
+    {
+        return function_cache.directory / std::format("{:016x}.{}", key, object_file_extension);
+    }
+
+    bool use_function_cache_entry(
+        std::filesystem::path const& entry_path
+    )
+    {
+        std::error_code error_code;
+        std::filesystem::last_write_time(entry_path, std::filesystem::file_time_type::clock::now(), error_code);
+        return !error_code;
+    }
+
+    std::uint64_t evict_function_cache_entries(
+        Function_cache const& function_cache
+    )
+    {
+        struct Entry
+        {
+            std::filesystem::path path;
+            std::uintmax_t size = 0;
+            std::filesystem::file_time_type last_use_time;
+        };
+
+        std::pmr::vector<Entry> entries;
+        std::uintmax_t total_size = 0;
+
+        std::error_code error_code;
+        for (std::filesystem::directory_entry const& directory_entry : std::filesystem::directory_iterator{function_cache.directory, error_code})
+        {
+            if (!directory_entry.is_regular_file())
+                continue;
+
+            Entry entry
+            {
+                .path = directory_entry.path(),
+                .size = directory_entry.file_size(),
+                .last_use_time = directory_entry.last_write_time(),
+            };
+            total_size += entry.size;
+            entries.push_back(std::move(entry));
+        }
+
+        if (total_size <= function_cache.maximum_size_in_bytes)
+            return 0;
+
+        std::sort(entries.begin(), entries.end(), [](Entry const& lhs, Entry const& rhs) -> bool { return lhs.last_use_time < rhs.last_use_time; });
+
+        std::uint64_t evicted_count = 0;
+        for (Entry const& entry : entries)
+        {
+            if (total_size <= function_cache.maximum_size_in_bytes)
+                break;
+
+            if (std::filesystem::remove(entry.path, error_code))
+            {
+                total_size -= entry.size;
+                evicted_count += 1;
+            }
+        }
+
+        return evicted_count;
+    }
+
+    bool write_object_archive(
+        std::span<std::filesystem::path const> const object_file_paths,
+        std::filesystem::path const& output_file_path,
+        bool const use_coff_format
+    )
+    {
+        std::pmr::vector<llvm::NewArchiveMember> members;
+        members.reserve(object_file_paths.size());
+
+        for (std::filesystem::path const& object_file_path : object_file_paths)
+        {
+            llvm::Expected<llvm::NewArchiveMember> member = llvm::NewArchiveMember::getFile(object_file_path.generic_string(), true);
+            if (llvm::Error error = member.takeError())
+            {
+                llvm::errs() << "Could not read '" << object_file_path.generic_string() << "': " << llvm::toString(std::move(error)) << '\n';
+                return false;
+            }
+
+            members.push_back(std::move(member.get()));
+        }
+
+        llvm::Error error = llvm::writeArchive(
+            output_file_path.generic_string(),
+            members,
+            llvm::SymtabWritingMode::NormalSymtab,
+            use_coff_format ? llvm::object::Archive::K_COFF : llvm::object::Archive::K_GNU,
+            true,
+            false
+        );
+
+        if (error)
+        {
+            llvm::errs() << "Could not write '" << output_file_path.generic_string() << "': " << llvm::toString(std::move(error)) << '\n';
+            return false;
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,72 @@
+module;
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <llvm/IR/Module.h>
+
+export module h.compiler.function_cache;
+
+namespace h::compiler
+{
+    // Object files of single functions, stored by the hash of their LLVM IR without debug information and of the compilation options.
+    export struct Function_cache
+    {
+        std::filesystem::path directory;
+        std::uint64_t maximum_size_in_bytes = 0;
+    };
+
+    export struct Function_partition
+    {
+        std::pmr::string name;
+        std::unique_ptr<llvm::Module> module;
+    };
+
+    // Moves each function definition into its own module, and all global variable definitions into another.
+    // Local symbols are renamed with the module name as prefix and given hidden visibility, so that
+    // partitions can refer to each other once linked. Private constants such as string literals are
+    // copied into each partition that uses them instead.
+    // If copy_callee_bodies is true, small callees are copied as available_externally so that they can still be inlined.
+    // Modules that cannot be split, such as those with aliases or comdats, produce a single partition.
+    export std::pmr::vector<Function_partition> split_module_into_function_partitions(
+        llvm::Module& llvm_module,
+        std::string_view module_name,
+        bool copy_callee_bodies
+    );
+
+    export std::uint64_t hash_function_partition(
+        llvm::Module const& partition,
+        std::uint64_t compilation_options_hash,
+        bool include_debug_info
+    );
+
+    export std::filesystem::path get_function_cache_entry_path(
+        Function_cache const& function_cache,
+        std::uint64_t key,
+        std::string_view object_file_extension
+    );
+
+    // Returns true if the entry exists, in which case it is marked as the most recently used.
+    export bool use_function_cache_entry(
+        std::filesystem::path const& entry_path
+    );
+
+    // Removes the least recently used entries until the cache fits in its maximum size.
+    // Returns the number of removed entries.
+    export std::uint64_t evict_function_cache_entries(
+        Function_cache const& function_cache
+    );
+
+    export bool write_object_archive(
+        std::span<std::filesystem::path const> object_file_paths,
+        std::filesystem::path const& output_file_path,
+        bool use_coff_format
+    );
+}
@@ -3,6 +3,8 @@ module;
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/Module.h>
 
+#include <algorithm>
+
 module h.compiler.instructions;
 
 import h.core.types;
@@ -81,18 +83,30 @@ namespace h::compiler
         }
     }
 
+    // The alignment of a struct member can be lower than the alignment of its type, for example in packed structs.
+    static llvm::Align get_access_alignment(
+        llvm::DataLayout const& llvm_data_layout,
+        llvm::Type* const llvm_type,
+        llvm::MaybeAlign const alignment
+    )
+    {
+        llvm::Align const type_alignment = llvm_data_layout.getABITypeAlign(llvm_type);
+        return alignment.has_value() ? std::min(type_alignment, alignment.value()) : type_alignment;
+    }
+
     llvm::LoadInst* create_load_instruction(
         llvm::IRBuilder<>& llvm_builder,
         llvm::DataLayout const& llvm_data_layout,
         llvm::Type* const llvm_type,
-        llvm::Value* const pointer
+        llvm::Value* const pointer,
+        llvm::MaybeAlign const alignment
     )
     {
         // If the value is not sized, we cannot load it.
         if (!llvm_type->isSized())
             return nullptr;
 
-        llvm::Align const type_alignment = llvm_data_layout.getABITypeAlign(llvm_type);
+        llvm::Align const type_alignment = get_access_alignment(llvm_data_layout, llvm_type, alignment);
         llvm::LoadInst* const instruction = llvm_builder.CreateAlignedLoad(llvm_type, pointer, type_alignment);
         return instruction;
     }
@@ -131,14 +145,15 @@ namespace h::compiler
         llvm::IRBuilder<>& llvm_builder,
         llvm::DataLayout const& llvm_data_layout,
         llvm::Value* const value,
-        llvm::Value* const pointer
+        llvm::Value* const pointer,
+        llvm::MaybeAlign const alignment
     )
     {
         // If the value is not sized, we cannot store it.
         if (!value->getType()->isSized())
             return nullptr;
 
-        llvm::Align const type_alignment = llvm_data_layout.getABITypeAlign(value->getType());
+        llvm::Align const type_alignment = get_access_alignment(llvm_data_layout, value->getType(), alignment);
         llvm::StoreInst* const instruction = llvm_builder.CreateAlignedStore(value, pointer, type_alignment);
         return instruction;
     }
@@ -13,6 +13,7 @@ namespace h::compiler
         std::pmr::string name;
         llvm::Value* value;
         std::optional<h::Type_reference> type;
+        llvm::MaybeAlign alignment = {};
     };
 
     export llvm::AllocaInst* create_alloca_instruction(
@@ -44,7 +45,8 @@ namespace h::compiler
         llvm::IRBuilder<>& llvm_builder,
         llvm::DataLayout const& llvm_data_layout,
         llvm::Type* const llvm_type,
-        llvm::Value* const pointer
+        llvm::Value* const pointer,
+        llvm::MaybeAlign const alignment = {}
     );
 
     export llvm::Value* create_load_instruction_if_needed(
@@ -58,7 +60,8 @@ namespace h::compiler
         llvm::IRBuilder<>& llvm_builder,
         llvm::DataLayout const& llvm_data_layout,
         llvm::Value* const value,
-        llvm::Value* const pointer
+        llvm::Value* const pointer,
+        llvm::MaybeAlign const alignment = {}
     );
 
     export llvm::Value* create_memcpy_call(
@@ -1,15 +1,37 @@
 module;
 
+#include <llvm/ExecutionEngine/Orc/CompileUtils.h>
 #include <llvm/ExecutionEngine/Orc/Core.h>
+#include <llvm/ExecutionEngine/Orc/IndirectionUtils.h>
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
 #include <llvm/ExecutionEngine/Orc/Layer.h>
+#include <llvm/ExecutionEngine/Orc/Mangling.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Target/TargetMachine.h>
 
+#include <xxhash.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstdio>
 #include <chrono>
+#include <cstdint>
 #include <filesystem>
+#include <format>
 #include <memory>
 #include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 module h.compiler.core_module_layer;
 
@@ -17,99 +39,398 @@ import h.core;
 import h.common;
 import h.compiler;
 import h.compiler.common;
+import h.compiler.jit_object_cache;
+import h.compiler.profiler;
+import h.core.hash;
+import h.compiler.target;
 
 namespace h::compiler
 {
-    static llvm::orc::MaterializationUnit::Interface get_interface(
-        h::Module const& core_module,
-        llvm::orc::MangleAndInterner& mangle
+    static void update_hash(
+        XXH64_state_t* const state,
+        std::string_view const string
     )
     {
-        llvm::orc::SymbolFlagsMap symbols;
+        XXH64_update(state, string.data(), string.size());
+    }
+
+    static void update_hash(
+        XXH64_state_t* const state,
+        std::uint64_t const value
+    )
+    {
+        XXH64_update(state, &value, sizeof(value));
+    }
+
+    static h::Module const& get_declarations_module(
+        Core_module_compilation_data const& compilation_data
+    )
+    {
+        return compilation_data.renamed_declarations != nullptr ? *compilation_data.renamed_declarations : *compilation_data.core_module;
+    }
+
+    static std::string_view get_body_name(
+        Core_module_compilation_data const& compilation_data,
+        std::pmr::string const& function_name
+    )
+    {
+        auto const location = compilation_data.function_name_to_body_name.find(function_name);
+        return location != compilation_data.function_name_to_body_name.end() ? std::string_view{ location->second } : std::string_view{ function_name };
+    }
+
+    // The shared module is not modified, so only the copy that is prepared gets the body names:
+    static h::Module create_module_to_prepare(
+        Core_module_compilation_data const& compilation_data
+    )
+    {
+        if (compilation_data.renamed_declarations == nullptr)
+            return *compilation_data.core_module;
+
+        h::Module core_module = *compilation_data.renamed_declarations;
+        core_module.definitions = compilation_data.core_module->definitions;
+
+        for (h::Function_definition& definition : core_module.definitions.function_definitions)
+        {
+            auto const location = compilation_data.function_name_to_body_name.find(definition.name);
+            if (location != compilation_data.function_name_to_body_name.end())
+                definition.name = location->second;
+        }
+
+        return core_module;
+    }
+
+    // Hash of everything that the code of any function of the module depends on, besides the function
+    // bodies themselves.
+    static std::uint64_t hash_module_for_object_cache(
+        Core_module_compilation_data const& compilation_data,
+        std::uint64_t const compilation_key
+    )
+    {
+        h::Module const& core_module = get_declarations_module(compilation_data);
+
+        XXH64_state_t* const state = XXH64_createState();
+        if (state == nullptr)
+            h::common::print_message_and_exit("Could not initialize xxhash state!");
+
+        XXH64_state_t* const declaration_state = XXH64_createState();
+        if (declaration_state == nullptr)
+            h::common::print_message_and_exit("Could not initialize xxhash state!");
+
+        XXH64_reset(state, compilation_key);
+
+        update_hash(state, core_module.name);
+        update_hash(state, h::hash_module_interface(core_module));
+
+        for (h::Global_variable_declaration const& declaration : core_module.internal_declarations.global_variable_declarations)
+            update_hash(state, h::hash_global_variable_declaration(declaration_state, declaration));
+
+        std::pmr::vector<std::string_view> dependency_names;
+        dependency_names.reserve(compilation_data.core_module_dependencies.size());
+        for (std::pair<std::pmr::string const, h::Module> const& pair : compilation_data.core_module_dependencies)
+            dependency_names.push_back(pair.first);
+        std::sort(dependency_names.begin(), dependency_names.end());
+
+        for (std::string_view const dependency_name : dependency_names)
+        {
+            h::Module const& dependency = compilation_data.core_module_dependencies.at(std::pmr::string{ dependency_name });
+            update_hash(state, dependency_name);
+            update_hash(state, h::hash_module_interface(dependency));
+        }
+
+        std::uint64_t const hash = XXH64_digest(state);
+
+        XXH64_freeState(declaration_state);
+        XXH64_freeState(state);
+
+        return hash;
+    }
+
+    static std::uint64_t get_materialization_object_cache_key(
+        Core_module_compilation_state const& compilation_state,
+        std::span<std::string_view const> const functions_to_compile
+    )
+    {
+        std::pmr::vector<std::string_view> sorted_functions_to_compile{ functions_to_compile.begin(), functions_to_compile.end() };
+        std::sort(sorted_functions_to_compile.begin(), sorted_functions_to_compile.end());
+
+        XXH64_state_t* const state = XXH64_createState();
+        if (state == nullptr)
+            h::common::print_message_and_exit("Could not initialize xxhash state!");
+
+        XXH64_reset(state, compilation_state.object_cache_module_hash);
+
+        for (std::string_view const function_name : sorted_functions_to_compile)
+        {
+            update_hash(state, function_name);
+
+            auto const location = compilation_state.function_hashes.find(std::pmr::string{ function_name });
+            update_hash(state, location != compilation_state.function_hashes.end() ? location->second : std::uint64_t{ 0 });
+        }
+
+        std::uint64_t const key = XXH64_digest(state);
+        XXH64_freeState(state);
+
+        return key;
+    }
+
+    static std::shared_ptr<Core_module_compilation_state> create_compilation_state(
+        Core_module_compilation_data core_module_compilation_data,
+        llvm::orc::MangleAndInterner& mangle,
+        JIT_object_cache const* const object_cache
+    )
+    {
+        std::shared_ptr<Core_module_compilation_state> compilation_state = std::make_shared<Core_module_compilation_state>(
+            std::move(core_module_compilation_data)
+        );
+
+        compilation_state->core_module_dependencies = create_module_references(compilation_state->data.core_module_dependencies);
+
+        Core_module_compilation_data const& compilation_data = compilation_state->data;
+        h::Module const& core_module = *compilation_data.core_module;
 
         for (h::Function_definition const& function_definition : core_module.definitions.function_definitions)
         {
-            if (function_definition.name.ends_with("$body"))
+            std::string_view const body_name = get_body_name(compilation_data, function_definition.name);
+            if (body_name.ends_with("$body"))
             {
-                std::string const mangled_name = mangle_name(core_module, function_definition.name, std::nullopt);
-
-                symbols.insert(
-                    { mangle(mangled_name.c_str()), llvm::JITSymbolFlags::Exported | llvm::JITSymbolFlags::Callable }
-                );
+                std::string const mangled_name = mangle_name(core_module, body_name, std::nullopt);
+                compilation_state->symbol_to_function_name.insert(std::make_pair(mangle(mangled_name.c_str()), std::pmr::string{ body_name }));
             }
         }
 
+        if (object_cache != nullptr)
+        {
+            compilation_state->object_cache_module_hash = hash_module_for_object_cache(compilation_state->data, object_cache->get_compilation_key());
+
+            XXH64_state_t* const state = XXH64_createState();
+            if (state == nullptr)
+                h::common::print_message_and_exit("Could not initialize xxhash state!");
+
+            for (h::Function_definition const& function_definition : core_module.definitions.function_definitions)
+                compilation_state->function_hashes.insert(std::make_pair(std::pmr::string{ get_body_name(compilation_data, function_definition.name) }, h::hash_function_definition(state, function_definition)));
+
+            XXH64_freeState(state);
+        }
+
+        return compilation_state;
+    }
+
+    static llvm::orc::MaterializationUnit::Interface get_interface(
+        Core_module_compilation_state const& compilation_state
+    )
+    {
+        llvm::orc::SymbolFlagsMap symbols;
+
+        for (auto const& pair : compilation_state.symbol_to_function_name)
+        {
+            symbols.insert(
+                { pair.first, llvm::JITSymbolFlags::Exported | llvm::JITSymbolFlags::Callable }
+            );
+        }
+
         return llvm::orc::MaterializationUnit::Interface{ std::move(symbols), nullptr };
     }
 
     Core_module_materialization_unit::Core_module_materialization_unit(
         Core_module_compilation_data core_module_compilation_data,
         llvm::orc::MangleAndInterner& mangle,
-        llvm::orc::IRLayer& base_layer
+        llvm::orc::IRLayer& base_layer,
+        llvm::orc::ObjectLayer& object_layer,
+        Tiered_compilation* const tiered_compilation,
+        JIT_object_cache* const object_cache
+    ) :
+        Core_module_materialization_unit(create_compilation_state(std::move(core_module_compilation_data), mangle, object_cache), mangle, base_layer, object_layer, tiered_compilation, object_cache)
+    {
+    }
+
+    Core_module_materialization_unit::Core_module_materialization_unit(
+        std::shared_ptr<Core_module_compilation_state> compilation_state,
+        llvm::orc::MangleAndInterner& mangle,
+        llvm::orc::IRLayer& base_layer,
+        llvm::orc::ObjectLayer& object_layer,
+        Tiered_compilation* const tiered_compilation,
+        JIT_object_cache* const object_cache
+    ) :
+        llvm::orc::MaterializationUnit(get_interface(*compilation_state)),
+        m_compilation_state{ std::move(compilation_state) },
+        m_mangle{ mangle },
+        m_base_layer{ base_layer },
+        m_object_layer{ object_layer },
+        m_tiered_compilation{ tiered_compilation },
+        m_object_cache{ object_cache }
+    {
+    }
+
+    Core_module_materialization_unit::Core_module_materialization_unit(
+        std::shared_ptr<Core_module_compilation_state> compilation_state,
+        llvm::orc::SymbolFlagsMap symbols,
+        llvm::orc::MangleAndInterner& mangle,
+        llvm::orc::IRLayer& base_layer,
+        llvm::orc::ObjectLayer& object_layer,
+        Tiered_compilation* const tiered_compilation,
+        JIT_object_cache* const object_cache
     ) :
-        llvm::orc::MaterializationUnit(get_interface(core_module_compilation_data.core_module, mangle)),
-        m_core_module_compilation_data{ std::move(core_module_compilation_data) },
+        llvm::orc::MaterializationUnit(llvm::orc::MaterializationUnit::Interface{ std::move(symbols), nullptr }),
+        m_compilation_state{ std::move(compilation_state) },
         m_mangle{ mangle },
-        m_base_layer{ base_layer }
+        m_base_layer{ base_layer },
+        m_object_layer{ object_layer },
+        m_tiered_compilation{ tiered_compilation },
+        m_object_cache{ object_cache }
     {
     }
 
+    // Increments the counter every time the function is entered. Relaxed ordering is enough, since
+    // the count is only used to decide when to tier up.
+    static void add_entry_counter(
+        llvm::Function& llvm_function,
+        std::atomic<std::uint64_t>& counter
+    )
+    {
+        if (llvm_function.isDeclaration())
+            return;
+
+        llvm::BasicBlock& entry_block = llvm_function.getEntryBlock();
+        llvm::IRBuilder<> builder{ &entry_block, entry_block.getFirstInsertionPt() };
+
+        llvm::Value* const counter_address = builder.CreateIntToPtr(
+            builder.getInt64(reinterpret_cast<std::uintptr_t>(&counter)),
+            builder.getPtrTy()
+        );
+        builder.CreateAtomicRMW(llvm::AtomicRMWInst::Add, counter_address, builder.getInt64(1), llvm::MaybeAlign{ alignof(std::uint64_t) }, llvm::AtomicOrdering::Monotonic);
+    }
+
     void Core_module_materialization_unit::materialize(
         std::unique_ptr<llvm::orc::MaterializationResponsibility> materialization_responsibility
     )
     {
-        std::chrono::high_resolution_clock::time_point const begin_materializing = std::chrono::high_resolution_clock::now();
+        Core_module_compilation_state& compilation_state = *m_compilation_state;
+        Core_module_compilation_data const& compilation_data = compilation_state.data;
 
-        llvm::orc::MangleAndInterner& mangle = m_mangle;
+        std::chrono::high_resolution_clock::time_point const begin_materializing = std::chrono::high_resolution_clock::now();
+        Profile_zone const profile_zone{compilation_data.profiler, "materialize_module", compilation_data.core_module->name};
 
         llvm::orc::SymbolNameSet const requested_symbols = materialization_responsibility->getRequestedSymbols();
 
-        auto const is_requested_symbol = [&](h::Function_definition const& definition) -> bool
-        {
-            std::string const mangled_name = mangle_name(m_core_module_compilation_data.core_module, definition.name, std::nullopt);
-            return requested_symbols.contains(mangle(mangled_name.c_str()));
-        };
-
         std::pmr::vector<std::string_view> functions_to_compile;
+        std::pmr::vector<llvm::orc::SymbolStringPtr> function_symbols;
+        llvm::orc::SymbolFlagsMap remaining_symbols;
 
-        for (h::Function_definition const& definition : m_core_module_compilation_data.core_module.definitions.function_definitions)
+        for (auto const& pair : materialization_responsibility->getSymbols())
         {
-            if (is_requested_symbol(definition))
-                functions_to_compile.push_back(definition.name);
+            if (requested_symbols.contains(pair.first))
+            {
+                auto const location = compilation_state.symbol_to_function_name.find(pair.first);
+                if (location != compilation_state.symbol_to_function_name.end())
+                {
+                    functions_to_compile.push_back(location->second);
+                    function_symbols.push_back(pair.first);
+                }
+            }
+            else
+            {
+                remaining_symbols.insert(pair);
+            }
         }
 
         // TODO refactor code so that exceptions are not used
         try
         {
-            std::unique_ptr<llvm::Module> llvm_module = h::compiler::create_llvm_module(
-                m_core_module_compilation_data.llvm_data,
-                m_core_module_compilation_data.core_module,
-                m_core_module_compilation_data.core_module_dependencies,
-                functions_to_compile,
-                m_core_module_compilation_data.compilation_options
-            );
-
+            if (!remaining_symbols.empty())
             {
-                std::pmr::vector<h::Function_definition>& function_definitions = m_core_module_compilation_data.core_module.definitions.function_definitions;
-                function_definitions.erase(
-                    std::remove_if(function_definitions.begin(), function_definitions.end(), is_requested_symbol),
-                    function_definitions.end()
+                std::unique_ptr<Core_module_materialization_unit> new_materialization_unit = std::make_unique<Core_module_materialization_unit>(
+                    m_compilation_state,
+                    std::move(remaining_symbols),
+                    m_mangle,
+                    m_base_layer,
+                    m_object_layer,
+                    m_tiered_compilation,
+                    m_object_cache
                 );
 
-                if (!function_definitions.empty())
+                llvm::Error error = materialization_responsibility->replace(std::move(new_materialization_unit));
+                if (error)
+                    h::common::print_message_and_exit(std::format("Error while creating a new materialization unit to replace unrequested symbols to target library: {}", llvm::toString(std::move(error))));
+            }
+
+            std::optional<std::uint64_t> object_cache_key;
+            if (m_object_cache != nullptr)
+            {
+                object_cache_key = get_materialization_object_cache_key(compilation_state, functions_to_compile);
+
+                std::unique_ptr<llvm::MemoryBuffer> object = m_object_cache->get_object(object_cache_key.value());
+                if (object != nullptr)
                 {
-                    std::unique_ptr<Core_module_materialization_unit> new_materialization_unit = std::make_unique<Core_module_materialization_unit>(
-                        std::move(m_core_module_compilation_data),
-                        m_mangle,
-                        m_base_layer
+                    m_object_layer.emit(std::move(materialization_responsibility), std::move(object));
+
+                    std::chrono::high_resolution_clock::time_point const end_materializing = std::chrono::high_resolution_clock::now();
+
+                    using namespace std::chrono_literals;
+                    auto const materialization_duration = (end_materializing - begin_materializing) / 1ms;
+                    std::puts(std::format("Materialization of {} took {} ms (object cache)", compilation_data.core_module->name, materialization_duration).c_str());
+                    return;
+                }
+            }
+
+            std::unique_ptr<llvm::Module> llvm_module;
+            {
+                std::lock_guard<std::mutex> const lock{ compilation_state.mutex };
+
+                if (compilation_state.prepared_core_module == nullptr)
+                {
+                    Profile_zone const prepare_profile_zone{compilation_data.profiler, "prepare_module", compilation_data.core_module->name};
+
+                    compilation_state.prepared_core_module = h::compiler::prepare_core_module(
+                        compilation_data.llvm_data,
+                        get_declarations_module(compilation_data),
+                        create_module_to_prepare(compilation_data),
+                        compilation_state.core_module_dependencies
                     );
+                }
+
+                llvm_module = h::compiler::create_llvm_module(
+                    compilation_data.llvm_data,
+                    *compilation_state.prepared_core_module,
+                    compilation_state.core_module_dependencies,
+                    functions_to_compile,
+                    compilation_data.compilation_options
+                );
+            }
+
+            if (m_tiered_compilation != nullptr)
+            {
+                llvm::orc::JITDylib& library = materialization_responsibility->getTargetJITDylib();
+
+                for (std::size_t index = 0; index < functions_to_compile.size(); ++index)
+                {
+                    std::string_view const function_name = functions_to_compile[index];
+
+                    auto const function_name_location = compilation_data.body_name_to_function_name.find(std::pmr::string{ function_name });
+                    if (function_name_location == compilation_data.body_name_to_function_name.end())
+                        continue;
+
+                    std::string const mangled_function_name = mangle_name(*compilation_data.core_module, function_name, std::nullopt);
+                    llvm::Function* const llvm_function = llvm_module->getFunction(mangled_function_name);
+                    if (llvm_function == nullptr)
+                        continue;
 
-                    llvm::Error error = materialization_responsibility->replace(std::move(new_materialization_unit));
-                    if (error)
-                        h::common::print_message_and_exit(std::format("Error while creating a new materialization unit to replace unrequested symbols to target library: {}", llvm::toString(std::move(error))));
+                    std::string const stub_name = mangle_function_name(*compilation_data.core_module, function_name_location->second);
+
+                    std::atomic<std::uint64_t>& counter = m_tiered_compilation->add_function(
+                        m_compilation_state,
+                        library,
+                        function_name,
+                        function_symbols[index],
+                        m_mangle(stub_name.c_str())
+                    );
+                    add_entry_counter(*llvm_function, counter);
                 }
             }
 
+            // The compile function only stores objects of modules with a cache identifier:
+            if (object_cache_key.has_value())
+                llvm_module->setModuleIdentifier(get_object_cache_module_identifier(object_cache_key.value()));
+
             llvm::orc::ThreadSafeContext thread_safe_context{ std::make_unique<llvm::LLVMContext>() };
             llvm::orc::ThreadSafeModule thread_safe_module{ std::move(llvm_module), std::move(thread_safe_context) };
             m_base_layer.emit(std::move(materialization_responsibility), std::move(thread_safe_module));
@@ -131,8 +452,11 @@ namespace h::compiler
 
         using namespace std::chrono_literals;
 
+        if (m_tiered_compilation != nullptr)
+            m_tiered_compilation->add_tier_0_compilation(std::chrono::duration_cast<std::chrono::microseconds>(end_materializing - begin_materializing));
+
         auto const materialization_duration = (end_materializing - begin_materializing) / 1ms;
-        std::puts(std::format("Materialization of {} took {} ms", m_core_module_compilation_data.core_module.name, materialization_duration).c_str());
+        std::puts(std::format("Materialization of {} took {} ms", compilation_data.core_module->name, materialization_duration).c_str());
     }
 
     void Core_module_materialization_unit::discard(const llvm::orc::JITDylib& library, const llvm::orc::SymbolStringPtr& symbol_name)
@@ -143,10 +467,16 @@ namespace h::compiler
 
     Core_module_layer::Core_module_layer(
         llvm::orc::IRLayer& base_layer,
-        llvm::orc::MangleAndInterner& mangle
+        llvm::orc::ObjectLayer& object_layer,
+        llvm::orc::MangleAndInterner& mangle,
+        Tiered_compilation* const tiered_compilation,
+        JIT_object_cache* const object_cache
     ) :
         m_base_layer{ base_layer },
-        m_mangle{ mangle }
+        m_object_layer{ object_layer },
+        m_mangle{ mangle },
+        m_tiered_compilation{ tiered_compilation },
+        m_object_cache{ object_cache }
     {
     }
 
@@ -160,7 +490,10 @@ namespace h::compiler
         std::unique_ptr<Core_module_materialization_unit> materialization_unit = std::make_unique<Core_module_materialization_unit>(
             std::move(core_module_compilation_data),
             m_mangle,
-            m_base_layer
+            m_base_layer,
+            m_object_layer,
+            m_tiered_compilation,
+            m_object_cache
         );
 
         return library.define(std::move(materialization_unit), resource_tracker);
@@ -174,9 +507,336 @@ namespace h::compiler
         std::unique_ptr<Core_module_materialization_unit> materialization_unit = std::make_unique<Core_module_materialization_unit>(
             std::move(core_module_compilation_data),
             m_mangle,
-            m_base_layer
+            m_base_layer,
+            m_object_layer,
+            m_tiered_compilation,
+            m_object_cache
         );
 
         materialization_unit->materialize(std::move(materialization_responsibility));
     }
+
+    Tiered_compilation::Tiered_compilation(
+        llvm::orc::ExecutionSession& execution_session,
+        llvm::orc::ObjectLayer& object_layer,
+        llvm::orc::IndirectStubsManager& indirect_stubs_manager,
+        llvm::orc::MangleAndInterner& mangle,
+        llvm::orc::JITTargetMachineBuilder target_machine_builder,
+        Compilation_options const& compilation_options,
+        Tiered_compilation_options const& options
+    ) :
+        m_execution_session{ execution_session },
+        m_object_layer{ object_layer },
+        m_indirect_stubs_manager{ indirect_stubs_manager },
+        m_mangle{ mangle },
+        m_compilation_options{ compilation_options },
+        m_options{ options }
+    {
+        m_compilation_options.optimization_level = options.tier_up_optimization_level;
+
+        // The optimizing tier has its own LLVM context, so it never waits for nor races with the
+        // materializations of tier 0:
+        m_llvm_data = std::make_unique<LLVM_data>(initialize_llvm(m_compilation_options));
+
+        target_machine_builder.setCodeGenOptLevel(to_llvm_code_generation_optimization_level(options.tier_up_optimization_level));
+        llvm::Expected<std::unique_ptr<llvm::TargetMachine>> target_machine = target_machine_builder.createTargetMachine();
+        if (!target_machine)
+            h::common::print_message_and_exit(std::format("Could not create target machine for tiered compilation: {}", llvm::toString(target_machine.takeError())));
+        m_target_machine = std::move(*target_machine);
+
+        m_thread = std::thread{ &Tiered_compilation::run, this };
+    }
+
+    Tiered_compilation::~Tiered_compilation()
+    {
+        stop();
+    }
+
+    void Tiered_compilation::stop()
+    {
+        {
+            std::unique_lock<std::mutex> lock{ m_mutex };
+            m_stop = true;
+        }
+        m_condition_variable.notify_all();
+
+        if (m_thread.joinable())
+            m_thread.join();
+    }
+
+    std::atomic<std::uint64_t>& Tiered_compilation::add_function(
+        std::shared_ptr<Core_module_compilation_state> compilation_state,
+        llvm::orc::JITDylib& library,
+        std::string_view const function_name,
+        llvm::orc::SymbolStringPtr body_symbol,
+        llvm::orc::SymbolStringPtr stub_symbol
+    )
+    {
+        std::shared_ptr<Tiered_function> function = std::make_shared<Tiered_function>();
+        function->compilation_state = std::move(compilation_state);
+        function->library = &library;
+        function->function_name = function_name;
+        function->body_symbol = std::move(body_symbol);
+        function->stub_symbol = std::move(stub_symbol);
+        function->call_count = std::make_unique<std::atomic<std::uint64_t>>(0);
+
+        std::atomic<std::uint64_t>& counter = *function->call_count;
+
+        std::unique_lock<std::mutex> lock{ m_mutex };
+
+        // A newer version of the module is being materialized, and the stub is about to point to it:
+        std::shared_ptr<Tiered_function>& entry = m_functions[function->stub_symbol];
+        if (entry != nullptr)
+            retire_function(*entry);
+        entry = std::move(function);
+
+        m_statistics[0].function_count += 1;
+
+        return counter;
+    }
+
+    void Tiered_compilation::retire_function(
+        Tiered_function& function
+    )
+    {
+        m_statistics[0].counted_call_count += function.call_count->load(std::memory_order_relaxed);
+        m_retired_call_counts.push_back(std::move(function.call_count));
+    }
+
+    void Tiered_compilation::add_tier_0_compilation(
+        std::chrono::microseconds const compilation_time
+    )
+    {
+        std::unique_lock<std::mutex> lock{ m_mutex };
+        m_statistics[0].compilation_count += 1;
+        m_statistics[0].compilation_time += compilation_time;
+    }
+
+    llvm::Error Tiered_compilation::update_stub_pointer(
+        llvm::orc::SymbolStringPtr const& stub_symbol,
+        llvm::orc::SymbolStringPtr const& body_symbol,
+        llvm::orc::ExecutorAddr const address
+    )
+    {
+        {
+            std::unique_lock<std::mutex> lock{ m_mutex };
+
+            auto const location = m_functions.find(stub_symbol);
+            if (location != m_functions.end() && location->second->body_symbol != body_symbol)
+            {
+                retire_function(*location->second);
+                m_functions.erase(location);
+            }
+        }
+
+        std::unique_lock<std::mutex> lock{ m_stub_mutex };
+        return m_indirect_stubs_manager.updatePointer(*stub_symbol, address);
+    }
+
+    std::array<Tier_statistics, 2> Tiered_compilation::get_statistics() const
+    {
+        std::unique_lock<std::mutex> lock{ m_mutex };
+
+        std::array<Tier_statistics, 2> statistics = m_statistics;
+        for (auto const& pair : m_functions)
+            statistics[0].counted_call_count += pair.second->call_count->load(std::memory_order_relaxed);
+
+        return statistics;
+    }
+
+    void Tiered_compilation::run()
+    {
+        while (true)
+        {
+            // Shared, because a newer version of the module may retire a function while it is tiered up:
+            std::pmr::vector<std::shared_ptr<Tiered_function>> hot_functions;
+
+            {
+                std::unique_lock<std::mutex> lock{ m_mutex };
+                m_condition_variable.wait_for(lock, m_options.sampling_interval, [&]() -> bool { return m_stop; });
+                if (m_stop)
+                    return;
+
+                for (auto const& pair : m_functions)
+                {
+                    std::shared_ptr<Tiered_function> const& function = pair.second;
+                    if (!function->is_done && is_function_hot(function->call_count->load(std::memory_order_relaxed), m_options))
+                        hot_functions.push_back(function);
+                }
+            }
+
+            for (std::shared_ptr<Tiered_function> const& function : hot_functions)
+            {
+                {
+                    std::unique_lock<std::mutex> lock{ m_mutex };
+                    if (m_stop)
+                        return;
+                }
+
+                tier_up(*function);
+
+                // Only this thread reads the compilation state, so it can be released without locking:
+                function->is_done = true;
+                function->compilation_state.reset();
+            }
+        }
+    }
+
+    static llvm::Expected<llvm::orc::ExecutorAddr> lookup_address(
+        llvm::orc::ExecutionSession& execution_session,
+        llvm::orc::JITDylib& library,
+        llvm::orc::SymbolStringPtr const& symbol,
+        llvm::orc::SymbolState const state
+    )
+    {
+        llvm::Expected<llvm::orc::ExecutorSymbolDef> symbol_definition = execution_session.lookup(
+            llvm::orc::makeJITDylibSearchOrder({ &library }),
+            symbol,
+            state
+        );
+        if (!symbol_definition)
+            return symbol_definition.takeError();
+
+        return symbol_definition->getAddress();
+    }
+
+    void Tiered_compilation::tier_up(
+        Tiered_function& function
+    )
+    {
+        Core_module_compilation_state& compilation_state = *function.compilation_state;
+        Core_module_compilation_data const& compilation_data = compilation_state.data;
+
+        std::chrono::high_resolution_clock::time_point const begin_compiling = std::chrono::high_resolution_clock::now();
+        Profile_zone const profile_zone{compilation_data.profiler, "tier_up", function.function_name};
+
+        auto const fail = [&](std::string_view const message) -> void
+        {
+            std::puts(std::format("Failed to tier up {}: {}", function.function_name, message).c_str());
+
+            std::unique_lock<std::mutex> lock{ m_mutex };
+            m_statistics[1].failed_count += 1;
+        };
+
+        auto const is_current = [&](llvm::orc::ExecutorAddr const body_address) -> bool
+        {
+            llvm::orc::ExecutorSymbolDef const stub = m_indirect_stubs_manager.findStub(*function.stub_symbol, false);
+            return stub != llvm::orc::ExecutorSymbolDef() && stub.getAddress() == body_address;
+        };
+
+        llvm::Expected<llvm::orc::ExecutorAddr> body_address = lookup_address(m_execution_session, *function.library, function.body_symbol, llvm::orc::SymbolState::Resolved);
+        if (!body_address)
+            return fail(llvm::toString(body_address.takeError()));
+
+        // The module was recompiled after a change, so the stub points to a newer tier 0 version:
+        {
+            std::unique_lock<std::mutex> lock{ m_stub_mutex };
+            if (!is_current(*body_address))
+            {
+                std::unique_lock<std::mutex> statistics_lock{ m_mutex };
+                m_statistics[1].discarded_count += 1;
+                return;
+            }
+        }
+
+        std::string const mangled_body_name = mangle_name(*compilation_data.core_module, function.function_name, std::nullopt);
+        std::string const optimized_body_name = std::format("{}$tier_1", mangled_body_name);
+
+        std::unique_ptr<llvm::Module> llvm_module;
+
+        try
+        {
+            std::lock_guard<std::mutex> const lock{ compilation_state.mutex };
+
+            if (compilation_state.optimized_prepared_core_module == nullptr)
+            {
+                compilation_state.optimized_prepared_core_module = h::compiler::prepare_core_module(
+                    *m_llvm_data,
+                    get_declarations_module(compilation_data),
+                    create_module_to_prepare(compilation_data),
+                    compilation_state.core_module_dependencies
+                );
+            }
+
+            std::array<std::string_view, 1> const functions_to_compile{ function.function_name };
+            llvm_module = h::compiler::create_llvm_module(
+                *m_llvm_data,
+                *compilation_state.optimized_prepared_core_module,
+                compilation_state.core_module_dependencies,
+                functions_to_compile,
+                m_compilation_options
+            );
+        }
+        catch (std::exception const& exception)
+        {
+            return fail(exception.what());
+        }
+
+        // Tier 0 code keeps its symbol, so the optimized function gets a new one:
+        llvm::Function* const llvm_function = llvm_module->getFunction(mangled_body_name);
+        if (llvm_function == nullptr)
+            return fail("function was not generated");
+        llvm_function->setName(optimized_body_name);
+
+        llvm::orc::SimpleCompiler compiler{ *m_target_machine };
+        llvm::Expected<std::unique_ptr<llvm::MemoryBuffer>> object = compiler(*llvm_module);
+        if (!object)
+            return fail(llvm::toString(object.takeError()));
+
+        if (llvm::Error error = m_object_layer.add(function.library->createResourceTracker(), std::move(*object)))
+            return fail(llvm::toString(std::move(error)));
+
+        llvm::Expected<llvm::orc::ExecutorAddr> optimized_address = lookup_address(m_execution_session, *function.library, m_mangle(optimized_body_name), llvm::orc::SymbolState::Ready);
+        if (!optimized_address)
+            return fail(llvm::toString(optimized_address.takeError()));
+
+        {
+            std::unique_lock<std::mutex> lock{ m_stub_mutex };
+
+            if (!is_current(*body_address))
+            {
+                std::unique_lock<std::mutex> statistics_lock{ m_mutex };
+                m_statistics[1].discarded_count += 1;
+                return;
+            }
+
+            if (llvm::Error error = m_indirect_stubs_manager.updatePointer(*function.stub_symbol, *optimized_address))
+                return fail(llvm::toString(std::move(error)));
+        }
+
+        std::chrono::high_resolution_clock::time_point const end_compiling = std::chrono::high_resolution_clock::now();
+
+        {
+            std::unique_lock<std::mutex> lock{ m_mutex };
+            m_statistics[1].function_count += 1;
+            m_statistics[1].compilation_count += 1;
+            m_statistics[1].compilation_time += std::chrono::duration_cast<std::chrono::microseconds>(end_compiling - begin_compiling);
+        }
+    }
+
+    bool is_function_hot(
+        std::uint64_t const call_count,
+        Tiered_compilation_options const& options
+    )
+    {
+        return call_count >= options.tier_up_call_count;
+    }
+
+    std::string get_tier_statistics_report(
+        std::array<Tier_statistics, 2> const& statistics,
+        Tiered_compilation_options const& options
+    )
+    {
+        using namespace std::chrono_literals;
+
+        Tier_statistics const& tier_0 = statistics[0];
+        Tier_statistics const& tier_1 = statistics[1];
+
+        return std::format(
+            "Tier 0 (O0): {} functions, {} compilations in {}ms, {} calls counted\n"
+            "Tier 1 ({}): {} functions tiered up after {} calls, {} compilations in {}ms, {} discarded, {} failed\n",
+            tier_0.function_count, tier_0.compilation_count, tier_0.compilation_time / 1ms, tier_0.counted_call_count,
+            to_string(options.tier_up_optimization_level), tier_1.function_count, options.tier_up_call_count, tier_1.compilation_count, tier_1.compilation_time / 1ms, tier_1.discarded_count, tier_1.failed_count
+        );
+    }
 }
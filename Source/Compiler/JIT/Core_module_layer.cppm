@@ -1,29 +1,176 @@
 module;
 
+#include <llvm/ADT/DenseMap.h>
 #include <llvm/ExecutionEngine/Orc/Core.h>
+#include <llvm/ExecutionEngine/Orc/IndirectionUtils.h>
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
 #include <llvm/ExecutionEngine/Orc/Layer.h>
-
+#include <llvm/ExecutionEngine/Orc/Mangling.h>
+#include <llvm/Target/TargetMachine.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <filesystem>
 #include <memory>
 #include <memory_resource>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 export module h.compiler.core_module_layer;
 
 import h.core;
 import h.compiler;
+import h.compiler.jit_object_cache;
+import h.compiler.profiler;
+import h.compiler.target;
 
 namespace h::compiler
 {
     export struct Core_module_compilation_data
     {
         LLVM_data& llvm_data;
-        h::Module core_module;
+        std::shared_ptr<h::Module const> core_module; // Shared with the JIT runner, so it is never modified
         std::pmr::unordered_map<std::pmr::string, h::Module> core_module_dependencies;
         Compilation_options compilation_options;
+        Profiler* profiler = nullptr;
+        std::shared_ptr<h::Module const> renamed_declarations; // Declarations of core_module using the body names, set by the recompile module layer
+        std::pmr::unordered_map<std::pmr::string, std::pmr::string> function_name_to_body_name; // Filled by the recompile module layer
+        std::pmr::unordered_map<std::pmr::string, std::pmr::string> body_name_to_function_name; // Filled by the recompile module layer
+    };
+
+    // Shared by the materialization units of one version of a module, so that the module is
+    // analyzed once no matter how many times its functions are lazily materialized.
+    struct Core_module_compilation_state
+    {
+        Core_module_compilation_data data;
+        std::pmr::unordered_map<std::pmr::string, h::Module const*> core_module_dependencies; // Points into data
+        llvm::DenseMap<llvm::orc::SymbolStringPtr, std::pmr::string> symbol_to_function_name;
+        std::unique_ptr<Prepared_core_module> prepared_core_module;
+        std::unique_ptr<Prepared_core_module> optimized_prepared_core_module; // Prepared with the LLVM data of the optimizing tier
+        std::uint64_t object_cache_module_hash = 0; // Only computed when using the object cache
+        std::pmr::unordered_map<std::pmr::string, std::uint64_t> function_hashes;
+        std::mutex mutex;
+    };
+
+    export struct Tiered_compilation_options
+    {
+        std::uint64_t tier_up_call_count = 10000;
+        Optimization_level tier_up_optimization_level = Optimization_level::O2;
+        std::chrono::milliseconds sampling_interval{ 10 };
+    };
+
+    export struct Tier_statistics
+    {
+        std::uint64_t function_count = 0;
+        std::uint64_t compilation_count = 0;
+        std::chrono::microseconds compilation_time{ 0 };
+        std::uint64_t counted_call_count = 0;
+        std::uint64_t discarded_count = 0;
+        std::uint64_t failed_count = 0;
+    };
+
+    struct Tiered_function
+    {
+        std::shared_ptr<Core_module_compilation_state> compilation_state;
+        llvm::orc::JITDylib* library = nullptr;
+        std::pmr::string function_name;
+        llvm::orc::SymbolStringPtr body_symbol;
+        llvm::orc::SymbolStringPtr stub_symbol;
+        std::unique_ptr<std::atomic<std::uint64_t>> call_count; // Incremented by the tier 0 code
+        bool is_done = false;
+    };
+
+    export bool is_function_hot(
+        std::uint64_t call_count,
+        Tiered_compilation_options const& options
+    );
+
+    // Functions are first compiled without optimizations and count how many times they are entered.
+    // A background thread recompiles the functions that cross the call count threshold with
+    // optimizations and points their stubs to the optimized code.
+    export class Tiered_compilation
+    {
+    public:
+
+        Tiered_compilation(
+            llvm::orc::ExecutionSession& execution_session,
+            llvm::orc::ObjectLayer& object_layer,
+            llvm::orc::IndirectStubsManager& indirect_stubs_manager,
+            llvm::orc::MangleAndInterner& mangle,
+            llvm::orc::JITTargetMachineBuilder target_machine_builder,
+            Compilation_options const& compilation_options,
+            Tiered_compilation_options const& options
+        );
+        ~Tiered_compilation();
+
+        Tiered_compilation(Tiered_compilation const&) = delete;
+        Tiered_compilation& operator=(Tiered_compilation const&) = delete;
+
+        std::atomic<std::uint64_t>& add_function(
+            std::shared_ptr<Core_module_compilation_state> compilation_state,
+            llvm::orc::JITDylib& library,
+            std::string_view function_name,
+            llvm::orc::SymbolStringPtr body_symbol,
+            llvm::orc::SymbolStringPtr stub_symbol
+        );
+
+        void add_tier_0_compilation(
+            std::chrono::microseconds compilation_time
+        );
+
+        llvm::Error update_stub_pointer(
+            llvm::orc::SymbolStringPtr const& stub_symbol,
+            llvm::orc::SymbolStringPtr const& body_symbol,
+            llvm::orc::ExecutorAddr address
+        );
+
+        std::array<Tier_statistics, 2> get_statistics() const;
+
+        // Waits for the function being tiered up and stops the background thread.
+        void stop();
+
+        Tiered_compilation_options const& get_options() const
+        {
+            return m_options;
+        }
+
+    private:
+        void run();
+        void tier_up(Tiered_function& function);
+        void retire_function(Tiered_function& function);
+
+        llvm::orc::ExecutionSession& m_execution_session;
+        llvm::orc::ObjectLayer& m_object_layer;
+        llvm::orc::IndirectStubsManager& m_indirect_stubs_manager;
+        llvm::orc::MangleAndInterner& m_mangle;
+        Compilation_options m_compilation_options;
+        Tiered_compilation_options m_options;
+        std::unique_ptr<LLVM_data> m_llvm_data;
+        std::unique_ptr<llvm::TargetMachine> m_target_machine;
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_condition_variable;
+        llvm::DenseMap<llvm::orc::SymbolStringPtr, std::shared_ptr<Tiered_function>> m_functions; // By stub symbol, only the latest version of each function
+        std::pmr::vector<std::unique_ptr<std::atomic<std::uint64_t>>> m_retired_call_counts; // Tier 0 code of replaced versions is never removed and may still increment them
+        std::array<Tier_statistics, 2> m_statistics;
+        bool m_stop = false;
+
+        std::mutex m_stub_mutex;
+        std::thread m_thread;
     };
 
+    export std::string get_tier_statistics_report(
+        std::array<Tier_statistics, 2> const& statistics,
+        Tiered_compilation_options const& options
+    );
+
     export class Core_module_materialization_unit : public llvm::orc::MaterializationUnit
     {
     public:
@@ -31,7 +178,20 @@ namespace h::compiler
         Core_module_materialization_unit(
             Core_module_compilation_data core_module_compilation_data,
             llvm::orc::MangleAndInterner& mangle,
-            llvm::orc::IRLayer& base_layer
+            llvm::orc::IRLayer& base_layer,
+            llvm::orc::ObjectLayer& object_layer,
+            Tiered_compilation* tiered_compilation,
+            JIT_object_cache* object_cache
+        );
+
+        Core_module_materialization_unit(
+            std::shared_ptr<Core_module_compilation_state> compilation_state,
+            llvm::orc::SymbolFlagsMap symbols,
+            llvm::orc::MangleAndInterner& mangle,
+            llvm::orc::IRLayer& base_layer,
+            llvm::orc::ObjectLayer& object_layer,
+            Tiered_compilation* tiered_compilation,
+            JIT_object_cache* object_cache
         );
 
         llvm::StringRef getName() const final
@@ -46,9 +206,21 @@ namespace h::compiler
         void discard(const llvm::orc::JITDylib& library, const llvm::orc::SymbolStringPtr& symbol_name) final;
 
     private:
-        Core_module_compilation_data m_core_module_compilation_data;
+        Core_module_materialization_unit(
+            std::shared_ptr<Core_module_compilation_state> compilation_state,
+            llvm::orc::MangleAndInterner& mangle,
+            llvm::orc::IRLayer& base_layer,
+            llvm::orc::ObjectLayer& object_layer,
+            Tiered_compilation* tiered_compilation,
+            JIT_object_cache* object_cache
+        );
+
+        std::shared_ptr<Core_module_compilation_state> m_compilation_state;
         llvm::orc::MangleAndInterner& m_mangle;
         llvm::orc::IRLayer& m_base_layer;
+        llvm::orc::ObjectLayer& m_object_layer;
+        Tiered_compilation* m_tiered_compilation;
+        JIT_object_cache* m_object_cache;
     };
 
     export class Core_module_layer
@@ -57,7 +229,10 @@ namespace h::compiler
 
         Core_module_layer(
             llvm::orc::IRLayer& base_layer,
-            llvm::orc::MangleAndInterner& mangle
+            llvm::orc::ObjectLayer& object_layer,
+            llvm::orc::MangleAndInterner& mangle,
+            Tiered_compilation* tiered_compilation,
+            JIT_object_cache* object_cache
         );
 
         llvm::Error add(
@@ -72,6 +247,9 @@ namespace h::compiler
 
     private:
         llvm::orc::IRLayer& m_base_layer;
+        llvm::orc::ObjectLayer& m_object_layer;
         llvm::orc::MangleAndInterner& m_mangle;
+        Tiered_compilation* m_tiered_compilation;
+        JIT_object_cache* m_object_cache;
     };
 }
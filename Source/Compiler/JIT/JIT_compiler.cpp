@@ -3,11 +3,13 @@ module;
 #include <llvm/ExecutionEngine/JITSymbol.h>
 #include <llvm/ExecutionEngine/SectionMemoryManager.h>
 #include <llvm/ExecutionEngine/Orc/Debugging/DebuggerSupport.h>
+#include <llvm/ExecutionEngine/Orc/CompileUtils.h>
 #include <llvm/ExecutionEngine/Orc/Core.h>
 #include <llvm/ExecutionEngine/Orc/EPCIndirectionUtils.h>
 #include <llvm/ExecutionEngine/Orc/ExecutorProcessControl.h>
 #include <llvm/ExecutionEngine/Orc/IndirectionUtils.h>
 #include <llvm/ExecutionEngine/Orc/IRCompileLayer.h>
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
 #include <llvm/ExecutionEngine/Orc/LazyReexports.h>
 #include <llvm/ExecutionEngine/Orc/LLJIT.h>
 #include <llvm/ExecutionEngine/Orc/RTDyldObjectLinkingLayer.h>
@@ -16,9 +18,14 @@ module;
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/ValueSymbolTable.h>
+#include <llvm/Config/llvm-config.h>
 #include <llvm/Support/Error.h>
 #include <llvm/TargetParser/Host.h>
+#include <llvm/TargetParser/SubtargetFeature.h>
 
+#include <xxhash.h>
+
+#include <cstdint>
 #include <filesystem>
 #include <future>
 #include <memory>
@@ -33,14 +40,18 @@ module h.compiler.jit_compiler;
 import h.common;
 import h.common.filesystem;
 import h.compiler;
+import h.compiler.build_database;
 import h.compiler.common;
 import h.compiler.core_module_layer;
+import h.compiler.function_cache;
+import h.compiler.jit_object_cache;
 import h.compiler.recompile_module_layer;
 
 namespace h::compiler
 {
     JIT_data::~JIT_data()
     {
+        tiered_compilation.reset();
         recompile_module_layer.reset();
         core_module_layer.reset();
         compile_on_demand_layer.reset();
@@ -56,18 +67,114 @@ namespace h::compiler
         epc_indirection_utils.reset();
 
         llvm_jit.reset();
+
+        // The compile layer of the JIT refers to the object cache:
+        object_cache.reset();
+    }
+
+    static llvm::orc::JITTargetMachineBuilder create_target_machine_builder(
+        std::optional<Target_cpu> const& target_cpu
+    )
+    {
+        llvm::Expected<llvm::orc::JITTargetMachineBuilder> target_machine_builder = llvm::orc::JITTargetMachineBuilder::detectHost();
+        if (!target_machine_builder)
+            h::common::print_message_and_exit(std::format("Could not detect JIT host: {}", llvm::toString(target_machine_builder.takeError())));
+
+        if (target_cpu.has_value())
+        {
+            target_machine_builder->setCPU(std::string{target_cpu->name});
+            target_machine_builder->getFeatures() = llvm::SubtargetFeatures{std::string_view{target_cpu->features}};
+        }
+
+        return std::move(*target_machine_builder);
+    }
+
+    // Everything besides the modules themselves that changes the generated objects:
+    static std::uint64_t compute_object_cache_compilation_key(
+        llvm::orc::JITTargetMachineBuilder const& target_machine_builder,
+        Compilation_options const& compilation_options
+    )
+    {
+        static constexpr std::uint64_t format_version = 1;
+
+        XXH64_state_t* const state = XXH64_createState();
+        if (state == nullptr)
+            h::common::print_message_and_exit("Could not initialize xxhash state!");
+
+        XXH64_reset(state, format_version);
+
+        auto const update_string = [state](std::string_view const value) -> void
+        {
+            XXH64_update(state, value.data(), value.size());
+            XXH64_update(state, "\0", 1);
+        };
+
+        update_string(LLVM_VERSION_STRING);
+        update_string(target_machine_builder.getTargetTriple().str());
+        update_string(target_machine_builder.getCPU());
+        update_string(target_machine_builder.getFeatures().getString());
+
+        std::uint64_t const options[] =
+        {
+            static_cast<std::uint64_t>(compilation_options.optimization_level),
+            static_cast<std::uint64_t>(compilation_options.debug),
+            static_cast<std::uint64_t>(compilation_options.contract_options),
+            static_cast<std::uint64_t>(compilation_options.pgo_options.mode),
+        };
+        XXH64_update(state, options, sizeof(options));
+
+        if (compilation_options.pgo_options.profile_path.has_value())
+        {
+            std::filesystem::path const& profile_path = compilation_options.pgo_options.profile_path.value();
+            update_string(profile_path.generic_string());
+
+            // Hashing the contents invalidates the cache when a new profile is merged, and only then:
+            std::uint64_t const profile_hash = hash_file_contents(profile_path).value_or(0);
+            XXH64_update(state, &profile_hash, sizeof(profile_hash));
+        }
+
+        std::uint64_t const key = XXH64_digest(state);
+        XXH64_freeState(state);
+
+        return key;
     }
 
     std::unique_ptr<JIT_data> create_jit_data(
         llvm::DataLayout& llvm_data_layout,
         std::pmr::vector<std::filesystem::path> search_library_paths,
-        bool const debug
+        std::optional<Target_cpu> const& target_cpu,
+        Compilation_options const& compilation_options,
+        std::optional<Tiered_compilation_options> const& tiered_compilation_options,
+        std::optional<Function_cache> const& object_cache_storage
     )
     {
         llvm::orc::LLJITBuilder builder;
         builder.setDataLayout(llvm_data_layout);
 
-        if (debug)
+        // Without an explicit CPU, LLJIT targets the host:
+        if (target_cpu.has_value() || object_cache_storage.has_value())
+            builder.setJITTargetMachineBuilder(create_target_machine_builder(target_cpu));
+
+        // Tier 0 code embeds the addresses of the call counters, so it cannot be reused by another process:
+        std::unique_ptr<JIT_object_cache> object_cache = object_cache_storage.has_value() && !tiered_compilation_options.has_value() ?
+            std::make_unique<JIT_object_cache>(
+                object_cache_storage.value(),
+                compute_object_cache_compilation_key(*builder.getJITTargetMachineBuilder(), compilation_options)
+            ) :
+            nullptr;
+
+        if (object_cache != nullptr)
+        {
+            // Modules may be materialized from several threads, so use a compiler that creates a target machine per module:
+            builder.setCompileFunctionCreator(
+                [object_cache = object_cache.get()](llvm::orc::JITTargetMachineBuilder target_machine_builder) -> llvm::Expected<std::unique_ptr<llvm::orc::IRCompileLayer::IRCompiler>>
+                {
+                    return std::make_unique<llvm::orc::ConcurrentIRCompiler>(std::move(target_machine_builder), object_cache);
+                }
+            );
+        }
+
+        if (compilation_options.debug)
         {
               builder.setPrePlatformSetup(
                 [](llvm::orc::LLJIT& llvm_jit) -> llvm::Error
@@ -108,10 +215,25 @@ namespace h::compiler
             [&epc = *epc_indirection_utils.get()]() { return epc.createIndirectStubsManager(); }
         );
 
+        std::unique_ptr<Tiered_compilation> tiered_compilation = tiered_compilation_options.has_value() ?
+            std::make_unique<Tiered_compilation>(
+                llvm_jit->getExecutionSession(),
+                llvm_jit->getObjLinkingLayer(),
+                *indirect_stubs_manager,
+                *mangle,
+                create_target_machine_builder(target_cpu),
+                compilation_options,
+                tiered_compilation_options.value()
+            ) :
+            nullptr;
+
         std::unique_ptr<Core_module_layer> core_module_layer = std::make_unique<Core_module_layer>(
             //*compile_on_demand_layer,
             llvm_jit->getIRCompileLayer(),
-            *mangle
+            llvm_jit->getObjLinkingLayer(),
+            *mangle,
+            tiered_compilation.get(),
+            object_cache.get()
         );
 
         std::unique_ptr<Recompile_module_layer> recompile_module_layer = std::make_unique<Recompile_module_layer>(
@@ -119,16 +241,19 @@ namespace h::compiler
             *core_module_layer,
             *local_lazy_call_through_manager->get(),
             *indirect_stubs_manager,
-            *mangle
+            *mangle,
+            tiered_compilation.get()
         );
 
         std::unique_ptr<JIT_data> jit_data = std::make_unique<JIT_data>();
+        jit_data->object_cache = std::move(object_cache);
         jit_data->llvm_jit = std::move(llvm_jit);
         jit_data->epc_indirection_utils = std::move(*epc_indirection_utils);
         jit_data->indirect_stubs_manager = std::move(indirect_stubs_manager);
         jit_data->lazy_call_through_manager = std::move(*local_lazy_call_through_manager);
         jit_data->mangle = std::move(mangle);
         jit_data->compile_on_demand_layer = std::move(compile_on_demand_layer);
+        jit_data->tiered_compilation = std::move(tiered_compilation);
         jit_data->core_module_layer = std::move(core_module_layer);
         jit_data->recompile_module_layer = std::move(recompile_module_layer);
         jit_data->search_library_paths = std::move(search_library_paths);
@@ -164,7 +289,7 @@ namespace h::compiler
     )
     {
         llvm::orc::JITDylib& library = jit_data.llvm_jit->getMainJITDylib();
-        return add_core_module(jit_data, library, core_compilation_data);
+        return add_core_module(jit_data, library, std::move(core_compilation_data));
     }
 
     llvm::orc::JITDylib& get_main_library(
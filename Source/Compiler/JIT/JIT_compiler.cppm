@@ -22,6 +22,8 @@ export module h.compiler.jit_compiler;
 import h.core;
 import h.compiler;
 import h.compiler.core_module_layer;
+import h.compiler.function_cache;
+import h.compiler.jit_object_cache;
 import h.compiler.recompile_module_layer;
 
 namespace h::compiler
@@ -30,12 +32,14 @@ namespace h::compiler
     {
         ~JIT_data();
 
+        std::unique_ptr<JIT_object_cache> object_cache;
         std::unique_ptr<llvm::orc::LLJIT> llvm_jit;
         std::unique_ptr<llvm::orc::EPCIndirectionUtils> epc_indirection_utils;
         std::unique_ptr<llvm::orc::IndirectStubsManager> indirect_stubs_manager;
         std::unique_ptr<llvm::orc::LazyCallThroughManager> lazy_call_through_manager;
         std::unique_ptr<llvm::orc::MangleAndInterner> mangle;
         std::unique_ptr<llvm::orc::CompileOnDemandLayer> compile_on_demand_layer;
+        std::unique_ptr<Tiered_compilation> tiered_compilation;
         std::unique_ptr<Core_module_layer> core_module_layer;
         std::unique_ptr<Recompile_module_layer> recompile_module_layer;
         std::pmr::vector<std::filesystem::path> search_library_paths;
@@ -44,7 +48,10 @@ namespace h::compiler
     export std::unique_ptr<JIT_data> create_jit_data(
         llvm::DataLayout& llvm_data_layout,
         std::pmr::vector<std::filesystem::path> search_library_paths,
-        bool const debug
+        std::optional<Target_cpu> const& target_cpu,
+        Compilation_options const& compilation_options,
+        std::optional<Tiered_compilation_options> const& tiered_compilation_options = std::nullopt,
+        std::optional<Function_cache> const& object_cache_storage = std::nullopt
     );
 
     export bool add_core_module(
@@ -0,0 +1,168 @@
+module;
+
+#include <llvm/ExecutionEngine/ObjectCache.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/ErrorOr.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+module h.compiler.jit_object_cache;
+
+import h.common.filesystem;
+import h.compiler.function_cache;
+
+namespace h::compiler
+{
+    static constexpr std::string_view module_identifier_prefix = "h_jit_object_cache:";
+
+    JIT_object_cache::JIT_object_cache(
+        Function_cache storage,
+        std::uint64_t const compilation_key
+    ) :
+        m_storage{ std::move(storage) },
+        m_compilation_key{ compilation_key }
+    {
+        std::error_code error_code;
+        std::filesystem::create_directories(m_storage.directory, error_code);
+        if (error_code)
+            std::puts(std::format("Failed to create JIT object cache directory {}: {}", m_storage.directory.generic_string(), error_code.message()).c_str());
+
+        m_evicted_count = evict_function_cache_entries(m_storage);
+    }
+
+    void JIT_object_cache::notifyObjectCompiled(
+        llvm::Module const* const llvm_module,
+        llvm::MemoryBufferRef const object
+    )
+    {
+        std::optional<std::uint64_t> const key = get_object_cache_key(llvm_module->getModuleIdentifier());
+        if (!key.has_value())
+            return;
+
+        std::filesystem::path const entry_path = get_function_cache_entry_path(m_storage, key.value(), "o");
+
+        // Write to a temporary file first so that readers never see a partially written object:
+        std::filesystem::path const temporary_file_path = h::common::get_temporary_file_path(entry_path);
+
+        {
+            std::ofstream output_stream{ temporary_file_path, std::ios::binary | std::ios::trunc };
+            output_stream.write(object.getBufferStart(), static_cast<std::streamsize>(object.getBufferSize()));
+            if (!output_stream)
+            {
+                std::puts(std::format("Failed to write JIT object cache entry {}", entry_path.generic_string()).c_str());
+                return;
+            }
+        }
+
+        std::error_code error_code;
+        std::filesystem::rename(temporary_file_path, entry_path, error_code);
+        if (error_code)
+        {
+            std::puts(std::format("Failed to write JIT object cache entry {}: {}", entry_path.generic_string(), error_code.message()).c_str());
+            return;
+        }
+
+        m_write_count += 1;
+    }
+
+    std::unique_ptr<llvm::MemoryBuffer> JIT_object_cache::getObject(
+        llvm::Module const* const llvm_module
+    )
+    {
+        std::optional<std::uint64_t> const key = get_object_cache_key(llvm_module->getModuleIdentifier());
+        if (!key.has_value())
+            return nullptr;
+
+        return read_object(key.value());
+    }
+
+    std::unique_ptr<llvm::MemoryBuffer> JIT_object_cache::get_object(
+        std::uint64_t const key
+    )
+    {
+        std::unique_ptr<llvm::MemoryBuffer> object = read_object(key);
+
+        if (object != nullptr)
+            m_hit_count += 1;
+        else
+            m_miss_count += 1;
+
+        return object;
+    }
+
+    std::unique_ptr<llvm::MemoryBuffer> JIT_object_cache::read_object(
+        std::uint64_t const key
+    ) const
+    {
+        std::filesystem::path const entry_path = get_function_cache_entry_path(m_storage, key, "o");
+        if (!use_function_cache_entry(entry_path))
+            return nullptr;
+
+        llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> object = llvm::MemoryBuffer::getFile(entry_path.generic_string(), false, false);
+        if (!object)
+            return nullptr;
+
+        return std::move(*object);
+    }
+
+    JIT_object_cache_statistics JIT_object_cache::get_statistics() const
+    {
+        return JIT_object_cache_statistics
+        {
+            .hit_count = m_hit_count.load(),
+            .miss_count = m_miss_count.load(),
+            .write_count = m_write_count.load(),
+            .evicted_count = m_evicted_count,
+        };
+    }
+
+    std::string get_object_cache_module_identifier(
+        std::uint64_t const key
+    )
+    {
+        return std::format("{}{:016x}", module_identifier_prefix, key);
+    }
+
+    std::optional<std::uint64_t> get_object_cache_key(
+        std::string_view const module_identifier
+    )
+    {
+        if (!module_identifier.starts_with(module_identifier_prefix))
+            return std::nullopt;
+
+        std::string_view const key_string = module_identifier.substr(module_identifier_prefix.size());
+
+        std::uint64_t key = 0;
+        std::from_chars_result const result = std::from_chars(key_string.data(), key_string.data() + key_string.size(), key, 16);
+        if (result.ec != std::errc{} || result.ptr != key_string.data() + key_string.size())
+            return std::nullopt;
+
+        return key;
+    }
+
+    std::string get_object_cache_statistics_report(
+        JIT_object_cache_statistics const& statistics
+    )
+    {
+        return std::format(
+            "Object cache: {} hits, {} misses, {} written, {} evicted\n",
+            statistics.hit_count,
+            statistics.miss_count,
+            statistics.write_count,
+            statistics.evicted_count
+        );
+    }
+}
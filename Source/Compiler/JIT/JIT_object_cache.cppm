@@ -0,0 +1,86 @@
+module;
+
+#include <llvm/ExecutionEngine/ObjectCache.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+export module h.compiler.jit_object_cache;
+
+import h.compiler.function_cache;
+
+namespace h::compiler
+{
+    export struct JIT_object_cache_statistics
+    {
+        std::uint64_t hit_count = 0;
+        std::uint64_t miss_count = 0;
+        std::uint64_t write_count = 0;
+        std::uint64_t evicted_count = 0;
+    };
+
+    // Object files compiled by the JIT, stored in the build directory so that a restarted JIT does not
+    // compile the modules that did not change. Only modules whose identifier was created with
+    // get_object_cache_module_identifier are cached, so that modules that embed process specific
+    // addresses are never reused.
+    export class JIT_object_cache final : public llvm::ObjectCache
+    {
+    public:
+
+        JIT_object_cache(
+            Function_cache storage,
+            std::uint64_t compilation_key
+        );
+
+        void notifyObjectCompiled(
+            llvm::Module const* llvm_module,
+            llvm::MemoryBufferRef object
+        ) final;
+
+        std::unique_ptr<llvm::MemoryBuffer> getObject(
+            llvm::Module const* llvm_module
+        ) final;
+
+        std::unique_ptr<llvm::MemoryBuffer> get_object(
+            std::uint64_t key
+        );
+
+        std::uint64_t get_compilation_key() const
+        {
+            return m_compilation_key;
+        }
+
+        JIT_object_cache_statistics get_statistics() const;
+
+    private:
+        std::unique_ptr<llvm::MemoryBuffer> read_object(
+            std::uint64_t key
+        ) const;
+
+        Function_cache m_storage;
+        std::uint64_t m_compilation_key;
+        std::uint64_t m_evicted_count = 0;
+        std::atomic<std::uint64_t> m_hit_count = 0;
+        std::atomic<std::uint64_t> m_miss_count = 0;
+        std::atomic<std::uint64_t> m_write_count = 0;
+    };
+
+    export std::string get_object_cache_module_identifier(
+        std::uint64_t key
+    );
+
+    export std::optional<std::uint64_t> get_object_cache_key(
+        std::string_view module_identifier
+    );
+
+    export std::string get_object_cache_statistics_report(
+        JIT_object_cache_statistics const& statistics
+    );
+}
@@ -17,6 +17,8 @@ module;
 
 #include <wtr/watcher.hpp>
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <cstdio>
@@ -28,12 +30,17 @@ module;
 #include <mutex>
 #include <optional>
 #include <shared_mutex>
+#include <stdexcept>
 #include <string>
 #include <span>
+#include <system_error>
+#include <thread>
+#include <utility>
 #include <variant>
 
 module h.compiler.jit_runner;
 
+import h.binary_serializer;
 import h.common;
 import h.common.filesystem;
 import h.compiler;
@@ -42,24 +49,58 @@ import h.compiler.common;
 import h.compiler.core_module_layer;
 import h.compiler.file_watcher;
 import h.core.hash;
+import h.compiler.function_cache;
 import h.compiler.jit_compiler;
+import h.compiler.jit_object_cache;
+import h.compiler.parallel;
+import h.compiler.profiler;
 import h.compiler.recompilation;
 import h.compiler.repository;
 import h.compiler.target;
 import h.core;
 import h.c_header_converter;
-import h.json_serializer;
 import h.parser.convertor;
 import h.parser.parser;
 
 namespace h::compiler
 {
+    static void stop_module_writer(
+        Module_writer& module_writer
+    );
+
+    static void stop_file_change_dispatcher(
+        File_change_queue& file_change_queue
+    );
+
     JIT_runner::~JIT_runner()
     {
         this->file_watcher.reset();
+
+        if (this->file_change_queue != nullptr)
+            stop_file_change_dispatcher(*this->file_change_queue);
+
+        if (this->unprotected_data.module_writer != nullptr)
+            stop_module_writer(*this->unprotected_data.module_writer);
+
+        if (this->unprotected_data.jit_data != nullptr && this->unprotected_data.jit_data->tiered_compilation != nullptr)
+        {
+            Tiered_compilation& tiered_compilation = *this->unprotected_data.jit_data->tiered_compilation;
+            tiered_compilation.stop();
+
+            if (this->unprotected_data.log_level >= 1)
+                std::fputs(get_tier_statistics_report(tiered_compilation.get_statistics(), tiered_compilation.get_options()).c_str(), stdout);
+        }
+
+        if (this->unprotected_data.log_level >= 1 && this->unprotected_data.jit_data != nullptr && this->unprotected_data.jit_data->object_cache != nullptr)
+            std::fputs(get_object_cache_statistics_report(this->unprotected_data.jit_data->object_cache->get_statistics()).c_str(), stdout);
+
         this->protected_data.symbol_to_module_name_map.clear();
         this->unprotected_data.jit_data.reset();
         this->unprotected_data.llvm_data.reset();
+
+        // Written last, because the chrome trace reads the buffers of every profiled thread:
+        if (this->unprotected_data.profile_output_path.has_value())
+            write_chrome_trace(*this->unprotected_data.profiler, this->unprotected_data.profile_output_path.value());
     }
 
     static std::optional<std::pmr::string> read_module_name(std::filesystem::path const& unparsed_file_path)
@@ -100,6 +141,112 @@ namespace h::compiler
         return module_name;
     }
 
+    static void run_module_writer(
+        Module_writer& module_writer
+    )
+    {
+        while (true)
+        {
+            std::pmr::unordered_map<std::filesystem::path, std::shared_ptr<h::Module const>> pending_writes;
+
+            {
+                std::unique_lock<std::mutex> lock{ module_writer.mutex };
+                module_writer.condition_variable.wait(lock, [&]() -> bool { return module_writer.stop || !module_writer.pending_writes.empty(); });
+
+                // Pending writes are flushed before stopping:
+                if (module_writer.pending_writes.empty())
+                    return;
+
+                pending_writes.swap(module_writer.pending_writes);
+            }
+
+            for (std::pair<std::filesystem::path const, std::shared_ptr<h::Module const>> const& pending_write : pending_writes)
+            {
+                std::filesystem::path const& module_file_path = pending_write.first;
+
+                // Write to a temporary file first so that readers never see a partially written module:
+                std::filesystem::path temporary_file_path = module_file_path;
+                temporary_file_path += ".tmp";
+
+                if (!h::binary_serializer::write_module_to_file(temporary_file_path, *pending_write.second, {}))
+                {
+                    std::puts(std::format("Failed to write {}", module_file_path.generic_string()).c_str());
+                    continue;
+                }
+
+                std::error_code error_code;
+                std::filesystem::rename(temporary_file_path, module_file_path, error_code);
+                if (error_code)
+                    std::puts(std::format("Failed to write {}: {}", module_file_path.generic_string(), error_code.message()).c_str());
+            }
+        }
+    }
+
+    static std::unique_ptr<Module_writer> create_module_writer()
+    {
+        std::unique_ptr<Module_writer> module_writer = std::make_unique<Module_writer>();
+        module_writer->thread = std::thread{ run_module_writer, std::ref(*module_writer) };
+        return module_writer;
+    }
+
+    static void stop_module_writer(
+        Module_writer& module_writer
+    )
+    {
+        {
+            std::unique_lock<std::mutex> lock{ module_writer.mutex };
+            module_writer.stop = true;
+        }
+        module_writer.condition_variable.notify_all();
+
+        if (module_writer.thread.joinable())
+            module_writer.thread.join();
+    }
+
+    static void write_module_in_background(
+        Module_writer& module_writer,
+        std::filesystem::path const& module_file_path,
+        std::shared_ptr<h::Module const> core_module
+    )
+    {
+        {
+            std::unique_lock<std::mutex> lock{ module_writer.mutex };
+            module_writer.pending_writes.insert_or_assign(module_file_path, std::move(core_module));
+        }
+        module_writer.condition_variable.notify_one();
+    }
+
+    static std::filesystem::path get_parsed_module_file_path(
+        std::filesystem::path const& build_directory_path,
+        std::filesystem::path const& source_file_path
+    )
+    {
+        return build_directory_path / source_file_path.filename().replace_extension("hlb");
+    }
+
+    // Makes the parsed module available in memory to the rest of the runner and persists it in the background.
+    static std::shared_ptr<h::Module const> add_parsed_module(
+        h::Module&& core_module,
+        std::filesystem::path const& source_file_path,
+        std::filesystem::path const& parsed_file_path,
+        JIT_runner_unprotected_data const& unprotected_data,
+        JIT_runner_protected_data& protected_data
+    )
+    {
+        std::shared_ptr<h::Module const> const shared_core_module = std::make_shared<h::Module const>(std::move(core_module));
+
+        {
+            std::unique_lock<std::shared_mutex> lock{ protected_data.mutex };
+            protected_data.module_name_to_source_file_path.insert(std::make_pair(shared_core_module->name, source_file_path));
+            protected_data.module_name_to_module_file_path.insert(std::make_pair(shared_core_module->name, parsed_file_path));
+            protected_data.module_name_to_core_module.insert_or_assign(shared_core_module->name, shared_core_module);
+        }
+
+        write_module_in_background(*unprotected_data.module_writer, parsed_file_path, shared_core_module);
+
+        return shared_core_module;
+    }
+
     std::optional<std::filesystem::path> get_module_source_file_path(
         std::string_view const module_name,
         std::pmr::unordered_map<std::pmr::string, std::filesystem::path> const& module_name_to_source_file_path
@@ -197,6 +344,7 @@ namespace h::compiler
     struct Parsed_module_info
     {
         std::filesystem::path parsed_file_path;
+        std::shared_ptr<h::Module const> core_module;
         bool is_c_header;
     };
 
@@ -242,12 +390,42 @@ namespace h::compiler
         };
     }
 
+    static std::optional<Parsed_module_info> find_parsed_module(
+        std::string_view const module_name,
+        JIT_runner_protected_data& protected_data
+    )
+    {
+        std::pmr::string const module_name_key{ module_name };
+
+        std::shared_lock<std::shared_mutex> lock{ protected_data.mutex };
+
+        auto const core_module_location = protected_data.module_name_to_core_module.find(module_name_key);
+        if (core_module_location == protected_data.module_name_to_core_module.end())
+            return std::nullopt;
+
+        auto const module_file_path_location = protected_data.module_name_to_module_file_path.find(module_name_key);
+        if (module_file_path_location == protected_data.module_name_to_module_file_path.end())
+            return std::nullopt;
+
+        return Parsed_module_info
+        {
+            .parsed_file_path = module_file_path_location->second,
+            .core_module = core_module_location->second,
+            .is_c_header = false
+        };
+    }
+
     std::optional<Parsed_module_info> find_module_and_parse(
         std::string_view const module_name,
         JIT_runner_unprotected_data const& unprotected_data,
         JIT_runner_protected_data& protected_data
     )
     {
+        // Modules parsed before, or updated by file changes, are already in memory:
+        std::optional<Parsed_module_info> parsed_module_info = find_parsed_module(module_name, protected_data);
+        if (parsed_module_info.has_value())
+            return parsed_module_info;
+
         std::optional<std::filesystem::path> const module_source_file_path = find_module_source_file_path(
             module_name,
             unprotected_data,
@@ -261,23 +439,32 @@ namespace h::compiler
             protected_data.module_name_to_source_file_path.insert(std::make_pair(std::pmr::string{ module_name }, *module_source_file_path));
         }
 
-        std::filesystem::path const parsed_file_path = unprotected_data.build_directory_path / module_source_file_path->filename().replace_extension("hl");
+        std::filesystem::path const parsed_file_path = get_parsed_module_file_path(unprotected_data.build_directory_path, *module_source_file_path);
 
         if (module_source_file_path->extension() == ".hltxt")
         {
-            std::optional<h::Module> const core_module = h::parser::parse_and_convert_to_module(
+            Profile_zone const profile_zone{unprotected_data.profiler.get(), "parse_module", module_name};
+
+            std::optional<h::Module> core_module = h::parser::parse_and_convert_to_module(
                 *module_source_file_path,
                 {},
                 {}
             );
             if (!core_module.has_value())
                 return std::nullopt;
-            
-            h::json::write<h::Module>(parsed_file_path, core_module.value());
+
+            std::shared_ptr<h::Module const> shared_core_module = add_parsed_module(
+                std::move(core_module.value()),
+                *module_source_file_path,
+                parsed_file_path,
+                unprotected_data,
+                protected_data
+            );
 
             return Parsed_module_info
             {
                 .parsed_file_path = parsed_file_path,
+                .core_module = std::move(shared_core_module),
                 .is_c_header = false
             };
         }
@@ -288,14 +475,17 @@ namespace h::compiler
                 protected_data
             );
 
+            Profile_zone const profile_zone{unprotected_data.profiler.get(), "import_c_header", module_name};
+
             h::c::Options const options = create_c_header_options_from_artifact(module_name, artifact);
-            std::optional<h::Module> const header_module = h::c::import_header_and_write_to_file(module_name, *module_source_file_path, parsed_file_path, options);
+            std::optional<h::Module> header_module = h::c::import_header_and_write_to_file(module_name, *module_source_file_path, parsed_file_path, options);
             if (!header_module.has_value())
                 return std::nullopt;
 
             return Parsed_module_info
             {
                 .parsed_file_path = parsed_file_path,
+                .core_module = std::make_shared<h::Module const>(std::move(header_module.value())),
                 .is_c_header = true
             };
         }
@@ -329,16 +519,8 @@ namespace h::compiler
                 protected_data.module_name_to_module_file_path.insert(std::make_pair(import_alias.module_name, parsed_module_info->parsed_file_path));
             }
 
-            std::filesystem::path const& module_file_path = parsed_module_info->parsed_file_path;
-
-            std::optional<h::Module> import_core_module = h::compiler::read_core_module_declarations(module_file_path);
-            if (!import_core_module.has_value())
-            {
-                ::printf("Failed to read contents of %s (invalid module)\n", module_file_path.generic_string().c_str());
-                return false;
-            }
-
-            core_module_dependecies.insert(std::make_pair(import_alias.module_name, std::move(*import_core_module)));
+            h::Module import_core_module = copy_module_declarations(*parsed_module_info->core_module);
+            core_module_dependecies.insert(std::make_pair(import_alias.module_name, std::move(import_core_module)));
 
             bool const success = find_and_parse_core_module_dependencies(
                 core_module_dependecies.at(import_alias.module_name),
@@ -403,31 +585,28 @@ namespace h::compiler
         }
     }
 
+    // The module is shared with the cache of parsed modules instead of copied, as the JIT layers never modify it.
     bool add_module_for_compilation(
-        std::filesystem::path const& module_file_path,
+        std::shared_ptr<h::Module const> const shared_core_module,
         llvm::orc::JITDylib& library,
         JIT_runner_unprotected_data const& unprotected_data,
-        JIT_runner_protected_data& protected_data,
-        bool const recompile_reverse_dependencies
+        JIT_runner_protected_data& protected_data
     )
     {
-        std::optional<h::Module> const core_module = h::compiler::read_core_module(module_file_path);
-        if (!core_module.has_value())
-        {
-            ::printf("Failed to read contents of module %s\n", module_file_path.generic_string().c_str());
-            return false;
-        }
+        h::Module const& core_module = *shared_core_module;
+
+        Profile_zone const profile_zone{unprotected_data.profiler.get(), "add_module_for_compilation", core_module.name};
 
         {
             std::unique_lock<std::shared_mutex> lock{ protected_data.mutex };
-            insert_symbol_to_module_name_entries(*core_module, *unprotected_data.jit_data->mangle, protected_data.symbol_to_module_name_map);
+            insert_symbol_to_module_name_entries(core_module, *unprotected_data.jit_data->mangle, protected_data.symbol_to_module_name_map);
         }
 
         std::optional<std::pmr::unordered_map<std::pmr::string, h::Module>> core_module_dependencies =
-            find_and_parse_core_module_dependencies(*core_module, unprotected_data, protected_data);
+            find_and_parse_core_module_dependencies(core_module, unprotected_data, protected_data);
         if (!core_module_dependencies.has_value())
         {
-            ::printf("Failed to read module dependencies of module %s\n", module_file_path.generic_string().c_str());
+            ::printf("Failed to read module dependencies of module %s\n", core_module.name.c_str());
             return false;
         }
 
@@ -436,63 +615,129 @@ namespace h::compiler
         {
             std::unique_lock<std::shared_mutex> lock{ protected_data.mutex };
 
-            // TODO remove all entries where pair.second == core_module->name
+            // TODO remove all entries where pair.second == core_module.name
 
             for (std::pair<std::pmr::string const, h::Module> const& core_module_dependency : *core_module_dependencies)
             {
-                protected_data.module_name_to_reverse_dependencies.insert(std::make_pair(core_module_dependency.first, core_module->name));
+                protected_data.module_name_to_reverse_dependencies.insert(std::make_pair(core_module_dependency.first, core_module.name));
             }
         }
 
-        if (recompile_reverse_dependencies)
+        Core_module_compilation_data core_compilation_data
         {
-            Symbol_name_to_hash new_symbol_name_to_hash_map = hash_module_declarations(*core_module, {});
+            .llvm_data = *unprotected_data.llvm_data,
+            .core_module = shared_core_module,
+            .core_module_dependencies = std::move(*core_module_dependencies),
+            .compilation_options = unprotected_data.compilation_options,
+            .profiler = unprotected_data.profiler.get(),
+        };
+        return add_core_module(*unprotected_data.jit_data, library, std::move(core_compilation_data));
+    }
 
-            {
-                std::unique_lock<std::shared_mutex> lock{ protected_data.mutex };
-                auto const previous_symbol_name_to_hash_map_location = protected_data.module_name_to_symbol_hashes.find(core_module->name);
-
-                std::pmr::vector<std::pmr::string> const modules_to_recompile = find_modules_to_recompile(
-                    *core_module,
-                    previous_symbol_name_to_hash_map_location != protected_data.module_name_to_symbol_hashes.end() ? previous_symbol_name_to_hash_map_location->second : Symbol_name_to_hash{},
-                    new_symbol_name_to_hash_map,
-                    protected_data.module_name_to_module_file_path,
-                    protected_data.module_name_to_reverse_dependencies,
-                    {},
-                    {}
-                );
+    // Returns the modules that use symbols of core_module that changed since the last time it was compiled.
+    static std::pmr::vector<std::pmr::string> update_symbol_hashes_and_find_modules_to_recompile(
+        h::Module const& core_module,
+        JIT_runner_protected_data& protected_data
+    )
+    {
+        Symbol_name_to_hash new_symbol_name_to_hash_map = hash_module_declarations(core_module, {});
 
-                for (std::pmr::string const& module_to_recompile_name : modules_to_recompile)
-                {
-                    std::filesystem::path const& module_file_path = protected_data.module_name_to_module_file_path.at(module_to_recompile_name);
+        std::unique_lock<std::shared_mutex> lock{ protected_data.mutex };
+        auto const previous_symbol_name_to_hash_map_location = protected_data.module_name_to_symbol_hashes.find(core_module.name);
 
-                    lock.unlock();
-                    bool const success = add_module_for_compilation(
-                        module_file_path,
-                        library,
-                        unprotected_data,
-                        protected_data,
-                        false
-                    );
+        std::pmr::vector<std::pmr::string> modules_to_recompile = find_modules_to_recompile(
+            core_module,
+            previous_symbol_name_to_hash_map_location != protected_data.module_name_to_symbol_hashes.end() ? previous_symbol_name_to_hash_map_location->second : Symbol_name_to_hash{},
+            new_symbol_name_to_hash_map,
+            protected_data.module_name_to_module_file_path,
+            protected_data.module_name_to_reverse_dependencies,
+            {},
+            {}
+        );
+
+        protected_data.module_name_to_symbol_hashes.insert_or_assign(core_module.name, std::move(new_symbol_name_to_hash_map));
+
+        return modules_to_recompile;
+    }
+
+    static std::shared_ptr<h::Module const> get_module_to_recompile(
+        std::pmr::string const& module_name,
+        JIT_runner_protected_data& protected_data
+    )
+    {
+        std::optional<std::filesystem::path> module_file_path;
+
+        {
+            std::shared_lock<std::shared_mutex> lock{ protected_data.mutex };
+
+            auto const cached_module_location = protected_data.module_name_to_core_module.find(module_name);
+            if (cached_module_location != protected_data.module_name_to_core_module.end())
+                return cached_module_location->second;
 
-                    if (!success)
-                        return false;
+            auto const module_file_path_location = protected_data.module_name_to_module_file_path.find(module_name);
+            if (module_file_path_location != protected_data.module_name_to_module_file_path.end())
+                module_file_path = module_file_path_location->second;
+        }
 
-                    lock.lock();
+        if (!module_file_path.has_value())
+            return nullptr;
+
+        std::optional<h::Module> core_module = h::compiler::read_core_module(module_file_path.value());
+        if (!core_module.has_value())
+        {
+            ::printf("Failed to read contents of module %s\n", module_file_path->generic_string().c_str());
+            return nullptr;
+        }
+
+        return std::make_shared<h::Module const>(std::move(core_module.value()));
+    }
+
+    // Adds the modules in dependency order. Modules of the same rank do not import each other, so
+    // they are added in parallel.
+    static bool add_modules_for_compilation(
+        std::span<std::shared_ptr<h::Module const> const> const core_modules,
+        llvm::orc::JITDylib& library,
+        JIT_runner_unprotected_data const& unprotected_data,
+        JIT_runner_protected_data& protected_data
+    )
+    {
+        std::pmr::vector<h::Module const*> core_module_pointers;
+        core_module_pointers.reserve(core_modules.size());
+        for (std::shared_ptr<h::Module const> const& core_module : core_modules)
+            core_module_pointers.push_back(core_module.get());
+
+        Sorted_core_modules const sorted = sort_core_modules_and_compute_ranks(core_module_pointers, {}, {});
+
+        std::pmr::vector<bool> is_ranked(core_modules.size(), false);
+        std::atomic<bool> success = true;
+
+        for (std::pmr::vector<std::size_t> const& rank : sorted.ranks)
+        {
+            parallel_for(
+                unprotected_data.worker_count,
+                rank.size(),
+                [&](std::size_t const worker_index, std::size_t const element_index) -> void
+                {
+                    if (!add_module_for_compilation(core_modules[rank[element_index]], library, unprotected_data, protected_data))
+                        success = false;
                 }
+            );
 
-                protected_data.module_name_to_symbol_hashes.insert(std::make_pair(core_module->name, std::move(new_symbol_name_to_hash_map)));
-            }
+            for (std::size_t const module_index : rank)
+                is_ranked[module_index] = true;
         }
 
-        Core_module_compilation_data core_compilation_data
+        // Modules that are part of an import cycle do not have a rank:
+        for (std::size_t module_index = 0; module_index < core_modules.size(); ++module_index)
         {
-            .llvm_data = *unprotected_data.llvm_data,
-            .core_module = std::move(*core_module),
-            .core_module_dependencies = std::move(*core_module_dependencies),
-            .compilation_options = unprotected_data.compilation_options,
-        };
-        return add_core_module(*unprotected_data.jit_data, library, std::move(core_compilation_data));
+            if (is_ranked[module_index])
+                continue;
+
+            if (!add_module_for_compilation(core_modules[module_index], library, unprotected_data, protected_data))
+                success = false;
+        }
+
+        return success;
     }
 
     static std::pmr::unordered_map<std::filesystem::path, Artifact>::const_iterator find_artifact(
@@ -583,35 +828,39 @@ namespace h::compiler
 
                 std::filesystem::path const source_file_path = artifact.file_path.parent_path() / executable_info.source;
 
-                std::filesystem::path const parsed_file_path = unprotected_data.build_directory_path / source_file_path.filename().replace_extension("hl");
+                std::filesystem::path const parsed_file_path = get_parsed_module_file_path(unprotected_data.build_directory_path, source_file_path);
 
-                std::optional<h::Module> const core_module = h::parser::parse_and_convert_to_module(
+                std::optional<h::Module> core_module = h::parser::parse_and_convert_to_module(
                     source_file_path,
                     {},
                     {}
                 );
                 if (core_module.has_value())
-                    h::json::write<h::Module>(parsed_file_path, core_module.value());
-
                 {
-                    std::optional<std::pmr::string> const module_name = read_module_name(source_file_path);
+                    std::shared_ptr<h::Module const> const shared_core_module = add_parsed_module(
+                        std::move(core_module.value()),
+                        source_file_path,
+                        parsed_file_path,
+                        unprotected_data,
+                        protected_data
+                    );
 
-                    if (module_name)
                     {
                         std::unique_lock<std::shared_mutex> lock{ protected_data.mutex };
-                        protected_data.module_name_to_source_file_path.insert(std::make_pair(*module_name, source_file_path));
-                        protected_data.module_name_to_module_file_path.insert(std::make_pair(*module_name, parsed_file_path));
-                        protected_data.module_name_to_artifact_path.insert(std::make_pair(*module_name, artifact_configuration_file_path));
+                        protected_data.module_name_to_artifact_path.insert(std::make_pair(shared_core_module->name, artifact_configuration_file_path));
                     }
-                }
 
-                add_module_for_compilation(
-                    parsed_file_path,
-                    get_main_library(*unprotected_data.jit_data),
-                    unprotected_data,
-                    protected_data,
-                    false
-                );
+                    add_module_for_compilation(
+                        shared_core_module,
+                        get_main_library(*unprotected_data.jit_data),
+                        unprotected_data,
+                        protected_data
+                    );
+                }
+                else
+                {
+                    ::printf("Failed to parse %s\n", source_file_path.generic_string().c_str());
+                }
             }
             else if (std::holds_alternative<Library_info>(*artifact.info))
             {
@@ -702,11 +951,10 @@ namespace h::compiler
                     continue;
 
                 add_module_for_compilation(
-                    parsed_module_info->parsed_file_path,
+                    parsed_module_info->core_module,
                     library,
                     m_unprotected_data,
-                    m_protected_data,
-                    false
+                    m_protected_data
                 );
 
                 // TODO
@@ -743,99 +991,235 @@ namespace h::compiler
         return directory_path_end == directory_path.end();
     }
 
-    static void handle_file_change(
-        JIT_runner_unprotected_data const& unprotected_data,
-        JIT_runner_protected_data& protected_data,
-        wtr::event const event
+    static void enqueue_file_change(
+        File_change_queue& file_change_queue,
+        std::filesystem::path const& build_directory_path,
+        wtr::event const& event
     )
     {
-        constexpr bool print_events = true;
-        if (print_events)
+        std::filesystem::path const& source_file_path = event.path_name;
+
+        // Ignore changes in the build directory:
+        if (is_inside_directory(source_file_path, build_directory_path))
+            return;
+
         {
-            /*std::pmr::string const effect_type = wtr::to<std::pmr::string>(event.effect_type);
-            std::pmr::string const path_type = wtr::to<std::pmr::string>(event.path_type);
-            std::pmr::string const path_name = wtr::to<std::pmr::string>(event.path_name);
-            std::pmr::string const associated = (event.associated ? " -> " + wtr::to<std::pmr::string>(event.associated->path_name) : "");
+            std::unique_lock<std::mutex> lock{ file_change_queue.mutex };
+
+            if (event.effect_type == wtr::event::effect_type::create || event.effect_type == wtr::event::effect_type::modify)
+            {
+                file_change_queue.pending_changes[source_file_path].is_created_or_modified = true;
+            }
+            else if (event.effect_type == wtr::event::effect_type::rename)
+            {
+                file_change_queue.pending_changes[source_file_path].is_renamed = true;
+
+                if (event.associated != nullptr)
+                    file_change_queue.pending_changes[event.associated->path_name].is_renamed = true;
+            }
 
-            std::string const output_string = std::format("{} {} {} {}\n", effect_type, path_type, path_name, associated);
-            std::puts(output_string.c_str());*/
+            file_change_queue.last_event_time = std::chrono::steady_clock::now();
         }
+        file_change_queue.condition_variable.notify_one();
+    }
 
-        std::filesystem::path const& source_file_path = event.path_name;
+    static void process_file_changes(
+        std::pmr::unordered_map<std::filesystem::path, File_change> const& file_changes,
+        JIT_runner_unprotected_data const& unprotected_data,
+        JIT_runner_protected_data& protected_data
+    )
+    {
+        using namespace std::chrono_literals;
 
-        // Ignore changes in the build directory:
-        if (is_inside_directory(source_file_path, unprotected_data.build_directory_path))
-            return;
+        std::pmr::vector<std::filesystem::path> source_file_paths;
 
-        // Any time there is a watched file is modified, add to the recompile module layer:
-        if (event.effect_type == wtr::event::effect_type::create || event.effect_type == wtr::event::effect_type::modify)
+        for (std::pair<std::filesystem::path const, File_change> const& pair : file_changes)
         {
-            if (source_file_path.extension() == ".hltxt")
+            std::filesystem::path const& file_path = pair.first;
+            File_change const& file_change = pair.second;
+
+            bool const exists = std::filesystem::exists(file_path);
+
+            if (file_change.is_renamed && exists)
             {
-                using namespace std::chrono_literals;
+                std::optional<std::pmr::string> const module_name = read_module_name(file_path);
+                if (module_name)
+                {
+                    std::unique_lock<std::shared_mutex> lock{ protected_data.mutex };
+                    protected_data.module_name_to_source_file_path[*module_name] = file_path;
+                }
+            }
 
+            // Editors that save by renaming a temporary file over the original only emit rename events:
+            if (exists && file_path.extension() == ".hltxt")
+            {
                 if (unprotected_data.log_level >= 1)
-                    std::puts(std::format("Detected change on {}", source_file_path.generic_string()).c_str());
+                    std::puts(std::format("Detected change on {}", file_path.generic_string()).c_str());
 
-                std::chrono::high_resolution_clock::time_point const begin_parsing = std::chrono::high_resolution_clock::now();
+                source_file_paths.push_back(file_path);
+            }
+        }
 
-                std::filesystem::path const parsed_file_path = unprotected_data.build_directory_path / source_file_path.filename().replace_extension("hl");
-                std::optional<h::Module> const core_module = h::parser::parse_and_convert_to_module(
-                    source_file_path,
-                    {},
-                    {}
-                );
-                if (core_module.has_value())
-                    h::json::write<h::Module>(parsed_file_path, core_module.value());
+        if (source_file_paths.empty())
+            return;
 
-                {
-                    std::optional<std::pmr::string> const module_name = read_module_name(source_file_path);
+        Profile_zone const profile_zone{unprotected_data.profiler.get(), "process_file_changes"};
 
-                    if (module_name)
-                    {
-                        std::unique_lock<std::shared_mutex> lock{ protected_data.mutex };
-                        protected_data.module_name_to_source_file_path.insert(std::make_pair(*module_name, source_file_path));
-                        protected_data.module_name_to_module_file_path.insert(std::make_pair(*module_name, parsed_file_path));
-                    }
-                }
+        std::chrono::high_resolution_clock::time_point const begin_parsing = std::chrono::high_resolution_clock::now();
 
-                std::chrono::high_resolution_clock::time_point const begin_processing = std::chrono::high_resolution_clock::now();
+        std::pmr::vector<std::optional<h::Module>> parsed_modules(source_file_paths.size());
+        parallel_for(
+            unprotected_data.worker_count,
+            source_file_paths.size(),
+            [&](std::size_t const worker_index, std::size_t const element_index) -> void
+            {
+                Profile_zone const parse_profile_zone{unprotected_data.profiler.get(), "parse_module", source_file_paths[element_index].filename().generic_string()};
+                parsed_modules[element_index] = h::parser::parse_and_convert_to_module(source_file_paths[element_index], {}, {});
+            }
+        );
 
-                bool const success = add_module_for_compilation(
-                    parsed_file_path,
-                    get_main_library(*unprotected_data.jit_data),
-                    unprotected_data,
-                    protected_data,
-                    true
-                );
+        // Several files may declare the same module, in which case the last one wins:
+        std::pmr::unordered_map<std::pmr::string, std::shared_ptr<h::Module const>> changed_modules;
+        for (std::size_t index = 0; index < source_file_paths.size(); ++index)
+        {
+            std::filesystem::path const& source_file_path = source_file_paths[index];
+            std::optional<h::Module>& core_module = parsed_modules[index];
 
-                std::chrono::high_resolution_clock::time_point const end_processing = std::chrono::high_resolution_clock::now();
+            if (!core_module.has_value())
+            {
+                ::printf("Failed to parse %s\n", source_file_path.generic_string().c_str());
+                continue;
+            }
 
-                if (unprotected_data.log_level >= 1)
-                    std::puts(std::format("{} {}. Parsing took {}ms. Creating materialization units took {}ms. Total time was {}ms", success ? "Created materialization units for" : "Failed to create materialization units for", source_file_path.generic_string(), (begin_processing - begin_parsing) / 1ms, (end_processing - begin_processing) / 1ms, (end_processing - begin_parsing) / 1ms).c_str());
+            std::filesystem::path const parsed_file_path = get_parsed_module_file_path(unprotected_data.build_directory_path, source_file_path);
+            std::shared_ptr<h::Module const> shared_core_module = add_parsed_module(std::move(core_module.value()), source_file_path, parsed_file_path, unprotected_data, protected_data);
+            changed_modules.insert_or_assign(shared_core_module->name, std::move(shared_core_module));
+        }
+
+        std::chrono::high_resolution_clock::time_point const begin_processing = std::chrono::high_resolution_clock::now();
+
+        // Modules that use changed declarations are recompiled together with the changed modules:
+        std::pmr::unordered_map<std::pmr::string, std::shared_ptr<h::Module const>> modules_to_add = changed_modules;
+        for (std::pair<std::pmr::string const, std::shared_ptr<h::Module const>> const& pair : changed_modules)
+        {
+            std::pmr::vector<std::pmr::string> const modules_to_recompile = update_symbol_hashes_and_find_modules_to_recompile(*pair.second, protected_data);
+            for (std::pmr::string const& module_to_recompile_name : modules_to_recompile)
+            {
+                if (modules_to_add.contains(module_to_recompile_name))
+                    continue;
+
+                std::shared_ptr<h::Module const> module_to_recompile = get_module_to_recompile(module_to_recompile_name, protected_data);
+                if (module_to_recompile != nullptr)
+                    modules_to_add.insert(std::make_pair(module_to_recompile_name, std::move(module_to_recompile)));
             }
         }
-        else if (event.effect_type == wtr::event::effect_type::rename)
+
+        std::pmr::vector<std::shared_ptr<h::Module const>> core_modules;
+        core_modules.reserve(modules_to_add.size());
+        for (std::pair<std::pmr::string const, std::shared_ptr<h::Module const>> const& pair : modules_to_add)
+            core_modules.push_back(pair.second);
+
+        bool const success = add_modules_for_compilation(
+            core_modules,
+            get_main_library(*unprotected_data.jit_data),
+            unprotected_data,
+            protected_data
+        );
+
+        std::chrono::high_resolution_clock::time_point const end_processing = std::chrono::high_resolution_clock::now();
+
+        if (unprotected_data.log_level >= 1)
+            std::puts(std::format("{} {} modules ({} changed files). Parsing took {}ms. Creating materialization units took {}ms. Total time was {}ms", success ? "Created materialization units for" : "Failed to create materialization units for", core_modules.size(), source_file_paths.size(), (begin_processing - begin_parsing) / 1ms, (end_processing - begin_processing) / 1ms, (end_processing - begin_parsing) / 1ms).c_str());
+
+        // TODO when a file is created, check if it matches the includes and then (optional) add to the watch list and to the recompile module layer
+        // TODO when a file is removed, maybe remove the definitions?
+    }
+
+    static void run_file_change_dispatcher(
+        File_change_queue& file_change_queue,
+        JIT_runner_unprotected_data const& unprotected_data,
+        JIT_runner_protected_data& protected_data
+    )
+    {
+        while (true)
         {
-            if (std::filesystem::exists(source_file_path))
+            std::pmr::unordered_map<std::filesystem::path, File_change> file_changes;
+
             {
-                std::optional<std::pmr::string> const module_name = read_module_name(source_file_path);
-                if (module_name)
+                std::unique_lock<std::mutex> lock{ file_change_queue.mutex };
+                file_change_queue.condition_variable.wait(lock, [&]() -> bool { return file_change_queue.stop || !file_change_queue.pending_changes.empty(); });
+
+                // Wait until no event arrived for the debounce window:
+                while (!file_change_queue.stop)
                 {
-                    std::unique_lock<std::shared_mutex> lock{ protected_data.mutex };
-                    protected_data.module_name_to_source_file_path[*module_name] = source_file_path;
+                    std::chrono::steady_clock::time_point const deadline = file_change_queue.last_event_time + unprotected_data.file_change_debounce_window;
+                    if (std::chrono::steady_clock::now() >= deadline)
+                        break;
+
+                    file_change_queue.condition_variable.wait_until(lock, deadline);
                 }
+
+                if (file_change_queue.stop)
+                    return;
+
+                file_changes.swap(file_change_queue.pending_changes);
+            }
+
+            try
+            {
+                process_file_changes(file_changes, unprotected_data, protected_data);
             }
+            catch (std::exception const& exception)
+            {
+                ::printf("Failed to process file changes: %s\n", exception.what());
+            }
+
+            // Several events for the same file are merged, so each changed file counts once per batch:
+            {
+                std::unique_lock<std::shared_mutex> lock{ protected_data.mutex };
+                protected_data.processed_files += file_changes.size();
+            }
+            protected_data.condition_variable.notify_all();
         }
+    }
+
+    static void start_file_change_dispatcher(
+        File_change_queue& file_change_queue,
+        JIT_runner_unprotected_data const& unprotected_data,
+        JIT_runner_protected_data& protected_data
+    )
+    {
+        file_change_queue.thread = std::thread{ run_file_change_dispatcher, std::ref(file_change_queue), std::cref(unprotected_data), std::ref(protected_data) };
+    }
 
+    static void stop_file_change_dispatcher(
+        File_change_queue& file_change_queue
+    )
+    {
         {
-            std::unique_lock<std::shared_mutex> lock{ protected_data.mutex };
-            protected_data.processed_files += 1;
+            std::unique_lock<std::mutex> lock{ file_change_queue.mutex };
+            file_change_queue.stop = true;
         }
-        protected_data.condition_variable.notify_all();
+        file_change_queue.condition_variable.notify_all();
 
-        // TODO when a file is created, check if it matches the includes and then (optional) add to the watch list and to the recompile module layer
-        // TODO when a file is removed, maybe remove the definitions?
+        if (file_change_queue.thread.joinable())
+            file_change_queue.thread.join();
+    }
+
+    static std::optional<Target_cpu> get_jit_target_cpu(
+        Compilation_options const& compilation_options
+    )
+    {
+        if (compilation_options.cpu.has_value())
+            return get_target_cpu(compilation_options);
+
+        if (!compilation_options.target_features.has_value())
+            return std::nullopt;
+
+        // Without --cpu the JIT keeps targeting the host, the explicit features are added to the host ones:
+        Compilation_options host_compilation_options = compilation_options;
+        host_compilation_options.cpu = "native";
+        return get_target_cpu(host_compilation_options);
     }
 
     std::unique_ptr<JIT_runner> setup_jit_and_watch(
@@ -844,7 +1228,12 @@ namespace h::compiler
         std::filesystem::path const& build_directory_path,
         std::span<std::filesystem::path const> const header_search_paths,
         Target const& target,
-        Compilation_options const& compilation_options
+        Compilation_options const& compilation_options,
+        std::optional<std::filesystem::path> const& profile_output_path,
+        std::chrono::milliseconds const file_change_debounce_window,
+        std::size_t const worker_count,
+        std::optional<Tiered_compilation_options> const& tiered_compilation_options,
+        std::optional<std::uint64_t> const object_cache_maximum_size_in_bytes
     )
     {
         // Print internal LLVM messages:
@@ -855,7 +1244,16 @@ namespace h::compiler
         // Create readonly and protected data:
         {
             std::unique_ptr<h::compiler::LLVM_data> llvm_data = std::make_unique<h::compiler::LLVM_data>(h::compiler::initialize_llvm(compilation_options));
-            std::unique_ptr<JIT_data> jit_data = create_jit_data(llvm_data->data_layout, h::common::get_default_library_directories(), compilation_options.debug);
+            std::optional<Target_cpu> const target_cpu = get_jit_target_cpu(compilation_options);
+            std::optional<Function_cache> const object_cache_storage = object_cache_maximum_size_in_bytes.has_value() ?
+                std::optional<Function_cache>{Function_cache{ .directory = build_directory_path / "jit_object_cache", .maximum_size_in_bytes = object_cache_maximum_size_in_bytes.value() }} :
+                std::nullopt;
+            std::unique_ptr<JIT_data> jit_data = create_jit_data(llvm_data->data_layout, h::common::get_default_library_directories(), target_cpu, compilation_options, tiered_compilation_options, object_cache_storage);
+
+            // With tiered compilation, functions are compiled quickly first and optimized once they are hot:
+            Compilation_options tier_0_compilation_options = compilation_options;
+            if (tiered_compilation_options.has_value())
+                tier_0_compilation_options.optimization_level = Optimization_level::O0;
 
             jit_runner->unprotected_data =
             {
@@ -866,7 +1264,12 @@ namespace h::compiler
                 .llvm_data = std::move(llvm_data),
                 .jit_data = std::move(jit_data),
                 .log_level = 1,
-                .compilation_options = compilation_options
+                .compilation_options = tier_0_compilation_options,
+                .profiler = profile_output_path.has_value() ? std::make_unique<Profiler>() : nullptr,
+                .profile_output_path = profile_output_path,
+                .module_writer = create_module_writer(),
+                .file_change_debounce_window = file_change_debounce_window,
+                .worker_count = get_worker_count(worker_count),
             };
 
             for (std::filesystem::path const& repository_file_path : repositories_file_paths)
@@ -878,12 +1281,14 @@ namespace h::compiler
 
         // Create file watcher:
         {
-            JIT_runner_unprotected_data const& unprotected_data = jit_runner->unprotected_data;
-            JIT_runner_protected_data& protected_data = jit_runner->protected_data;
+            jit_runner->file_change_queue = std::make_unique<File_change_queue>();
 
-            std::function<void(wtr::watcher::event const&)> callback = [&](wtr::event const event) -> void
+            File_change_queue& file_change_queue = *jit_runner->file_change_queue;
+            std::filesystem::path const& build_directory_path = jit_runner->unprotected_data.build_directory_path;
+
+            std::function<void(wtr::watcher::event const&)> callback = [&file_change_queue, &build_directory_path](wtr::event const event) -> void
             {
-                handle_file_change(unprotected_data, protected_data, event);
+                enqueue_file_change(file_change_queue, build_directory_path, event);
             };
 
             std::unique_ptr<File_watcher> file_watcher = create_file_watcher(std::move(callback));
@@ -907,9 +1312,39 @@ namespace h::compiler
             add_artifact_for_compilation(artifact_configuration_file_path, unprotected_data, protected_data, *jit_runner->file_watcher);
         }
 
+        // Start handling file changes:
+        {
+            JIT_runner_unprotected_data const& unprotected_data = jit_runner->unprotected_data;
+            JIT_runner_protected_data& protected_data = jit_runner->protected_data;
+
+            start_file_change_dispatcher(*jit_runner->file_change_queue, unprotected_data, protected_data);
+        }
+
         return jit_runner;
     }
 
+    std::optional<std::array<Tier_statistics, 2>> get_tier_statistics(
+        JIT_runner& jit_runner
+    )
+    {
+        Tiered_compilation const* const tiered_compilation = jit_runner.unprotected_data.jit_data->tiered_compilation.get();
+        if (tiered_compilation == nullptr)
+            return std::nullopt;
+
+        return tiered_compilation->get_statistics();
+    }
+
+    std::optional<JIT_object_cache_statistics> get_object_cache_statistics(
+        JIT_runner& jit_runner
+    )
+    {
+        JIT_object_cache const* const object_cache = jit_runner.unprotected_data.jit_data->object_cache.get();
+        if (object_cache == nullptr)
+            return std::nullopt;
+
+        return object_cache->get_statistics();
+    }
+
     std::uint64_t get_processed_files(
         JIT_runner& jit_runner
     )
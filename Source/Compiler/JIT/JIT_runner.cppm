@@ -5,12 +5,18 @@ module;
 #include <llvm/ExecutionEngine/Orc/Shared/ExecutorSymbolDef.h>
 #include <llvm/Support/Error.h>
 
+#include <array>
+#include <chrono>
 #include <condition_variable>
+#include <cstddef>
 #include <filesystem>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <span>
 #include <shared_mutex>
 #include <string_view>
+#include <thread>
 #include <unordered_map>
 #include <variant>
 
@@ -18,9 +24,12 @@ export module h.compiler.jit_runner;
 
 import h.compiler;
 import h.compiler.artifact;
+import h.compiler.core_module_layer;
 import h.compiler.file_watcher;
 import h.core.hash;
 import h.compiler.jit_compiler;
+import h.compiler.jit_object_cache;
+import h.compiler.profiler;
 import h.compiler.repository;
 import h.compiler.target;
 import h.core;
@@ -28,6 +37,35 @@ import h.parser.parser;
 
 namespace h::compiler
 {
+    // Persists parsed modules to the build directory on a background thread, so that
+    // writing files is not part of the edit-to-run latency.
+    struct Module_writer
+    {
+        std::mutex mutex;
+        std::condition_variable condition_variable;
+        std::pmr::unordered_map<std::filesystem::path, std::shared_ptr<h::Module const>> pending_writes;
+        bool stop = false;
+        std::thread thread;
+    };
+
+    struct File_change
+    {
+        bool is_created_or_modified = false;
+        bool is_renamed = false;
+    };
+
+    // Collects file watcher events so that a burst of saves is handled as a single batch once
+    // no event has arrived for the debounce window.
+    struct File_change_queue
+    {
+        std::mutex mutex;
+        std::condition_variable condition_variable;
+        std::pmr::unordered_map<std::filesystem::path, File_change> pending_changes;
+        std::chrono::steady_clock::time_point last_event_time;
+        bool stop = false;
+        std::thread thread;
+    };
+
     struct JIT_runner_unprotected_data
     {
         std::filesystem::path build_directory_path;
@@ -38,6 +76,11 @@ namespace h::compiler
         std::unique_ptr<JIT_data> jit_data;
         int log_level;
         Compilation_options compilation_options;
+        std::unique_ptr<Profiler> profiler;
+        std::optional<std::filesystem::path> profile_output_path;
+        std::unique_ptr<Module_writer> module_writer;
+        std::chrono::milliseconds file_change_debounce_window;
+        std::size_t worker_count;
     };
 
     struct JIT_runner_protected_data
@@ -49,6 +92,7 @@ namespace h::compiler
         std::pmr::unordered_map<std::filesystem::path, Repository> repositories;
         std::pmr::unordered_map<std::pmr::string, std::filesystem::path> module_name_to_source_file_path;
         std::pmr::unordered_map<std::pmr::string, std::filesystem::path> module_name_to_module_file_path;
+        std::pmr::unordered_map<std::pmr::string, std::shared_ptr<h::Module const>> module_name_to_core_module;
         std::pmr::unordered_multimap<std::pmr::string, std::pmr::string> module_name_to_reverse_dependencies;
         std::pmr::unordered_map<std::pmr::string, Symbol_name_to_hash> module_name_to_symbol_hashes;
         std::pmr::unordered_map<std::pmr::string, std::filesystem::path> module_name_to_artifact_path;
@@ -59,6 +103,7 @@ namespace h::compiler
     {
         JIT_runner_unprotected_data unprotected_data;
         JIT_runner_protected_data protected_data;
+        std::unique_ptr<File_change_queue> file_change_queue;
         std::unique_ptr<File_watcher> file_watcher;
 
         ~JIT_runner();
@@ -70,7 +115,12 @@ namespace h::compiler
         std::filesystem::path const& build_directory_path,
         std::span<std::filesystem::path const> header_search_paths,
         Target const& target,
-        Compilation_options const& compilation_options
+        Compilation_options const& compilation_options,
+        std::optional<std::filesystem::path> const& profile_output_path = std::nullopt,
+        std::chrono::milliseconds file_change_debounce_window = std::chrono::milliseconds{ 50 },
+        std::size_t worker_count = 0,
+        std::optional<Tiered_compilation_options> const& tiered_compilation_options = std::nullopt,
+        std::optional<std::uint64_t> object_cache_maximum_size_in_bytes = std::nullopt
     );
 
     export
@@ -110,6 +160,14 @@ namespace h::compiler
         JIT_runner& jit_runner
     );
 
+    export std::optional<std::array<Tier_statistics, 2>> get_tier_statistics(
+        JIT_runner& jit_runner
+    );
+
+    export std::optional<JIT_object_cache_statistics> get_object_cache_statistics(
+        JIT_runner& jit_runner
+    );
+
     export void wait_for(
         JIT_runner& jit_runner,
         std::uint64_t const processed_files
@@ -1,6 +1,10 @@
 #include <array>
 #include <chrono>
+#include <cstdint>
 #include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
 #include <string_view>
 #include <thread>
 
@@ -11,6 +15,7 @@
 #include <llvm/IR/PassInstrumentation.h>
 #include <llvm/IR/PassManager.h>
 #include <llvm/Passes/StandardInstrumentations.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Target/TargetMachine.h>
 
 #include <llvm/ExecutionEngine/Orc/Core.h>
@@ -25,6 +30,9 @@ import h.common;
 import h.common.filesystem;
 import h.compiler;
 import h.compiler.artifact;
+import h.compiler.core_module_layer;
+import h.compiler.function_cache;
+import h.compiler.jit_object_cache;
 import h.compiler.jit_runner;
 import h.compiler.target;
 
@@ -128,7 +136,7 @@ namespace h
         h::compiler::Compilation_options const compilation_options =
         {
             .target_triple = std::nullopt,
-            .is_optimized = false,
+            .optimization_level = h::compiler::Optimization_level::O0,
             .debug = false,
         };
         std::unique_ptr<h::compiler::JIT_runner> jit_runner = h::compiler::setup_jit_and_watch(artifact_configuration_file_path, {}, build_directory_path, {}, target, compilation_options);
@@ -228,7 +236,7 @@ namespace h
         h::compiler::Compilation_options const compilation_options =
         {
             .target_triple = std::nullopt,
-            .is_optimized = false,
+            .optimization_level = h::compiler::Optimization_level::O0,
             .debug = false,
         };
         std::unique_ptr<h::compiler::JIT_runner> jit_runner = h::compiler::setup_jit_and_watch(artifact_configuration_file_path, {}, build_directory_path, {}, target, compilation_options);
@@ -313,7 +321,7 @@ namespace h
         h::compiler::Compilation_options const compilation_options =
         {
             .target_triple = std::nullopt,
-            .is_optimized = false,
+            .optimization_level = h::compiler::Optimization_level::O0,
             .debug = false,
         };
         std::unique_ptr<h::compiler::JIT_runner> jit_runner = h::compiler::setup_jit_and_watch(artifact_configuration_file_path, repositories, build_directory_path, header_search_paths, target, compilation_options);
@@ -382,7 +390,7 @@ namespace h
         h::compiler::Compilation_options const compilation_options =
         {
             .target_triple = std::nullopt,
-            .is_optimized = false,
+            .optimization_level = h::compiler::Optimization_level::O0,
             .debug = false,
         };
         std::unique_ptr<h::compiler::JIT_runner> jit_runner = h::compiler::setup_jit_and_watch(artifact_configuration_file_path, {}, build_directory_path, {}, target, compilation_options);
@@ -513,7 +521,7 @@ namespace h
         h::compiler::Compilation_options const compilation_options =
         {
             .target_triple = std::nullopt,
-            .is_optimized = false,
+            .optimization_level = h::compiler::Optimization_level::O0,
             .debug = false,
         };
         std::unique_ptr<h::compiler::JIT_runner> jit_runner = h::compiler::setup_jit_and_watch(artifact_configuration_file_path, {}, build_directory_path, {}, target, compilation_options);
@@ -598,7 +606,7 @@ namespace h
         h::compiler::Compilation_options const compilation_options =
         {
             .target_triple = std::nullopt,
-            .is_optimized = false,
+            .optimization_level = h::compiler::Optimization_level::O0,
             .debug = false,
         };
         std::unique_ptr<h::compiler::JIT_runner> jit_runner = h::compiler::setup_jit_and_watch(artifact_configuration_file_path, {}, build_directory_path, {}, target, compilation_options);
@@ -690,7 +698,7 @@ namespace h
         h::compiler::Compilation_options const compilation_options =
         {
             .target_triple = std::nullopt,
-            .is_optimized = false,
+            .optimization_level = h::compiler::Optimization_level::O0,
             .debug = false,
         };
         std::unique_ptr<h::compiler::JIT_runner> jit_runner = h::compiler::setup_jit_and_watch(artifact_configuration_file_path, {}, build_directory_path, {}, target, compilation_options);
@@ -795,7 +803,7 @@ namespace h
         h::compiler::Compilation_options const compilation_options =
         {
             .target_triple = std::nullopt,
-            .is_optimized = false,
+            .optimization_level = h::compiler::Optimization_level::O0,
             .debug = false,
         };
         std::unique_ptr<h::compiler::JIT_runner> jit_runner = h::compiler::setup_jit_and_watch(artifact_configuration_file_path, {}, build_directory_path, {}, target, compilation_options);
@@ -907,7 +915,7 @@ namespace h
         h::compiler::Compilation_options const compilation_options =
         {
             .target_triple = std::nullopt,
-            .is_optimized = false,
+            .optimization_level = h::compiler::Optimization_level::O0,
             .debug = false,
         };
         std::unique_ptr<h::compiler::JIT_runner> jit_runner = h::compiler::setup_jit_and_watch(artifact_configuration_file_path, {}, build_directory_path, {}, target, compilation_options);
@@ -932,6 +940,366 @@ namespace h
         }
     }
 
+    TEST_CASE("Run JIT program with tiered compilation", "[JIT]")
+    {
+        SKIP();
+
+        std::filesystem::path const root_directory = std::filesystem::temp_directory_path() / "hlang_test" / "jit_tiered_compilation";
+
+        if (std::filesystem::exists(root_directory))
+            std::filesystem::remove_all(root_directory);
+
+        std::filesystem::create_directories(root_directory);
+
+        std::filesystem::path const build_directory_path = root_directory / "build";
+        std::filesystem::create_directories(build_directory_path);
+
+        std::filesystem::path const artifact_configuration_file_path = root_directory / "hlang_artifact.json";
+        h::compiler::Artifact const artifact
+        {
+            .file_path = artifact_configuration_file_path,
+            .name = "hlang_artifact.json",
+            .version = {
+                .major = 0,
+                .minor = 1,
+                .patch = 0
+            },
+            .type = h::compiler::Artifact_type::Executable,
+            .dependencies = {},
+            .sources = {
+                h::compiler::Source_group
+                {
+                    .data = h::compiler::Hlang_source_group{},
+                    .include = "./**/*.hltxt"
+                }
+            },
+            .info = h::compiler::Executable_info
+            {
+                .source = "main.hltxt",
+                .entry_point = "main",
+            }
+        };
+
+        h::compiler::write_artifact_to_file(artifact, artifact_configuration_file_path);
+
+        std::filesystem::path const main_file_path = root_directory / "main.hltxt";
+        std::string_view const code = R"(
+            module test;
+
+            function get_result() -> (result: Int32)
+            {
+                return 10;
+            }
+
+            export function main() -> (result: Int32)
+            {
+                return get_result();
+            }
+        )";
+        h::common::write_to_file(main_file_path, code);
+
+        h::compiler::Target const target = h::compiler::get_default_target();
+        h::compiler::Compilation_options const compilation_options =
+        {
+            .target_triple = std::nullopt,
+            .optimization_level = h::compiler::Optimization_level::O0,
+            .debug = false,
+        };
+        h::compiler::Tiered_compilation_options const tiered_compilation_options =
+        {
+            .tier_up_call_count = 100,
+            .tier_up_optimization_level = h::compiler::Optimization_level::O2,
+        };
+        std::unique_ptr<h::compiler::JIT_runner> jit_runner = h::compiler::setup_jit_and_watch(artifact_configuration_file_path, {}, build_directory_path, {}, target, compilation_options, std::nullopt, std::chrono::milliseconds{ 50 }, 0, tiered_compilation_options);
+
+        int(*function_pointer)() = h::compiler::get_function<int(*)()>(*jit_runner, "test_main");
+        REQUIRE(function_pointer != nullptr);
+
+        for (int index = 0; index < 1000; ++index)
+            CHECK(function_pointer() == 10);
+
+        std::optional<std::array<h::compiler::Tier_statistics, 2>> statistics = h::compiler::get_tier_statistics(*jit_runner);
+        REQUIRE(statistics.has_value());
+
+        for (int attempt = 0; attempt < 100 && statistics->at(1).function_count < 2; ++attempt)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });
+            statistics = h::compiler::get_tier_statistics(*jit_runner);
+        }
+
+        CHECK(statistics->at(0).function_count == 2);
+        CHECK(statistics->at(1).function_count == 2);
+        CHECK(statistics->at(1).failed_count == 0);
+
+        // Calls go through the stubs, which now point to the optimized functions:
+        CHECK(function_pointer() == 10);
+    }
+
+    TEST_CASE("Tiered compilation tiers up functions that reach the call count threshold", "[JIT][Tiered_compilation]")
+    {
+        h::compiler::Tiered_compilation_options const options =
+        {
+            .tier_up_call_count = 100,
+            .tier_up_optimization_level = h::compiler::Optimization_level::O2,
+        };
+
+        CHECK(!h::compiler::is_function_hot(0, options));
+        CHECK(!h::compiler::is_function_hot(99, options));
+        CHECK(h::compiler::is_function_hot(100, options));
+        CHECK(h::compiler::is_function_hot(1000, options));
+    }
+
+    TEST_CASE("Tiered compilation reports the statistics of each tier", "[JIT][Tiered_compilation]")
+    {
+        using namespace std::chrono_literals;
+
+        h::compiler::Tiered_compilation_options const options =
+        {
+            .tier_up_call_count = 100,
+            .tier_up_optimization_level = h::compiler::Optimization_level::O3,
+        };
+
+        std::array<h::compiler::Tier_statistics, 2> const statistics =
+        {
+            h::compiler::Tier_statistics
+            {
+                .function_count = 3,
+                .compilation_count = 2,
+                .compilation_time = 1500us,
+                .counted_call_count = 250,
+            },
+            h::compiler::Tier_statistics
+            {
+                .function_count = 1,
+                .compilation_count = 2,
+                .compilation_time = 20ms,
+                .discarded_count = 1,
+                .failed_count = 0,
+            },
+        };
+
+        std::string const expected_report =
+            "Tier 0 (O0): 3 functions, 2 compilations in 1ms, 250 calls counted\n"
+            "Tier 1 (O3): 1 functions tiered up after 100 calls, 2 compilations in 20ms, 1 discarded, 0 failed\n";
+
+        CHECK(h::compiler::get_tier_statistics_report(statistics, options) == expected_report);
+    }
+
+    TEST_CASE("Run JIT program again using the object cache", "[JIT]")
+    {
+        SKIP();
+
+        std::filesystem::path const root_directory = std::filesystem::temp_directory_path() / "hlang_test" / "jit_object_cache";
+
+        if (std::filesystem::exists(root_directory))
+            std::filesystem::remove_all(root_directory);
+
+        std::filesystem::create_directories(root_directory);
+
+        std::filesystem::path const build_directory_path = root_directory / "build";
+        std::filesystem::create_directories(build_directory_path);
+
+        std::filesystem::path const artifact_configuration_file_path = root_directory / "hlang_artifact.json";
+        h::compiler::Artifact const artifact
+        {
+            .file_path = artifact_configuration_file_path,
+            .name = "hlang_artifact.json",
+            .version = {
+                .major = 0,
+                .minor = 1,
+                .patch = 0
+            },
+            .type = h::compiler::Artifact_type::Executable,
+            .dependencies = {},
+            .sources = {
+                h::compiler::Source_group
+                {
+                    .data = h::compiler::Hlang_source_group{},
+                    .include = "./**/*.hltxt"
+                }
+            },
+            .info = h::compiler::Executable_info
+            {
+                .source = "main.hltxt",
+                .entry_point = "main",
+            }
+        };
+
+        h::compiler::write_artifact_to_file(artifact, artifact_configuration_file_path);
+
+        std::filesystem::path const main_file_path = root_directory / "main.hltxt";
+        std::string_view const code = R"(
+            module test;
+
+            export function main() -> (result: Int32)
+            {
+                return 10;
+            }
+        )";
+        h::common::write_to_file(main_file_path, code);
+
+        h::compiler::Target const target = h::compiler::get_default_target();
+        h::compiler::Compilation_options const compilation_options =
+        {
+            .target_triple = std::nullopt,
+            .optimization_level = h::compiler::Optimization_level::O0,
+            .debug = false,
+        };
+        std::uint64_t const object_cache_maximum_size_in_bytes = 64 * 1024 * 1024;
+
+        {
+            std::unique_ptr<h::compiler::JIT_runner> jit_runner = h::compiler::setup_jit_and_watch(artifact_configuration_file_path, {}, build_directory_path, {}, target, compilation_options, std::nullopt, std::chrono::milliseconds{ 50 }, 0, std::nullopt, object_cache_maximum_size_in_bytes);
+
+            int(*function_pointer)() = h::compiler::get_function<int(*)()>(*jit_runner, "test_main");
+            REQUIRE(function_pointer != nullptr);
+            CHECK(function_pointer() == 10);
+
+            std::optional<h::compiler::JIT_object_cache_statistics> const statistics = h::compiler::get_object_cache_statistics(*jit_runner);
+            REQUIRE(statistics.has_value());
+            CHECK(statistics->hit_count == 0);
+            CHECK(statistics->write_count == 1);
+        }
+
+        // A new JIT compiles nothing, since the module did not change:
+        {
+            std::unique_ptr<h::compiler::JIT_runner> jit_runner = h::compiler::setup_jit_and_watch(artifact_configuration_file_path, {}, build_directory_path, {}, target, compilation_options, std::nullopt, std::chrono::milliseconds{ 50 }, 0, std::nullopt, object_cache_maximum_size_in_bytes);
+
+            int(*function_pointer)() = h::compiler::get_function<int(*)()>(*jit_runner, "test_main");
+            REQUIRE(function_pointer != nullptr);
+            CHECK(function_pointer() == 10);
+
+            std::optional<h::compiler::JIT_object_cache_statistics> const statistics = h::compiler::get_object_cache_statistics(*jit_runner);
+            REQUIRE(statistics.has_value());
+            CHECK(statistics->hit_count == 1);
+            CHECK(statistics->write_count == 0);
+        }
+    }
+
+    TEST_CASE("Object cache module identifiers round-trip their keys", "[JIT][Object_cache]")
+    {
+        for (std::uint64_t const key : { std::uint64_t{0}, std::uint64_t{1}, std::uint64_t{0x0123456789abcdef}, ~std::uint64_t{0} })
+        {
+            std::string const module_identifier = h::compiler::get_object_cache_module_identifier(key);
+
+            std::optional<std::uint64_t> const parsed_key = h::compiler::get_object_cache_key(module_identifier);
+            REQUIRE(parsed_key.has_value());
+            CHECK(parsed_key.value() == key);
+        }
+    }
+
+    TEST_CASE("Object cache ignores malformed module identifiers", "[JIT][Object_cache]")
+    {
+        std::string const valid_identifier = h::compiler::get_object_cache_module_identifier(0x1234);
+        std::string_view const prefix = std::string_view{valid_identifier}.substr(0, valid_identifier.size() - 16);
+
+        CHECK(!h::compiler::get_object_cache_key("").has_value());
+        CHECK(!h::compiler::get_object_cache_key("test").has_value());
+        CHECK(!h::compiler::get_object_cache_key(prefix).has_value());
+        CHECK(!h::compiler::get_object_cache_key(std::string{prefix} + "xyz").has_value());
+        CHECK(!h::compiler::get_object_cache_key(std::string{prefix} + "1234 ").has_value());
+        CHECK(!h::compiler::get_object_cache_key(std::string{prefix} + "-1234").has_value());
+        CHECK(!h::compiler::get_object_cache_key(std::string{prefix} + "1ffffffffffffffff").has_value());
+        CHECK(!h::compiler::get_object_cache_key("other" + valid_identifier).has_value());
+    }
+
+    TEST_CASE("Object cache returns the objects it was notified about", "[JIT][Object_cache]")
+    {
+        std::filesystem::path const root_directory = std::filesystem::temp_directory_path() / "hlang_test" / "jit_object_cache_store";
+
+        if (std::filesystem::exists(root_directory))
+            std::filesystem::remove_all(root_directory);
+
+        h::compiler::Function_cache const storage
+        {
+            .directory = root_directory,
+            .maximum_size_in_bytes = 1024 * 1024,
+        };
+        h::compiler::JIT_object_cache object_cache{ storage, 0 };
+
+        std::uint64_t const key = 0xabcdef;
+        std::string_view const object_data = "object file contents";
+
+        llvm::LLVMContext llvm_context;
+        llvm::Module const cached_module{ h::compiler::get_object_cache_module_identifier(key), llvm_context };
+        llvm::Module const uncached_module{ "test", llvm_context };
+
+        CHECK(object_cache.get_object(key) == nullptr);
+        CHECK(object_cache.getObject(&cached_module) == nullptr);
+
+        object_cache.notifyObjectCompiled(&uncached_module, llvm::MemoryBufferRef{ object_data, "test" });
+        CHECK(object_cache.get_statistics().write_count == 0);
+
+        object_cache.notifyObjectCompiled(&cached_module, llvm::MemoryBufferRef{ object_data, "test" });
+        CHECK(object_cache.get_statistics().write_count == 1);
+
+        std::unique_ptr<llvm::MemoryBuffer> const object = object_cache.get_object(key);
+        REQUIRE(object != nullptr);
+        CHECK(object->getBuffer().str() == object_data);
+
+        std::unique_ptr<llvm::MemoryBuffer> const module_object = object_cache.getObject(&cached_module);
+        REQUIRE(module_object != nullptr);
+        CHECK(module_object->getBuffer().str() == object_data);
+
+        CHECK(object_cache.getObject(&uncached_module) == nullptr);
+
+        h::compiler::JIT_object_cache_statistics const statistics = object_cache.get_statistics();
+        CHECK(statistics.hit_count == 1);
+        CHECK(statistics.miss_count == 1);
+
+        // No temporary files are left behind:
+        std::size_t file_count = 0;
+        for (std::filesystem::directory_entry const& entry : std::filesystem::directory_iterator{ root_directory })
+        {
+            CHECK(entry.path().extension() == ".o");
+            file_count += 1;
+        }
+        CHECK(file_count == 1);
+    }
+
+    TEST_CASE("Object cache evicts the least recently used objects", "[JIT][Object_cache]")
+    {
+        std::filesystem::path const root_directory = std::filesystem::temp_directory_path() / "hlang_test" / "jit_object_cache_eviction";
+
+        if (std::filesystem::exists(root_directory))
+            std::filesystem::remove_all(root_directory);
+
+        std::string_view const object_data = "0123456789abcdef";
+
+        {
+            h::compiler::Function_cache const storage
+            {
+                .directory = root_directory,
+                .maximum_size_in_bytes = 1024 * 1024,
+            };
+            h::compiler::JIT_object_cache object_cache{ storage, 0 };
+
+            llvm::LLVMContext llvm_context;
+            std::filesystem::file_time_type const now = std::filesystem::file_time_type::clock::now();
+
+            for (std::uint64_t key = 1; key <= 3; ++key)
+            {
+                llvm::Module const llvm_module{ h::compiler::get_object_cache_module_identifier(key), llvm_context };
+                object_cache.notifyObjectCompiled(&llvm_module, llvm::MemoryBufferRef{ object_data, "test" });
+
+                // Key 1 is the least recently used:
+                std::filesystem::path const entry_path = h::compiler::get_function_cache_entry_path(storage, key, "o");
+                std::filesystem::last_write_time(entry_path, now - std::chrono::hours{ 4 - static_cast<int>(key) });
+            }
+        }
+
+        h::compiler::Function_cache const storage
+        {
+            .directory = root_directory,
+            .maximum_size_in_bytes = 2 * object_data.size(),
+        };
+        h::compiler::JIT_object_cache object_cache{ storage, 0 };
+
+        CHECK(object_cache.get_statistics().evicted_count == 1);
+        CHECK(object_cache.get_object(1) == nullptr);
+        CHECK(object_cache.get_object(2) != nullptr);
+        CHECK(object_cache.get_object(3) != nullptr);
+    }
+
     // TODO test making changes to Artifact
     // TODO test making changes to Repository
 }
@@ -3,6 +3,7 @@ module;
 #include <llvm/ExecutionEngine/Orc/Core.h>
 #include <llvm/ExecutionEngine/Orc/LazyReexports.h>
 
+#include <atomic>
 #include <filesystem>
 #include <memory>
 #include <memory_resource>
@@ -52,19 +53,26 @@ namespace h::compiler
     {
         llvm::orc::SymbolAliasMap new_aliases;
         llvm::orc::SymbolAliasMap replace_aliases;
+        h::Module renamed_declarations;
+        std::pmr::unordered_map<std::pmr::string, std::pmr::string> function_name_to_body_name;
+        std::pmr::unordered_map<std::pmr::string, std::pmr::string> body_name_to_function_name;
     };
 
-    static Recompile_data modify_function_names_and_create_recompile_data(
-        h::Module& core_module,
+    static Recompile_data create_recompile_data(
+        h::Module const& original_core_module,
         llvm::orc::ExecutionSession& execution_session,
         llvm::orc::JITDylib& source_library,
         llvm::orc::IndirectStubsManager& indirect_stubs_manager,
         llvm::orc::MangleAndInterner& mangle
     )
     {
-        static int id = 0;
+        // Modules of the same rank are added in parallel:
+        static std::atomic<int> id = 0;
+        int const module_id = id.fetch_add(1);
 
         Recompile_data recompile_data;
+        recompile_data.renamed_declarations = copy_module_declarations(original_core_module);
+        h::Module& core_module = recompile_data.renamed_declarations;
 
         std::pmr::vector<h::Function_declaration> new_function_declarations;
         new_function_declarations.reserve(core_module.export_declarations.function_declarations.size() + core_module.internal_declarations.function_declarations.size());
@@ -74,12 +82,15 @@ namespace h::compiler
             std::string const stub_name = mangle_function_name(core_module, declaration.name);
             llvm::orc::SymbolStringPtr const stub_symbol = mangle(stub_name.c_str());
 
-            std::string const body_name = std::format("{}_{}_$body", declaration.name, id);
+            std::string const body_name = std::format("{}_{}_$body", declaration.name, module_id);
             std::string const mangled_body_name = mangle_name(core_module, body_name, std::nullopt);
             llvm::orc::SymbolStringPtr const body_symbol = mangle(mangled_body_name.c_str());
 
             declaration.linkage = h::Linkage::External;
 
+            recompile_data.function_name_to_body_name.insert(std::make_pair(declaration.name, std::pmr::string{ body_name }));
+            recompile_data.body_name_to_function_name.insert(std::make_pair(std::pmr::string{ body_name }, declaration.name));
+
             {
                 h::Function_declaration body_declaration = declaration;
                 body_declaration.name = body_name;
@@ -114,17 +125,8 @@ namespace h::compiler
             process_function_declaration(declaration);
         }
 
-        for (h::Function_definition& definition : core_module.definitions.function_definitions)
-        {
-            std::string const body_name = std::format("{}_{}_$body", definition.name, id);
-
-            definition.name = body_name;
-        }
-
         core_module.internal_declarations.function_declarations.insert(core_module.internal_declarations.function_declarations.end(), new_function_declarations.begin(), new_function_declarations.end());
 
-        id += 1;
-
         return recompile_data;
     }
 
@@ -136,17 +138,22 @@ namespace h::compiler
         llvm::orc::IndirectStubsManager& indirect_stubs_manager,
         llvm::orc::JITDylib& source_library,
         llvm::orc::MangleAndInterner& mangle,
-        h::compiler::Core_module_layer& next_layer
+        h::compiler::Core_module_layer& next_layer,
+        Tiered_compilation* const tiered_compilation
     )
     {
-        Recompile_data recompile_data = modify_function_names_and_create_recompile_data(
-            core_module_compilation_data.core_module,
+        Recompile_data recompile_data = create_recompile_data(
+            *core_module_compilation_data.core_module,
             execution_session,
             source_library,
             indirect_stubs_manager,
             mangle
         );
 
+        core_module_compilation_data.renamed_declarations = std::make_shared<h::Module const>(std::move(recompile_data.renamed_declarations));
+        core_module_compilation_data.function_name_to_body_name = std::move(recompile_data.function_name_to_body_name);
+        core_module_compilation_data.body_name_to_function_name = std::move(recompile_data.body_name_to_function_name);
+
         // Add module to the next layer for compilation:
         {
             llvm::Error error = next_layer.add(source_library.createResourceTracker(), std::move(core_module_compilation_data));
@@ -205,7 +212,11 @@ namespace h::compiler
                 if (!function_address)
                     return function_address.takeError();
 
-                if (llvm::Error error = indirect_stubs_manager.updatePointer(*stub_symbol, function_address->getAddress()))
+                // The tiered compilation thread may be swapping the same stub:
+                llvm::Error error = tiered_compilation != nullptr ?
+                    tiered_compilation->update_stub_pointer(stub_symbol, aliasee_symbol, function_address->getAddress()) :
+                    indirect_stubs_manager.updatePointer(*stub_symbol, function_address->getAddress());
+                if (error)
                     return error;
             }
         }
@@ -219,13 +230,15 @@ namespace h::compiler
         h::compiler::Core_module_layer& base_layer,
         llvm::orc::LazyCallThroughManager& lazy_call_through_manager,
         llvm::orc::IndirectStubsManager& indirect_stubs_manager,
-        llvm::orc::MangleAndInterner& mangle
+        llvm::orc::MangleAndInterner& mangle,
+        Tiered_compilation* const tiered_compilation
     ) :
         m_base_layer{ base_layer },
         m_execution_session{ execution_session },
         m_lazy_call_through_manager{ lazy_call_through_manager },
         m_indirect_stubs_manager{ indirect_stubs_manager },
-        m_mangle{ mangle }
+        m_mangle{ mangle },
+        m_tiered_compilation{ tiered_compilation }
     {
     }
 
@@ -244,7 +257,8 @@ namespace h::compiler
             m_indirect_stubs_manager,
             library,
             m_mangle,
-            m_base_layer
+            m_base_layer,
+            m_tiered_compilation
         );
     }
 
@@ -263,7 +277,8 @@ namespace h::compiler
             m_indirect_stubs_manager,
             library,
             m_mangle,
-            m_base_layer
+            m_base_layer,
+            m_tiered_compilation
         );
         if (error)
             h::common::print_message_and_exit(std::format("Failed to recompile module: {}", llvm::toString(std::move(error))));
@@ -28,7 +28,8 @@ namespace h::compiler
             h::compiler::Core_module_layer& base_layer,
             llvm::orc::LazyCallThroughManager& lazy_call_through_manager,
             llvm::orc::IndirectStubsManager& indirect_stubs_manager,
-            llvm::orc::MangleAndInterner& mangle
+            llvm::orc::MangleAndInterner& mangle,
+            Tiered_compilation* tiered_compilation
         );
         virtual ~Recompile_module_layer() = default;
 
@@ -48,5 +49,6 @@ namespace h::compiler
         llvm::orc::LazyCallThroughManager& m_lazy_call_through_manager;
         llvm::orc::IndirectStubsManager& m_indirect_stubs_manager;
         llvm::orc::MangleAndInterner& m_mangle;
+        Tiered_compilation* m_tiered_compilation;
     };
 }
@@ -1,6 +1,7 @@
 module;
 
 #include <filesystem>
+#include <optional>
 #include <span>
 #include <string>
 #include <string_view>
@@ -22,6 +23,7 @@ namespace h::compiler
         std::optional<std::string_view> entry_point = std::nullopt;
         bool debug = false;
         Link_type link_type = Link_type::Static_library;
+        std::span<std::string_view const> undefined_symbols = {}; // Resolved even if no input references them
     };
 
     export bool link(
@@ -2,12 +2,14 @@ module;
 
 #include <lld/Common/Driver.h>
 
+#include <llvm/Object/Archive.h>
 #include <llvm/Object/ArchiveWriter.h>
 #include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/raw_ostream.h>
 
 #include <filesystem>
 #include <format>
+#include <memory>
 #include <span>
 #include <string>
 #include <string_view>
@@ -45,6 +47,9 @@ namespace h::compiler
         if (options.debug)
             arguments_storage.push_back("/debug:full");
 
+        for (std::string_view const symbol : options.undefined_symbols)
+            arguments_storage.push_back(std::format("/include:{}", symbol));
+
         for (std::string_view const library : libraries)
         {
             std::filesystem::path library_path = library;
@@ -61,9 +66,13 @@ namespace h::compiler
             }
         }
 
+        // Module archives hold one object per function, and all of them are part of the output:
         for (std::filesystem::path const& object_file_path : object_file_paths)
         {
-            arguments_storage.push_back(object_file_path.generic_string());
+            if (object_file_path.extension() == ".lib")
+                arguments_storage.push_back(std::format("/wholearchive:{}", object_file_path.generic_string()));
+            else
+                arguments_storage.push_back(object_file_path.generic_string());
         }
 
 
@@ -96,15 +105,47 @@ namespace h::compiler
     )
     {
         std::pmr::vector<llvm::NewArchiveMember> members;
-        members.resize(object_file_paths.size());
+        members.reserve(object_file_paths.size());
 
-        for (std::size_t index = 0; index < object_file_paths.size(); ++index)
+        // Module archives are flattened, as the linker does not look into nested archives.
+        // Their buffers must outlive the members that refer to them.
+        std::pmr::vector<std::unique_ptr<llvm::MemoryBuffer>> archive_buffers;
+        std::pmr::vector<std::unique_ptr<llvm::object::Archive>> archives;
+
+        for (std::filesystem::path const& object_file_path : object_file_paths)
         {
-            llvm::Expected<llvm::NewArchiveMember> member = llvm::NewArchiveMember::getFile(object_file_paths[index].generic_string(), true);
-            if (llvm::Error error = member.takeError())
-                h::common::print_message_and_exit(std::format("Error while creating creating member for static library: {}", llvm::toString(std::move(error))));
+            if (object_file_path.extension() != ".lib")
+            {
+                llvm::Expected<llvm::NewArchiveMember> member = llvm::NewArchiveMember::getFile(object_file_path.generic_string(), true);
+                if (llvm::Error error = member.takeError())
+                    h::common::print_message_and_exit(std::format("Error while creating creating member for static library: {}", llvm::toString(std::move(error))));
+
+                members.push_back(std::move(member.get()));
+                continue;
+            }
+
+            llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer = llvm::MemoryBuffer::getFile(object_file_path.generic_string());
+            if (!buffer)
+                h::common::print_message_and_exit(std::format("Could not read archive '{}': {}", object_file_path.generic_string(), buffer.getError().message()));
+
+            llvm::Expected<std::unique_ptr<llvm::object::Archive>> archive = llvm::object::Archive::create(buffer.get()->getMemBufferRef());
+            if (llvm::Error error = archive.takeError())
+                h::common::print_message_and_exit(std::format("Could not read archive '{}': {}", object_file_path.generic_string(), llvm::toString(std::move(error))));
+
+            llvm::Error children_error = llvm::Error::success();
+            for (llvm::object::Archive::Child const& child : archive.get()->children(children_error))
+            {
+                llvm::Expected<llvm::NewArchiveMember> member = llvm::NewArchiveMember::getOldMember(child, true);
+                if (llvm::Error error = member.takeError())
+                    h::common::print_message_and_exit(std::format("Error while creating creating member for static library: {}", llvm::toString(std::move(error))));
+
+                members.push_back(std::move(member.get()));
+            }
+            if (children_error)
+                h::common::print_message_and_exit(std::format("Could not read archive '{}': {}", object_file_path.generic_string(), llvm::toString(std::move(children_error))));
 
-            members[index] = std::move(member.get());
+            archive_buffers.push_back(std::move(buffer.get()));
+            archives.push_back(std::move(archive.get()));
         }
 
         llvm::Error error = llvm::writeArchive(
@@ -81,14 +81,29 @@ namespace h::compiler
         if (options.debug)
             arguments_storage.push_back("-g");
 
+        for (std::string_view const symbol : options.undefined_symbols)
+        {
+            arguments_storage.push_back(std::format("-u{}", symbol));
+        }
+
         for (std::string_view const library : libraries)
         {
             arguments_storage.push_back(std::format("-l{}", library));
         }
 
+        // Module archives hold one object per function, and all of them are part of the output:
         for (std::filesystem::path const& object_file_path : object_file_paths)
         {
-            arguments_storage.push_back(object_file_path.generic_string());
+            if (object_file_path.extension() == ".a")
+            {
+                arguments_storage.push_back("--whole-archive");
+                arguments_storage.push_back(object_file_path.generic_string());
+                arguments_storage.push_back("--no-whole-archive");
+            }
+            else
+            {
+                arguments_storage.push_back(object_file_path.generic_string());
+            }
         }
 
 
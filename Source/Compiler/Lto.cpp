@@ -0,0 +1,319 @@
+module;
+
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/BinaryFormat/Magic.h>
+#include <llvm/LTO/Config.h>
+#include <llvm/LTO/LTO.h>
+#include <llvm/Object/Archive.h>
+#include <llvm/Object/Binary.h>
+#include <llvm/Object/SymbolicFile.h>
+#include <llvm/Support/CachePruning.h>
+#include <llvm/Support/Caching.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Threading.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+module h.compiler.lto;
+
+import h.compiler;
+import h.compiler.target;
+
+namespace h::compiler
+{
+    static unsigned int get_lto_optimization_level(
+        Optimization_level const optimization_level
+    )
+    {
+        switch (optimization_level)
+        {
+        case Optimization_level::O0:
+            return 0;
+        case Optimization_level::O1:
+            return 1;
+        case Optimization_level::O3:
+            return 3;
+        case Optimization_level::O2:
+        case Optimization_level::Os:
+        case Optimization_level::Oz:
+        default:
+            return 2;
+        }
+    }
+
+    static llvm::lto::Config create_lto_config(
+        Thin_lto_options const& options
+    )
+    {
+        llvm::lto::Config config;
+        config.DefaultTriple = std::string{options.target_triple};
+        config.CPU = std::string{options.cpu};
+        for (llvm::StringRef const feature : llvm::split(llvm::StringRef{options.features.data(), options.features.size()}, ','))
+        {
+            if (!feature.empty())
+                config.MAttrs.push_back(feature.str());
+        }
+        config.OptLevel = get_lto_optimization_level(options.optimization_level);
+        config.CGOptLevel = to_llvm_code_generation_optimization_level(options.optimization_level);
+        return config;
+    }
+
+    static void print_error(
+        std::string_view const message,
+        llvm::Error error
+    )
+    {
+        llvm::errs() << std::format("{}: {}\n", message, llvm::toString(std::move(error)));
+    }
+
+    static bool write_buffer_to_file(
+        std::filesystem::path const& output_file_path,
+        llvm::MemoryBuffer const& buffer
+    )
+    {
+        std::error_code error_code;
+        llvm::raw_fd_ostream output_stream(output_file_path.generic_string(), error_code, llvm::sys::fs::OF_None);
+        if (error_code)
+        {
+            llvm::errs() << std::format("Could not open file '{}': {}\n", output_file_path.generic_string(), error_code.message());
+            return false;
+        }
+
+        output_stream << buffer.getBuffer();
+        return true;
+    }
+
+    static void add_undefined_symbols(
+        std::unordered_set<std::string>& undefined_symbols,
+        llvm::object::Binary const& binary
+    )
+    {
+        if (llvm::object::Archive const* const archive = llvm::dyn_cast<llvm::object::Archive>(&binary))
+        {
+            llvm::Error error = llvm::Error::success();
+            for (llvm::object::Archive::Child const& child : archive->children(error))
+            {
+                llvm::Expected<std::unique_ptr<llvm::object::Binary>> child_binary = child.getAsBinary();
+                if (!child_binary)
+                {
+                    llvm::consumeError(child_binary.takeError());
+                    continue;
+                }
+
+                add_undefined_symbols(undefined_symbols, *child_binary.get());
+            }
+            llvm::consumeError(std::move(error));
+            return;
+        }
+
+        llvm::object::SymbolicFile const* const symbolic_file = llvm::dyn_cast<llvm::object::SymbolicFile>(&binary);
+        if (symbolic_file == nullptr)
+            return;
+
+        for (llvm::object::BasicSymbolRef const& symbol : symbolic_file->symbols())
+        {
+            llvm::Expected<std::uint32_t> const flags = symbol.getFlags();
+            if (!flags)
+            {
+                llvm::consumeError(flags.takeError());
+                continue;
+            }
+            if ((flags.get() & llvm::object::BasicSymbolRef::SF_Undefined) == 0)
+                continue;
+
+            std::string name;
+            llvm::raw_string_ostream name_stream{name};
+            if (llvm::Error error = symbol.printName(name_stream))
+            {
+                llvm::consumeError(std::move(error));
+                continue;
+            }
+            undefined_symbols.insert(std::move(name));
+        }
+    }
+
+    // Like lld, any symbol that a native object or library references must stay visible, or ThinLTO would internalize it and drop it.
+    // Files that cannot be read, such as system libraries given by name, are skipped.
+    static void add_undefined_symbols(
+        std::unordered_set<std::string>& undefined_symbols,
+        std::filesystem::path const& file_path
+    )
+    {
+        llvm::Expected<llvm::object::OwningBinary<llvm::object::Binary>> binary = llvm::object::createBinary(file_path.generic_string());
+        if (!binary)
+        {
+            llvm::consumeError(binary.takeError());
+            return;
+        }
+
+        add_undefined_symbols(undefined_symbols, *binary.get().getBinary());
+    }
+
+    static bool is_bitcode_file(
+        std::filesystem::path const& file_path
+    )
+    {
+        llvm::file_magic magic;
+        if (llvm::identify_magic(file_path.generic_string(), magic))
+            return false;
+
+        return magic == llvm::file_magic::bitcode;
+    }
+
+    std::optional<std::pmr::vector<std::filesystem::path>> run_thin_lto(
+        std::span<std::filesystem::path const> const bitcode_file_paths,
+        Thin_lto_options const& options,
+        std::pmr::polymorphic_allocator<> const& output_allocator
+    )
+    {
+        llvm::lto::ThinBackend backend = llvm::lto::createInProcessThinBackend(
+            llvm::heavyweight_hardware_concurrency(static_cast<unsigned int>(options.jobs))
+        );
+        llvm::lto::LTO lto{create_lto_config(options), std::move(backend)};
+
+        // The input files reference the buffers, which must stay alive until the backends are done:
+        std::pmr::vector<std::unique_ptr<llvm::MemoryBuffer>> buffers;
+        buffers.reserve(bitcode_file_paths.size());
+
+        std::unordered_set<std::string> defined_symbols;
+
+        // Objects compiled without bitcode, such as C++ sources, are not part of the thin link and are linked as they are:
+        std::pmr::vector<std::filesystem::path> native_object_file_paths{output_allocator};
+        std::unordered_set<std::string> native_undefined_symbols;
+
+        for (std::filesystem::path const& bitcode_file_path : bitcode_file_paths)
+        {
+            if (!is_bitcode_file(bitcode_file_path))
+            {
+                add_undefined_symbols(native_undefined_symbols, bitcode_file_path);
+                native_object_file_paths.push_back(bitcode_file_path);
+            }
+        }
+
+        for (std::filesystem::path const& native_file_path : options.native_file_paths)
+            add_undefined_symbols(native_undefined_symbols, native_file_path);
+
+        for (std::filesystem::path const& bitcode_file_path : bitcode_file_paths)
+        {
+            if (!is_bitcode_file(bitcode_file_path))
+                continue;
+
+            llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer = llvm::MemoryBuffer::getFile(bitcode_file_path.generic_string());
+            if (!buffer)
+            {
+                llvm::errs() << std::format("Could not read '{}': {}\n", bitcode_file_path.generic_string(), buffer.getError().message());
+                return std::nullopt;
+            }
+
+            llvm::Expected<std::unique_ptr<llvm::lto::InputFile>> input_file = llvm::lto::InputFile::create(buffer.get()->getMemBufferRef());
+            if (!input_file)
+            {
+                print_error(std::format("Could not read bitcode of '{}'", bitcode_file_path.generic_string()), input_file.takeError());
+                return std::nullopt;
+            }
+
+            // Every symbol is defined by bitcode of this link, except for the ones of external libraries.
+            // Only preserved symbols and symbols referenced by native code are visible outside of it, so everything else can be internalized.
+            std::vector<llvm::lto::SymbolResolution> resolutions;
+            resolutions.reserve(input_file.get()->symbols().size());
+
+            for (llvm::lto::InputFile::Symbol const& symbol : input_file.get()->symbols())
+            {
+                std::string_view const name{symbol.getName().data(), symbol.getName().size()};
+                bool const is_preserved = std::find(options.preserved_symbols.begin(), options.preserved_symbols.end(), name) != options.preserved_symbols.end();
+
+                llvm::lto::SymbolResolution resolution;
+                resolution.Prevailing = !symbol.isUndefined() && defined_symbols.insert(std::string{name}).second;
+                resolution.VisibleToRegularObj = is_preserved || symbol.isUsed() || native_undefined_symbols.contains(std::string{name});
+                resolutions.push_back(resolution);
+            }
+
+            if (llvm::Error error = lto.add(std::move(input_file.get()), resolutions))
+            {
+                print_error(std::format("Could not add '{}' to the thin link", bitcode_file_path.generic_string()), std::move(error));
+                return std::nullopt;
+            }
+
+            buffers.push_back(std::move(buffer.get()));
+        }
+
+        std::size_t const task_count = lto.getMaxTasks();
+
+        auto const get_object_file_path = [&](unsigned int const task) -> std::filesystem::path
+        {
+            return options.output_directory / std::format("{}.{}.{}", options.output_prefix, task, options.object_file_extension);
+        };
+
+        // Backends run on several threads, so each one only writes the element of its own task:
+        std::pmr::vector<std::uint8_t> has_output(task_count, 0);
+        std::pmr::vector<std::uint8_t> has_error(task_count, 0);
+
+        llvm::AddStreamFn const add_stream = [&](unsigned int const task, llvm::Twine const&) -> llvm::Expected<std::unique_ptr<llvm::CachedFileStream>>
+        {
+            std::error_code error_code;
+            std::unique_ptr<llvm::raw_fd_ostream> output_stream = std::make_unique<llvm::raw_fd_ostream>(get_object_file_path(task).generic_string(), error_code, llvm::sys::fs::OF_None);
+            if (error_code)
+                return llvm::errorCodeToError(error_code);
+
+            has_output[task] = 1;
+            return std::make_unique<llvm::CachedFileStream>(std::move(output_stream));
+        };
+
+        // Called with the cached object when a backend result is found in the cache, and after a new result was added to it:
+        llvm::AddBufferFn const add_buffer = [&](unsigned int const task, llvm::Twine const&, std::unique_ptr<llvm::MemoryBuffer> buffer) -> void
+        {
+            if (!write_buffer_to_file(get_object_file_path(task), *buffer))
+                has_error[task] = 1;
+
+            has_output[task] = 1;
+        };
+
+        std::filesystem::create_directories(options.output_directory);
+        std::filesystem::create_directories(options.cache_directory);
+
+        llvm::Expected<llvm::FileCache> cache = llvm::localCache("ThinLTO", "Thin", options.cache_directory.generic_string(), add_buffer);
+        if (!cache)
+        {
+            print_error("Could not create the ThinLTO cache", cache.takeError());
+            return std::nullopt;
+        }
+
+        if (llvm::Error error = lto.run(add_stream, cache.get()))
+        {
+            print_error("ThinLTO failed", std::move(error));
+            return std::nullopt;
+        }
+
+        if (std::find(has_error.begin(), has_error.end(), 1) != has_error.end())
+            return std::nullopt;
+
+        // Keep the cache from growing without bounds:
+        llvm::Expected<llvm::CachePruningPolicy> const pruning_policy = llvm::parseCachePruningPolicy("");
+        if (pruning_policy)
+            llvm::pruneCache(options.cache_directory.generic_string(), pruning_policy.get());
+
+        std::pmr::vector<std::filesystem::path> object_file_paths = std::move(native_object_file_paths);
+        for (unsigned int task = 0; task < task_count; ++task)
+        {
+            if (has_output[task] != 0)
+                object_file_paths.push_back(get_object_file_path(task));
+        }
+
+        return object_file_paths;
+    }
+}
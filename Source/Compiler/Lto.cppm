@@ -0,0 +1,40 @@
+module;
+
+#include <cstddef>
+#include <filesystem>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+export module h.compiler.lto;
+
+import h.compiler.target;
+
+namespace h::compiler
+{
+    export struct Thin_lto_options
+    {
+        std::string_view target_triple;
+        std::string_view cpu;
+        std::string_view features;
+        Optimization_level optimization_level = Optimization_level::O0;
+        std::span<std::string_view const> preserved_symbols; // Symbols referenced from outside the linked bitcode, such as the entry point
+        std::span<std::filesystem::path const> native_file_paths; // Objects and libraries linked with the output, whose undefined symbols stay visible
+        std::filesystem::path output_directory;
+        std::string_view output_prefix;
+        std::string_view object_file_extension;
+        std::filesystem::path cache_directory;
+        std::size_t jobs = 0; // 0 means one job per hardware thread
+    };
+
+    // Runs the thin link over the bitcode files and the per-module backends in parallel.
+    // Input files that are not bitcode are returned as they are, together with the generated object files.
+    // Returns the paths of the object files, or std::nullopt if an error was printed.
+    export std::optional<std::pmr::vector<std::filesystem::path>> run_thin_lto(
+        std::span<std::filesystem::path const> bitcode_file_paths,
+        Thin_lto_options const& options,
+        std::pmr::polymorphic_allocator<> const& output_allocator
+    );
+}
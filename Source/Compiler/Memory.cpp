@@ -0,0 +1,61 @@
+module;
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+
+module h.compiler.memory;
+
+namespace h::compiler
+{
+    Tracked_memory_resource::Tracked_memory_resource(
+        std::pmr::memory_resource* const upstream
+    ) :
+        m_upstream{ upstream }
+    {
+    }
+
+    std::size_t Tracked_memory_resource::get_current_bytes() const
+    {
+        return m_current_bytes.load(std::memory_order_relaxed);
+    }
+
+    std::size_t Tracked_memory_resource::get_peak_bytes() const
+    {
+        return m_peak_bytes.load(std::memory_order_relaxed);
+    }
+
+    void* Tracked_memory_resource::do_allocate(
+        std::size_t const bytes,
+        std::size_t const alignment
+    )
+    {
+        void* const pointer = m_upstream->allocate(bytes, alignment);
+
+        std::size_t const current_bytes = m_current_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+        std::size_t peak_bytes = m_peak_bytes.load(std::memory_order_relaxed);
+        while (current_bytes > peak_bytes && !m_peak_bytes.compare_exchange_weak(peak_bytes, current_bytes, std::memory_order_relaxed))
+        {
+        }
+
+        return pointer;
+    }
+
+    void Tracked_memory_resource::do_deallocate(
+        void* const pointer,
+        std::size_t const bytes,
+        std::size_t const alignment
+    )
+    {
+        m_upstream->deallocate(pointer, bytes, alignment);
+        m_current_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    bool Tracked_memory_resource::do_is_equal(
+        std::pmr::memory_resource const& other
+    ) const noexcept
+    {
+        return this == &other;
+    }
+}
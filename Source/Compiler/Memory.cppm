@@ -0,0 +1,33 @@
+module;
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+
+export module h.compiler.memory;
+
+namespace h::compiler
+{
+    // Forwards allocations to an upstream resource and records how many bytes are in use.
+    // Placed between an arena and the heap, it measures how much memory the arena holds.
+    export class Tracked_memory_resource : public std::pmr::memory_resource
+    {
+    public:
+
+        explicit Tracked_memory_resource(
+            std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()
+        );
+
+        std::size_t get_current_bytes() const;
+        std::size_t get_peak_bytes() const;
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) final;
+        void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) final;
+        bool do_is_equal(std::pmr::memory_resource const& other) const noexcept final;
+
+        std::pmr::memory_resource* m_upstream;
+        std::atomic_size_t m_current_bytes = 0;
+        std::atomic_size_t m_peak_bytes = 0;
+    };
+}
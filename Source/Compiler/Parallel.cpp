@@ -0,0 +1,141 @@
+module;
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+module h.compiler.parallel;
+
+namespace h::compiler
+{
+    std::size_t get_worker_count(
+        std::size_t const requested_worker_count
+    )
+    {
+        if (requested_worker_count != 0)
+            return requested_worker_count;
+
+        std::size_t const hardware_concurrency = std::thread::hardware_concurrency();
+        return hardware_concurrency != 0 ? hardware_concurrency : 1;
+    }
+
+    struct Work_range
+    {
+        std::mutex mutex;
+        std::size_t begin = 0;
+        std::size_t end = 0;
+    };
+
+    static std::optional<std::size_t> pop_front(
+        Work_range& range
+    )
+    {
+        std::lock_guard<std::mutex> const lock{range.mutex};
+
+        if (range.begin == range.end)
+            return std::nullopt;
+
+        std::size_t const index = range.begin;
+        range.begin += 1;
+        return index;
+    }
+
+    static std::optional<std::size_t> steal_back(
+        Work_range& victim,
+        Work_range& thief
+    )
+    {
+        std::scoped_lock const lock{victim.mutex, thief.mutex};
+
+        std::size_t const remaining = victim.end - victim.begin;
+        if (remaining == 0)
+            return std::nullopt;
+
+        std::size_t const stolen_count = (remaining + 1) / 2;
+        std::size_t const stolen_begin = victim.end - stolen_count;
+
+        thief.begin = stolen_begin + 1;
+        thief.end = victim.end;
+        victim.end = stolen_begin;
+
+        return stolen_begin;
+    }
+
+    void parallel_for(
+        std::size_t const worker_count,
+        std::size_t const element_count,
+        Parallel_function const& function
+    )
+    {
+        std::size_t const actual_worker_count = std::min(get_worker_count(worker_count), element_count);
+
+        if (actual_worker_count <= 1)
+        {
+            for (std::size_t element_index = 0; element_index < element_count; ++element_index)
+                function(0, element_index);
+
+            return;
+        }
+
+        std::unique_ptr<Work_range[]> const ranges = std::make_unique<Work_range[]>(actual_worker_count);
+        for (std::size_t worker_index = 0; worker_index < actual_worker_count; ++worker_index)
+        {
+            ranges[worker_index].begin = (element_count * worker_index) / actual_worker_count;
+            ranges[worker_index].end = (element_count * (worker_index + 1)) / actual_worker_count;
+        }
+
+        std::atomic_bool stop = false;
+        std::mutex exception_mutex;
+        std::exception_ptr first_exception = nullptr;
+
+        auto const run_worker = [&](std::size_t const worker_index) -> void
+        {
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                std::optional<std::size_t> element_index = pop_front(ranges[worker_index]);
+
+                for (std::size_t offset = 1; !element_index.has_value() && offset < actual_worker_count; ++offset)
+                {
+                    std::size_t const victim_index = (worker_index + offset) % actual_worker_count;
+                    element_index = steal_back(ranges[victim_index], ranges[worker_index]);
+                }
+
+                if (!element_index.has_value())
+                    return;
+
+                try
+                {
+                    function(worker_index, element_index.value());
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> const lock{exception_mutex};
+                    if (first_exception == nullptr)
+                        first_exception = std::current_exception();
+
+                    stop.store(true, std::memory_order_relaxed);
+                }
+            }
+        };
+
+        {
+            std::vector<std::jthread> threads;
+            threads.reserve(actual_worker_count - 1);
+
+            for (std::size_t worker_index = 1; worker_index < actual_worker_count; ++worker_index)
+                threads.emplace_back(run_worker, worker_index);
+
+            run_worker(0);
+        }
+
+        if (first_exception != nullptr)
+            std::rethrow_exception(first_exception);
+    }
+}
@@ -0,0 +1,27 @@
+module;
+
+#include <cstddef>
+#include <functional>
+
+export module h.compiler.parallel;
+
+namespace h::compiler
+{
+    export std::size_t get_worker_count(
+        std::size_t const requested_worker_count
+    );
+
+    export using Parallel_function = std::function<void(std::size_t worker_index, std::size_t element_index)>;
+
+    // Calls function for every index in [0, element_count) using up to worker_count threads.
+    // Each worker starts with a contiguous range of indices and steals half of the remaining
+    // range of another worker when its own range is exhausted.
+    // worker_index is always smaller than get_worker_count(worker_count), so callers can use it
+    // to index per-worker state.
+    // If a call throws, the remaining elements are skipped and the first exception is rethrown.
+    export void parallel_for(
+        std::size_t const worker_count,
+        std::size_t const element_count,
+        Parallel_function const& function
+    );
+}
@@ -0,0 +1,316 @@
+module;
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+module h.compiler.profiler;
+
+import h.common;
+
+namespace h::compiler
+{
+    std::uint64_t create_profiler_id()
+    {
+        static std::atomic_uint64_t next_id = 1;
+        return next_id.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static thread_local std::uint64_t g_cached_profiler_id = 0;
+    static thread_local Profile_thread_buffer* g_cached_thread_buffer = nullptr;
+
+    static Profile_thread_buffer& get_thread_buffer(
+        Profiler& profiler
+    )
+    {
+        if (g_cached_profiler_id == profiler.id && g_cached_thread_buffer != nullptr)
+            return *g_cached_thread_buffer;
+
+        std::thread::id const thread_id = std::this_thread::get_id();
+
+        std::lock_guard<std::mutex> const lock{*profiler.mutex};
+
+        auto const location = std::find_if(
+            profiler.thread_buffers.begin(),
+            profiler.thread_buffers.end(),
+            [&](std::unique_ptr<Profile_thread_buffer> const& buffer) -> bool { return buffer->thread_id == thread_id; }
+        );
+
+        Profile_thread_buffer* thread_buffer = nullptr;
+        if (location != profiler.thread_buffers.end())
+        {
+            thread_buffer = location->get();
+        }
+        else
+        {
+            profiler.thread_buffers.push_back(std::make_unique<Profile_thread_buffer>());
+            thread_buffer = profiler.thread_buffers.back().get();
+            thread_buffer->thread_id = thread_id;
+        }
+
+        g_cached_profiler_id = profiler.id;
+        g_cached_thread_buffer = thread_buffer;
+        return *thread_buffer;
+    }
+
+    static Profile_event& allocate_event(
+        Profile_thread_buffer& buffer
+    )
+    {
+        if (buffer.chunks.empty() || buffer.last_chunk_size == buffer.chunks.back()->size())
+        {
+            buffer.chunks.push_back(std::make_unique<Profile_event_chunk>());
+            buffer.last_chunk_size = 0;
+        }
+
+        Profile_event& event = (*buffer.chunks.back())[buffer.last_chunk_size];
+        buffer.last_chunk_size += 1;
+        return event;
+    }
+
+    static std::int64_t get_nanoseconds_since_start(
+        Profiler const& profiler
+    )
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - profiler.start_time_point).count();
+    }
+
+    // Truncated details must stay valid UTF-8, so they end before the code point that does not fit:
+    static std::size_t get_truncated_detail_size(
+        std::string_view const detail,
+        std::size_t const maximum_size
+    )
+    {
+        if (detail.size() <= maximum_size)
+            return detail.size();
+
+        std::size_t size = maximum_size;
+        while (size > 0 && (static_cast<unsigned char>(detail[size]) & 0xC0) == 0x80)
+            size -= 1;
+
+        return size;
+    }
+
+    Profile_zone::Profile_zone(
+        Profiler* const profiler,
+        char const* const name,
+        std::string_view const detail
+    )
+    {
+        if (profiler == nullptr)
+            return;
+
+        m_profiler = profiler;
+        m_buffer = &get_thread_buffer(*profiler);
+        m_event = &allocate_event(*m_buffer);
+
+        std::size_t const detail_size = get_truncated_detail_size(detail, m_event->detail.size());
+        std::memcpy(m_event->detail.data(), detail.data(), detail_size);
+
+        m_event->name = name;
+        m_event->detail_size = static_cast<std::uint8_t>(detail_size);
+        m_event->depth = m_buffer->depth;
+        m_event->begin_nanoseconds = get_nanoseconds_since_start(*profiler);
+        m_event->end_nanoseconds = m_event->begin_nanoseconds;
+
+        m_buffer->depth += 1;
+    }
+
+    Profile_zone::~Profile_zone()
+    {
+        if (m_profiler == nullptr)
+            return;
+
+        m_event->end_nanoseconds = get_nanoseconds_since_start(*m_profiler);
+        m_buffer->depth -= 1;
+    }
+
+    void add_to_counter(
+        Profiler* const profiler,
+        std::string_view const key,
+        std::uint64_t const value
+    )
+    {
+        if (profiler == nullptr)
+            return;
+
+        std::lock_guard<std::mutex> const lock{*profiler->mutex};
+
+        auto const counter_location = std::find_if(profiler->counters.begin(), profiler->counters.end(), [&](auto const& pair) -> bool { return pair.first == key; });
+        if (counter_location == profiler->counters.end())
+        {
+            profiler->counters.push_back(std::make_pair(std::pmr::string{key}, value));
+            return;
+        }
+
+        counter_location->second += value;
+    }
+
+    template <typename Function_t>
+    static void visit_events(
+        Profile_thread_buffer const& buffer,
+        Function_t&& function
+    )
+    {
+        for (std::size_t chunk_index = 0; chunk_index < buffer.chunks.size(); ++chunk_index)
+        {
+            Profile_event_chunk const& chunk = *buffer.chunks[chunk_index];
+            std::size_t const event_count = (chunk_index + 1) == buffer.chunks.size() ? buffer.last_chunk_size : chunk.size();
+
+            for (std::size_t event_index = 0; event_index < event_count; ++event_index)
+                function(chunk[event_index]);
+        }
+    }
+
+    static std::string_view get_detail(
+        Profile_event const& event
+    )
+    {
+        return std::string_view{event.detail.data(), event.detail_size};
+    }
+
+    static double to_milliseconds(
+        std::int64_t const nanoseconds
+    )
+    {
+        return static_cast<double>(nanoseconds) / 1'000'000.0;
+    }
+
+    void print_profiler_timings(
+        Profiler const* const profiler
+    )
+    {
+        if (profiler == nullptr)
+            return;
+
+        // Zones without detail describe the build phases and are printed as a hierarchy per thread. Zones
+        // with detail, such as one per module, are aggregated by name across all threads.
+        struct Zone_summary
+        {
+            char const* name = nullptr;
+            std::size_t count = 0;
+            std::int64_t total_nanoseconds = 0;
+            std::int64_t maximum_nanoseconds = 0;
+        };
+        std::pmr::vector<Zone_summary> summaries;
+
+        std::cout << "<-- Begin Profiler Timings -->\n";
+        bool const print_thread_names = profiler->thread_buffers.size() > 1;
+        std::size_t const indentation = print_thread_names ? 6 : 4;
+
+        for (std::size_t buffer_index = 0; buffer_index < profiler->thread_buffers.size(); ++buffer_index)
+        {
+            bool is_thread_name_printed = false;
+
+            visit_events(*profiler->thread_buffers[buffer_index], [&](Profile_event const& event) -> void
+            {
+                std::int64_t const duration = event.end_nanoseconds - event.begin_nanoseconds;
+
+                if (event.detail_size == 0)
+                {
+                    if (print_thread_names && !is_thread_name_printed)
+                    {
+                        std::cout << std::format("    Thread {}:\n", buffer_index);
+                        is_thread_name_printed = true;
+                    }
+
+                    std::cout << std::format("{:{}}{}: {:.3f}ms\n", "", indentation + 2 * event.depth, event.name, to_milliseconds(duration));
+                    return;
+                }
+
+                auto location = std::find_if(summaries.begin(), summaries.end(), [&](Zone_summary const& summary) -> bool { return std::strcmp(summary.name, event.name) == 0; });
+                if (location == summaries.end())
+                {
+                    summaries.push_back(Zone_summary{ .name = event.name });
+                    location = summaries.end() - 1;
+                }
+
+                location->count += 1;
+                location->total_nanoseconds += duration;
+                location->maximum_nanoseconds = std::max(location->maximum_nanoseconds, duration);
+            });
+        }
+        for (Zone_summary const& summary : summaries)
+            std::cout << std::format("    {} x{}: total {:.3f}ms, max {:.3f}ms\n", summary.name, summary.count, to_milliseconds(summary.total_nanoseconds), to_milliseconds(summary.maximum_nanoseconds));
+        std::cout << "<-- End Profiler Timings -->\n";
+
+        if (!profiler->counters.empty())
+        {
+            std::cout << "<-- Begin Profiler Counters -->\n";
+            for (auto const& pair : profiler->counters)
+                std::cout << "    " << pair.first << ": " << pair.second << '\n';
+            std::cout << "<-- End Profiler Counters -->\n";
+        }
+        std::cout.flush();
+    }
+
+    void write_chrome_trace(
+        Profiler const& profiler,
+        std::filesystem::path const& output_file_path
+    )
+    {
+        nlohmann::json trace_events = nlohmann::json::array();
+        std::int64_t last_end_nanoseconds = 0;
+
+        for (std::size_t buffer_index = 0; buffer_index < profiler.thread_buffers.size(); ++buffer_index)
+        {
+            visit_events(*profiler.thread_buffers[buffer_index], [&](Profile_event const& event) -> void
+            {
+                // Chrome trace timestamps are in microseconds:
+                nlohmann::json trace_event
+                {
+                    {"name", event.name},
+                    {"cat", "hlang"},
+                    {"ph", "X"},
+                    {"ts", static_cast<double>(event.begin_nanoseconds) / 1000.0},
+                    {"dur", static_cast<double>(event.end_nanoseconds - event.begin_nanoseconds) / 1000.0},
+                    {"pid", 1},
+                    {"tid", buffer_index},
+                };
+
+                if (event.detail_size > 0)
+                    trace_event["args"] = { {"detail", get_detail(event)} };
+
+                trace_events.push_back(std::move(trace_event));
+                last_end_nanoseconds = std::max(last_end_nanoseconds, event.end_nanoseconds);
+            });
+        }
+
+        for (auto const& pair : profiler.counters)
+        {
+            trace_events.push_back(
+                {
+                    {"name", std::string_view{pair.first}},
+                    {"ph", "C"},
+                    {"ts", static_cast<double>(last_end_nanoseconds) / 1000.0},
+                    {"pid", 1},
+                    {"args", { {"value", pair.second} }},
+                }
+            );
+        }
+
+        nlohmann::json const json
+        {
+            {"traceEvents", std::move(trace_events)},
+            {"displayTimeUnit", "ms"},
+        };
+
+        h::common::write_to_file(output_file_path, json.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace));
+    }
+}
@@ -1,9 +1,16 @@
 module;
 
+#include <array>
 #include <chrono>
-#include <iostream>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -11,62 +18,77 @@ export module h.compiler.profiler;
 
 namespace h::compiler
 {
-    using Clock = std::chrono::high_resolution_clock;
+    using Clock = std::chrono::steady_clock;
     using Time_point = Clock::time_point;
-    using Duration = Clock::duration;
 
-    export struct Profiler
+    struct Profile_event
     {
-        std::pmr::vector<std::pair<std::pmr::string, Time_point>> time_points;
-        std::pmr::vector<std::pair<std::pmr::string, Duration>> durations;
+        char const* name = nullptr;
+        std::array<char, 64> detail = {};
+        std::uint8_t detail_size = 0;
+        std::uint32_t depth = 0;
+        std::int64_t begin_nanoseconds = 0;
+        std::int64_t end_nanoseconds = 0;
     };
 
-    export void start_timer(
-        Profiler* const profiler,
-        std::string_view const key
-    )
+    using Profile_event_chunk = std::array<Profile_event, 1024>;
+
+    // Events are only written by the thread that owns the buffer, so recording a zone never takes a lock
+    // unless a new chunk has to be allocated.
+    struct Profile_thread_buffer
     {
-        if (profiler == nullptr)
-            return;
+        std::thread::id thread_id;
+        std::uint32_t depth = 0;
+        std::size_t last_chunk_size = 0;
+        std::pmr::vector<std::unique_ptr<Profile_event_chunk>> chunks;
+    };
 
-        Time_point const time_point = Clock::now();
-        profiler->time_points.push_back(std::make_pair(std::pmr::string{key}, time_point));
-    }
+    std::uint64_t create_profiler_id();
 
-    export void end_timer(
-        Profiler* const profiler,
-        std::string_view const key
-    )
+    export struct Profiler
     {
-        if (profiler == nullptr)
-            return;
+        std::uint64_t id = create_profiler_id();
+        Time_point start_time_point = Clock::now();
+        std::unique_ptr<std::mutex> mutex = std::make_unique<std::mutex>();
+        std::pmr::vector<std::unique_ptr<Profile_thread_buffer>> thread_buffers;
+        std::pmr::vector<std::pair<std::pmr::string, std::uint64_t>> counters;
+    };
 
-        Time_point const end_time_point = Clock::now();
+    // Measures the lifetime of the zone. Zones opened on the same thread nest into a hierarchy.
+    // The name must outlive the profiler, which in practice means it must be a string literal.
+    export class Profile_zone
+    {
+    public:
+
+        Profile_zone(
+            Profiler* profiler,
+            char const* name,
+            std::string_view detail = {}
+        );
+        ~Profile_zone();
 
-        auto const time_point_location = std::find_if(profiler->time_points.begin(), profiler->time_points.end(), [&](auto const& pair) -> bool { return pair.first == key; });
-        if (time_point_location == profiler->time_points.end())
-            return;
+        Profile_zone(Profile_zone const&) = delete;
+        Profile_zone& operator=(Profile_zone const&) = delete;
 
-        Time_point const start_time_point = time_point_location->second;
-        Duration const duration = end_time_point - start_time_point;
+    private:
+        Profiler* m_profiler = nullptr;
+        Profile_thread_buffer* m_buffer = nullptr;
+        Profile_event* m_event = nullptr;
+    };
 
-        profiler->durations.push_back(std::make_pair(std::pmr::string{key}, duration));
-    }
+    export void add_to_counter(
+        Profiler* profiler,
+        std::string_view key,
+        std::uint64_t value
+    );
 
+    // The functions below read every thread buffer, so they must only be called once all profiled threads are done.
     export void print_profiler_timings(
-        Profiler const* const profiler
-    )
-    {
-        if (profiler == nullptr)
-            return;
+        Profiler const* profiler
+    );
 
-        std::cout << "<-- Begin Profiler Timings -->\n";
-        for (auto const& pair : profiler->durations)
-        {
-            std::chrono::milliseconds const milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(pair.second);
-            std::cout << "    " << pair.first << ": " << milliseconds << '\n';
-        }
-        std::cout << "<-- End Profiler Timings -->\n";
-        std::cout.flush();
-    }
+    export void write_chrome_trace(
+        Profiler const& profiler,
+        std::filesystem::path const& output_file_path
+    );
 }
@@ -334,6 +334,19 @@ namespace h::compiler
         }
     }
 
+    std::optional<Optimization_level> parse_artifact_optimization_level(nlohmann::json const& json)
+    {
+        if (!json.contains("optimization_level"))
+            return std::nullopt;
+
+        std::string const value = json.at("optimization_level").get<std::string>();
+        std::optional<Optimization_level> const optimization_level = parse_optimization_level(value);
+        if (!optimization_level.has_value())
+            h::common::print_message_and_exit(std::format("Failed to parse optimization level '{}'. Expected one of O0, O1, O2, O3, Os or Oz.", value));
+
+        return optimization_level;
+    }
+
     Artifact get_artifact(std::filesystem::path const& artifact_file_path)
     {
         std::optional<std::pmr::string> const json_data = h::common::get_file_contents(artifact_file_path.c_str());
@@ -356,6 +369,8 @@ namespace h::compiler
 
         std::optional<std::variant<Executable_info, Library_info>> info = parse_info(json);
 
+        std::optional<Optimization_level> const optimization_level = parse_artifact_optimization_level(json);
+
         return Artifact
         {
             .file_path = artifact_file_path,
@@ -366,6 +381,7 @@ namespace h::compiler
             .sources = std::move(source_groups),
             .public_include_directories = std::move(public_include_directories),
             .info = std::move(info),
+            .optimization_level = optimization_level,
         };
     }
 
@@ -535,6 +551,9 @@ namespace h::compiler
             }
         }
 
+        if (artifact.optimization_level.has_value())
+            json["optimization_level"] = to_string(artifact.optimization_level.value());
+
         std::string const json_string = json.dump(4);
         h::common::write_to_file(artifact_file_path, json_string);
     }
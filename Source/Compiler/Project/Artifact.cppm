@@ -100,6 +100,7 @@ namespace h::compiler
         std::pmr::vector<Source_group> sources;
         std::pmr::vector<std::filesystem::path> public_include_directories;
         std::optional<std::variant<Executable_info, Library_info>> info;
+        std::optional<Optimization_level> optimization_level; // Overrides the level of the build for this artifact
     };
 
     export Artifact get_artifact(std::filesystem::path const& artifact_file_path);
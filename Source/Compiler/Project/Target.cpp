@@ -0,0 +1,52 @@
+module;
+
+#include <optional>
+#include <string_view>
+
+module h.compiler.target;
+
+namespace h::compiler
+{
+    std::optional<Optimization_level> parse_optimization_level(
+        std::string_view const value
+    )
+    {
+        if (value == "O0" || value == "0")
+            return Optimization_level::O0;
+        else if (value == "O1" || value == "1")
+            return Optimization_level::O1;
+        else if (value == "O2" || value == "2")
+            return Optimization_level::O2;
+        else if (value == "O3" || value == "3")
+            return Optimization_level::O3;
+        else if (value == "Os" || value == "s")
+            return Optimization_level::Os;
+        else if (value == "Oz" || value == "z")
+            return Optimization_level::Oz;
+
+        return std::nullopt;
+    }
+
+    std::string_view to_string(
+        Optimization_level const optimization_level
+    )
+    {
+        switch (optimization_level)
+        {
+        case Optimization_level::O0:
+            return "O0";
+        case Optimization_level::O1:
+            return "O1";
+        case Optimization_level::O2:
+            return "O2";
+        case Optimization_level::O3:
+            return "O3";
+        case Optimization_level::Os:
+            return "Os";
+        case Optimization_level::Oz:
+            return "Oz";
+        }
+
+        return "O0";
+    }
+}
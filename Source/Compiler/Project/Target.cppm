@@ -1,7 +1,10 @@
 module;
 
+#include <filesystem>
 #include <memory_resource>
+#include <optional>
 #include <string>
+#include <string_view>
 
 export module h.compiler.target;
 
@@ -13,4 +16,44 @@ namespace h::compiler
     };
 
     export Target get_default_target();
+
+    // Os and Oz optimize like O2 but favor smaller code.
+    export enum class Optimization_level
+    {
+        O0,
+        O1,
+        O2,
+        O3,
+        Os,
+        Oz
+    };
+
+    export enum class Lto_mode
+    {
+        None,
+        Thin
+    };
+
+    export enum class Pgo_mode
+    {
+        None,
+        Instrument,
+        Use
+    };
+
+    // With Instrument, profile_path is the directory where instrumented programs write their raw profiles.
+    // With Use, it is the profile merged from them with llvm-profdata.
+    export struct Pgo_options
+    {
+        Pgo_mode mode = Pgo_mode::None;
+        std::optional<std::filesystem::path> profile_path;
+    };
+
+    export std::optional<Optimization_level> parse_optimization_level(
+        std::string_view value
+    );
+
+    export std::string_view to_string(
+        Optimization_level optimization_level
+    );
 }
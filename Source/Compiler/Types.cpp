@@ -1,6 +1,9 @@
 module;
 
+#include <clang/AST/ASTContext.h>
+#include <clang/AST/Attr.h>
 #include <clang/AST/Decl.h>
+#include <clang/AST/RecordLayout.h>
 #include <llvm/IR/DataLayout.h>
 #include <llvm/IR/DebugInfoMetadata.h>
 #include <llvm/IR/DerivedTypes.h>
@@ -9,6 +12,7 @@ module;
 #include <llvm/IR/Type.h>
 #include <llvm/IR/Value.h>
 
+#include <algorithm>
 #include <array>
 #include <filesystem>
 #include <functional>
@@ -369,10 +373,23 @@ namespace h::compiler
         }
     }
 
+    static void add_type_alignment_if_over_aligned(
+        llvm::DataLayout const& llvm_data_layout,
+        Type_database& type_database,
+        llvm::Type* const llvm_type,
+        std::uint64_t const alignment
+    )
+    {
+        if (alignment > llvm_data_layout.getABITypeAlign(llvm_type).value())
+            type_database.llvm_type_alignments.insert_or_assign(llvm_type, llvm::Align{alignment});
+    }
+
     void add_struct_declarations(
+        llvm::DataLayout const& llvm_data_layout,
         Clang_module_data const& clang_module_data,
         Module const& core_module,
         std::span<Struct_declaration const> const struct_declarations,
+        Type_database& type_database,
         LLVM_type_map& llvm_type_map
     )
     {
@@ -385,6 +402,10 @@ namespace h::compiler
             );
 
             llvm_type_map.insert(std::make_pair(struct_declaration.name, converted_type));
+
+            std::optional<std::uint64_t> const alignment = get_struct_alignment(clang_module_data, core_module.name, struct_declaration.name);
+            if (alignment.has_value())
+                add_type_alignment_if_over_aligned(llvm_data_layout, type_database, converted_type, alignment.value());
         }
     }
 
@@ -668,6 +689,7 @@ namespace h::compiler
             .builtin = create_builtin_types(llvm_context),
             .name_to_llvm_type = {},
             .type_instance_to_llvm_type = {},
+            .llvm_type_alignments = {},
         };
     }
 
@@ -697,8 +719,8 @@ namespace h::compiler
         add_enum_types(llvm_context, core_module.export_declarations.enum_declarations, llvm_type_map);
         add_enum_types(llvm_context, core_module.internal_declarations.enum_declarations, llvm_type_map);
 
-        add_struct_declarations(clang_module_data, core_module, core_module.export_declarations.struct_declarations, llvm_type_map);
-        add_struct_declarations(clang_module_data, core_module, core_module.internal_declarations.struct_declarations, llvm_type_map);
+        add_struct_declarations(llvm_data_layout, clang_module_data, core_module, core_module.export_declarations.struct_declarations, type_database, llvm_type_map);
+        add_struct_declarations(llvm_data_layout, clang_module_data, core_module, core_module.internal_declarations.struct_declarations, type_database, llvm_type_map);
 
         add_union_declarations(clang_module_data, core_module, core_module.export_declarations.union_declarations, llvm_type_map);
         add_union_declarations(clang_module_data, core_module, core_module.internal_declarations.union_declarations, llvm_type_map);
@@ -711,6 +733,8 @@ namespace h::compiler
             clang::RecordDecl* const record_declaration = pair.second;
             llvm::Type* const clang_type = convert_type(clang_module_data, record_declaration);
             type_database.type_instance_to_llvm_type.emplace(pair.first, clang_type);
+            if (record_declaration->isCompleteDefinition())
+                add_type_alignment_if_over_aligned(llvm_data_layout, type_database, clang_type, get_record_alignment(clang_module_data, record_declaration));
             
             std::pmr::string const mangled_name = mangle_type_instance_name(pair.first);
             type_database.name_to_llvm_type[pair.first.type_constructor.module_reference.name].insert(std::make_pair(mangled_name, clang_type));
@@ -847,6 +871,34 @@ namespace h::compiler
         return array_type;
     }
 
+    llvm::DIType* vector_type_to_llvm_debug_type(
+        llvm::DIBuilder& llvm_debug_builder,
+        llvm::DIScope& llvm_debug_scope,
+        llvm::DataLayout const& llvm_data_layout,
+        h::Module const& core_module,
+        Vector_type const& type,
+        Debug_type_database const& debug_type_database
+    )
+    {
+        llvm::DIType* const element_type = 
+            !type.element_type.empty() ?
+            type_reference_to_llvm_debug_type(llvm_debug_builder, llvm_debug_scope, llvm_data_layout, core_module, type.element_type[0], debug_type_database) :
+            llvm_debug_builder.createUnspecifiedParameter();
+
+        std::uint64_t const element_size_in_bits = element_type != nullptr ? element_type->getSizeInBits() : 0;
+
+        llvm::Metadata* const subscripts[] = { llvm_debug_builder.getOrCreateSubrange(0, static_cast<std::int64_t>(type.size)) };
+
+        llvm::DICompositeType* const vector_type = llvm_debug_builder.createVectorType(
+            element_size_in_bits * type.size,
+            0,
+            element_type,
+            llvm_debug_builder.getOrCreateArray(subscripts)
+        );
+
+        return vector_type;
+    }
+
     llvm::Type* fundamental_type_to_llvm_type(
         llvm::LLVMContext& llvm_context,
         llvm::DataLayout const& llvm_data_layout,
@@ -1107,6 +1159,13 @@ namespace h::compiler
             llvm::Type* const llvm_type = type_database.type_instance_to_llvm_type.at(data);
             return llvm_type;
         }
+        else if (std::holds_alternative<Vector_type>(type_reference.data))
+        {
+            Vector_type const& data = std::get<Vector_type>(type_reference.data);
+            llvm::Type* const llvm_element_type = type_reference_to_llvm_type(llvm_context, llvm_data_layout, data.element_type, type_database);
+            llvm::FixedVectorType* const llvm_vector_type = llvm::FixedVectorType::get(llvm_element_type, static_cast<unsigned>(data.size));
+            return llvm_vector_type;
+        }
 
         throw std::runtime_error{ "Not implemented." };
     }
@@ -1202,6 +1261,11 @@ namespace h::compiler
             Pointer_type const& data = std::get<Pointer_type>(type_reference.data);
             return pointer_type_to_llvm_debug_type(llvm_debug_builder, llvm_debug_scope, llvm_data_layout, core_module, data, debug_type_database);
         }
+        else if (std::holds_alternative<Vector_type>(type_reference.data))
+        {
+            Vector_type const& data = std::get<Vector_type>(type_reference.data);
+            return vector_type_to_llvm_debug_type(llvm_debug_builder, llvm_debug_scope, llvm_data_layout, core_module, data, debug_type_database);
+        }
 
         throw std::runtime_error{ "Not implemented." };
     }
@@ -1244,48 +1308,60 @@ namespace h::compiler
         return output;
     }
 
-    Struct_layout calculate_struct_layout(
+    llvm::Align get_type_alignment(
         llvm::DataLayout const& llvm_data_layout,
         Type_database const& type_database,
+        llvm::Type* const llvm_type
+    )
+    {
+        auto const location = type_database.llvm_type_alignments.find(llvm_type);
+        if (location != type_database.llvm_type_alignments.end())
+            return location->second;
+
+        return llvm_data_layout.getABITypeAlign(llvm_type);
+    }
+
+    Struct_layout calculate_struct_layout(
+        Clang_module_data const& clang_module_data,
         std::string_view const module_name,
         std::string_view const struct_name
     )
     {
-        LLVM_type_map const& llvm_type_map = type_database.name_to_llvm_type.at(module_name.data());
-        auto const llvm_type_location = llvm_type_map.find(struct_name.data());
-        if (llvm_type_location == llvm_type_map.end())
-            h::common::print_message_and_exit(std::format("Could not calculate struct layout of '{}.{}'. Could not find it!", module_name, struct_name));
+        auto const module_location = clang_module_data.declaration_database.map.find(module_name);
+        if (module_location == clang_module_data.declaration_database.map.end())
+            h::common::print_message_and_exit(std::format("Could not calculate struct layout of '{}.{}'. Could not find module!", module_name, struct_name));
 
-        llvm::Type* const llvm_type = llvm_type_location->second;
-        if (llvm_type == nullptr)
-            h::common::print_message_and_exit(std::format("Could not calculate struct layout of '{}.{}'. llvm::Type is null!", module_name, struct_name));
-
-        if (!llvm::StructType::classof(llvm_type))
-            h::common::print_message_and_exit(std::format("Could not calculate struct layout of '{}.{}'. llvm::Type is not llvm::StructType!", module_name, struct_name));
+        Clang_module_declarations const& clang_declarations = module_location->second;
+        auto const struct_location = clang_declarations.struct_declarations.find(struct_name);
+        if (struct_location == clang_declarations.struct_declarations.end())
+            h::common::print_message_and_exit(std::format("Could not calculate struct layout of '{}.{}'. Could not find it!", module_name, struct_name));
 
+        clang::RecordDecl const* const record_declaration = struct_location->second->getDefinition();
+        if (record_declaration == nullptr)
+            h::common::print_message_and_exit(std::format("Could not calculate struct layout of '{}.{}'. Struct is not defined!", module_name, struct_name));
 
-        llvm::StructType* const llvm_struct_type = static_cast<llvm::StructType*>(llvm_type);
-        llvm::StructLayout const* const llvm_struct_layout = llvm_data_layout.getStructLayout(llvm_struct_type);
+        clang::ASTContext& clang_ast_context = clang_module_data.ast_context;
+        clang::ASTRecordLayout const& clang_record_layout = clang_ast_context.getASTRecordLayout(record_declaration);
 
-        std::uint64_t const struct_size = llvm_struct_layout->getSizeInBytes();
-        std::uint64_t const struct_alignment = llvm_struct_layout->getAlignment().value();
+        std::uint64_t const struct_size = clang_record_layout.getSize().getQuantity();
+        std::uint64_t const struct_alignment = clang_record_layout.getAlignment().getQuantity();
 
         std::pmr::vector<Struct_member_layout> members;
-        members.reserve(llvm_struct_type->getNumElements());
 
-        for (unsigned index = 0; index < llvm_struct_type->getNumElements(); ++index)
+        for (clang::FieldDecl const* const field_declaration : record_declaration->fields())
         {
-            std::uint64_t const member_offset = llvm_struct_layout->getElementOffset(index);
+            std::uint64_t const member_offset = clang_record_layout.getFieldOffset(field_declaration->getFieldIndex()) / 8;
 
-            llvm::Type* const member_type = llvm_struct_type->getElementType(index);
-            std::uint64_t const member_size = llvm_data_layout.getTypeStoreSize(member_type);
-            std::uint64_t const member_alignment = llvm_data_layout.getABITypeAlign(member_type).value();
+            clang::QualType const member_type = field_declaration->getType();
+            std::uint64_t const member_size = clang_ast_context.getTypeSizeInChars(member_type).getQuantity();
+            std::uint64_t const member_type_alignment = record_declaration->hasAttr<clang::PackedAttr>() ? 1 : clang_ast_context.getTypeAlignInChars(member_type).getQuantity();
+            std::uint64_t const member_declared_alignment = field_declaration->getMaxAlignment() / 8;
 
             members.push_back(
                 {
                     .offset = member_offset,
                     .size = member_size,
-                    .alignment = member_alignment
+                    .alignment = std::max(member_type_alignment, member_declared_alignment)
                 }
             );
         }
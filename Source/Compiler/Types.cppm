@@ -46,6 +46,7 @@ namespace h::compiler
         Builtin_types builtin;
         std::pmr::unordered_map<Module_name, LLVM_type_map> name_to_llvm_type;
         std::pmr::unordered_map<Type_instance, llvm::Type*, Type_instance_hash> type_instance_to_llvm_type;
+        std::pmr::unordered_map<llvm::Type*, llvm::Align> llvm_type_alignments;
     };
 
     export struct Debug_type_database
@@ -99,6 +100,12 @@ namespace h::compiler
         Type_database const& type_database
     );
 
+    export llvm::Align get_type_alignment(
+        llvm::DataLayout const& llvm_data_layout,
+        Type_database const& type_database,
+        llvm::Type* const llvm_type
+    );
+
     export std::pmr::vector<llvm::Type*> type_references_to_llvm_types(
         llvm::LLVMContext& llvm_context,
         llvm::DataLayout const& llvm_data_layout,
@@ -136,8 +143,7 @@ namespace h::compiler
     );
 
     export Struct_layout calculate_struct_layout(
-        llvm::DataLayout const& llvm_data_layout,
-        Type_database const& type_database,
+        Clang_module_data const& clang_module_data,
         std::string_view const module_name,
         std::string_view const struct_name
     );
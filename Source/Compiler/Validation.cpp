@@ -1,7 +1,10 @@
 module;
 
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <cstddef>
+#include <cstdlib>
 #include <filesystem>
 #include <format>
 #include <memory_resource>
@@ -181,6 +184,52 @@ namespace h::compiler
         return first == second;
     }
 
+    // A scalar operand of a binary operation is broadcast to all lanes of the other vector operand.
+    bool is_vector_and_element_type(
+        Declaration_database const& declaration_database,
+        std::optional<h::Type_reference> const& first,
+        std::optional<h::Type_reference> const& second
+    )
+    {
+        if (!first.has_value() || !second.has_value())
+            return false;
+
+        std::optional<h::Type_reference> const first_underlying_type = get_underlying_type(declaration_database, first.value());
+        std::optional<h::Type_reference> const second_underlying_type = get_underlying_type(declaration_database, second.value());
+        if (!first_underlying_type.has_value() || !second_underlying_type.has_value())
+            return false;
+
+        if (is_vector_type_reference(first_underlying_type.value()) == is_vector_type_reference(second_underlying_type.value()))
+            return false;
+
+        h::Type_reference const& vector_type = is_vector_type_reference(first_underlying_type.value()) ? first_underlying_type.value() : second_underlying_type.value();
+        h::Type_reference const& scalar_type = is_vector_type_reference(first_underlying_type.value()) ? second_underlying_type.value() : first_underlying_type.value();
+
+        std::optional<h::Type_reference> const element_type = get_element_or_pointee_type(vector_type);
+        return are_compatible_types(declaration_database, element_type, scalar_type);
+    }
+
+    std::optional<std::uint32_t> get_integer_or_integer_vector_number_of_bits(
+        Declaration_database const& declaration_database,
+        std::optional<h::Type_reference> const& type
+    )
+    {
+        if (!type.has_value())
+            return std::nullopt;
+
+        std::optional<h::Type_reference> const underlying_type = get_underlying_type(declaration_database, type.value());
+        if (!underlying_type.has_value())
+            return std::nullopt;
+
+        if (is_vector_type_reference(underlying_type.value()))
+            return get_integer_or_integer_vector_number_of_bits(declaration_database, get_element_or_pointee_type(underlying_type.value()));
+
+        if (!std::holds_alternative<h::Integer_type>(underlying_type->data))
+            return std::nullopt;
+
+        return std::get<h::Integer_type>(underlying_type->data).number_of_bits;
+    }
+
     bool can_assign_type(
         Declaration_database const& declaration_database,
         std::optional<h::Type_reference> const& destination,
@@ -446,6 +495,15 @@ namespace h::compiler
                 temporaries_allocator
             );
         }
+        else if (std::holds_alternative<h::Vector_type>(type.data))
+        {
+            return validate_vector_type(
+                core_module,
+                type,
+                declaration_database,
+                temporaries_allocator
+            );
+        }
 
         return {};
     }
@@ -505,6 +563,44 @@ namespace h::compiler
         return {};
     }
 
+    std::pmr::vector<h::compiler::Diagnostic> validate_vector_type(
+        h::Module const& core_module,
+        h::Type_reference const& type,
+        Declaration_database const& declaration_database,
+        std::pmr::polymorphic_allocator<> const& temporaries_allocator
+    )
+    {
+        h::Vector_type const& vector_type = std::get<h::Vector_type>(type.data);
+
+        std::pmr::string const type_name = h::format_type_reference(core_module, type, temporaries_allocator, temporaries_allocator);
+
+        if (vector_type.size == 0)
+        {
+            return
+            {
+                create_error_diagnostic(
+                    core_module.source_file_path,
+                    type.source_range,
+                    std::format("Vector type '{}' must have at least one lane.", type_name)
+                )
+            };
+        }
+
+        if (vector_type.element_type.empty() || !(is_bool(vector_type.element_type[0]) || is_integer(vector_type.element_type[0]) || is_floating_point(vector_type.element_type[0])))
+        {
+            return
+            {
+                create_error_diagnostic(
+                    core_module.source_file_path,
+                    type.source_range,
+                    std::format("Vector type '{}' must have a boolean, integer or floating point element type.", type_name)
+                )
+            };
+        }
+
+        return {};
+    }
+
     std::pmr::vector<h::compiler::Diagnostic> validate_declarations(
         h::Module const& core_module,
         Declaration_database const& declaration_database,
@@ -906,6 +1002,17 @@ namespace h::compiler
     {
         std::pmr::vector<h::compiler::Diagnostic> diagnostics{temporaries_allocator};
 
+        if (declaration.alignment.has_value() && !std::has_single_bit(declaration.alignment.value()))
+        {
+            diagnostics.push_back(
+                create_error_diagnostic(
+                    core_module.source_file_path,
+                    create_source_range_from_source_location(declaration.source_location, declaration.name.size()),
+                    std::format("Alignment of struct '{}' must be a power of two, but {} was provided.", declaration.name, declaration.alignment.value())
+                )
+            );
+        }
+
         std::pmr::unordered_set<std::string_view> all_names{temporaries_allocator};
 
         for (std::size_t member_index = 0; member_index < declaration.member_names.size(); ++member_index)
@@ -932,6 +1039,22 @@ namespace h::compiler
                 all_names.insert(member_name);
             }
 
+            std::optional<std::uint32_t> const member_alignment =
+                member_index < declaration.member_alignments.size() ?
+                declaration.member_alignments[member_index] :
+                std::optional<std::uint32_t>{std::nullopt};
+
+            if (member_alignment.has_value() && !std::has_single_bit(member_alignment.value()))
+            {
+                diagnostics.push_back(
+                    create_error_diagnostic(
+                        core_module.source_file_path,
+                        create_source_range_from_source_position(member_source_position, member_name.size()),
+                        std::format("Alignment of struct member '{}.{}' must be a power of two, but {} was provided.", declaration.name, member_name, member_alignment.value())
+                    )
+                );
+            }
+
             h::Type_reference const& member_type = declaration.member_types[member_index];
             h::Statement const& member_default_value = declaration.member_default_values[member_index];
 
@@ -1119,6 +1242,82 @@ namespace h::compiler
         return validate_function_return_expressions_with_statements(core_module, declaration.name, definition.statements, source_range);
     }
 
+    static std::pmr::vector<h::compiler::Diagnostic> validate_function_attributes(
+        h::Module const& core_module,
+        h::Function_declaration const& declaration,
+        Declaration_database const& declaration_database,
+        std::pmr::polymorphic_allocator<> const& temporaries_allocator
+    )
+    {
+        std::pmr::vector<h::compiler::Diagnostic> diagnostics{temporaries_allocator};
+
+        std::optional<h::Source_range> const source_range = create_source_range_from_source_location(declaration.source_location, declaration.name.size());
+
+        auto const has_attribute = [&](h::Function_attribute const attribute) -> bool
+        {
+            return std::find(declaration.attributes.begin(), declaration.attributes.end(), attribute) != declaration.attributes.end();
+        };
+
+        auto const add_conflict_diagnostic = [&](h::Function_attribute const first, h::Function_attribute const second, std::string_view const first_name, std::string_view const second_name) -> void
+        {
+            if (has_attribute(first) && has_attribute(second))
+            {
+                diagnostics.push_back(
+                    create_error_diagnostic(
+                        core_module.source_file_path,
+                        source_range,
+                        std::format("Function '{}' cannot be both '{}' and '{}'.", declaration.name, first_name, second_name)
+                    )
+                );
+            }
+        };
+
+        add_conflict_diagnostic(h::Function_attribute::Always_inline, h::Function_attribute::No_inline, "@always_inline", "@no_inline");
+        add_conflict_diagnostic(h::Function_attribute::Hot, h::Function_attribute::Cold, "@hot", "@cold");
+        add_conflict_diagnostic(h::Function_attribute::Const, h::Function_attribute::Pure, "@const", "@pure");
+
+        for (h::Named_parameter_attribute const& parameter_attribute : declaration.parameter_attributes)
+        {
+            auto const location = std::find(declaration.input_parameter_names.begin(), declaration.input_parameter_names.end(), parameter_attribute.parameter_name);
+            if (location == declaration.input_parameter_names.end())
+            {
+                diagnostics.push_back(
+                    create_error_diagnostic(
+                        core_module.source_file_path,
+                        source_range,
+                        std::format("Function '{}' does not have an input parameter named '{}'.", declaration.name, parameter_attribute.parameter_name)
+                    )
+                );
+                continue;
+            }
+
+            std::size_t const parameter_index = std::distance(declaration.input_parameter_names.begin(), location);
+            h::Type_reference const& parameter_type = declaration.type.input_parameter_types[parameter_index];
+
+            std::optional<h::Type_reference> const underlying_parameter_type = get_underlying_type(declaration_database, parameter_type);
+
+            if (parameter_attribute.attribute == h::Parameter_attribute::No_alias && (!underlying_parameter_type.has_value() || !is_pointer(underlying_parameter_type.value())))
+            {
+                std::optional<Source_position> const parameter_source_position =
+                    declaration.input_parameter_source_positions.has_value() ?
+                    declaration.input_parameter_source_positions.value()[parameter_index] :
+                    std::optional<Source_position>{std::nullopt};
+
+                std::pmr::string const parameter_type_name = h::format_type_reference(core_module, parameter_type, temporaries_allocator, temporaries_allocator);
+
+                diagnostics.push_back(
+                    create_error_diagnostic(
+                        core_module.source_file_path,
+                        create_source_range_from_source_position(parameter_source_position, parameter_attribute.parameter_name.size()),
+                        std::format("Parameter '{}' of type '{}' cannot be '@no_alias' because it is not a pointer.", parameter_attribute.parameter_name, parameter_type_name)
+                    )
+                );
+            }
+        }
+
+        return diagnostics;
+    }
+
     std::pmr::vector<h::compiler::Diagnostic> validate_function(
         h::Module const& core_module,
         h::Function_declaration const& declaration,
@@ -1131,6 +1330,17 @@ namespace h::compiler
 
         // TODO validate parameters
 
+        {
+            std::pmr::vector<h::compiler::Diagnostic> attribute_diagnostics = validate_function_attributes(
+                core_module,
+                declaration,
+                declaration_database,
+                temporaries_allocator
+            );
+            if (!attribute_diagnostics.empty())
+                diagnostics.insert(diagnostics.end(), attribute_diagnostics.begin(), attribute_diagnostics.end());
+        }
+
         {
             Scope scope
             {
@@ -1751,8 +1961,12 @@ namespace h::compiler
         std::optional<h::Type_reference> const type_optional = get_underlying_type(parameters.declaration_database, left_hand_side_type_optional.value());
         if (!type_optional.has_value())
             return {};
+
+        std::optional<h::Type_reference> const vector_element_type = is_vector_type_reference(type_optional.value()) ? get_element_or_pointee_type(type_optional.value()) : std::nullopt;
+        if (is_vector_type_reference(type_optional.value()) && !vector_element_type.has_value())
+            return {};
         
-        h::Type_reference const& type = type_optional.value();
+        h::Type_reference const& type = vector_element_type.has_value() ? vector_element_type.value() : type_optional.value();
 
         if (is_bit_shift_binary_operation(operation))
         {
@@ -1964,7 +2178,7 @@ namespace h::compiler
         std::optional<h::Type_reference> const& left_hand_side_type_optional = get_expression_type_from_type_info(parameters.expression_types, expression.left_hand_side);
         std::optional<h::Type_reference> const& right_hand_side_type_optional = get_expression_type_from_type_info(parameters.expression_types, expression.right_hand_side);
         
-        if (!are_compatible_types(parameters.declaration_database, left_hand_side_type_optional, right_hand_side_type_optional))
+        if (!are_compatible_types(parameters.declaration_database, left_hand_side_type_optional, right_hand_side_type_optional) && !is_vector_and_element_type(parameters.declaration_database, left_hand_side_type_optional, right_hand_side_type_optional))
         {
             std::pmr::string const left_hand_side_type_name = h::format_type_reference(parameters.core_module, left_hand_side_type_optional, parameters.temporaries_allocator, parameters.temporaries_allocator);
             std::pmr::string const right_hand_side_type_name = h::format_type_reference(parameters.core_module, right_hand_side_type_optional, parameters.temporaries_allocator, parameters.temporaries_allocator);
@@ -2073,6 +2287,10 @@ namespace h::compiler
                 {
                     return std::pair<std::string_view, h::Instance_call_expression>{"reinterpret_as", instance_call_expression};
                 }
+                else if (variable_expression.name == "vector_load")
+                {
+                    return std::pair<std::string_view, h::Instance_call_expression>{"vector_load", instance_call_expression};
+                }
             }
         }
 
@@ -2221,6 +2439,248 @@ namespace h::compiler
                     .output_parameter_names = {"result"}
                 };
             }
+            else if (builtin_type_reference.value == "vector_shuffle")
+            {
+                h::Type_reference vector_type;
+                std::uint64_t mask_size = 0;
+
+                if (expression.arguments.size() > 0)
+                {
+                    std::optional<Type_info> first_argument_type_info = get_expression_type_info(parameters.core_module, nullptr, parameters.scope, parameters.statement, parameters.statement.expressions[expression.arguments[0].expression_index], std::nullopt, parameters.declaration_database);
+                    if (first_argument_type_info.has_value() && is_vector_type_reference(first_argument_type_info->type))
+                        vector_type = std::move(first_argument_type_info->type);
+                }
+
+                if (expression.arguments.size() > 2)
+                {
+                    h::Expression const& mask_expression = parameters.statement.expressions[expression.arguments[2].expression_index];
+                    if (std::holds_alternative<h::Constant_array_expression>(mask_expression.data))
+                        mask_size = std::get<h::Constant_array_expression>(mask_expression.data).array_data.size();
+                }
+
+                std::optional<h::Type_reference> const element_type = get_element_or_pointee_type(vector_type);
+                std::pmr::vector<h::Type_reference> const output_element_type = element_type.has_value() ? std::pmr::vector<h::Type_reference>{element_type.value()} : std::pmr::vector<h::Type_reference>{};
+
+                h::Function_type function_type
+                {
+                    .input_parameter_types = {
+                        vector_type,
+                        vector_type,
+                        create_constant_array_type_reference({create_integer_type_type_reference(32, true)}, mask_size)
+                    },
+                    .output_parameter_types = {
+                        create_vector_type_reference(output_element_type, mask_size)
+                    },
+                    .is_variadic = false,
+                };
+
+                return h::Function_pointer_type
+                {
+                    .type = std::move(function_type),
+                    .input_parameter_names = {"first", "second", "mask"},
+                    .output_parameter_names = {"result"}
+                };
+            }
+            else if (builtin_type_reference.value == "vector_store")
+            {
+                h::Type_reference vector_type;
+
+                if (expression.arguments.size() > 2)
+                {
+                    std::optional<Type_info> third_argument_type_info = get_expression_type_info(parameters.core_module, nullptr, parameters.scope, parameters.statement, parameters.statement.expressions[expression.arguments[2].expression_index], std::nullopt, parameters.declaration_database);
+                    if (third_argument_type_info.has_value() && is_vector_type_reference(third_argument_type_info->type))
+                        vector_type = std::move(third_argument_type_info->type);
+                }
+
+                std::optional<h::Type_reference> const element_type = get_element_or_pointee_type(vector_type);
+                std::pmr::vector<h::Type_reference> const slice_element_type = element_type.has_value() ? std::pmr::vector<h::Type_reference>{element_type.value()} : std::pmr::vector<h::Type_reference>{};
+
+                h::Function_type function_type
+                {
+                    .input_parameter_types = {
+                        create_array_slice_type_reference(slice_element_type, true),
+                        create_integer_type_type_reference(64, false),
+                        vector_type
+                    },
+                    .output_parameter_types = {},
+                    .is_variadic = false,
+                };
+
+                return h::Function_pointer_type
+                {
+                    .type = std::move(function_type),
+                    .input_parameter_names = {"values", "index", "value"},
+                    .output_parameter_names = {}
+                };
+            }
+            else if (builtin_type_reference.value == "assume")
+            {
+                h::Function_type function_type
+                {
+                    .input_parameter_types = {
+                        create_bool_type_reference()
+                    },
+                    .output_parameter_types = {},
+                    .is_variadic = false,
+                };
+
+                return h::Function_pointer_type
+                {
+                    .type = std::move(function_type),
+                    .input_parameter_names = {"condition"},
+                    .output_parameter_names = {}
+                };
+            }
+            else if (builtin_type_reference.value == "likely" || builtin_type_reference.value == "unlikely")
+            {
+                h::Function_type function_type
+                {
+                    .input_parameter_types = {
+                        create_bool_type_reference()
+                    },
+                    .output_parameter_types = {
+                        create_bool_type_reference()
+                    },
+                    .is_variadic = false,
+                };
+
+                return h::Function_pointer_type
+                {
+                    .type = std::move(function_type),
+                    .input_parameter_names = {"condition"},
+                    .output_parameter_names = {"result"}
+                };
+            }
+            else if (builtin_type_reference.value == "unreachable")
+            {
+                h::Function_type function_type
+                {
+                    .input_parameter_types = {},
+                    .output_parameter_types = {},
+                    .is_variadic = false,
+                };
+
+                return h::Function_pointer_type
+                {
+                    .type = std::move(function_type),
+                    .input_parameter_names = {},
+                    .output_parameter_names = {}
+                };
+            }
+            else if (builtin_type_reference.value == "expect")
+            {
+                h::Type_reference value_type;
+
+                if (expression.arguments.size() > 0)
+                {
+                    std::optional<Type_info> first_argument_type_info = get_expression_type_info(parameters.core_module, nullptr, parameters.scope, parameters.statement, parameters.statement.expressions[expression.arguments[0].expression_index], std::nullopt, parameters.declaration_database);
+                    if (first_argument_type_info.has_value())
+                        value_type = std::move(first_argument_type_info->type);
+                }
+
+                h::Function_type function_type
+                {
+                    .input_parameter_types = {
+                        value_type,
+                        value_type
+                    },
+                    .output_parameter_types = {
+                        value_type
+                    },
+                    .is_variadic = false,
+                };
+
+                return h::Function_pointer_type
+                {
+                    .type = std::move(function_type),
+                    .input_parameter_names = {"value", "expected_value"},
+                    .output_parameter_names = {"result"}
+                };
+            }
+            else if (
+                builtin_type_reference.value == "byte_swap" ||
+                builtin_type_reference.value == "count_leading_zeros" ||
+                builtin_type_reference.value == "population_count"
+            )
+            {
+                h::Type_reference value_type;
+
+                if (expression.arguments.size() > 0)
+                {
+                    std::optional<Type_info> first_argument_type_info = get_expression_type_info(parameters.core_module, nullptr, parameters.scope, parameters.statement, parameters.statement.expressions[expression.arguments[0].expression_index], std::nullopt, parameters.declaration_database);
+                    if (first_argument_type_info.has_value())
+                        value_type = std::move(first_argument_type_info->type);
+                }
+
+                h::Function_type function_type
+                {
+                    .input_parameter_types = {
+                        value_type
+                    },
+                    .output_parameter_types = {
+                        value_type
+                    },
+                    .is_variadic = false,
+                };
+
+                return h::Function_pointer_type
+                {
+                    .type = std::move(function_type),
+                    .input_parameter_names = {"value"},
+                    .output_parameter_names = {"result"}
+                };
+            }
+            else if (builtin_type_reference.value == "assume_aligned" || builtin_type_reference.value == "prefetch")
+            {
+                h::Type_reference pointer_type;
+
+                if (expression.arguments.size() > 0)
+                {
+                    std::optional<Type_info> first_argument_type_info = get_expression_type_info(parameters.core_module, nullptr, parameters.scope, parameters.statement, parameters.statement.expressions[expression.arguments[0].expression_index], std::nullopt, parameters.declaration_database);
+                    if (first_argument_type_info.has_value() && std::holds_alternative<h::Pointer_type>(first_argument_type_info->type.data))
+                        pointer_type = std::move(first_argument_type_info->type);
+                }
+
+                if (builtin_type_reference.value == "assume_aligned")
+                {
+                    h::Function_type function_type
+                    {
+                        .input_parameter_types = {
+                            pointer_type,
+                            create_integer_type_type_reference(64, false)
+                        },
+                        .output_parameter_types = {
+                            pointer_type
+                        },
+                        .is_variadic = false,
+                    };
+
+                    return h::Function_pointer_type
+                    {
+                        .type = std::move(function_type),
+                        .input_parameter_names = {"pointer", "alignment"},
+                        .output_parameter_names = {"result"}
+                    };
+                }
+
+                h::Function_type function_type
+                {
+                    .input_parameter_types = {
+                        pointer_type,
+                        create_bool_type_reference(),
+                        create_integer_type_type_reference(32, true)
+                    },
+                    .output_parameter_types = {},
+                    .is_variadic = false,
+                };
+
+                return h::Function_pointer_type
+                {
+                    .type = std::move(function_type),
+                    .input_parameter_names = {"address", "is_write", "locality"},
+                    .output_parameter_names = {}
+                };
+            }
         }
 
         return std::nullopt;
@@ -2262,6 +2722,148 @@ namespace h::compiler
                     }
                 }
             }
+            else if (builtin_type_reference.value == "vector_shuffle")
+            {
+                if (expression.arguments.size() == 3)
+                {
+                    std::optional<h::Type_reference> const& first_argument_type_optional = get_expression_type_from_type_info(parameters.expression_types, expression.arguments[0]);
+                    std::uint64_t const lane_count = first_argument_type_optional.has_value() && is_vector_type_reference(first_argument_type_optional.value()) ? get_vector_type_size(first_argument_type_optional.value()) : 0;
+
+                    h::Expression const& mask_expression = parameters.statement.expressions[expression.arguments[2].expression_index];
+                    bool const is_valid_mask = [&]() -> bool
+                    {
+                        if (!std::holds_alternative<h::Constant_array_expression>(mask_expression.data))
+                            return false;
+
+                        for (h::Statement const& lane_statement : std::get<h::Constant_array_expression>(mask_expression.data).array_data)
+                        {
+                            if (lane_statement.expressions.size() != 1 || !std::holds_alternative<h::Constant_expression>(lane_statement.expressions[0].data))
+                                return false;
+
+                            std::uint64_t const lane = std::strtoull(std::get<h::Constant_expression>(lane_statement.expressions[0].data).data.c_str(), nullptr, 10);
+                            if (lane >= 2 * lane_count)
+                                return false;
+                        }
+
+                        return true;
+                    }();
+
+                    if (!is_valid_mask)
+                    {
+                        return
+                        {
+                            create_error_diagnostic(
+                                parameters.core_module.source_file_path,
+                                mask_expression.source_range,
+                                std::format(
+                                    "The mask of 'vector_shuffle' must be a constant array of lane indices smaller than {}.",
+                                    2 * lane_count
+                                )
+                            )
+                        };
+                    }
+                }
+            }
+            else if (
+                builtin_type_reference.value == "byte_swap" ||
+                builtin_type_reference.value == "count_leading_zeros" ||
+                builtin_type_reference.value == "expect" ||
+                builtin_type_reference.value == "population_count"
+            )
+            {
+                if (expression.arguments.size() > 0)
+                {
+                    std::optional<h::Type_reference> const& first_argument_type_optional = get_expression_type_from_type_info(parameters.expression_types, expression.arguments[0]);
+                    std::optional<std::uint32_t> const number_of_bits = get_integer_or_integer_vector_number_of_bits(parameters.declaration_database, first_argument_type_optional);
+
+                    bool const is_valid_argument = [&]() -> bool
+                    {
+                        if (builtin_type_reference.value == "expect")
+                            return first_argument_type_optional.has_value() && (is_bool(first_argument_type_optional.value()) || (number_of_bits.has_value() && !is_vector_type_reference(first_argument_type_optional.value())));
+                        else if (builtin_type_reference.value == "byte_swap")
+                            return number_of_bits.has_value() && number_of_bits.value() % 16 == 0;
+                        else
+                            return number_of_bits.has_value();
+                    }();
+
+                    if (!is_valid_argument)
+                    {
+                        h::Expression const& first_argument_expression = parameters.statement.expressions[expression.arguments[0].expression_index];
+                        std::pmr::string const provided_type_name = h::format_type_reference(parameters.core_module, first_argument_type_optional, parameters.temporaries_allocator, parameters.temporaries_allocator);
+
+                        return
+                        {
+                            create_error_diagnostic(
+                                parameters.core_module.source_file_path,
+                                first_argument_expression.source_range,
+                                std::format(
+                                    "Cannot pass '{}' as first argument to '{}'. Expected {}.",
+                                    provided_type_name,
+                                    builtin_type_reference.value,
+                                    builtin_type_reference.value == "byte_swap" ? "an integer whose number of bits is a multiple of 16" : "an integer"
+                                )
+                            )
+                        };
+                    }
+                }
+            }
+            else if (builtin_type_reference.value == "prefetch")
+            {
+                if (expression.arguments.size() == 3)
+                {
+                    h::Expression const& is_write_expression = parameters.statement.expressions[expression.arguments[1].expression_index];
+                    if (!std::holds_alternative<h::Constant_expression>(is_write_expression.data))
+                    {
+                        return
+                        {
+                            create_error_diagnostic(
+                                parameters.core_module.source_file_path,
+                                is_write_expression.source_range,
+                                "The 'is_write' argument of 'prefetch' must be a constant."
+                            )
+                        };
+                    }
+
+                    h::Expression const& locality_expression = parameters.statement.expressions[expression.arguments[2].expression_index];
+                    bool const is_valid_locality =
+                        std::holds_alternative<h::Constant_expression>(locality_expression.data) &&
+                        std::strtoull(std::get<h::Constant_expression>(locality_expression.data).data.c_str(), nullptr, 10) <= 3;
+
+                    if (!is_valid_locality)
+                    {
+                        return
+                        {
+                            create_error_diagnostic(
+                                parameters.core_module.source_file_path,
+                                locality_expression.source_range,
+                                "The 'locality' argument of 'prefetch' must be a constant between 0 and 3."
+                            )
+                        };
+                    }
+                }
+            }
+            else if (builtin_type_reference.value == "assume_aligned")
+            {
+                if (expression.arguments.size() == 2)
+                {
+                    h::Expression const& alignment_expression = parameters.statement.expressions[expression.arguments[1].expression_index];
+                    std::uint64_t const alignment = std::holds_alternative<h::Constant_expression>(alignment_expression.data) ?
+                        std::strtoull(std::get<h::Constant_expression>(alignment_expression.data).data.c_str(), nullptr, 10) :
+                        0;
+
+                    if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+                    {
+                        return
+                        {
+                            create_error_diagnostic(
+                                parameters.core_module.source_file_path,
+                                alignment_expression.source_range,
+                                "The 'alignment' argument of 'assume_aligned' must be a constant power of two."
+                            )
+                        };
+                    }
+                }
+            }
             else if (builtin_type_reference.value == "create_stack_array_uninitialized")
             {
                 return
@@ -2285,7 +2887,7 @@ namespace h::compiler
                 expression
             );
 
-            if (builtin_instance_call.has_value())
+            if (builtin_instance_call.has_value() && !find_declaration(parameters.declaration_database, parameters.core_module.name, builtin_instance_call->first).has_value())
             {
                 if (builtin_instance_call->first == "create_stack_array_uninitialized")
                 {
@@ -2327,6 +2929,26 @@ namespace h::compiler
                         };
                     }
                 }
+                else if (builtin_instance_call->first == "vector_load")
+                {
+                    h::Instance_call_expression const& instance_call_expression = builtin_instance_call->second;
+
+                    if (instance_call_expression.arguments.size() != 2)
+                    {
+                        return
+                        {
+                            create_error_diagnostic(
+                                parameters.core_module.source_file_path,
+                                source_range,
+                                std::format(
+                                    "Function expects {} type arguments, but {} were provided.",
+                                    2,
+                                    instance_call_expression.arguments.size()
+                                )
+                            )
+                        };
+                    }
+                }
             }
         }
 
@@ -3014,6 +3636,137 @@ namespace h::compiler
         return {};
     }
 
+    static h::Variable_expression const* get_address_root_variable_expression(
+        h::Statement const& statement,
+        h::Expression const& expression
+    )
+    {
+        if (std::holds_alternative<h::Access_expression>(expression.data))
+        {
+            h::Access_expression const& access_expression = std::get<h::Access_expression>(expression.data);
+            return get_address_root_variable_expression(statement, statement.expressions[access_expression.expression.expression_index]);
+        }
+        else if (std::holds_alternative<h::Access_array_expression>(expression.data))
+        {
+            h::Access_array_expression const& access_expression = std::get<h::Access_array_expression>(expression.data);
+            return get_address_root_variable_expression(statement, statement.expressions[access_expression.expression.expression_index]);
+        }
+        else if (std::holds_alternative<h::Variable_expression>(expression.data))
+        {
+            return &std::get<h::Variable_expression>(expression.data);
+        }
+
+        return nullptr;
+    }
+
+    static h::Variable_expression const* find_address_of_local_variable(
+        Scope const& scope,
+        h::Statement const& statement,
+        h::Expression const& expression
+    )
+    {
+        auto const find_in = [&](h::Expression_index const index) -> h::Variable_expression const*
+        {
+            return find_address_of_local_variable(scope, statement, statement.expressions[index.expression_index]);
+        };
+
+        if (std::holds_alternative<h::Unary_expression>(expression.data))
+        {
+            h::Unary_expression const& unary_expression = std::get<h::Unary_expression>(expression.data);
+            if (unary_expression.operation == h::Unary_operation::Address_of)
+            {
+                h::Variable_expression const* const variable_expression = get_address_root_variable_expression(statement, statement.expressions[unary_expression.expression.expression_index]);
+                if (variable_expression != nullptr && find_variable_from_scope(scope, variable_expression->name) != nullptr)
+                    return variable_expression;
+            }
+
+            return find_in(unary_expression.expression);
+        }
+        else if (std::holds_alternative<h::Binary_expression>(expression.data))
+        {
+            h::Binary_expression const& binary_expression = std::get<h::Binary_expression>(expression.data);
+            h::Variable_expression const* const left_variable_expression = find_in(binary_expression.left_hand_side);
+            return left_variable_expression != nullptr ? left_variable_expression : find_in(binary_expression.right_hand_side);
+        }
+        else if (std::holds_alternative<h::Call_expression>(expression.data))
+        {
+            h::Call_expression const& call_expression = std::get<h::Call_expression>(expression.data);
+            for (h::Expression_index const argument : call_expression.arguments)
+            {
+                h::Variable_expression const* const variable_expression = find_in(argument);
+                if (variable_expression != nullptr)
+                    return variable_expression;
+            }
+        }
+        else if (std::holds_alternative<h::Cast_expression>(expression.data))
+        {
+            return find_in(std::get<h::Cast_expression>(expression.data).source);
+        }
+        else if (std::holds_alternative<h::Parenthesis_expression>(expression.data))
+        {
+            return find_in(std::get<h::Parenthesis_expression>(expression.data).expression);
+        }
+
+        return nullptr;
+    }
+
+    static std::pmr::vector<h::compiler::Diagnostic> validate_must_tail_return_expression(
+        Validate_expression_parameters const& parameters,
+        h::Return_expression const& expression,
+        std::optional<h::Source_range> const& source_range
+    )
+    {
+        h::Function_declaration const& function_declaration = *parameters.function_declaration;
+
+        if (!expression.expression.has_value())
+            return {};
+
+        h::Expression const& returned_expression = parameters.statement.expressions[expression.expression->expression_index];
+        if (!std::holds_alternative<h::Call_expression>(returned_expression.data))
+            return {};
+
+        h::Call_expression const& call_expression = std::get<h::Call_expression>(returned_expression.data);
+
+        std::optional<h::Type_reference> const& callable_type = get_expression_type_from_type_info(parameters.expression_types, call_expression.expression);
+        if (!callable_type.has_value() || !is_function_pointer(callable_type.value()))
+            return {};
+
+        h::Function_pointer_type const& function_pointer_type = std::get<h::Function_pointer_type>(callable_type->data);
+        if (function_pointer_type.type != function_declaration.type)
+        {
+            return
+            {
+                create_error_diagnostic(
+                    parameters.core_module.source_file_path,
+                    source_range,
+                    std::format(
+                        "Function '{}' is '@must_tail' but the returned call has a different signature.",
+                        function_declaration.name
+                    )
+                )
+            };
+        }
+
+        h::Variable_expression const* const escaped_variable_expression = find_address_of_local_variable(parameters.scope, parameters.statement, returned_expression);
+        if (escaped_variable_expression != nullptr)
+        {
+            return
+            {
+                create_error_diagnostic(
+                    parameters.core_module.source_file_path,
+                    source_range,
+                    std::format(
+                        "Function '{}' is '@must_tail' but the address of local variable '{}' is passed to the returned call.",
+                        function_declaration.name,
+                        escaped_variable_expression->name
+                    )
+                )
+            };
+        }
+
+        return {};
+    }
+
     std::pmr::vector<h::compiler::Diagnostic> validate_return_expression(
         Validate_expression_parameters const& parameters,
         h::Return_expression const& expression,
@@ -3077,6 +3830,10 @@ namespace h::compiler
             }
         }
 
+        std::pmr::vector<h::Function_attribute> const& attributes = parameters.function_declaration->attributes;
+        if (std::find(attributes.begin(), attributes.end(), h::Function_attribute::Must_tail) != attributes.end())
+            return validate_must_tail_return_expression(parameters, expression, source_range);
+
         return {};
     }
 
@@ -1,3 +1,4 @@
+#include <array>
 #include <memory_resource>
 #include <filesystem>
 #include <optional>
@@ -141,6 +142,39 @@ import my.module_a as my_module;
         test_validate_module(input, {}, expected_diagnostics);
     }
 
+    TEST_CASE("Reports a missing import module only once", "[Validation][Import]")
+    {
+        std::string_view const input = R"(module Test;
+
+import my.module_a as my_module;
+)";
+
+        std::optional<h::Module> core_module = h::parser::parse_and_convert_to_module(
+            input,
+            std::nullopt,
+            {},
+            {}
+        );
+        REQUIRE(core_module.has_value());
+
+        std::array<h::Module const*, 1> const core_modules{ &core_module.value() };
+        h::compiler::Sorted_core_modules const sorted = h::compiler::sort_core_modules_and_compute_ranks(core_modules, {}, {});
+        CHECK(sorted.diagnostics.empty());
+
+        Declaration_database declaration_database = create_declaration_database();
+        add_declarations(declaration_database, core_module.value());
+
+        Analysis_result const result = process_module(
+            core_module.value(),
+            declaration_database,
+            { .validate = true },
+            {}
+        );
+
+        REQUIRE(result.diagnostics.size() == 1);
+        CHECK(result.diagnostics[0].message == "Cannot find module 'my.module_a'.");
+    }
+
 
     TEST_CASE("Validates that a declaration name is not a duplicate", "[Validation][Declaration]")
     {
@@ -471,6 +505,41 @@ struct My_struct
         test_validate_module(input, {}, expected_diagnostics);
     }
 
+    TEST_CASE("Validates that struct alignments are powers of two", "[Validation][Struct]")
+    {
+        std::string_view const input = R"(module Test;
+
+@align(24)
+@align(b, 3)
+struct My_struct
+{
+    a: Int32 = 0;
+    b: Int32 = 0;
+}
+)";
+
+        std::pmr::vector<h::compiler::Diagnostic> expected_diagnostics =
+        {
+            h::compiler::Diagnostic
+            {
+                .range = create_source_range(5, 8, 5, 17),
+                .source = Diagnostic_source::Compiler,
+                .severity = Diagnostic_severity::Error,
+                .message = "Alignment of struct 'My_struct' must be a power of two, but 24 was provided.",
+                .related_information = {},
+            },
+            {
+                .range = create_source_range(8, 5, 8, 6),
+                .source = Diagnostic_source::Compiler,
+                .severity = Diagnostic_severity::Error,
+                .message = "Alignment of struct member 'My_struct.b' must be a power of two, but 3 was provided.",
+                .related_information = {},
+            }
+        };
+
+        test_validate_module(input, {}, expected_diagnostics);
+    }
+
     TEST_CASE("Validates that member default values types must match member types", "[Validation][Struct]")
     {
         std::string_view const input = R"(module Test;
@@ -2166,6 +2235,38 @@ using My_type = My_struct;
         test_validate_module(input, {}, expected_diagnostics);
     }
 
+    TEST_CASE("Validates vector types", "[Validation][Vector_type]")
+    {
+        std::string_view const input = R"(module Test;
+
+using Vector_0 = Vector::<Float32, 0>;
+using Vector_1 = Vector::<*Int32, 4>;
+using Vector_2 = Vector::<Float32, 8>;
+)";
+
+        std::pmr::vector<h::compiler::Diagnostic> expected_diagnostics =
+        {
+            h::compiler::Diagnostic
+            {
+                .range = create_source_range(3, 18, 3, 38),
+                .source = Diagnostic_source::Compiler,
+                .severity = Diagnostic_severity::Error,
+                .message = "Vector type 'Vector::<Float32, 0>' must have at least one lane.",
+                .related_information = {},
+            },
+            h::compiler::Diagnostic
+            {
+                .range = create_source_range(4, 18, 4, 37),
+                .source = Diagnostic_source::Compiler,
+                .severity = Diagnostic_severity::Error,
+                .message = "Vector type 'Vector::<*Int32, 4>' must have a boolean, integer or floating point element type.",
+                .related_information = {},
+            },
+        };
+
+        test_validate_module(input, {}, expected_diagnostics);
+    }
+
     TEST_CASE("Validates that a type from an import module exists", "[Validation][Custom_type_reference]")
     {
         std::string_view const input = R"(module Test_a;
@@ -4845,6 +4946,171 @@ export function run(data: *Int32, length: Uint64) -> ()
         test_validate_module(input, {}, expected_diagnostics);
     }
 
+    TEST_CASE("Validates intrinsic builtins usage", "[Validation][Builtins]")
+    {
+        std::string_view const input = R"(module Intrinsics;
+
+export function run(data: *Int32, value: Int32, flag: Bool) -> ()
+{
+    prefetch(data, false, 3);
+    var a = likely(flag);
+    var b = expect(value, 0);
+    assume(flag);
+    var c = assume_aligned(data, 16u64);
+    var d = population_count(value);
+    var e = byte_swap(value);
+
+    var f = population_count(flag);
+    var g = byte_swap(0i8);
+    prefetch(data, false, 4);
+    var h = assume_aligned(data, 12u64);
+    unreachable();
+}
+)";
+
+        std::pmr::vector<h::compiler::Diagnostic> expected_diagnostics =
+        {
+            h::compiler::Diagnostic
+            {
+                .range = create_source_range(13, 30, 13, 34),
+                .source = Diagnostic_source::Compiler,
+                .severity = Diagnostic_severity::Error,
+                .message = "Cannot pass 'Bool' as first argument to 'population_count'. Expected an integer.",
+                .related_information = {},
+            },
+            {
+                .range = create_source_range(14, 23, 14, 26),
+                .source = Diagnostic_source::Compiler,
+                .severity = Diagnostic_severity::Error,
+                .message = "Cannot pass 'Int8' as first argument to 'byte_swap'. Expected an integer whose number of bits is a multiple of 16.",
+                .related_information = {},
+            },
+            {
+                .range = create_source_range(15, 27, 15, 28),
+                .source = Diagnostic_source::Compiler,
+                .severity = Diagnostic_severity::Error,
+                .message = "The 'locality' argument of 'prefetch' must be a constant between 0 and 3.",
+                .related_information = {},
+            },
+            {
+                .range = create_source_range(16, 34, 16, 39),
+                .source = Diagnostic_source::Compiler,
+                .severity = Diagnostic_severity::Error,
+                .message = "The 'alignment' argument of 'assume_aligned' must be a constant power of two.",
+                .related_information = {},
+            },
+        };
+
+        test_validate_module(input, {}, expected_diagnostics);
+    }
+
+    TEST_CASE("Validates function and parameter attributes", "[Validation][Function_attributes]")
+    {
+        std::string_view const input = R"(module Function_attributes;
+
+@hot()
+@no_alias(destination, source)
+export function copy(destination: *mutable Int32, source: *Int32, count: Int64) -> ()
+{
+}
+
+@always_inline()
+@no_inline()
+@no_alias(count, other)
+export function run(count: Int64) -> ()
+{
+}
+)";
+
+        std::pmr::vector<h::compiler::Diagnostic> expected_diagnostics =
+        {
+            h::compiler::Diagnostic
+            {
+                .range = create_source_range(13, 17, 13, 20),
+                .source = Diagnostic_source::Compiler,
+                .severity = Diagnostic_severity::Error,
+                .message = "Function 'run' cannot be both '@always_inline' and '@no_inline'.",
+                .related_information = {},
+            },
+            {
+                .range = create_source_range(13, 21, 13, 26),
+                .source = Diagnostic_source::Compiler,
+                .severity = Diagnostic_severity::Error,
+                .message = "Parameter 'count' of type 'Int64' cannot be '@no_alias' because it is not a pointer.",
+                .related_information = {},
+            },
+            {
+                .range = create_source_range(13, 17, 13, 20),
+                .source = Diagnostic_source::Compiler,
+                .severity = Diagnostic_severity::Error,
+                .message = "Function 'run' does not have an input parameter named 'other'.",
+                .related_information = {},
+            },
+        };
+
+        test_validate_module(input, {}, expected_diagnostics);
+    }
+
+    TEST_CASE("Validates that returned calls of must_tail functions can be tail calls", "[Validation][Function_attributes]")
+    {
+        std::string_view const input = R"(module Tail_calls;
+
+function add(value: Int32, accumulator: Int32) -> (result: Int32)
+{
+    return value + accumulator;
+}
+
+function read(pointer: *Int32, value: Int32) -> (result: Int32)
+{
+    return *pointer + value;
+}
+
+@must_tail()
+function sum(value: Int32, accumulator: Int32) -> (result: Int32)
+{
+    if value == 0 {
+        return accumulator;
+    }
+
+    return sum(value - 1, accumulator + value);
+}
+
+@must_tail()
+function forward(value: Int32) -> (result: Int32)
+{
+    return add(value, 0);
+}
+
+@must_tail()
+function escape(pointer: *Int32, value: Int32) -> (result: Int32)
+{
+    var local = value;
+    return read(&local, value);
+}
+)";
+
+        std::pmr::vector<h::compiler::Diagnostic> expected_diagnostics =
+        {
+            h::compiler::Diagnostic
+            {
+                .range = create_source_range(26, 5, 26, 25),
+                .source = Diagnostic_source::Compiler,
+                .severity = Diagnostic_severity::Error,
+                .message = "Function 'forward' is '@must_tail' but the returned call has a different signature.",
+                .related_information = {},
+            },
+            {
+                .range = create_source_range(33, 5, 33, 31),
+                .source = Diagnostic_source::Compiler,
+                .severity = Diagnostic_severity::Error,
+                .message = "Function 'escape' is '@must_tail' but the address of local variable 'local' is passed to the returned call.",
+                .related_information = {},
+            },
+        };
+
+        test_validate_module(input, {}, expected_diagnostics);
+    }
+
     TEST_CASE("Validates that null cannot be passed to create_array_slice_from_pointer()", "[Validation][Array_slices]")
     {
         std::string_view const input = R"(module Array_slices;
@@ -256,7 +256,7 @@ namespace h
 
     h::Module const& find_module(
         h::Module const& core_module,
-        std::pmr::unordered_map<std::pmr::string, h::Module> const& core_module_dependencies,
+        std::pmr::unordered_map<std::pmr::string, h::Module const*> const& core_module_dependencies,
         std::string_view const name
     )
     {
@@ -265,7 +265,7 @@ namespace h
 
         auto const location = core_module_dependencies.find(name.data());
         if (location != core_module_dependencies.end())
-            return location->second;
+            return *location->second;
 
         h::common::print_message_and_exit(std::format("Could not find module '{}'", name));
         std::unreachable();
@@ -613,10 +613,23 @@ namespace h
         std::string_view const name
     )
     {
-        return name == "create_array_slice_from_pointer" ||
+        return name == "assume" ||
+               name == "assume_aligned" ||
+               name == "byte_swap" ||
+               name == "count_leading_zeros" ||
+               name == "create_array_slice_from_pointer" ||
                name == "create_stack_array_uninitialized" ||
+               name == "expect" ||
+               name == "likely" ||
                name == "offset_pointer" ||
-               name == "reinterpret_as";
+               name == "population_count" ||
+               name == "prefetch" ||
+               name == "reinterpret_as" ||
+               name == "unlikely" ||
+               name == "unreachable" ||
+               name == "vector_load" ||
+               name == "vector_shuffle" ||
+               name == "vector_store";
     }
 
     bool is_expression_address_of(
@@ -296,6 +296,18 @@ namespace h
 #endif
     };
 
+    export struct Vector_type
+    {
+        std::pmr::vector<Type_reference> element_type;
+        std::uint64_t size;
+
+#if HACK_SPACESHIP_OPERATOR
+        friend std::strong_ordering operator<=>(Vector_type const&, Vector_type const&) = default;
+#else
+        friend auto operator<=>(Vector_type const&, Vector_type const&) = default;
+#endif
+    };
+
     export struct Type_reference
     {
         using Data_type = std::variant<
@@ -309,7 +321,8 @@ namespace h
             Null_pointer_type,
             Parameter_type,
             Pointer_type,
-            Type_instance
+            Type_instance,
+            Vector_type
         >;
 
         Data_type data;
@@ -439,8 +452,10 @@ namespace h
         std::pmr::vector<Type_reference> member_types;
         std::pmr::vector<std::pmr::string> member_names;
         std::pmr::vector<std::optional<std::uint32_t>> member_bit_fields;
+        std::pmr::vector<std::optional<std::uint32_t>> member_alignments;
         std::pmr::vector<Statement> member_default_values;
         bool is_packed;
+        std::optional<std::uint32_t> alignment;
         bool is_literal;
         std::optional<std::pmr::string> comment;
         std::pmr::vector<Indexed_comment> member_comments;
@@ -492,6 +507,34 @@ namespace h
         Private
     };
 
+    export enum class Function_attribute
+    {
+        Always_inline,
+        Cold,
+        Const,
+        Hot,
+        Must_tail,
+        No_inline,
+        Pure
+    };
+
+    export enum class Parameter_attribute
+    {
+        No_alias
+    };
+
+    export struct Named_parameter_attribute
+    {
+        std::pmr::string parameter_name;
+        Parameter_attribute attribute;
+
+#if HACK_SPACESHIP_OPERATOR
+        friend std::strong_ordering operator<=>(Named_parameter_attribute const&, Named_parameter_attribute const&) = default;
+#else
+        friend auto operator<=>(Named_parameter_attribute const&, Named_parameter_attribute const&) = default;
+#endif
+    };
+
     export struct Function_declaration
     {
         std::pmr::string name;
@@ -500,6 +543,8 @@ namespace h
         std::pmr::vector<std::pmr::string> input_parameter_names;
         std::pmr::vector<std::pmr::string> output_parameter_names;
         Linkage linkage;
+        std::pmr::vector<Function_attribute> attributes;
+        std::pmr::vector<Named_parameter_attribute> parameter_attributes;
         std::pmr::vector<Function_condition> preconditions;
         std::pmr::vector<Function_condition> postconditions;
         std::optional<std::pmr::string> comment;
@@ -1276,7 +1321,7 @@ namespace h
 
     export Module const& find_module(
         Module const& core_module,
-        std::pmr::unordered_map<std::pmr::string, Module> const& core_module_dependencies,
+        std::pmr::unordered_map<std::pmr::string, Module const*> const& core_module_dependencies,
         std::string_view name
     );
 
@@ -2,7 +2,9 @@ module;
 
 #include <format>
 #include <memory_resource>
+#include <mutex>
 #include <optional>
+#include <shared_mutex>
 #include <string>
 #include <span>
 #include <stdexcept>
@@ -161,7 +163,41 @@ namespace h
         Struct_declaration const& struct_declaration
     )
     {
-        database.instances.insert(std::make_pair(type_instance, Declaration_instance_storage{ .data = struct_declaration }));
+        add_type_instance(database, type_instance, Declaration_instance_storage{ .data = struct_declaration });
+    }
+
+    Declaration_instance_storage const* find_type_instance_storage(
+        Declaration_database const& database,
+        Type_instance const& type_instance
+    )
+    {
+        std::shared_lock<std::shared_mutex> const lock{database.instances_mutex.value};
+
+        auto const location = database.instances.find(type_instance);
+        if (location == database.instances.end())
+            return nullptr;
+
+        return &location->second;
+    }
+
+    void add_type_instance(
+        Declaration_database& database,
+        Type_instance const& type_instance,
+        Declaration_instance_storage storage
+    )
+    {
+        std::unique_lock<std::shared_mutex> const lock{database.instances_mutex.value};
+        database.instances.emplace(type_instance, std::move(storage));
+    }
+
+    void add_instance_call(
+        Declaration_database& database,
+        Instance_call_key key,
+        Function_expression function_expression
+    )
+    {
+        std::unique_lock<std::shared_mutex> const lock{database.call_instances_mutex.value};
+        database.call_instances.emplace(std::move(key), std::move(function_expression));
     }
 
     std::optional<Declaration> find_declaration(
@@ -198,14 +234,14 @@ namespace h
         {
             Type_instance const& type_instance = std::get<Type_instance>(type_reference.data);
 
-            auto const declaration_location = database.instances.find(type_instance);
-            if (declaration_location == database.instances.end())
+            Declaration_instance_storage const* const instance_storage_pointer = find_type_instance_storage(database, type_instance);
+            if (instance_storage_pointer == nullptr)
                 return std::nullopt;
 
             std::string_view const declaration_module_name = type_instance.type_constructor.module_reference.name;
             bool const is_export = true;
             
-            Declaration_instance_storage const& instance_storage = declaration_location->second;
+            Declaration_instance_storage const& instance_storage = *instance_storage_pointer;
             if (std::holds_alternative<Alias_type_declaration>(instance_storage.data))
             {
                 Alias_type_declaration const& declaration = std::get<Alias_type_declaration>(instance_storage.data);
@@ -483,10 +519,10 @@ namespace h
             if (std::holds_alternative<Type_instance>(type_reference.data))
             {
                 Type_instance const& type_instance = std::get<Type_instance>(type_reference.data);
-                if (!declaration_database.instances.contains(type_instance))
+                if (find_type_instance_storage(declaration_database, type_instance) == nullptr)
                 {
                     Declaration_instance_storage storage = instantiate_type_instance(declaration_database, type_instance);
-                    declaration_database.instances.emplace(type_instance, std::move(storage));   
+                    add_type_instance(declaration_database, type_instance, std::move(storage));
                 }
             }
 
@@ -509,10 +545,10 @@ namespace h
             if (std::holds_alternative<Type_instance>(type_reference.data))
             {
                 Type_instance const& type_instance = std::get<Type_instance>(type_reference.data);
-                if (!declaration_database.instances.contains(type_instance))
+                if (find_type_instance_storage(declaration_database, type_instance) == nullptr)
                 {
                     Declaration_instance_storage storage = instantiate_type_instance(declaration_database, type_instance);
-                    declaration_database.instances.emplace(type_instance, std::move(storage));
+                    add_type_instance(declaration_database, type_instance, std::move(storage));
                 }
             }
 
@@ -643,6 +679,8 @@ namespace h
         Instance_call_key const& key
     )
     {
+        std::shared_lock<std::shared_mutex> const lock{declaration_database.call_instances_mutex.value};
+
         auto const location = declaration_database.call_instances.find(key);
         if (location == declaration_database.call_instances.end())
             return nullptr;
@@ -717,6 +755,8 @@ namespace h
     }
 
     static bool is_builtin_instance_call(
+        Declaration_database const& declaration_database,
+        std::string_view const module_name,
         h::Statement const& statement,
         Instance_call_expression const& expression
     )
@@ -725,7 +765,11 @@ namespace h
         if (std::holds_alternative<h::Variable_expression>(left_hand_side.data))
         {
             h::Variable_expression const& variable_expression = std::get<h::Variable_expression>(left_hand_side.data);
-            return is_builtin_function_name(variable_expression.name);
+            if (!is_builtin_function_name(variable_expression.name))
+                return false;
+
+            // A function constructor of the module with the same name is instantiated instead:
+            return !find_declaration(declaration_database, module_name, variable_expression.name).has_value();
         }
 
         return false;
@@ -742,7 +786,7 @@ namespace h
             {
                 Instance_call_expression const& instance_call_expression = std::get<Instance_call_expression>(expression.data);
 
-                if (is_builtin_instance_call(statement, instance_call_expression))
+                if (is_builtin_instance_call(declaration_database, core_module.name, statement, instance_call_expression))
                     return false;
 
                 // TODO can optimize by checking for the existence of the key first
@@ -753,10 +797,10 @@ namespace h
                     core_module.name
                 );
 
-                if (!declaration_database.call_instances.contains(pair.first))
+                if (get_instance_call_function_expression(declaration_database, pair.first) == nullptr)
                 {
                     add_instantiated_type_instances(declaration_database, pair.second);
-                    declaration_database.call_instances.emplace(std::move(pair));
+                    add_instance_call(declaration_database, pair.first, pair.second);
                 }
             }
 
@@ -3,6 +3,7 @@ module;
 #include <functional>
 #include <memory_resource>
 #include <optional>
+#include <shared_mutex>
 #include <string>
 #include <span>
 #include <unordered_map>
@@ -67,11 +68,27 @@ namespace h
         }
     };*/
 
+    // Copying a database creates a new, unlocked mutex.
+    export struct Declaration_database_mutex
+    {
+        Declaration_database_mutex() = default;
+        Declaration_database_mutex(Declaration_database_mutex const&) {}
+        Declaration_database_mutex& operator=(Declaration_database_mutex const&) { return *this; }
+
+        mutable std::shared_mutex value;
+    };
+
+    // instances and call_instances can be read and inserted concurrently, as long as the accesses go
+    // through find_type_instance_storage, add_type_instance, get_instance_call_function_expression and add_instance_call.
+    // Elements are never erased and unordered_map nodes are stable, so returned pointers stay valid.
+    // map is only modified by add_declarations, which must not run concurrently with anything else.
     export struct Declaration_database
     {
         std::pmr::unordered_map<Module_name, Declaration_map, String_hash, String_equal> map;
         std::pmr::unordered_map<Type_instance, Declaration_instance_storage, Type_instance_hash> instances;
         std::pmr::unordered_map<Instance_call_key, Function_expression, Instance_call_key_hash> call_instances;
+        Declaration_database_mutex instances_mutex;
+        Declaration_database_mutex call_instances_mutex;
     };
 
     export Declaration_database create_declaration_database();
@@ -102,6 +119,23 @@ namespace h
         Struct_declaration const& struct_declaration
     );
 
+    export Declaration_instance_storage const* find_type_instance_storage(
+        Declaration_database const& database,
+        Type_instance const& type_instance
+    );
+
+    export void add_type_instance(
+        Declaration_database& database,
+        Type_instance const& type_instance,
+        Declaration_instance_storage storage
+    );
+
+    export void add_instance_call(
+        Declaration_database& database,
+        Instance_call_key key,
+        Function_expression function_expression
+    );
+
     export std::optional<Declaration> find_declaration(
         Declaration_database const& database,
         std::string_view const module_name,
@@ -170,6 +170,96 @@ namespace h
         return std::nullopt;
     }
 
+    static std::string_view function_attribute_to_string(
+        Function_attribute const attribute
+    )
+    {
+        switch (attribute)
+        {
+        case Function_attribute::Always_inline:
+            return "@always_inline";
+        case Function_attribute::Cold:
+            return "@cold";
+        case Function_attribute::Const:
+            return "@const";
+        case Function_attribute::Hot:
+            return "@hot";
+        case Function_attribute::Must_tail:
+            return "@must_tail";
+        case Function_attribute::No_inline:
+            return "@no_inline";
+        case Function_attribute::Pure:
+            return "@pure";
+        }
+
+        return "";
+    }
+
+    static void add_function_attributes(
+        String_buffer& buffer,
+        Function_declaration const& declaration
+    )
+    {
+        for (Function_attribute const attribute : declaration.attributes)
+        {
+            add_text(buffer, function_attribute_to_string(attribute));
+            add_text(buffer, "()");
+            add_new_line(buffer);
+        }
+
+        bool is_first_no_alias_parameter = true;
+
+        for (Named_parameter_attribute const& parameter_attribute : declaration.parameter_attributes)
+        {
+            if (parameter_attribute.attribute != Parameter_attribute::No_alias)
+                continue;
+
+            add_text(buffer, is_first_no_alias_parameter ? "@no_alias(" : ", ");
+            add_text(buffer, parameter_attribute.parameter_name);
+            is_first_no_alias_parameter = false;
+        }
+
+        if (!is_first_no_alias_parameter)
+        {
+            add_text(buffer, ")");
+            add_new_line(buffer);
+        }
+    }
+
+    static void add_struct_attributes(
+        String_buffer& buffer,
+        Struct_declaration const& declaration
+    )
+    {
+        if (declaration.is_packed)
+        {
+            add_text(buffer, "@packed()");
+            add_new_line(buffer);
+        }
+
+        if (declaration.alignment.has_value())
+        {
+            add_text(buffer, "@align(");
+            add_integer_text(buffer, static_cast<std::uint64_t>(declaration.alignment.value()));
+            add_text(buffer, ")");
+            add_new_line(buffer);
+        }
+
+        for (std::size_t member_index = 0; member_index < declaration.member_alignments.size(); ++member_index)
+        {
+            std::optional<std::uint32_t> const& member_alignment = declaration.member_alignments[member_index];
+            if (!member_alignment.has_value())
+                continue;
+
+            add_text(buffer, "@align(");
+            add_text(buffer, declaration.member_names[member_index]);
+            add_text(buffer, ", ");
+            add_integer_text(buffer, static_cast<std::uint64_t>(member_alignment.value()));
+            add_text(buffer, ")");
+            add_new_line(buffer);
+        }
+    }
+
     static void add_format_declaration(
         String_buffer& buffer,
         h::Module const& core_module,
@@ -194,6 +284,11 @@ namespace h
             add_new_line(buffer);
         }
 
+        if (std::holds_alternative<Function_declaration const*>(declaration.data))
+            add_function_attributes(buffer, *std::get<Function_declaration const*>(declaration.data));
+        else if (std::holds_alternative<Struct_declaration const*>(declaration.data))
+            add_struct_attributes(buffer, *std::get<Struct_declaration const*>(declaration.data));
+
         if (is_export)
             add_text(buffer, "export ");
 
@@ -1705,6 +1800,15 @@ namespace h
 
             add_text(buffer, ">");
         }
+        else if (std::holds_alternative<Vector_type>(type.data))
+        {
+            Vector_type const& value = std::get<Vector_type>(type.data);
+            add_text(buffer, "Vector::<");
+            add_format_type_name(buffer, value.element_type, options);
+            add_text(buffer, ", ");
+            add_integer_text(buffer, value.size);
+            add_text(buffer, ">");
+        }
     }
 
     void add_format_type_name(
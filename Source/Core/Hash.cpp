@@ -2,13 +2,16 @@ module;
 
 #include <xxhash.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <memory_resource>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <variant>
+#include <vector>
 
 module h.core.hash;
 
@@ -184,6 +187,17 @@ namespace h
 
             update_hash(state, &data.is_mutable, sizeof(data.is_mutable));
         }
+        else if (std::holds_alternative<h::Vector_type>(type_reference.data))
+        {
+            h::Vector_type const& data = std::get<h::Vector_type>(type_reference.data);
+
+            for (h::Type_reference const& element_type : data.element_type)
+            {
+                update_hash(state, element_type);
+            }
+
+            update_hash(state, &data.size, sizeof(data.size));
+        }
         else
         {
             h::common::print_message_and_exit("Hash of type reference data is not implemented!");
@@ -350,7 +364,17 @@ namespace h
         for (h::Statement const& member_default_value : declaration.member_default_values)
             update_hash(state, member_default_value);
 
+        for (std::optional<std::uint32_t> const& member_alignment : declaration.member_alignments)
+        {
+            std::uint32_t const value = member_alignment.value_or(0);
+            update_hash(state, &value, sizeof(value));
+        }
+
         update_hash(state, &declaration.is_packed, sizeof(declaration.is_packed));
+
+        if (declaration.alignment.has_value())
+            update_hash(state, &declaration.alignment.value(), sizeof(declaration.alignment.value()));
+
         update_hash(state, &declaration.is_literal, sizeof(declaration.is_literal));
     }
 
@@ -383,6 +407,15 @@ namespace h
 
         update_hash(state, declaration.type);
         update_hash(state, &declaration.linkage, sizeof(declaration.linkage));
+
+        for (h::Function_attribute const attribute : declaration.attributes)
+            update_hash(state, &attribute, sizeof(attribute));
+
+        for (h::Named_parameter_attribute const& parameter_attribute : declaration.parameter_attributes)
+        {
+            update_hash(state, parameter_attribute.parameter_name);
+            update_hash(state, &parameter_attribute.attribute, sizeof(parameter_attribute.attribute));
+        }
     }
 
     void update_hash(
@@ -474,6 +507,42 @@ namespace h
         return hash;
     }
 
+    XXH64_hash_t hash_global_variable_declaration(
+        XXH64_state_t* const state,
+        h::Global_variable_declaration const& declaration
+    )
+    {
+        XXH64_hash_t const seed = 0;
+        if (XXH64_reset(state, seed) == XXH_ERROR)
+            h::common::print_message_and_exit("Could not reset xxhash state!");
+
+        update_hash(state, declaration.name);
+        if (declaration.type.has_value())
+            update_hash(state, declaration.type.value());
+        update_hash(state, declaration.initial_value);
+        update_hash(state, &declaration.is_mutable, sizeof(declaration.is_mutable));
+
+        XXH64_hash_t const hash = XXH64_digest(state);
+        return hash;
+    }
+
+    XXH64_hash_t hash_function_definition(
+        XXH64_state_t* const state,
+        h::Function_definition const& definition
+    )
+    {
+        XXH64_hash_t const seed = 0;
+        if (XXH64_reset(state, seed) == XXH_ERROR)
+            h::common::print_message_and_exit("Could not reset xxhash state!");
+
+        update_hash(state, definition.name);
+        for (Statement const& statement : definition.statements)
+            update_hash(state, statement);
+
+        XXH64_hash_t const hash = XXH64_digest(state);
+        return hash;
+    }
+
     XXH64_hash_t hash_type_instance(
         XXH64_state_t* const state,
         h::Type_instance const& type_instance
@@ -585,4 +654,71 @@ namespace h
 
         return map;
     }
+
+    XXH64_hash_t hash_module_interface(
+        h::Module const& core_module
+    )
+    {
+        Symbol_name_to_hash const declaration_hashes = hash_module_declarations(core_module, {});
+
+        std::pmr::vector<std::pair<std::string_view, std::uint64_t>> sorted_declaration_hashes;
+        sorted_declaration_hashes.reserve(declaration_hashes.size());
+        for (std::pair<std::pmr::string const, std::uint64_t> const& pair : declaration_hashes)
+            sorted_declaration_hashes.push_back(std::make_pair(std::string_view{pair.first}, pair.second));
+        std::sort(sorted_declaration_hashes.begin(), sorted_declaration_hashes.end());
+
+        XXH64_state_t* const state = XXH64_createState();
+        if (state == nullptr)
+            h::common::print_message_and_exit("Could not initialize xxhash state!");
+
+        XXH64_hash_t const seed = 0;
+        if (XXH64_reset(state, seed) == XXH_ERROR)
+            h::common::print_message_and_exit("Could not reset xxhash state!");
+
+        for (std::pair<std::string_view, std::uint64_t> const& pair : sorted_declaration_hashes)
+        {
+            update_hash(state, pair.first);
+            update_hash(state, &pair.second, sizeof(pair.second));
+        }
+
+        // Dependents inline the values of global variables and instantiate function and type constructors,
+        // so their contents are part of the interface too:
+        for (Global_variable_declaration const& declaration : core_module.export_declarations.global_variable_declarations)
+        {
+            update_hash(state, declaration.name);
+            if (declaration.type.has_value())
+                update_hash(state, declaration.type.value());
+            update_hash(state, declaration.initial_value);
+            update_hash(state, &declaration.is_mutable, sizeof(declaration.is_mutable));
+        }
+
+        for (Function_constructor const& constructor : core_module.export_declarations.function_constructors)
+        {
+            update_hash(state, constructor.name);
+            for (Function_constructor_parameter const& parameter : constructor.parameters)
+            {
+                update_hash(state, parameter.name);
+                update_hash(state, parameter.type);
+            }
+            for (Statement const& statement : constructor.statements)
+                update_hash(state, statement);
+        }
+
+        for (Type_constructor const& constructor : core_module.export_declarations.type_constructors)
+        {
+            update_hash(state, constructor.name);
+            for (Type_constructor_parameter const& parameter : constructor.parameters)
+            {
+                update_hash(state, parameter.name);
+                update_hash(state, parameter.type);
+            }
+            for (Statement const& statement : constructor.statements)
+                update_hash(state, statement);
+        }
+
+        XXH64_hash_t const hash = XXH64_digest(state);
+        XXH64_freeState(state);
+
+        return hash;
+    }
 }
@@ -112,6 +112,16 @@ namespace h
         h::Function_declaration const& declaration
     );
 
+    export XXH64_hash_t hash_global_variable_declaration(
+        XXH64_state_t* const state,
+        h::Global_variable_declaration const& declaration
+    );
+
+    export XXH64_hash_t hash_function_definition(
+        XXH64_state_t* const state,
+        h::Function_definition const& definition
+    );
+
     export XXH64_hash_t hash_type_instance(
         XXH64_state_t* const state,
         h::Type_instance const& type_instance
@@ -129,6 +139,11 @@ namespace h
         std::pmr::polymorphic_allocator<> const& output_allocator
     );
 
+    // Hash of everything that dependents of core_module can observe. Function bodies are not part of it.
+    export XXH64_hash_t hash_module_interface(
+        h::Module const& core_module
+    );
+
     export struct Type_instance_hash
     {
         using is_transparent = void;
@@ -1,7 +1,9 @@
 module;
 
+#include <algorithm>
 #include <cstdint>
 #include <format>
+#include <numeric>
 #include <ostream>
 #include <vector>
 
@@ -54,4 +56,122 @@ namespace h
 
         return output_stream;
     }
+
+    export struct Struct_layout_hole
+    {
+        std::uint64_t offset = 0;
+        std::uint64_t size = 0;
+
+        friend auto operator<=>(Struct_layout_hole const&, Struct_layout_hole const&) = default;
+    };
+
+    export struct Struct_layout_analysis
+    {
+        std::pmr::vector<Struct_layout_hole> holes;
+        std::uint64_t tail_padding = 0;
+        std::uint64_t padding = 0;
+        std::uint64_t cache_line_size = 0;
+        std::uint64_t cache_line_count = 0;
+        std::pmr::vector<std::uint64_t> member_cache_lines;
+        std::pmr::vector<bool> member_crosses_cache_line;
+
+        friend auto operator<=>(Struct_layout_analysis const&, Struct_layout_analysis const&) = default;
+    };
+
+    export Struct_layout_analysis analyze_struct_layout(
+        Struct_layout const& struct_layout,
+        std::uint64_t const cache_line_size
+    )
+    {
+        Struct_layout_analysis analysis
+        {
+            .cache_line_size = cache_line_size,
+            .cache_line_count = (struct_layout.size + cache_line_size - 1) / cache_line_size,
+        };
+
+        std::pmr::vector<std::size_t> member_indices;
+        member_indices.resize(struct_layout.members.size());
+        std::iota(member_indices.begin(), member_indices.end(), std::size_t{0});
+        std::stable_sort(
+            member_indices.begin(),
+            member_indices.end(),
+            [&](std::size_t const lhs, std::size_t const rhs) -> bool { return struct_layout.members[lhs].offset < struct_layout.members[rhs].offset; }
+        );
+
+        // Bit fields share storage, so members may overlap:
+        std::uint64_t end_of_previous_members = 0;
+        for (std::size_t const member_index : member_indices)
+        {
+            Struct_member_layout const& member = struct_layout.members[member_index];
+            if (member.offset > end_of_previous_members)
+                analysis.holes.push_back({ .offset = end_of_previous_members, .size = member.offset - end_of_previous_members });
+
+            end_of_previous_members = std::max(end_of_previous_members, member.offset + member.size);
+        }
+
+        if (struct_layout.size > end_of_previous_members)
+            analysis.tail_padding = struct_layout.size - end_of_previous_members;
+
+        analysis.padding = analysis.tail_padding;
+        for (Struct_layout_hole const& hole : analysis.holes)
+            analysis.padding += hole.size;
+
+        analysis.member_cache_lines.reserve(struct_layout.members.size());
+        analysis.member_crosses_cache_line.reserve(struct_layout.members.size());
+        for (Struct_member_layout const& member : struct_layout.members)
+        {
+            std::uint64_t const first_cache_line = member.offset / cache_line_size;
+            std::uint64_t const last_cache_line = member.size > 0 ? (member.offset + member.size - 1) / cache_line_size : first_cache_line;
+
+            analysis.member_cache_lines.push_back(first_cache_line);
+            analysis.member_crosses_cache_line.push_back(first_cache_line != last_cache_line);
+        }
+
+        return analysis;
+    }
+
+    export void write_struct_layout_report(
+        std::ostream& output_stream,
+        Struct_layout const& struct_layout,
+        Struct_layout_analysis const& analysis
+    )
+    {
+        output_stream << "{";
+        output_stream << "\"size\":" << struct_layout.size << ",";
+        output_stream << "\"alignment\":" << struct_layout.alignment << ",";
+        output_stream << "\"members\":[";
+
+        for (std::size_t index = 0; index < struct_layout.members.size(); ++index)
+        {
+            Struct_member_layout const& member = struct_layout.members[index];
+            output_stream << std::format(
+                "{{\"offset\":{},\"size\":{},\"alignment\":{},\"cache_line\":{},\"crosses_cache_line\":{}}}",
+                member.offset,
+                member.size,
+                member.alignment,
+                analysis.member_cache_lines[index],
+                analysis.member_crosses_cache_line[index] ? "true" : "false"
+            );
+            if (index + 1 < struct_layout.members.size())
+                output_stream << ',';
+        }
+
+        output_stream << "],";
+        output_stream << "\"holes\":[";
+
+        for (std::size_t index = 0; index < analysis.holes.size(); ++index)
+        {
+            Struct_layout_hole const& hole = analysis.holes[index];
+            output_stream << std::format("{{\"offset\":{},\"size\":{}}}", hole.offset, hole.size);
+            if (index + 1 < analysis.holes.size())
+                output_stream << ',';
+        }
+
+        output_stream << "],";
+        output_stream << "\"tail_padding\":" << analysis.tail_padding << ",";
+        output_stream << "\"padding\":" << analysis.padding << ",";
+        output_stream << "\"cache_line_size\":" << analysis.cache_line_size << ",";
+        output_stream << "\"cache_line_count\":" << analysis.cache_line_count;
+        output_stream << "}";
+    }
 }
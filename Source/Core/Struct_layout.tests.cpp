@@ -0,0 +1,189 @@
+#include <cstdint>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+import h.core.struct_layout;
+
+namespace h
+{
+    TEST_CASE("Analyze struct layout finds holes between members", "[Struct_layout]")
+    {
+        // struct { char a; int b; char c; double d; }
+        Struct_layout const struct_layout
+        {
+            .size = 24,
+            .alignment = 8,
+            .members =
+            {
+                { .offset = 0, .size = 1, .alignment = 1 },
+                { .offset = 4, .size = 4, .alignment = 4 },
+                { .offset = 8, .size = 1, .alignment = 1 },
+                { .offset = 16, .size = 8, .alignment = 8 },
+            },
+        };
+
+        Struct_layout_analysis const analysis = analyze_struct_layout(struct_layout, 64);
+
+        std::pmr::vector<Struct_layout_hole> const expected_holes
+        {
+            { .offset = 1, .size = 3 },
+            { .offset = 9, .size = 7 },
+        };
+        CHECK(analysis.holes == expected_holes);
+        CHECK(analysis.tail_padding == 0);
+        CHECK(analysis.padding == 10);
+        CHECK(analysis.cache_line_count == 1);
+    }
+
+    TEST_CASE("Analyze struct layout finds tail padding", "[Struct_layout]")
+    {
+        // struct { int a; char b; }
+        Struct_layout const struct_layout
+        {
+            .size = 8,
+            .alignment = 4,
+            .members =
+            {
+                { .offset = 0, .size = 4, .alignment = 4 },
+                { .offset = 4, .size = 1, .alignment = 1 },
+            },
+        };
+
+        Struct_layout_analysis const analysis = analyze_struct_layout(struct_layout, 64);
+
+        CHECK(analysis.holes.empty());
+        CHECK(analysis.tail_padding == 3);
+        CHECK(analysis.padding == 3);
+    }
+
+    TEST_CASE("Analyze struct layout of a packed struct has no padding", "[Struct_layout]")
+    {
+        // struct __attribute__((packed)) { char a; int b; char c; }
+        Struct_layout const struct_layout
+        {
+            .size = 6,
+            .alignment = 1,
+            .members =
+            {
+                { .offset = 0, .size = 1, .alignment = 1 },
+                { .offset = 1, .size = 4, .alignment = 1 },
+                { .offset = 5, .size = 1, .alignment = 1 },
+            },
+        };
+
+        Struct_layout_analysis const analysis = analyze_struct_layout(struct_layout, 64);
+
+        CHECK(analysis.holes.empty());
+        CHECK(analysis.tail_padding == 0);
+        CHECK(analysis.padding == 0);
+    }
+
+    TEST_CASE("Analyze struct layout with an explicit member alignment", "[Struct_layout]")
+    {
+        // struct { char a; _Alignas(16) int b; }
+        Struct_layout const struct_layout
+        {
+            .size = 32,
+            .alignment = 16,
+            .members =
+            {
+                { .offset = 0, .size = 1, .alignment = 1 },
+                { .offset = 16, .size = 4, .alignment = 16 },
+            },
+        };
+
+        Struct_layout_analysis const analysis = analyze_struct_layout(struct_layout, 64);
+
+        std::pmr::vector<Struct_layout_hole> const expected_holes
+        {
+            { .offset = 1, .size = 15 },
+        };
+        CHECK(analysis.holes == expected_holes);
+        CHECK(analysis.tail_padding == 12);
+        CHECK(analysis.padding == 27);
+    }
+
+    TEST_CASE("Analyze struct layout ignores bit fields sharing storage", "[Struct_layout]")
+    {
+        // struct { int a : 3; int b : 5; short c; }
+        Struct_layout const struct_layout
+        {
+            .size = 8,
+            .alignment = 4,
+            .members =
+            {
+                { .offset = 0, .size = 4, .alignment = 4 },
+                { .offset = 0, .size = 4, .alignment = 4 },
+                { .offset = 4, .size = 2, .alignment = 2 },
+            },
+        };
+
+        Struct_layout_analysis const analysis = analyze_struct_layout(struct_layout, 64);
+
+        CHECK(analysis.holes.empty());
+        CHECK(analysis.tail_padding == 2);
+        CHECK(analysis.padding == 2);
+    }
+
+    TEST_CASE("Analyze struct layout finds members crossing cache lines", "[Struct_layout]")
+    {
+        // struct __attribute__((packed)) { char a[60]; long long b; char c[60]; int d; }
+        Struct_layout const struct_layout
+        {
+            .size = 132,
+            .alignment = 1,
+            .members =
+            {
+                { .offset = 0, .size = 60, .alignment = 1 },
+                { .offset = 60, .size = 8, .alignment = 1 },
+                { .offset = 68, .size = 60, .alignment = 1 },
+                { .offset = 128, .size = 4, .alignment = 1 },
+            },
+        };
+
+        Struct_layout_analysis const analysis = analyze_struct_layout(struct_layout, 64);
+
+        CHECK(analysis.cache_line_size == 64);
+        CHECK(analysis.cache_line_count == 3);
+
+        std::pmr::vector<std::uint64_t> const expected_member_cache_lines{ 0, 0, 1, 2 };
+        CHECK(analysis.member_cache_lines == expected_member_cache_lines);
+
+        std::pmr::vector<bool> const expected_member_crosses_cache_line{ false, true, false, false };
+        CHECK(analysis.member_crosses_cache_line == expected_member_crosses_cache_line);
+    }
+
+    TEST_CASE("Write struct layout report", "[Struct_layout]")
+    {
+        // struct { char a; int b; char c; }
+        Struct_layout const struct_layout
+        {
+            .size = 12,
+            .alignment = 4,
+            .members =
+            {
+                { .offset = 0, .size = 1, .alignment = 1 },
+                { .offset = 4, .size = 4, .alignment = 4 },
+                { .offset = 8, .size = 1, .alignment = 1 },
+            },
+        };
+
+        Struct_layout_analysis const analysis = analyze_struct_layout(struct_layout, 8);
+
+        std::stringstream output_stream;
+        write_struct_layout_report(output_stream, struct_layout, analysis);
+
+        std::string const expected_report =
+            "{\"size\":12,\"alignment\":4,\"members\":["
+            "{\"offset\":0,\"size\":1,\"alignment\":1,\"cache_line\":0,\"crosses_cache_line\":false},"
+            "{\"offset\":4,\"size\":4,\"alignment\":4,\"cache_line\":0,\"crosses_cache_line\":false},"
+            "{\"offset\":8,\"size\":1,\"alignment\":1,\"cache_line\":1,\"crosses_cache_line\":false}"
+            "],\"holes\":[{\"offset\":1,\"size\":3}],"
+            "\"tail_padding\":3,\"padding\":6,\"cache_line_size\":8,\"cache_line_count\":2}";
+        CHECK(output_stream.str() == expected_report);
+    }
+}
@@ -504,6 +504,28 @@ namespace h
         return false;
     }
 
+    Type_reference create_vector_type_reference(std::pmr::vector<Type_reference> element_type, std::uint64_t size)
+    {
+        return Type_reference
+        {
+            .data = Vector_type
+            {
+                .element_type = std::move(element_type),
+                .size = size,
+            }
+        };
+    }
+
+    std::uint64_t get_vector_type_size(Type_reference const& type_reference)
+    {
+        return std::get<Vector_type>(type_reference.data).size;
+    }
+
+    bool is_vector_type_reference(Type_reference const& type)
+    {
+        return std::holds_alternative<Vector_type>(type.data);
+    }
+
     std::optional<Type_reference> get_element_or_pointee_type(Type_reference const& type)
     {
         if (std::holds_alternative<Array_slice_type>(type.data))
@@ -530,6 +552,14 @@ namespace h
 
             return pointer_type.element_type.front();
         }
+        else if (std::holds_alternative<Vector_type>(type.data))
+        {
+            Vector_type const& vector_type = std::get<Vector_type>(type.data);
+            if (vector_type.element_type.empty())
+                return std::nullopt;
+
+            return vector_type.element_type.front();
+        }
 
         return std::nullopt;
     }
@@ -63,6 +63,10 @@ namespace h
     export bool is_pointer(Type_reference const& type);
     export bool is_non_void_pointer(Type_reference const& type);
 
+    export Type_reference create_vector_type_reference(std::pmr::vector<Type_reference> element_type, std::uint64_t size);
+    export std::uint64_t get_vector_type_size(Type_reference const& type_reference);
+    export bool is_vector_type_reference(Type_reference const& type);
+
     export std::optional<Type_reference> get_element_or_pointee_type(Type_reference const& type);
 
     export std::optional<std::string_view> get_type_module_name(Type_reference const& type);
@@ -202,6 +206,17 @@ namespace h
 
             return visit_type_references_recursively(data.arguments, predicate);
         }
+        else if (std::holds_alternative<Vector_type>(type_reference.data))
+        {
+            Vector_type const& data = std::get<Vector_type>(type_reference.data);
+            for (Type_reference const& nested_type_reference : data.element_type)
+            {
+                if (visit_type_references_recursively(nested_type_reference, predicate))
+                    return true;
+            }
+
+            return false;
+        }
         else
         {
             throw std::runtime_error{"visit_type_references_recursively: Did not handle type!"};
@@ -1,5 +1,6 @@
 module;
 
+#include <cstdint>
 #include <filesystem>
 #include <functional>
 #include <memory_resource>
@@ -63,6 +64,12 @@ namespace h::c
             if (!constant_array_type.value_type.empty())
                 add_type_reference_declaration(sorted_declarations, core_module, constant_array_type.value_type[0]);
         }
+        else if (std::holds_alternative<h::Vector_type>(type_reference.data))
+        {
+            h::Vector_type const& vector_type = std::get<h::Vector_type>(type_reference.data);
+            if (!vector_type.element_type.empty())
+                add_type_reference_declaration(sorted_declarations, core_module, vector_type.element_type[0]);
+        }
         else if (std::holds_alternative<h::Custom_type_reference>(type_reference.data))
         {
             h::Custom_type_reference const& custom_type_reference = std::get<h::Custom_type_reference>(type_reference.data);
@@ -600,6 +607,15 @@ namespace h::c
             h::Type_instance const& data = std::get<h::Type_instance>(type_reference.data);
             // TODO
         }
+        else if (std::holds_alternative<h::Vector_type>(type_reference.data))
+        {
+            h::Vector_type const& data = std::get<h::Vector_type>(type_reference.data);
+            write_c_type_name(stream, declaration_database, data.element_type, std::nullopt);
+            stream << " __attribute__((ext_vector_type(" << data.size << ")))";
+
+            if (variable_name.has_value())
+                stream << ' ' << variable_name.value();
+        }
 
         // TODO
     }
@@ -637,10 +653,20 @@ namespace h::c
         std::string_view const declaration_name,
         std::optional<std::pmr::string> const unique_name,
         std::span<std::pmr::string const> const member_names,
-        std::span<h::Type_reference const> const member_types
+        std::span<h::Type_reference const> const member_types,
+        std::span<std::optional<std::uint32_t> const> const member_alignments,
+        bool const is_packed,
+        std::optional<std::uint32_t> const alignment
     )
     {
+        // C11 can only align objects and members, so the alignment of the type itself needs the attribute:
         stream << declaration_type << " ";
+        if (is_packed && alignment.has_value())
+            stream << "__attribute__((packed, aligned(" << alignment.value() << "))) ";
+        else if (is_packed)
+            stream << "__attribute__((packed)) ";
+        else if (alignment.has_value())
+            stream << "__attribute__((aligned(" << alignment.value() << "))) ";
         write_c_declaration_name(stream, core_module_name, declaration_name, unique_name);
         stream << "\n{\n";
         
@@ -649,6 +675,8 @@ namespace h::c
             h::Type_reference const& member_type = member_types[member_index];
 
             stream << "    ";
+            if (member_index < member_alignments.size() && member_alignments[member_index].has_value())
+                stream << "_Alignas(" << member_alignments[member_index].value() << ") ";
             write_c_type_name(stream, declaration_database, member_type, member_names[member_index]);
             stream << ";\n";
         }
@@ -681,7 +709,10 @@ namespace h::c
                 struct_declaration.name,
                 struct_declaration.unique_name,
                 struct_declaration.member_names,
-                struct_declaration.member_types
+                struct_declaration.member_types,
+                struct_declaration.member_alignments,
+                struct_declaration.is_packed,
+                struct_declaration.alignment
             );
         }
         else if (std::holds_alternative<h::Union_declaration const*>(declaration.data))
@@ -695,11 +726,55 @@ namespace h::c
                 union_declaration.name,
                 union_declaration.unique_name,
                 union_declaration.member_names,
-                union_declaration.member_types
+                union_declaration.member_types,
+                {},
+                false,
+                std::nullopt
             );
         }
     }
 
+    static void write_c_function_attributes(
+        String_stream& stream,
+        h::Function_declaration const& declaration
+    )
+    {
+        for (h::Function_attribute const attribute : declaration.attributes)
+        {
+            switch (attribute)
+            {
+            case h::Function_attribute::Cold:
+                stream << "__attribute__((cold)) ";
+                break;
+            case h::Function_attribute::Const:
+                stream << "__attribute__((const)) ";
+                break;
+            case h::Function_attribute::Hot:
+                stream << "__attribute__((hot)) ";
+                break;
+            case h::Function_attribute::Pure:
+                stream << "__attribute__((pure)) ";
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    static bool is_no_alias_parameter(
+        h::Function_declaration const& declaration,
+        std::string_view const parameter_name
+    )
+    {
+        for (h::Named_parameter_attribute const& parameter_attribute : declaration.parameter_attributes)
+        {
+            if (parameter_attribute.parameter_name == parameter_name && parameter_attribute.attribute == h::Parameter_attribute::No_alias)
+                return true;
+        }
+
+        return false;
+    }
+
     void write_c_function_declaration(
         String_stream& stream,
         h::Declaration_database const declaration_database,
@@ -707,6 +782,8 @@ namespace h::c
         h::Function_declaration const& declaration
     )
     {
+        write_c_function_attributes(stream, declaration);
+
         write_c_type_name(stream, declaration_database, declaration.type.output_parameter_types, std::nullopt);
 
         stream << " ";
@@ -715,7 +792,20 @@ namespace h::c
         stream << '(';
         for (std::size_t index = 0; index < declaration.input_parameter_names.size(); ++index)
         {
-            write_c_type_name(stream, declaration_database, declaration.type.input_parameter_types[index], declaration.input_parameter_names[index]);
+            std::string_view const input_parameter_name = declaration.input_parameter_names[index];
+            h::Type_reference const& input_parameter_type = declaration.type.input_parameter_types[index];
+
+            // __restrict is accepted by both C and C++ compilers, unlike restrict:
+            if (is_pointer(input_parameter_type) && is_no_alias_parameter(declaration, input_parameter_name))
+            {
+                write_c_type_name(stream, declaration_database, input_parameter_type, std::nullopt);
+                stream << " __restrict " << input_parameter_name;
+            }
+            else
+            {
+                write_c_type_name(stream, declaration_database, input_parameter_type, input_parameter_name);
+            }
+
             if (index + 1 < declaration.input_parameter_names.size())
                 stream << ", ";
         }
@@ -909,6 +999,15 @@ namespace h::c
             h::Type_instance const& data = std::get<h::Type_instance>(type_reference.data);
             // TODO
         }
+        else if (std::holds_alternative<h::Vector_type>(type_reference.data))
+        {
+            h::Vector_type const& data = std::get<h::Vector_type>(type_reference.data);
+            write_cpp_type(stream, data.element_type, std::nullopt);
+            stream << " __attribute__((ext_vector_type(" << data.size << ")))";
+
+            if (variable_name.has_value())
+                stream << ' ' << variable_name.value();
+        }
 
         // TODO
     }
@@ -156,6 +156,54 @@ namespace my::namespace
         test_cpp_exporter(input, "input.h", cpp_expected);
     }
 
+    TEST_CASE("Export struct packing and alignment")
+    {
+        std::string_view const input = R"RAW(module my.namespace;
+@packed()
+export struct My_packed
+{
+    a: Int8 = 0i8;
+    b: Int32 = 0;
+}
+
+@align(64)
+@align(b, 16)
+export struct My_aligned
+{
+    a: Int32 = 0;
+    b: Int32 = 0;
+}
+)RAW";
+
+        std::string_view const expected = R"RAW(
+struct __attribute__((packed)) my_namespace_My_packed
+{
+    int8_t a;
+    int32_t b;
+};
+
+struct Array_slice_my_namespace_My_packed
+{
+    struct my_namespace_My_packed* data;
+    uint64_t size;
+};
+
+struct __attribute__((aligned(64))) my_namespace_My_aligned
+{
+    int32_t a;
+    _Alignas(16) int32_t b;
+};
+
+struct Array_slice_my_namespace_My_aligned
+{
+    struct my_namespace_My_aligned* data;
+    uint64_t size;
+};
+)RAW";
+
+        test_c_exporter(input, {}, {}, expected);
+    }
+
     TEST_CASE("Export functions")
     {
         std::string_view const input = R"RAW(module my.namespace;
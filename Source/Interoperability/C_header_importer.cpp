@@ -2,6 +2,7 @@ module;
 
 #include <algorithm>
 #include <cassert>
+#include <charconv>
 #include <cstdio>
 #include <filesystem>
 #include <format>
@@ -538,6 +539,32 @@ namespace h::c
                 .data = std::move(reference)
             };
         }
+        case CXType_Vector:
+        case CXType_ExtVector:
+        {
+            CXType const element_type = clang_getElementType(type);
+            long long const size = clang_getNumElements(type);
+
+            std::optional<h::Type_reference> element_type_reference = create_type_reference(declarations, cursor, element_type);
+
+            if (!element_type_reference.has_value())
+            {
+                std::string const message = "Element type of a vector cannot be void!";
+                std::cerr << message << '\n';
+                throw std::runtime_error{ message };
+            }
+
+            h::Vector_type reference
+            {
+                .element_type = {std::move(*element_type_reference)},
+                .size = static_cast<std::uint64_t>(size)
+            };
+
+            return h::Type_reference
+            {
+                .data = std::move(reference)
+            };
+        }
         case CXType_Float128:
         {
             std::cerr << "Warning: ignoring Float128 type\n";
@@ -702,6 +729,59 @@ namespace h::c
         return parameter_names;
     }
 
+    std::pmr::vector<h::Named_parameter_attribute> create_input_parameter_attributes(CXCursor const cursor)
+    {
+        int const number_of_arguments = clang_Cursor_getNumArguments(cursor);
+
+        std::pmr::vector<h::Named_parameter_attribute> parameter_attributes;
+
+        for (int argument_index = 0; argument_index < number_of_arguments; ++argument_index)
+        {
+            CXCursor const argument_cursor = clang_Cursor_getArgument(cursor, argument_index);
+            CXType const argument_type = clang_getCursorType(argument_cursor);
+            String const argument_name = { clang_getCursorSpelling(argument_cursor) };
+
+            if (clang_isRestrictQualifiedType(argument_type) != 0 && !argument_name.string_view().empty())
+            {
+                parameter_attributes.push_back(
+                    h::Named_parameter_attribute
+                    {
+                        .parameter_name = std::pmr::string{ argument_name.string_view() },
+                        .attribute = h::Parameter_attribute::No_alias,
+                    }
+                );
+            }
+        }
+
+        return parameter_attributes;
+    }
+
+    std::pmr::vector<h::Function_attribute> create_function_attributes(CXCursor const cursor)
+    {
+        auto const visitor = [](CXCursor current_cursor, CXCursor parent, CXClientData client_data) -> CXChildVisitResult
+        {
+            std::pmr::vector<h::Function_attribute>* const attributes = reinterpret_cast<std::pmr::vector<h::Function_attribute>*>(client_data);
+
+            CXCursorKind const cursor_kind = clang_getCursorKind(current_cursor);
+            if (cursor_kind == CXCursor_PureAttr)
+                attributes->push_back(h::Function_attribute::Pure);
+            else if (cursor_kind == CXCursor_ConstAttr)
+                attributes->push_back(h::Function_attribute::Const);
+
+            return CXChildVisit_Continue;
+        };
+
+        std::pmr::vector<h::Function_attribute> attributes;
+
+        clang_visitChildren(
+            cursor,
+            visitor,
+            &attributes
+        );
+
+        return attributes;
+    }
+
     std::pmr::vector<std::pmr::string> create_output_parameter_names(std::size_t const number_of_outputs)
     {
         if (number_of_outputs == 0)
@@ -1025,6 +1105,9 @@ namespace h::c
 
         std::optional<std::pmr::string> comment = create_function_comment(cursor);
 
+        std::pmr::vector<h::Function_attribute> attributes = create_function_attributes(cursor);
+        std::pmr::vector<h::Named_parameter_attribute> parameter_attributes = create_input_parameter_attributes(cursor);
+
         return h::Function_declaration
         {
             .name = std::pmr::string{function_name},
@@ -1033,6 +1116,8 @@ namespace h::c
             .input_parameter_names = std::move(input_parameter_names),
             .output_parameter_names = std::move(output_parameter_names),
             .linkage = h::Linkage::External,
+            .attributes = std::move(attributes),
+            .parameter_attributes = std::move(parameter_attributes),
             .comment = std::move(comment),
             .source_location = cursor_location.source_location,
             .input_parameter_source_positions = std::move(input_parameter_source_positions),
@@ -1293,6 +1378,64 @@ namespace h::c
 
     h::Union_declaration create_union_declaration(C_declarations& declarations, CXCursor const cursor);
 
+    static std::optional<std::uint32_t> get_aligned_attribute_value(CXCursor const attribute_cursor)
+    {
+        CXTranslationUnit const translation_unit = clang_Cursor_getTranslationUnit(attribute_cursor);
+
+        CXToken* tokens = nullptr;
+        unsigned number_of_tokens = 0;
+        clang_tokenize(translation_unit, clang_getCursorExtent(attribute_cursor), &tokens, &number_of_tokens);
+
+        std::optional<std::uint32_t> alignment = std::nullopt;
+
+        for (unsigned token_index = 0; token_index < number_of_tokens; ++token_index)
+        {
+            if (clang_getTokenKind(tokens[token_index]) != CXToken_Literal)
+                continue;
+
+            String const token_spelling = { clang_getTokenSpelling(translation_unit, tokens[token_index]) };
+            std::string_view const value = token_spelling.string_view();
+
+            std::uint32_t parsed_value = 0;
+            std::from_chars_result const result = std::from_chars(value.data(), value.data() + value.size(), parsed_value);
+            if (result.ec == std::errc{})
+                alignment = parsed_value;
+
+            break;
+        }
+
+        clang_disposeTokens(translation_unit, tokens, number_of_tokens);
+
+        return alignment;
+    }
+
+    static std::optional<std::uint32_t> get_field_alignment(CXCursor const field_cursor)
+    {
+        auto const visitor = [](CXCursor current_cursor, CXCursor parent, CXClientData client_data) -> CXChildVisitResult
+        {
+            std::optional<std::uint32_t>* const alignment = reinterpret_cast<std::optional<std::uint32_t>*>(client_data);
+
+            if (clang_getCursorKind(current_cursor) == CXCursor_AlignedAttr)
+            {
+                std::optional<std::uint32_t> const value = get_aligned_attribute_value(current_cursor);
+                if (value.has_value())
+                    *alignment = std::max(alignment->value_or(0), value.value());
+            }
+
+            return CXChildVisit_Continue;
+        };
+
+        std::optional<std::uint32_t> alignment = std::nullopt;
+
+        clang_visitChildren(
+            field_cursor,
+            visitor,
+            &alignment
+        );
+
+        return alignment;
+    }
+
     h::Struct_declaration create_struct_declaration(C_declarations& declarations, CXCursor const cursor)
     {
         struct Client_data
@@ -1329,6 +1472,7 @@ namespace h::c
                     data->struct_declaration->member_names.push_back(std::pmr::string{ member_name });
                     data->struct_declaration->member_types.push_back(std::move(member_type_reference.value()));
                     data->struct_declaration->member_bit_fields.push_back(bit_field_width);
+                    data->struct_declaration->member_alignments.push_back(get_field_alignment(current_cursor));
                 }
                 else
                 {
@@ -1342,6 +1486,7 @@ namespace h::c
                     data->struct_declaration->member_names.push_back(std::pmr::string{ member_name });
                     data->struct_declaration->member_types.push_back(std::move(*member_type_reference));
                     data->struct_declaration->member_bit_fields.push_back(std::nullopt);
+                    data->struct_declaration->member_alignments.push_back(get_field_alignment(current_cursor));
                 }
 
                 {
@@ -1374,6 +1519,7 @@ namespace h::c
                 };
                 data->struct_declaration->member_types.push_back({ .data = std::move(reference) });
                 data->struct_declaration->member_bit_fields.push_back(std::nullopt);
+                data->struct_declaration->member_alignments.push_back(std::nullopt);
 
                 data->declarations->struct_declarations.push_back(std::move(nested_struct_declaration));
             }
@@ -1397,9 +1543,20 @@ namespace h::c
                 };
                 data->struct_declaration->member_types.push_back({ .data = std::move(reference) });
                 data->struct_declaration->member_bit_fields.push_back(std::nullopt);
+                data->struct_declaration->member_alignments.push_back(std::nullopt);
     
                 data->declarations->union_declarations.push_back(std::move(nested_union_declaration));
             }
+            else if (cursor_kind == CXCursor_PackedAttr)
+            {
+                data->struct_declaration->is_packed = true;
+            }
+            else if (cursor_kind == CXCursor_AlignedAttr)
+            {
+                long long const struct_alignment = clang_Type_getAlignOf(clang_getCursorType(parent));
+                if (struct_alignment > 0)
+                    data->struct_declaration->alignment = static_cast<std::uint32_t>(struct_alignment);
+            }
 
             return CXChildVisit_Continue;
         };
@@ -1415,8 +1572,10 @@ namespace h::c
             .member_types = {},
             .member_names = {},
             .member_bit_fields = {},
+            .member_alignments = {},
             .member_default_values = {},
             .is_packed = false,
+            .alignment = std::nullopt,
             .is_literal = false,
             .source_location = cursor_location.source_location,
             .member_source_positions = std::pmr::vector<h::Source_position>{}
@@ -1436,6 +1595,7 @@ namespace h::c
 
         assert(struct_declaration.member_names.size() == struct_declaration.member_types.size());
         assert(struct_declaration.member_names.size() == struct_declaration.member_bit_fields.size());
+        assert(struct_declaration.member_names.size() == struct_declaration.member_alignments.size());
 
         return struct_declaration;
     }
@@ -1727,6 +1887,20 @@ namespace h::c
         {
             h::Pointer_type& data = std::get<h::Pointer_type>(type.data);
 
+            for (h::Type_reference& reference : data.element_type)
+            {
+                convert_typedef_to_integer_type_if_necessary(
+                    reference,
+                    alias_type_declarations,
+                    integer_alias_names,
+                    integer_alias_indices
+                );
+            }
+        }
+        else if (std::holds_alternative<h::Vector_type>(type.data))
+        {
+            h::Vector_type& data = std::get<h::Vector_type>(type.data);
+
             for (h::Type_reference& reference : data.element_type)
             {
                 convert_typedef_to_integer_type_if_necessary(
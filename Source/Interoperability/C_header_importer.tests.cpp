@@ -1468,6 +1468,57 @@ struct My_data
         }
     }
 
+    TEST_CASE("Handles struct packing and alignment")
+    {
+        std::filesystem::path const root_directory_path = std::filesystem::temp_directory_path() / "c_header_importer" / "struct_alignment";
+        std::filesystem::create_directories(root_directory_path);
+
+        std::string const header_content = R"(
+struct __attribute__((packed)) My_packed_data
+{
+    char a;
+    int b;
+};
+
+struct __attribute__((aligned(64))) My_aligned_data
+{
+    int a;
+    _Alignas(16) int b;
+};
+)";
+
+        std::filesystem::path const header_file_path = root_directory_path / "My_data.h";
+        h::common::write_to_file(header_file_path, header_content);
+
+        std::optional<h::Module> const header_module_optional = h::c::import_header("c.My_data", header_file_path, {});
+        REQUIRE(header_module_optional.has_value());
+        h::Module const& header_module = header_module_optional.value();
+
+        REQUIRE(header_module.export_declarations.struct_declarations.size() == 2);
+
+        {
+            h::Struct_declaration const& declaration = header_module.export_declarations.struct_declarations[0];
+            CHECK(declaration.name == "My_packed_data");
+            CHECK(declaration.is_packed == true);
+            CHECK(declaration.alignment.has_value() == false);
+
+            REQUIRE(declaration.member_alignments.size() == 2);
+            CHECK(declaration.member_alignments[0].has_value() == false);
+            CHECK(declaration.member_alignments[1].has_value() == false);
+        }
+
+        {
+            h::Struct_declaration const& declaration = header_module.export_declarations.struct_declarations[1];
+            CHECK(declaration.name == "My_aligned_data");
+            CHECK(declaration.is_packed == false);
+            CHECK(declaration.alignment == 64);
+
+            REQUIRE(declaration.member_alignments.size() == 2);
+            CHECK(declaration.member_alignments[0].has_value() == false);
+            CHECK(declaration.member_alignments[1] == 16);
+        }
+    }
+
 
     TEST_CASE("Handles opaque handles")
     {
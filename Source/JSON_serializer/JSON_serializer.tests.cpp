@@ -817,7 +817,7 @@ namespace h
     {
         h::Function_declaration const input = {};
 
-        std::string const expected = "{\"name\":\"\",\"type\":{\"input_parameter_types\":{\"size\":0,\"elements\":[]},\"output_parameter_types\":{\"size\":0,\"elements\":[]},\"is_variadic\":false},\"input_parameter_names\":{\"size\":0,\"elements\":[]},\"output_parameter_names\":{\"size\":0,\"elements\":[]},\"linkage\":\"External\",\"preconditions\":{\"size\":0,\"elements\":[]},\"postconditions\":{\"size\":0,\"elements\":[]}}";
+        std::string const expected = "{\"name\":\"\",\"type\":{\"input_parameter_types\":{\"size\":0,\"elements\":[]},\"output_parameter_types\":{\"size\":0,\"elements\":[]},\"is_variadic\":false},\"input_parameter_names\":{\"size\":0,\"elements\":[]},\"output_parameter_names\":{\"size\":0,\"elements\":[]},\"linkage\":\"External\",\"attributes\":{\"size\":0,\"elements\":[]},\"parameter_attributes\":{\"size\":0,\"elements\":[]},\"preconditions\":{\"size\":0,\"elements\":[]},\"postconditions\":{\"size\":0,\"elements\":[]}}";
 
         rapidjson::StringBuffer output_stream;
         rapidjson::Writer<rapidjson::StringBuffer> writer{ output_stream };
@@ -1397,7 +1397,7 @@ namespace h
     {
         h::Struct_declaration const input = create_expected_struct_declaration();
 
-        std::string const expected = R"({"name":"My_struct","member_types":{"size":3,"elements":[{"data":{"type":"Integer_type","value":{"number_of_bits":32,"is_signed":false}}},{"data":{"type":"Integer_type","value":{"number_of_bits":32,"is_signed":false}}},{"data":{"type":"Integer_type","value":{"number_of_bits":32,"is_signed":false}}}]},"member_names":{"size":3,"elements":["first","second","third"]},"member_bit_fields":{"size":3,"elements":[24,8,null]},"member_default_values":{"size":3,"elements":[{"expressions":{"size":1,"elements":[{"data":{"type":"Constant_expression","value":{"type":{"data":{"type":"Integer_type","value":{"number_of_bits":32,"is_signed":false}}},"data":"0"}}}]}},{"expressions":{"size":1,"elements":[{"data":{"type":"Constant_expression","value":{"type":{"data":{"type":"Integer_type","value":{"number_of_bits":32,"is_signed":false}}},"data":"0"}}}]}},{"expressions":{"size":1,"elements":[{"data":{"type":"Constant_expression","value":{"type":{"data":{"type":"Integer_type","value":{"number_of_bits":32,"is_signed":false}}},"data":"0"}}}]}}]},"is_packed":false,"is_literal":false,"member_comments":{"size":0,"elements":[]}})";
+        std::string const expected = R"({"name":"My_struct","member_types":{"size":3,"elements":[{"data":{"type":"Integer_type","value":{"number_of_bits":32,"is_signed":false}}},{"data":{"type":"Integer_type","value":{"number_of_bits":32,"is_signed":false}}},{"data":{"type":"Integer_type","value":{"number_of_bits":32,"is_signed":false}}}]},"member_names":{"size":3,"elements":["first","second","third"]},"member_bit_fields":{"size":3,"elements":[24,8,null]},"member_alignments":{"size":0,"elements":[]},"member_default_values":{"size":3,"elements":[{"expressions":{"size":1,"elements":[{"data":{"type":"Constant_expression","value":{"type":{"data":{"type":"Integer_type","value":{"number_of_bits":32,"is_signed":false}}},"data":"0"}}}]}},{"expressions":{"size":1,"elements":[{"data":{"type":"Constant_expression","value":{"type":{"data":{"type":"Integer_type","value":{"number_of_bits":32,"is_signed":false}}},"data":"0"}}}]}},{"expressions":{"size":1,"elements":[{"data":{"type":"Constant_expression","value":{"type":{"data":{"type":"Integer_type","value":{"number_of_bits":32,"is_signed":false}}},"data":"0"}}}]}}]},"is_packed":false,"is_literal":false,"member_comments":{"size":0,"elements":[]}})";
 
         rapidjson::StringBuffer output_stream;
         rapidjson::Writer<rapidjson::StringBuffer> writer{ output_stream };
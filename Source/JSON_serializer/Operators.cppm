@@ -51,6 +51,40 @@ namespace h::json::operators
         return output_stream;
     }
 
+    export std::istream& operator>>(std::istream& input_stream, Function_attribute& value)
+    {
+        std::pmr::string string;
+        input_stream >> string;
+
+        value = h::json::read_enum<Function_attribute>(string);
+
+        return input_stream;
+    }
+
+    export std::ostream& operator<<(std::ostream& output_stream, Function_attribute const value)
+    {
+        output_stream << h::json::write_enum(value);
+
+        return output_stream;
+    }
+
+    export std::istream& operator>>(std::istream& input_stream, Parameter_attribute& value)
+    {
+        std::pmr::string string;
+        input_stream >> string;
+
+        value = h::json::read_enum<Parameter_attribute>(string);
+
+        return input_stream;
+    }
+
+    export std::ostream& operator<<(std::ostream& output_stream, Parameter_attribute const value)
+    {
+        output_stream << h::json::write_enum(value);
+
+        return output_stream;
+    }
+
     export std::istream& operator>>(std::istream& input_stream, Binary_operation& value)
     {
         std::pmr::string string;
@@ -487,6 +521,29 @@ namespace h::json::operators
         return output_stream;
     }
 
+    export std::istream& operator>>(std::istream& input_stream, Vector_type& value)
+    {
+        rapidjson::Reader reader;
+        rapidjson::IStreamWrapper stream_wrapper{ input_stream };
+        std::optional<Vector_type> const output = h::json::read<Vector_type>(reader, stream_wrapper);
+
+        if (output)
+        {
+            value = std::move(*output);
+        }
+
+        return input_stream;
+    }
+
+    export std::ostream& operator<<(std::ostream& output_stream, Vector_type const& value)
+    {
+        rapidjson::OStreamWrapper stream_wrapper{ output_stream };
+        rapidjson::Writer<rapidjson::OStreamWrapper> writer{ stream_wrapper };
+        h::json::write(writer, value);
+
+        return output_stream;
+    }
+
     export std::istream& operator>>(std::istream& input_stream, Type_reference& value)
     {
         rapidjson::Reader reader;
@@ -740,6 +797,29 @@ namespace h::json::operators
         return output_stream;
     }
 
+    export std::istream& operator>>(std::istream& input_stream, Named_parameter_attribute& value)
+    {
+        rapidjson::Reader reader;
+        rapidjson::IStreamWrapper stream_wrapper{ input_stream };
+        std::optional<Named_parameter_attribute> const output = h::json::read<Named_parameter_attribute>(reader, stream_wrapper);
+
+        if (output)
+        {
+            value = std::move(*output);
+        }
+
+        return input_stream;
+    }
+
+    export std::ostream& operator<<(std::ostream& output_stream, Named_parameter_attribute const& value)
+    {
+        rapidjson::OStreamWrapper stream_wrapper{ output_stream };
+        rapidjson::Writer<rapidjson::OStreamWrapper> writer{ stream_wrapper };
+        h::json::write(writer, value);
+
+        return output_stream;
+    }
+
     export std::istream& operator>>(std::istream& input_stream, Function_declaration& value)
     {
         rapidjson::Reader reader;
@@ -159,6 +159,62 @@ namespace h::json
         return false;
     }
 
+    export template<>
+        bool read_enum(Function_attribute& output, std::string_view const value)
+    {
+        if (value == "Always_inline")
+        {
+            output = Function_attribute::Always_inline;
+            return true;
+        }
+        else if (value == "Cold")
+        {
+            output = Function_attribute::Cold;
+            return true;
+        }
+        else if (value == "Const")
+        {
+            output = Function_attribute::Const;
+            return true;
+        }
+        else if (value == "Hot")
+        {
+            output = Function_attribute::Hot;
+            return true;
+        }
+        else if (value == "Must_tail")
+        {
+            output = Function_attribute::Must_tail;
+            return true;
+        }
+        else if (value == "No_inline")
+        {
+            output = Function_attribute::No_inline;
+            return true;
+        }
+        else if (value == "Pure")
+        {
+            output = Function_attribute::Pure;
+            return true;
+        }
+
+        std::cerr << std::format("Failed to read enum 'Function_attribute' with value '{}'\n", value);
+        return false;
+    }
+
+    export template<>
+        bool read_enum(Parameter_attribute& output, std::string_view const value)
+    {
+        if (value == "No_alias")
+        {
+            output = Parameter_attribute::No_alias;
+            return true;
+        }
+
+        std::cerr << std::format("Failed to read enum 'Parameter_attribute' with value '{}'\n", value);
+        return false;
+    }
+
     export template<>
         bool read_enum(Binary_operation& output, std::string_view const value)
     {
@@ -377,6 +433,20 @@ namespace h::json
             return static_cast<int>(enum_value);
         }
 
+        if (type == "Function_attribute")
+        {
+            Function_attribute enum_value;
+            read_enum(enum_value, value);
+            return static_cast<int>(enum_value);
+        }
+
+        if (type == "Parameter_attribute")
+        {
+            Parameter_attribute enum_value;
+            read_enum(enum_value, value);
+            return static_cast<int>(enum_value);
+        }
+
         if (type == "Binary_operation")
         {
             Binary_operation enum_value;
@@ -450,6 +520,7 @@ namespace h::json
     export std::optional<Stack_state> get_next_state_custom_type_reference(Stack_state* state, std::string_view const key);
     export std::optional<Stack_state> get_next_state_type_instance(Stack_state* state, std::string_view const key);
     export std::optional<Stack_state> get_next_state_parameter_type(Stack_state* state, std::string_view const key);
+    export std::optional<Stack_state> get_next_state_vector_type(Stack_state* state, std::string_view const key);
     export std::optional<Stack_state> get_next_state_type_reference(Stack_state* state, std::string_view const key);
     export std::optional<Stack_state> get_next_state_indexed_comment(Stack_state* state, std::string_view const key);
     export std::optional<Stack_state> get_next_state_statement(Stack_state* state, std::string_view const key);
@@ -461,6 +532,7 @@ namespace h::json
     export std::optional<Stack_state> get_next_state_struct_declaration(Stack_state* state, std::string_view const key);
     export std::optional<Stack_state> get_next_state_union_declaration(Stack_state* state, std::string_view const key);
     export std::optional<Stack_state> get_next_state_function_condition(Stack_state* state, std::string_view const key);
+    export std::optional<Stack_state> get_next_state_named_parameter_attribute(Stack_state* state, std::string_view const key);
     export std::optional<Stack_state> get_next_state_function_declaration(Stack_state* state, std::string_view const key);
     export std::optional<Stack_state> get_next_state_function_definition(Stack_state* state, std::string_view const key);
     export std::optional<Stack_state> get_next_state_variable_expression(Stack_state* state, std::string_view const key);
@@ -1069,6 +1141,49 @@ namespace h::json
         return {};
     }
 
+    export std::optional<Stack_state> get_next_state_vector_type(Stack_state* state, std::string_view const key)
+    {
+        h::Vector_type* parent = static_cast<h::Vector_type*>(state->pointer);
+
+        if (key == "element_type")
+        {
+            auto const set_vector_size = [](Stack_state const* const state, std::size_t const size) -> void
+            {
+                std::pmr::vector<Type_reference>* parent = static_cast<std::pmr::vector<Type_reference>*>(state->pointer);
+                parent->resize(size);
+            };
+
+            auto const get_element = [](Stack_state const* const state, std::size_t const index) -> void*
+            {
+                std::pmr::vector<Type_reference>* parent = static_cast<std::pmr::vector<Type_reference>*>(state->pointer);
+                return &((*parent)[index]);
+            };
+
+            return Stack_state
+            {
+                .pointer = &parent->element_type,
+                .type = "std::pmr::vector<Type_reference>",
+                .get_next_state = get_next_state_vector,
+                .set_vector_size = set_vector_size,
+                .get_element = get_element,
+                .get_next_state_element = get_next_state_type_reference
+            };
+        }
+
+        if (key == "size")
+        {
+
+            return Stack_state
+            {
+                .pointer = &parent->size,
+                .type = "std::uint64_t",
+                .get_next_state = nullptr,
+            };
+        }
+
+        return {};
+    }
+
     export std::optional<Stack_state> get_next_state_type_reference(Stack_state* state, std::string_view const key)
     {
         h::Type_reference* parent = static_cast<h::Type_reference*>(state->pointer);
@@ -1077,7 +1192,7 @@ namespace h::json
         {
             auto const set_variant_type = [](Stack_state* state, std::string_view const type) -> void
             {
-                using Variant_type = std::variant<h::Array_slice_type, h::Builtin_type_reference, h::Constant_array_type, h::Custom_type_reference, h::Fundamental_type, h::Function_pointer_type, h::Integer_type, h::Null_pointer_type, h::Parameter_type, h::Pointer_type, h::Type_instance>;
+                using Variant_type = std::variant<h::Array_slice_type, h::Builtin_type_reference, h::Constant_array_type, h::Custom_type_reference, h::Fundamental_type, h::Function_pointer_type, h::Integer_type, h::Null_pointer_type, h::Parameter_type, h::Pointer_type, h::Type_instance, h::Vector_type>;
                 Variant_type* pointer = static_cast<Variant_type*>(state->pointer);
 
                 if (type == "Array_slice_type")
@@ -1146,6 +1261,12 @@ namespace h::json
                     state->type = "Type_instance";
                     return;
                 }
+                if (type == "Vector_type")
+                {
+                    *pointer = Vector_type{};
+                    state->type = "Vector_type";
+                    return;
+                }
             };
 
             auto const get_next_state = [](Stack_state* state, std::string_view const key) -> std::optional<Stack_state>
@@ -1219,6 +1340,11 @@ namespace h::json
                             return get_next_state_type_instance;
                         }
 
+                        if (state->type == "Vector_type")
+                        {
+                            return get_next_state_vector_type;
+                        }
+
                         return nullptr;
                     };
 
@@ -1237,7 +1363,7 @@ namespace h::json
             return Stack_state
             {
                 .pointer = &parent->data,
-                .type = "std::variant<Array_slice_type,Builtin_type_reference,Constant_array_type,Custom_type_reference,Fundamental_type,Function_pointer_type,Integer_type,Null_pointer_type,Parameter_type,Pointer_type,Type_instance>",
+                .type = "std::variant<Array_slice_type,Builtin_type_reference,Constant_array_type,Custom_type_reference,Fundamental_type,Function_pointer_type,Integer_type,Null_pointer_type,Parameter_type,Pointer_type,Type_instance,Vector_type>",
                 .get_next_state = get_next_state,
                 .set_variant_type = set_variant_type,
             };
@@ -1746,6 +1872,31 @@ namespace h::json
             };
         }
 
+        if (key == "member_alignments")
+        {
+            auto const set_vector_size = [](Stack_state const* const state, std::size_t const size) -> void
+            {
+                std::pmr::vector<std::optional<std::uint32_t>>* parent = static_cast<std::pmr::vector<std::optional<std::uint32_t>>*>(state->pointer);
+                parent->resize(size);
+            };
+
+            auto const get_element = [](Stack_state const* const state, std::size_t const index) -> void*
+            {
+                std::pmr::vector<std::optional<std::uint32_t>>* parent = static_cast<std::pmr::vector<std::optional<std::uint32_t>>*>(state->pointer);
+                return &((*parent)[index]);
+            };
+
+            return Stack_state
+            {
+                .pointer = &parent->member_alignments,
+                .type = "std::pmr::vector<std::optional<std::uint32_t>>",
+                .get_next_state = get_next_state_vector,
+                .set_vector_size = set_vector_size,
+                .get_element = get_element,
+                .get_next_state_element = nullptr,
+            };
+        }
+
         if (key == "member_default_values")
         {
             auto const set_vector_size = [](Stack_state const* const state, std::size_t const size) -> void
@@ -1782,6 +1933,17 @@ namespace h::json
             };
         }
 
+        if (key == "alignment")
+        {
+            parent->alignment = std::uint32_t{};
+            return Stack_state
+            {
+                .pointer = &parent->alignment.value(),
+                .type = "std::uint32_t",
+                .get_next_state = nullptr,
+            };
+        }
+
         if (key == "is_literal")
         {
 
@@ -2059,6 +2221,35 @@ namespace h::json
         return {};
     }
 
+    export std::optional<Stack_state> get_next_state_named_parameter_attribute(Stack_state* state, std::string_view const key)
+    {
+        h::Named_parameter_attribute* parent = static_cast<h::Named_parameter_attribute*>(state->pointer);
+
+        if (key == "parameter_name")
+        {
+
+            return Stack_state
+            {
+                .pointer = &parent->parameter_name,
+                .type = "std::pmr::string",
+                .get_next_state = nullptr,
+            };
+        }
+
+        if (key == "attribute")
+        {
+
+            return Stack_state
+            {
+                .pointer = &parent->attribute,
+                .type = "Parameter_attribute",
+                .get_next_state = nullptr,
+            };
+        }
+
+        return {};
+    }
+
     export std::optional<Stack_state> get_next_state_function_declaration(Stack_state* state, std::string_view const key)
     {
         h::Function_declaration* parent = static_cast<h::Function_declaration*>(state->pointer);
@@ -2157,6 +2348,56 @@ namespace h::json
             };
         }
 
+        if (key == "attributes")
+        {
+            auto const set_vector_size = [](Stack_state const* const state, std::size_t const size) -> void
+            {
+                std::pmr::vector<Function_attribute>* parent = static_cast<std::pmr::vector<Function_attribute>*>(state->pointer);
+                parent->resize(size);
+            };
+
+            auto const get_element = [](Stack_state const* const state, std::size_t const index) -> void*
+            {
+                std::pmr::vector<Function_attribute>* parent = static_cast<std::pmr::vector<Function_attribute>*>(state->pointer);
+                return &((*parent)[index]);
+            };
+
+            return Stack_state
+            {
+                .pointer = &parent->attributes,
+                .type = "std::pmr::vector<Function_attribute>",
+                .get_next_state = get_next_state_vector,
+                .set_vector_size = set_vector_size,
+                .get_element = get_element,
+                .get_next_state_element = nullptr
+            };
+        }
+
+        if (key == "parameter_attributes")
+        {
+            auto const set_vector_size = [](Stack_state const* const state, std::size_t const size) -> void
+            {
+                std::pmr::vector<Named_parameter_attribute>* parent = static_cast<std::pmr::vector<Named_parameter_attribute>*>(state->pointer);
+                parent->resize(size);
+            };
+
+            auto const get_element = [](Stack_state const* const state, std::size_t const index) -> void*
+            {
+                std::pmr::vector<Named_parameter_attribute>* parent = static_cast<std::pmr::vector<Named_parameter_attribute>*>(state->pointer);
+                return &((*parent)[index]);
+            };
+
+            return Stack_state
+            {
+                .pointer = &parent->parameter_attributes,
+                .type = "std::pmr::vector<Named_parameter_attribute>",
+                .get_next_state = get_next_state_vector,
+                .set_vector_size = set_vector_size,
+                .get_element = get_element,
+                .get_next_state_element = get_next_state_named_parameter_attribute
+            };
+        }
+
         if (key == "preconditions")
         {
             auto const set_vector_size = [](Stack_state const* const state, std::size_t const size) -> void
@@ -5048,6 +5289,16 @@ namespace h::json
             };
         }
 
+        if constexpr (std::is_same_v<Struct_type, h::Vector_type>)
+        {
+            return Stack_state
+            {
+                .pointer = output,
+                .type = "Vector_type",
+                .get_next_state = get_next_state_vector_type
+            };
+        }
+
         if constexpr (std::is_same_v<Struct_type, h::Type_reference>)
         {
             return Stack_state
@@ -5158,6 +5409,16 @@ namespace h::json
             };
         }
 
+        if constexpr (std::is_same_v<Struct_type, h::Named_parameter_attribute>)
+        {
+            return Stack_state
+            {
+                .pointer = output,
+                .type = "Named_parameter_attribute",
+                .get_next_state = get_next_state_named_parameter_attribute
+            };
+        }
+
         if constexpr (std::is_same_v<Struct_type, h::Function_declaration>)
         {
             return Stack_state
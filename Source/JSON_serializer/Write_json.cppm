@@ -114,6 +114,50 @@ namespace h::json
         throw std::runtime_error{ "Failed to write enum 'Linkage'!\n" };
     }
 
+    export std::string_view write_enum(Function_attribute const value)
+    {
+        if (value == Function_attribute::Always_inline)
+        {
+            return "Always_inline";
+        }
+        else if (value == Function_attribute::Cold)
+        {
+            return "Cold";
+        }
+        else if (value == Function_attribute::Const)
+        {
+            return "Const";
+        }
+        else if (value == Function_attribute::Hot)
+        {
+            return "Hot";
+        }
+        else if (value == Function_attribute::Must_tail)
+        {
+            return "Must_tail";
+        }
+        else if (value == Function_attribute::No_inline)
+        {
+            return "No_inline";
+        }
+        else if (value == Function_attribute::Pure)
+        {
+            return "Pure";
+        }
+
+        throw std::runtime_error{ "Failed to write enum 'Function_attribute'!\n" };
+    }
+
+    export std::string_view write_enum(Parameter_attribute const value)
+    {
+        if (value == Parameter_attribute::No_alias)
+        {
+            return "No_alias";
+        }
+
+        throw std::runtime_error{ "Failed to write enum 'Parameter_attribute'!\n" };
+    }
+
     export std::string_view write_enum(Binary_operation const value)
     {
         if (value == Binary_operation::Add)
@@ -370,6 +414,12 @@ namespace h::json
             Parameter_type const& input
         );
 
+    export template<typename Writer_type>
+        void write_object(
+            Writer_type& writer,
+            Vector_type const& input
+        );
+
     export template<typename Writer_type>
         void write_object(
             Writer_type& writer,
@@ -436,6 +486,12 @@ namespace h::json
             Function_condition const& input
         );
 
+    export template<typename Writer_type>
+        void write_object(
+            Writer_type& writer,
+            Named_parameter_attribute const& input
+        );
+
     export template<typename Writer_type>
         void write_object(
             Writer_type& writer,
@@ -1097,6 +1153,20 @@ namespace h::json
         writer.EndObject();
     }
 
+    export template<typename Writer_type>
+        void write_object(
+            Writer_type& writer,
+            Vector_type const& output
+        )
+    {
+        writer.StartObject();
+        writer.Key("element_type");
+        write_object(writer, output.element_type);
+        writer.Key("size");
+        writer.Uint64(output.size);
+        writer.EndObject();
+    }
+
     export template<typename Writer_type>
         void write_object(
             Writer_type& writer,
@@ -1198,6 +1268,14 @@ namespace h::json
             Type_instance const& value = std::get<Type_instance>(output.data);
             write_object(writer, value);
         }
+        else if (std::holds_alternative<Vector_type>(output.data))
+        {
+            writer.Key("type");
+            writer.String("Vector_type");
+            writer.Key("value");
+            Vector_type const& value = std::get<Vector_type>(output.data);
+            write_object(writer, value);
+        }
         writer.EndObject();
 
         write_optional_object(writer, "source_range", output.source_range);
@@ -1329,10 +1407,13 @@ namespace h::json
         write_object(writer, output.member_names);
         writer.Key("member_bit_fields");
         write_object(writer, output.member_bit_fields);
+        writer.Key("member_alignments");
+        write_object(writer, output.member_alignments);
         writer.Key("member_default_values");
         write_object(writer, output.member_default_values);
         writer.Key("is_packed");
         writer.Bool(output.is_packed);
+        write_optional(writer, "alignment", output.alignment);
         writer.Key("is_literal");
         writer.Bool(output.is_literal);
         write_optional(writer, "comment", output.comment);
@@ -1380,6 +1461,23 @@ namespace h::json
         writer.EndObject();
     }
 
+    export template<typename Writer_type>
+        void write_object(
+            Writer_type& writer,
+            Named_parameter_attribute const& output
+        )
+    {
+        writer.StartObject();
+        writer.Key("parameter_name");
+        writer.String(output.parameter_name.data(), output.parameter_name.size());
+        writer.Key("attribute");
+        {
+            std::string_view const enum_value_string = write_enum(output.attribute);
+            writer.String(enum_value_string.data(), enum_value_string.size());
+        }
+        writer.EndObject();
+    }
+
     export template<typename Writer_type>
         void write_object(
             Writer_type& writer,
@@ -1401,6 +1499,10 @@ namespace h::json
             std::string_view const enum_value_string = write_enum(output.linkage);
             writer.String(enum_value_string.data(), enum_value_string.size());
         }
+        writer.Key("attributes");
+        write_object(writer, output.attributes);
+        writer.Key("parameter_attributes");
+        write_object(writer, output.parameter_attributes);
         writer.Key("preconditions");
         write_object(writer, output.preconditions);
         writer.Key("postconditions");
@@ -201,11 +201,12 @@ namespace h::language_server
         std::pmr::vector<lsp::WorkspaceDocumentDiagnosticReport> items{output_allocator};
         items.reserve(core_module_source_file_paths.size());
 
-        std::pmr::vector<h::Module const*> sorted_core_modules = h::compiler::sort_core_modules(
+        h::compiler::Sorted_core_modules sorted = h::compiler::sort_core_modules_and_compute_ranks(
             core_modules,
             temporaries_allocator,
             temporaries_allocator
         );
+        std::pmr::vector<h::Module const*> const& sorted_core_modules = sorted.sorted_core_modules;
 
         h::Declaration_database declaration_database = h::compiler::create_declaration_database_and_add_modules(
             header_modules,
@@ -295,7 +296,13 @@ namespace h::language_server
                     temporaries_allocator
                 );
 
-                std::span<h::compiler::Diagnostic const> const compiler_diagnostics = result.diagnostics;
+                std::pmr::vector<h::compiler::Diagnostic> compiler_diagnostics{temporaries_allocator};
+                for (h::compiler::Diagnostic const& diagnostic : sorted.diagnostics)
+                {
+                    if (diagnostic.file_path == source_file_path)
+                        compiler_diagnostics.push_back(diagnostic);
+                }
+                compiler_diagnostics.insert(compiler_diagnostics.end(), result.diagnostics.begin(), result.diagnostics.end());
 
                 lsp::WorkspaceFullDocumentDiagnosticReport item = create_full_document_diagnostics_report(
                     source_file_path,
@@ -304,7 +311,7 @@ namespace h::language_server
                     compiler_diagnostics
                 );
 
-                core_module_diagnostics[core_module_index] = result.diagnostics;
+                core_module_diagnostics[core_module_index].assign(compiler_diagnostics.begin(), compiler_diagnostics.end());
                 items.push_back(std::move(item));
             }
         }
@@ -380,6 +380,34 @@ namespace h::language_server
                 }
             );
         }
+        else if (std::holds_alternative<h::Vector_type>(type.data))
+        {
+            h::Vector_type const& vector_type = std::get<h::Vector_type>(type.data);
+            if (vector_type.element_type.empty())
+                return;
+
+            parts.push_back(
+                lsp::InlayHintLabelPart
+                {
+                    .value = "Vector::<",
+                }
+            );
+
+            create_inlay_hint_variable_type_label_aux(
+                parts,
+                core_module,
+                declaration_database,
+                vector_type.element_type[0],
+                temporaries_allocator
+            );
+
+            parts.push_back(
+                lsp::InlayHintLabelPart
+                {
+                    .value = std::format(", {}>", vector_type.size),
+                }
+            );
+        }
         else
         {
             std::pmr::string const type_name = h::format_type_reference(
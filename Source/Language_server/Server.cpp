@@ -464,7 +464,7 @@ namespace h::language_server
             h::compiler::Compilation_options const compilation_options
             {
                 .target_triple = std::nullopt,
-                .is_optimized = false,
+                .optimization_level = h::compiler::Optimization_level::O0,
                 .debug = true,
                 .contract_options = h::compiler::Contract_options::Log_error_and_abort,
             };
@@ -1,5 +1,6 @@
 module;
 
+#include <algorithm>
 #include <cctype>
 #include <filesystem>
 #include <memory_resource>
@@ -20,6 +21,19 @@ import h.parser.type_name_parser;
 
 namespace h::parser
 {
+    static bool declares_vector_type_constructor(
+        h::Module const& core_module
+    )
+    {
+        auto const is_vector = [](h::Type_constructor const& type_constructor) -> bool
+        {
+            return type_constructor.name == "Vector";
+        };
+
+        return std::any_of(core_module.export_declarations.type_constructors.begin(), core_module.export_declarations.type_constructors.end(), is_vector)
+            || std::any_of(core_module.internal_declarations.type_constructors.begin(), core_module.internal_declarations.type_constructors.end(), is_vector);
+    }
+
     Module_info create_module_info(
         h::Module const& core_module
     )
@@ -29,6 +43,7 @@ namespace h::parser
             .module_name = core_module.name,
             .source_file_path = core_module.source_file_path,
             .alias_imports = core_module.dependencies.alias_imports,
+            .declares_vector_type_constructor = declares_vector_type_constructor(core_module),
         };
     }
 
@@ -329,9 +344,22 @@ namespace h::parser
             temporaries_allocator
         );
 
-        Module_info const module_info = create_module_info(output);
+        Module_info module_info = create_module_info(output);
 
         std::pmr::vector<Parse_node> const child_nodes = get_child_nodes(tree, node, temporaries_allocator);
+
+        // Type constructors can be declared after their first use, so they are looked up before converting any declaration:
+        for (std::size_t child_index = 1; child_index < child_nodes.size(); ++child_index)
+        {
+            std::optional<Parse_node> const declaration_value_node = get_last_child_node(tree, child_nodes[child_index]);
+            if (!declaration_value_node.has_value() || get_node_symbol(declaration_value_node.value()) != "Type_constructor")
+                continue;
+
+            std::optional<Parse_node> const name_node = get_child_node(tree, declaration_value_node.value(), 1);
+            if (name_node.has_value() && get_node_value(tree, name_node.value()) == "Vector")
+                module_info.declares_vector_type_constructor = true;
+        }
+
         for (std::size_t child_index = 1; child_index < child_nodes.size(); ++child_index)
         {
             Parse_node const declaration_node = child_nodes[child_index];
@@ -422,18 +450,59 @@ namespace h::parser
         return export_node.has_value();
     }
 
+    struct Member_alignment_attribute
+    {
+        std::string_view member_name;
+        std::uint32_t alignment;
+    };
+
     struct Declaration_attributes
     {
         std::optional<std::string_view> unique_name;
+        std::pmr::vector<h::Function_attribute> function_attributes;
+        std::pmr::vector<h::Named_parameter_attribute> parameter_attributes;
+        bool is_packed;
+        std::optional<std::uint32_t> alignment;
+        std::pmr::vector<Member_alignment_attribute> member_alignments;
     };
 
+    static std::optional<h::Function_attribute> get_function_attribute(
+        std::string_view const name
+    )
+    {
+        if (name == "@always_inline")
+            return h::Function_attribute::Always_inline;
+        else if (name == "@cold")
+            return h::Function_attribute::Cold;
+        else if (name == "@const")
+            return h::Function_attribute::Const;
+        else if (name == "@hot")
+            return h::Function_attribute::Hot;
+        else if (name == "@must_tail")
+            return h::Function_attribute::Must_tail;
+        else if (name == "@no_inline")
+            return h::Function_attribute::No_inline;
+        else if (name == "@pure")
+            return h::Function_attribute::Pure;
+
+        return std::nullopt;
+    }
+
     Declaration_attributes get_declaration_attributes(
         Parse_tree const& tree,
         Parse_node const& node,
         std::pmr::polymorphic_allocator<> const& temporaries_allocator
     )
     {
-        Declaration_attributes attributes = {};
+        Declaration_attributes attributes
+        {
+            .unique_name = std::nullopt,
+            .function_attributes = std::pmr::vector<h::Function_attribute>{temporaries_allocator},
+            .parameter_attributes = std::pmr::vector<h::Named_parameter_attribute>{temporaries_allocator},
+            .is_packed = false,
+            .alignment = std::nullopt,
+            .member_alignments = std::pmr::vector<Member_alignment_attribute>{temporaries_allocator},
+        };
 
         std::pmr::vector<Parse_node> const attribute_nodes = get_child_nodes(tree, node, "Declaration_attribute", temporaries_allocator);
         for (Parse_node const& attribute_node : attribute_nodes)
@@ -454,6 +523,46 @@ namespace h::parser
                     attributes.unique_name = get_string_content(get_node_value(tree, unique_name_node));
                 }
             }
+            else if (name == "@packed")
+            {
+                attributes.is_packed = true;
+            }
+            else if (name == "@align")
+            {
+                if (argument_nodes.size() == 1)
+                {
+                    attributes.alignment = static_cast<std::uint32_t>(parse_uint64(get_node_value(tree, argument_nodes[0])));
+                }
+                else if (argument_nodes.size() == 2)
+                {
+                    attributes.member_alignments.push_back(
+                        Member_alignment_attribute
+                        {
+                            .member_name = get_node_value(tree, argument_nodes[0]),
+                            .alignment = static_cast<std::uint32_t>(parse_uint64(get_node_value(tree, argument_nodes[1]))),
+                        }
+                    );
+                }
+            }
+            else if (name == "@no_alias")
+            {
+                for (Parse_node const& argument_node : argument_nodes)
+                {
+                    attributes.parameter_attributes.push_back(
+                        h::Named_parameter_attribute
+                        {
+                            .parameter_name = std::pmr::string{get_node_value(tree, argument_node), temporaries_allocator},
+                            .attribute = h::Parameter_attribute::No_alias,
+                        }
+                    );
+                }
+            }
+            else
+            {
+                std::optional<h::Function_attribute> const function_attribute = get_function_attribute(name);
+                if (function_attribute.has_value())
+                    attributes.function_attributes.push_back(function_attribute.value());
+            }
         }
 
         return attributes;
@@ -520,6 +629,9 @@ namespace h::parser
                 temporaries_allocator
             );
 
+            function_declaration.attributes = std::pmr::vector<h::Function_attribute>{declaration_attributes.function_attributes.begin(), declaration_attributes.function_attributes.end(), output_allocator};
+            function_declaration.parameter_attributes = std::pmr::vector<h::Named_parameter_attribute>{declaration_attributes.parameter_attributes.begin(), declaration_attributes.parameter_attributes.end(), output_allocator};
+
             std::optional<Parse_node> function_definition_node = get_child_node(tree, declaration_value_node.value(), 1);
             if (function_definition_node.has_value() && get_node_symbol(*function_definition_node) == "Function_definition")
             {
@@ -562,6 +674,19 @@ namespace h::parser
         {
             Struct_declaration declaration = node_to_struct_declaration(module_info, tree, declaration_value_node.value(), declaration_attributes.unique_name, comment, output_allocator, temporaries_allocator);
 
+            declaration.is_packed = declaration_attributes.is_packed;
+            declaration.alignment = declaration_attributes.alignment;
+
+            for (Member_alignment_attribute const& member_alignment : declaration_attributes.member_alignments)
+            {
+                auto const location = std::find(declaration.member_names.begin(), declaration.member_names.end(), member_alignment.member_name);
+                if (location != declaration.member_names.end())
+                {
+                    std::size_t const member_index = std::distance(declaration.member_names.begin(), location);
+                    declaration.member_alignments[member_index] = member_alignment.alignment;
+                }
+            }
+
             if (is_export)
                 core_module.export_declarations.struct_declarations.push_back(std::move(declaration));
             else
@@ -668,6 +793,46 @@ namespace h::parser
         return output;
     }
 
+    // The grammar has no dedicated rule for vectors, so Vector::<Element_type, Lane_count> is first parsed as a type instance.
+    static std::optional<h::Vector_type> type_instance_to_vector_type(
+        Module_info const& module_info,
+        h::Type_instance const& type_instance,
+        std::pmr::polymorphic_allocator<> const& output_allocator
+    )
+    {
+        if (type_instance.type_constructor.name != "Vector" || type_instance.type_constructor.module_reference.name != module_info.module_name)
+            return std::nullopt;
+
+        if (module_info.declares_vector_type_constructor)
+            return std::nullopt;
+
+        if (type_instance.arguments.size() != 2)
+            return std::nullopt;
+
+        h::Statement const& element_type_statement = type_instance.arguments[0];
+        h::Statement const& size_statement = type_instance.arguments[1];
+        if (element_type_statement.expressions.empty() || size_statement.expressions.empty())
+            return std::nullopt;
+
+        if (!std::holds_alternative<h::Type_expression>(element_type_statement.expressions[0].data))
+            return std::nullopt;
+
+        if (!std::holds_alternative<h::Constant_expression>(size_statement.expressions[0].data))
+            return std::nullopt;
+
+        h::Constant_expression const& size_expression = std::get<h::Constant_expression>(size_statement.expressions[0].data);
+        if (!is_integer(size_expression.type))
+            return std::nullopt;
+
+        h::Type_expression const& element_type_expression = std::get<h::Type_expression>(element_type_statement.expressions[0].data);
+
+        return h::Vector_type
+        {
+            .element_type = std::pmr::vector<h::Type_reference>{{element_type_expression.type}, output_allocator},
+            .size = parse_uint64(size_expression.data),
+        };
+    }
+
     std::optional<h::Type_reference> node_to_type_reference(
         Module_info const& module_info,
         Parse_tree const& tree,
@@ -898,6 +1063,10 @@ namespace h::parser
             
             std::pmr::vector<Parse_node> const argument_nodes = get_child_nodes_of_parent(tree, child, "Type_instance_type_parameters", "Expression_instance_call_parameter", temporaries_allocator);
             output.arguments = node_to_block(module_info, tree, argument_nodes, output_allocator, temporaries_allocator);
+
+            std::optional<h::Vector_type> vector_type = type_instance_to_vector_type(module_info, output, output_allocator);
+            if (vector_type.has_value())
+                return h::Type_reference{ .data = std::move(vector_type.value()), .source_range = source_range };
             
             return h::Type_reference{ .data = std::move(output), .source_range = source_range };
         }
@@ -1414,6 +1583,9 @@ namespace h::parser
                 output.member_bit_fields = std::pmr::vector<std::optional<std::uint32_t>>{output_allocator};
                 output.member_bit_fields.resize(member_count, std::nullopt);
 
+                output.member_alignments = std::pmr::vector<std::optional<std::uint32_t>>{output_allocator};
+                output.member_alignments.resize(member_count, std::nullopt);
+
                 output.member_default_values = std::pmr::vector<h::Statement>{output_allocator};
                 output.member_default_values.resize(member_count, h::Statement{});
 
@@ -18,6 +18,7 @@ namespace h::parser
         std::string_view module_name;
         std::optional<std::filesystem::path> source_file_path;
         std::span<Import_module_with_alias const> alias_imports;
+        bool declares_vector_type_constructor = false; // If true, Vector::<T, N> refers to that type constructor instead of the builtin vector type
     };
 
     export Module_info create_module_info(
@@ -2,6 +2,7 @@
 #include <filesystem>
 #include <optional>
 #include <string_view>
+#include <variant>
 
 #include <catch2/catch_all.hpp>
 
@@ -556,6 +557,43 @@ namespace h::parser
         test_convertor(input_file);
     }
 
+    TEST_CASE("Converts Vector::<T, N> into a vector type unless the module declares a Vector type constructor", "[Convertor]")
+    {
+        std::string_view const builtin_vector_source = R"(module Builtin_vector;
+
+export function run(value: Vector::<Float32, 4>) -> ()
+{
+}
+)";
+
+        std::string_view const user_vector_source = R"(module User_vector;
+
+export function run(value: Vector::<Float32, 4>) -> ()
+{
+}
+
+export type_constructor Vector(element_type: Type, count: Uint64)
+{
+    return struct
+    {
+        data: *element_type = null;
+    };
+}
+)";
+
+        std::optional<h::Module> const builtin_vector_module = parse_and_convert_to_module(builtin_vector_source, std::nullopt, {}, {});
+        REQUIRE(builtin_vector_module.has_value());
+        REQUIRE(builtin_vector_module->export_declarations.function_declarations.size() == 1);
+        h::Type_reference const& builtin_vector_type = builtin_vector_module->export_declarations.function_declarations[0].type.input_parameter_types[0];
+        CHECK(std::holds_alternative<h::Vector_type>(builtin_vector_type.data));
+
+        std::optional<h::Module> const user_vector_module = parse_and_convert_to_module(user_vector_source, std::nullopt, {}, {});
+        REQUIRE(user_vector_module.has_value());
+        REQUIRE(user_vector_module->export_declarations.function_declarations.size() == 1);
+        h::Type_reference const& user_vector_type = user_vector_module->export_declarations.function_declarations[0].type.input_parameter_types[0];
+        CHECK(std::holds_alternative<h::Type_instance>(user_vector_type.data));
+    }
+
     TEST_CASE("Converts while_loop_expressions.hltxt", "[Convertor]")
     {
         std::string_view const input_file = "while_loop_expressions.hltxt";
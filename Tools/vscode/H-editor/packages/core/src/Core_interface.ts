@@ -36,6 +36,20 @@ export enum Linkage {
     Private = "Private",
 }
 
+export enum Function_attribute {
+    Always_inline = "Always_inline",
+    Cold = "Cold",
+    Const = "Const",
+    Hot = "Hot",
+    Must_tail = "Must_tail",
+    No_inline = "No_inline",
+    Pure = "Pure",
+}
+
+export enum Parameter_attribute {
+    No_alias = "No_alias",
+}
+
 export enum Binary_operation {
     Add = "Add",
     Subtract = "Subtract",
@@ -91,6 +105,7 @@ export enum Type_reference_enum {
     Parameter_type = "Parameter_type",
     Pointer_type = "Pointer_type",
     Type_instance = "Type_instance",
+    Vector_type = "Vector_type",
 }
 
 export enum Expression_enum {
@@ -200,8 +215,13 @@ export interface Parameter_type {
     name: string;
 }
 
+export interface Vector_type {
+    element_type: Vector<Type_reference>;
+    size: number;
+}
+
 export interface Type_reference {
-    data: Variant<Type_reference_enum, Builtin_type_reference | Constant_array_type | Custom_type_reference | Fundamental_type | Function_pointer_type | Integer_type | Null_pointer_type | Parameter_type | Pointer_type | Type_instance>;
+    data: Variant<Type_reference_enum, Builtin_type_reference | Constant_array_type | Custom_type_reference | Fundamental_type | Function_pointer_type | Integer_type | Null_pointer_type | Parameter_type | Pointer_type | Type_instance | Vector_type>;
 }
 
 export interface Indexed_comment {
@@ -252,8 +272,10 @@ export interface Struct_declaration {
     member_types: Vector<Type_reference>;
     member_names: Vector<string>;
     member_bit_fields: Vector<number>;
+    member_alignments: Vector<number>;
     member_default_values: Vector<Statement>;
     is_packed: boolean;
+    alignment?: number;
     is_literal: boolean;
     comment?: string;
     member_comments: Vector<Indexed_comment>;
@@ -277,6 +299,11 @@ export interface Function_condition {
     condition: Statement;
 }
 
+export interface Named_parameter_attribute {
+    parameter_name: string;
+    attribute: Parameter_attribute;
+}
+
 export interface Function_declaration {
     name: string;
     unique_name?: string;
@@ -284,6 +311,8 @@ export interface Function_declaration {
     input_parameter_names: Vector<string>;
     output_parameter_names: Vector<string>;
     linkage: Linkage;
+    attributes: Vector<Function_attribute>;
+    parameter_attributes: Vector<Named_parameter_attribute>;
     preconditions: Vector<Function_condition>;
     postconditions: Vector<Function_condition>;
     comment?: string;
@@ -299,6 +299,20 @@ export enum Linkage {
     Private = "Private",
 }
 
+export enum Function_attribute {
+    Always_inline = "Always_inline",
+    Cold = "Cold",
+    Const = "Const",
+    Hot = "Hot",
+    Must_tail = "Must_tail",
+    No_inline = "No_inline",
+    Pure = "Pure",
+}
+
+export enum Parameter_attribute {
+    No_alias = "No_alias",
+}
+
 export enum Binary_operation {
     Add = "Add",
     Subtract = "Subtract",
@@ -354,6 +368,7 @@ export enum Type_reference_enum {
     Parameter_type = "Parameter_type",
     Pointer_type = "Pointer_type",
     Type_instance = "Type_instance",
+    Vector_type = "Vector_type",
 }
 
 export enum Expression_enum {
@@ -676,8 +691,30 @@ function intermediate_to_core_parameter_type(intermediate_value: Parameter_type)
     };
 }
 
+export interface Vector_type {
+    element_type: Type_reference[];
+    size: number;
+}
+
+function core_to_intermediate_vector_type(core_value: Core.Vector_type): Vector_type {
+    return {
+        element_type: core_value.element_type.elements.map(value => core_to_intermediate_type_reference(value)),
+        size: core_value.size,
+    };
+}
+
+function intermediate_to_core_vector_type(intermediate_value: Vector_type): Core.Vector_type {
+    return {
+        element_type: {
+            size: intermediate_value.element_type.length,
+            elements: intermediate_value.element_type.map(value => intermediate_to_core_type_reference(value)),
+        },
+        size: intermediate_value.size,
+    };
+}
+
 export interface Type_reference {
-    data: Variant<Type_reference_enum, Builtin_type_reference | Constant_array_type | Custom_type_reference | Fundamental_type | Function_pointer_type | Integer_type | Null_pointer_type | Parameter_type | Pointer_type | Type_instance>;
+    data: Variant<Type_reference_enum, Builtin_type_reference | Constant_array_type | Custom_type_reference | Fundamental_type | Function_pointer_type | Integer_type | Null_pointer_type | Parameter_type | Pointer_type | Type_instance | Vector_type>;
 }
 
 function core_to_intermediate_type_reference(core_value: Core.Type_reference): Type_reference {
@@ -744,6 +781,12 @@ function core_to_intermediate_type_reference(core_value: Core.Type_reference): T
                         value: core_to_intermediate_type_instance(core_value.data.value as Core.Type_instance)
                     };
                 }
+                case Core.Type_reference_enum.Vector_type: {
+                    return {
+                        type: core_value.data.type,
+                        value: core_to_intermediate_vector_type(core_value.data.value as Core.Vector_type)
+                    };
+                }
             }
         })(),
     };
@@ -831,6 +874,14 @@ function intermediate_to_core_type_reference(intermediate_value: Type_reference)
                 }
             };
         }
+        case Type_reference_enum.Vector_type: {
+            return {
+                data: {
+                    type: intermediate_value.data.type,
+                    value: intermediate_to_core_vector_type(intermediate_value.data.value as Vector_type)
+                }
+            };
+        }
     }
 }
 
@@ -980,8 +1031,10 @@ export interface Struct_declaration {
     member_types: Type_reference[];
     member_names: string[];
     member_bit_fields: number[];
+    member_alignments: number[];
     member_default_values: Statement[];
     is_packed: boolean;
+    alignment?: number;
     is_literal: boolean;
     comment?: string;
     member_comments: Indexed_comment[];
@@ -996,8 +1049,10 @@ function core_to_intermediate_struct_declaration(core_value: Core.Struct_declara
         member_types: core_value.member_types.elements.map(value => core_to_intermediate_type_reference(value)),
         member_names: core_value.member_names.elements,
         member_bit_fields: core_value.member_bit_fields.elements,
+        member_alignments: core_value.member_alignments.elements,
         member_default_values: core_value.member_default_values.elements.map(value => core_to_intermediate_statement(value)),
         is_packed: core_value.is_packed,
+        alignment: core_value.alignment,
         is_literal: core_value.is_literal,
         comment: core_value.comment,
         member_comments: core_value.member_comments.elements.map(value => core_to_intermediate_indexed_comment(value)),
@@ -1022,11 +1077,16 @@ function intermediate_to_core_struct_declaration(intermediate_value: Struct_decl
             size: intermediate_value.member_bit_fields.length,
             elements: intermediate_value.member_bit_fields,
         },
+        member_alignments: {
+            size: intermediate_value.member_alignments.length,
+            elements: intermediate_value.member_alignments,
+        },
         member_default_values: {
             size: intermediate_value.member_default_values.length,
             elements: intermediate_value.member_default_values.map(value => intermediate_to_core_statement(value)),
         },
         is_packed: intermediate_value.is_packed,
+        alignment: intermediate_value.alignment,
         is_literal: intermediate_value.is_literal,
         comment: intermediate_value.comment,
         member_comments: {
@@ -1103,6 +1163,25 @@ function intermediate_to_core_function_condition(intermediate_value: Function_co
     };
 }
 
+export interface Named_parameter_attribute {
+    parameter_name: string;
+    attribute: Parameter_attribute;
+}
+
+function core_to_intermediate_named_parameter_attribute(core_value: Core.Named_parameter_attribute): Named_parameter_attribute {
+    return {
+        parameter_name: core_value.parameter_name,
+        attribute: core_value.attribute,
+    };
+}
+
+function intermediate_to_core_named_parameter_attribute(intermediate_value: Named_parameter_attribute): Core.Named_parameter_attribute {
+    return {
+        parameter_name: intermediate_value.parameter_name,
+        attribute: intermediate_value.attribute,
+    };
+}
+
 export interface Function_declaration {
     name: string;
     unique_name?: string;
@@ -1110,6 +1189,8 @@ export interface Function_declaration {
     input_parameter_names: string[];
     output_parameter_names: string[];
     linkage: Linkage;
+    attributes: Function_attribute[];
+    parameter_attributes: Named_parameter_attribute[];
     preconditions: Function_condition[];
     postconditions: Function_condition[];
     comment?: string;
@@ -1126,6 +1207,8 @@ function core_to_intermediate_function_declaration(core_value: Core.Function_dec
         input_parameter_names: core_value.input_parameter_names.elements,
         output_parameter_names: core_value.output_parameter_names.elements,
         linkage: core_value.linkage,
+        attributes: core_value.attributes.elements,
+        parameter_attributes: core_value.parameter_attributes.elements.map(value => core_to_intermediate_named_parameter_attribute(value)),
         preconditions: core_value.preconditions.elements.map(value => core_to_intermediate_function_condition(value)),
         postconditions: core_value.postconditions.elements.map(value => core_to_intermediate_function_condition(value)),
         comment: core_value.comment,
@@ -1149,6 +1232,14 @@ function intermediate_to_core_function_declaration(intermediate_value: Function_
             elements: intermediate_value.output_parameter_names,
         },
         linkage: intermediate_value.linkage,
+        attributes: {
+            size: intermediate_value.attributes.length,
+            elements: intermediate_value.attributes,
+        },
+        parameter_attributes: {
+            size: intermediate_value.parameter_attributes.length,
+            elements: intermediate_value.parameter_attributes.map(value => intermediate_to_core_named_parameter_attribute(value)),
+        },
         preconditions: {
             size: intermediate_value.preconditions.length,
             elements: intermediate_value.preconditions.map(value => intermediate_to_core_function_condition(value)),
@@ -86,6 +86,8 @@ export function create_0(): IR.Module {
                         input_parameter_names: ["lhs", "rhs"],
                         output_parameter_names: ["result"],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -125,6 +127,8 @@ export function create_0(): IR.Module {
                         input_parameter_names: ["lhs", "rhs"],
                         output_parameter_names: ["result"],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -164,6 +168,8 @@ export function create_0(): IR.Module {
                         input_parameter_names: ["lhs", "rhs"],
                         output_parameter_names: ["result"],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -198,6 +204,8 @@ export function create_0(): IR.Module {
                         input_parameter_names: [],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -313,6 +321,8 @@ export function create_0(): IR.Module {
                         input_parameter_names: ["lhs", "rhs"],
                         output_parameter_names: ["result"],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -601,6 +611,8 @@ export function create_function_example(): IR.Module {
                         input_parameter_names: ["lhs", "rhs"],
                         output_parameter_names: ["result"],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -650,6 +662,8 @@ export function create_function_calling_module_function_example(): IR.Module {
                         input_parameter_names: [],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -725,6 +739,8 @@ export function create_hello_world(): IR.Module {
                         input_parameter_names: [],
                         output_parameter_names: ["result"],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -821,6 +837,8 @@ export function create_variables(): IR.Module {
                         input_parameter_names: [],
                         output_parameter_names: ["result"],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -1027,6 +1045,8 @@ export function create_numbers(): IR.Module {
                         input_parameter_names: [],
                         output_parameter_names: ["result"],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -1152,6 +1172,8 @@ export function create_numeric_casts(): IR.Module {
                         input_parameter_names: [],
                         output_parameter_names: ["result"],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -1237,6 +1259,8 @@ export function create_booleans(): IR.Module {
                         input_parameter_names: [],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -1314,6 +1338,8 @@ export function create_binary_expressions(): IR.Module {
                         input_parameter_names: ["first_integer", "second_integer", "first_boolean", "second_boolean"],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -1397,6 +1423,8 @@ export function create_binary_expressions_operator_precedence(): IR.Module {
                         input_parameter_names: ["a", "b", "c"],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -1446,6 +1474,8 @@ export function create_defer_expressions(): IR.Module {
                         input_parameter_names: [],
                         output_parameter_names: ["id"],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -1476,6 +1506,8 @@ export function create_defer_expressions(): IR.Module {
                         input_parameter_names: ["id"],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -1501,6 +1533,8 @@ export function create_defer_expressions(): IR.Module {
                         input_parameter_names: [],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -1554,6 +1588,8 @@ export function create_dereference_and_access_expressions(): IR.Module {
                 input_parameter_names: [],
                 output_parameter_names: [],
                 linkage: IR.Linkage.External,
+                attributes: [],
+                parameter_attributes: [],
                 preconditions: [],
                 postconditions: [],
             },
@@ -1666,6 +1702,8 @@ export function create_assert_expressions(): IR.Module {
                         input_parameter_names: ["value"],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -1728,6 +1766,8 @@ export function create_assignment_expressions(): IR.Module {
                         input_parameter_names: ["other_integer"],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -1803,6 +1843,8 @@ export function create_constant_array_expressions(): IR.Module {
                         input_parameter_names: [],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -1880,6 +1922,8 @@ export function create_function_pointer_types(): IR.Module {
                 input_parameter_names: ["lhs", "rhs"],
                 output_parameter_names: ["result"],
                 linkage: IR.Linkage.Private,
+                attributes: [],
+                parameter_attributes: [],
                 preconditions: [],
                 postconditions: [],
             },
@@ -1915,6 +1959,8 @@ export function create_function_pointer_types(): IR.Module {
                 input_parameter_names: [],
                 output_parameter_names: [],
                 linkage: IR.Linkage.External,
+                attributes: [],
+                parameter_attributes: [],
                 preconditions: [],
                 postconditions: [],
             },
@@ -2007,6 +2053,8 @@ export function create_unary_expressions(): IR.Module {
                         input_parameter_names: ["my_integer", "my_boolean"],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -2099,6 +2147,8 @@ export function create_pointer_types(): IR.Module {
                 input_parameter_names: input_parameters.map(pair => pair[0]),
                 output_parameter_names: [],
                 linkage: IR.Linkage.External,
+                attributes: [],
+                parameter_attributes: [],
                 preconditions: [],
                 postconditions: [],
             },
@@ -2155,6 +2205,8 @@ export function create_block_expressions(): IR.Module {
                         input_parameter_names: [],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -2283,6 +2335,8 @@ export function create_for_loop_expressions(): IR.Module {
                         input_parameter_names: ["value"],
                         output_parameter_names: [],
                         linkage: IR.Linkage.Private,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -2317,6 +2371,8 @@ export function create_for_loop_expressions(): IR.Module {
                         input_parameter_names: [],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -2582,6 +2638,8 @@ export function create_if_expressions(add_source_locations: boolean): IR.Module
                         input_parameter_names: ["message"],
                         output_parameter_names: [],
                         linkage: IR.Linkage.Private,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -2617,6 +2675,8 @@ export function create_if_expressions(add_source_locations: boolean): IR.Module
                         input_parameter_names: ["value"],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -2680,6 +2740,8 @@ export function create_reflection_expressions(): IR.Module {
                         input_parameter_names: [],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -2825,6 +2887,8 @@ export function create_switch_expressions(): IR.Module {
                         input_parameter_names: ["value"],
                         output_parameter_names: ["result"],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -2932,6 +2996,8 @@ export function create_ternary_condition_expressions(): IR.Module {
                         input_parameter_names: ["first_boolean", "second_boolean"],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -3103,6 +3169,8 @@ export function create_while_loop_expressions(): IR.Module {
                         input_parameter_names: ["value"],
                         output_parameter_names: [],
                         linkage: IR.Linkage.Private,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -3137,6 +3205,8 @@ export function create_while_loop_expressions(): IR.Module {
                         input_parameter_names: ["size"],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -3185,6 +3255,8 @@ export function create_function_contracts(): IR.Module {
                         input_parameter_names: ["x"],
                         output_parameter_names: ["result"],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [
                             {
                                 description: "x >= 0",
@@ -3267,6 +3339,8 @@ export function create_function_with_empty_return_expression(): IR.Module {
                         input_parameter_names: [],
                         output_parameter_names: [],
                         linkage: IR.Linkage.Private,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -3322,6 +3396,8 @@ export function create_import_module_with_empty_function(): IR.Module {
                         input_parameter_names: [],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -3366,6 +3442,8 @@ export function create_function_with_int32_return_expression(): IR.Module {
                         input_parameter_names: [],
                         output_parameter_names: ["result"],
                         linkage: IR.Linkage.Private,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -3614,6 +3692,8 @@ export function create_break_expressions(): IR.Module {
                         input_parameter_names: ["value"],
                         output_parameter_names: [],
                         linkage: IR.Linkage.Private,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -3648,6 +3728,8 @@ export function create_break_expressions(): IR.Module {
                         input_parameter_names: ["size"],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -3691,6 +3773,8 @@ export function create_using_alias(): IR.Module {
                         input_parameter_names: ["size"],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -3759,6 +3843,8 @@ export function create_using_enums(): IR.Module {
                         input_parameter_names: ["enum_argument"],
                         output_parameter_names: ["result"],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -3906,6 +3992,8 @@ export function create_using_enum_flags(): IR.Module {
                         input_parameter_names: ["enum_argument"],
                         output_parameter_names: ["result"],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -4124,6 +4212,8 @@ export function create_using_global_variables(): IR.Module {
                         input_parameter_names: ["parameter"],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -4249,6 +4339,8 @@ export function create_using_structs(): IR.Module {
                         input_parameter_names: ["my_struct"],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -4429,6 +4521,8 @@ export function create_using_structs(): IR.Module {
                         input_parameter_names: ["my_struct"],
                         output_parameter_names: [],
                         linkage: IR.Linkage.Private,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -4453,6 +4547,8 @@ export function create_using_structs(): IR.Module {
                         input_parameter_names: [],
                         output_parameter_names: ["my_struct"],
                         linkage: IR.Linkage.Private,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -4593,6 +4689,8 @@ export function create_using_unions(): IR.Module {
                         input_parameter_names: ["my_union", "my_union_tag"],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -4883,6 +4981,8 @@ export function create_using_unions(): IR.Module {
                         input_parameter_names: ["my_union"],
                         output_parameter_names: [],
                         linkage: IR.Linkage.Private,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -4907,6 +5007,8 @@ export function create_using_unions(): IR.Module {
                         input_parameter_names: [],
                         output_parameter_names: ["my_union"],
                         linkage: IR.Linkage.Private,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -4957,6 +5059,8 @@ export function create_variadic_function_declarations(): IR.Module {
                         input_parameter_names: ["first"],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -5039,6 +5143,8 @@ export function create_type_constructor(): IR.Module {
                         input_parameter_names: [],
                         output_parameter_names: [],
                         linkage: IR.Linkage.Private,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: []
                     },
@@ -5124,6 +5230,8 @@ export function create_function_constructor_0(): IR.Module {
                                             "result"
                                         ],
                                         linkage: IR.Linkage.External,
+                                        attributes: [],
+                                        parameter_attributes: [],
                                         preconditions: [],
                                         postconditions: [],
                                     },
@@ -5242,6 +5350,8 @@ export function create_function_constructor_1(): IR.Module {
                                             "result"
                                         ],
                                         linkage: IR.Linkage.Private,
+                                        attributes: [],
+                                        parameter_attributes: [],
                                         preconditions: [],
                                         postconditions: [],
                                     },
@@ -5280,6 +5390,8 @@ export function create_function_constructor_1(): IR.Module {
                         input_parameter_names: [],
                         output_parameter_names: [],
                         linkage: IR.Linkage.Private,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -5426,6 +5538,8 @@ export function create_comments_in_functions(add_source_locations: boolean): IR.
                         input_parameter_names: [],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                         comment: "Function comment\nNo arguments"
@@ -5609,6 +5723,8 @@ export function create_newlines_after_statements(add_source_locations: boolean):
                         input_parameter_names: [],
                         output_parameter_names: [],
                         linkage: IR.Linkage.Private,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -5696,6 +5812,8 @@ export function create_add_function(): IR.Module {
                         input_parameter_names: ["lhs", "rhs"],
                         output_parameter_names: ["result"],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -5740,6 +5858,8 @@ export function create_invalid_assignment_to_itself_function(): IR.Module {
                         input_parameter_names: [],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -5782,6 +5902,8 @@ export function create_function_with_variable_declaration(): IR.Module {
                         input_parameter_names: [],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -5831,6 +5953,8 @@ export function create_function_with_variable_declaration_with_type(): IR.Module
                         input_parameter_names: [],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -5917,6 +6041,8 @@ export function create_variable_declaration_inside_while_loop(): IR.Module {
                         input_parameter_names: [],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -5985,6 +6111,8 @@ export function create_variable_declaration_inside_if_expression(): IR.Module {
                         input_parameter_names: [],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -6054,6 +6182,8 @@ export function create_variable_declaration_inside_switch_case(): IR.Module {
                         input_parameter_names: [],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -6116,6 +6246,8 @@ export function create_access_struct_of_imported_module(): IR.Module {
                         input_parameter_names: [],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -6178,6 +6310,8 @@ export function create_call_of_function_of_imported_module(): IR.Module {
                         input_parameter_names: [],
                         output_parameter_names: [],
                         linkage: IR.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
@@ -2772,6 +2772,8 @@ export function node_to_function_declaration(root: Parser_node.Node, node: Parse
         input_parameter_names: input_parameter_names,
         output_parameter_names: output_parameter_names,
         linkage: linkage,
+        attributes: [],
+        parameter_attributes: [],
         preconditions: preconditions,
         postconditions: postconditions,
     };
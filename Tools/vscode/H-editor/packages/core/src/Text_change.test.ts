@@ -673,6 +673,8 @@ export function hello() -> ()
                         input_parameter_names: [],
                         output_parameter_names: [],
                         linkage: Core_intermediate_representation.Linkage.External,
+                        attributes: [],
+                        parameter_attributes: [],
                         preconditions: [],
                         postconditions: [],
                     },
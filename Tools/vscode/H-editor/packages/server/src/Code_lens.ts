@@ -54,7 +54,7 @@ export async function create(
                         {
                             range: Helpers.create_vscode_range(iterator.line, iterator.column, iterator.line, iterator.column + struct_name.length),
                             command: {
-                                title: `Size: ${struct_layout.size} bytes | Alignment: ${struct_layout.alignment} bytes`,
+                                title: create_struct_layout_title(struct_layout),
                                 command: ""
                             }
                         }
@@ -80,7 +80,7 @@ export async function create(
                                 {
                                     range: Helpers.create_vscode_range(iterator.line, iterator.column, iterator.line, iterator.column + struct_member_name.length),
                                     command: {
-                                        title: `Offset: ${struct_member_layout.offset} bytes | Size: ${struct_member_layout.size} bytes | Alignment: ${struct_member_layout.alignment} bytes`,
+                                        title: create_struct_member_layout_title(struct_member_layout),
                                         command: ""
                                     }
                                 }
@@ -109,12 +109,43 @@ interface Struct_member_layout {
     offset: number;
     size: number;
     alignment: number;
+    cache_line?: number;
+    crosses_cache_line?: boolean;
+}
+
+interface Struct_layout_hole {
+    offset: number;
+    size: number;
 }
 
 interface Struct_layout {
     size: number;
     alignment: number;
     members: Struct_member_layout[];
+    holes?: Struct_layout_hole[];
+    tail_padding?: number;
+    padding?: number;
+    cache_line_size?: number;
+    cache_line_count?: number;
+}
+
+function create_struct_layout_title(struct_layout: Struct_layout): string {
+    let title = `Size: ${struct_layout.size} bytes | Alignment: ${struct_layout.alignment} bytes`;
+    if (struct_layout.padding !== undefined) {
+        title += ` | Padding: ${struct_layout.padding} bytes`;
+    }
+    if (struct_layout.cache_line_count !== undefined) {
+        title += ` | Cache lines: ${struct_layout.cache_line_count}`;
+    }
+    return title;
+}
+
+function create_struct_member_layout_title(struct_member_layout: Struct_member_layout): string {
+    let title = `Offset: ${struct_member_layout.offset} bytes | Size: ${struct_member_layout.size} bytes | Alignment: ${struct_member_layout.alignment} bytes`;
+    if (struct_member_layout.crosses_cache_line === true) {
+        title += ` | Crosses cache line`;
+    }
+    return title;
 }
 
 async function get_struct_layout(